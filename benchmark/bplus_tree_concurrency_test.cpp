@@ -264,6 +264,9 @@ public:
 
     BenchmarkBase::SetUp(state);
 
+    // 第二个参数控制是否乐观地查找叶子节点，用来对比加锁的 crabbing protocol
+    handler_.set_optimistic_descent(state.range(1) != 0);
+
     uint32_t max = static_cast<uint32_t>(state.range(0)) * 3;
     ASSERT(max > 0, "invalid argument count. %ld", state.range(0));
     FillUp(0, max);
@@ -290,7 +293,7 @@ BENCHMARK_DEFINE_F(ScanBenchmark, Scan)(State &state)
   state.counters["other"]                 = Counter(stat.scan_other_count, Counter::kIsRate);
 }
 
-BENCHMARK_REGISTER_F(ScanBenchmark, Scan)->Threads(10)->Arg(4 * 10000);
+BENCHMARK_REGISTER_F(ScanBenchmark, Scan)->ThreadRange(1, 16)->Args({4 * 10000, 0})->Args({4 * 10000, 1});
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -0,0 +1,175 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <benchmark/benchmark.h>
+#include <cmath>
+
+#include "common/lang/random.h"
+#include "common/lang/stdexcept.h"
+#include "common/log/log.h"
+#include "storage/buffer/disk_buffer_pool.h"
+
+using namespace std;
+using namespace common;
+using namespace benchmark;
+
+/**
+ * @brief 比较不同页面置换策略的命中率和吞吐量
+ * @details 直接使用 BPFrameManager 模拟页面访问，不读写磁盘：命中时只 pin/unpin，没有命中时分配一个页帧，
+ * 页帧用完了就淘汰一个。
+ * 参数 0 是置换策略，参数 1 是负载类型：
+ * 0 zipfian，所有访问都按照 zipfian 分布落在热点页面上；
+ * 1 scan，一部分访问是对一个很大的冷数据范围的顺序扫描，模拟 OLTP 负载中混入的全表扫描。
+ */
+
+static const int POOL_NUM        = 8;                          ///< 页帧个数 POOL_NUM * 128
+static const int HOT_PAGE_NUM    = 8 * 1024;                   ///< zipfian 访问的页面范围
+static const int SCAN_PAGE_NUM   = 64 * 1024;                  ///< 扫描的冷数据范围
+static const int SCAN_PERCENTAGE = 30;                         ///< scan 负载中扫描访问的比例
+static const int BUFFER_POOL_ID  = 1;
+static const int SCAN_POOL_ID    = 2;
+
+/**
+ * @brief zipfian 分布的随机数
+ * @details 参考 Gray et al. Quickly Generating Billion-Record Synthetic Databases
+ */
+class ZipfianGenerator
+{
+public:
+  ZipfianGenerator(int item_num, double theta, unsigned seed) : item_num_(item_num), theta_(theta), random_(seed)
+  {
+    for (int i = 1; i <= item_num; i++) {
+      zetan_ += 1.0 / pow(i, theta);
+    }
+    const double zeta2 = 1.0 + 1.0 / pow(2, theta);
+    alpha_             = 1.0 / (1.0 - theta);
+    eta_               = (1.0 - pow(2.0 / item_num, 1.0 - theta)) / (1.0 - zeta2 / zetan_);
+  }
+
+  int next()
+  {
+    const double u  = uniform_(random_);
+    const double uz = u * zetan_;
+    if (uz < 1.0) {
+      return 0;
+    }
+    if (uz < 1.0 + pow(0.5, theta_)) {
+      return 1;
+    }
+    return static_cast<int>(item_num_ * pow(eta_ * u - eta_ + 1.0, alpha_)) % item_num_;
+  }
+
+private:
+  int                              item_num_ = 0;
+  double                           theta_    = 0;
+  double                           zetan_    = 0;
+  double                           alpha_    = 0;
+  double                           eta_      = 0;
+  mt19937                          random_;
+  uniform_real_distribution<double> uniform_{0.0, 1.0};
+};
+
+class FrameReplacerBenchmark : public Fixture
+{
+public:
+  void SetUp(const State &state) override
+  {
+    if (0 != state.thread_index()) {
+      return;
+    }
+
+    LoggerFactory::init_default("frame_replacer_performance_test.log", LOG_LEVEL_WARN);
+
+    frame_manager_ = make_unique<BPFrameManager>(
+        "Benchmark", BPFrameManager::DEFAULT_SHARD_NUM, static_cast<FrameReplacerType>(state.range(0)));
+    if (frame_manager_->init(POOL_NUM) != RC::SUCCESS) {
+      throw runtime_error("failed to init frame manager");
+    }
+    scan_cursor_ = 0;
+  }
+
+  void TearDown(const State &state) override
+  {
+    if (0 != state.thread_index()) {
+      return;
+    }
+
+    for (int buffer_pool_id : {BUFFER_POOL_ID, SCAN_POOL_ID}) {
+      for (Frame *frame : frame_manager_->find_list(buffer_pool_id)) {
+        frame_manager_->free(buffer_pool_id, frame->page_num(), frame);
+      }
+    }
+    frame_manager_->cleanup();
+    frame_manager_.reset();
+  }
+
+  /// @brief 访问一个页面，返回是否命中
+  bool Access(int buffer_pool_id, PageNum page_num)
+  {
+    Frame *frame = frame_manager_->get(buffer_pool_id, page_num);
+    const bool hit = frame != nullptr;
+    while (nullptr == frame) {
+      frame = frame_manager_->alloc(buffer_pool_id, page_num);
+      if (nullptr == frame) {
+        (void)frame_manager_->purge_frames(1, [](Frame *) { return RC::SUCCESS; });
+      }
+    }
+    frame->unpin();
+    return hit;
+  }
+
+protected:
+  unique_ptr<BPFrameManager> frame_manager_;
+  atomic<int64_t>            scan_cursor_{0};
+};
+
+BENCHMARK_DEFINE_F(FrameReplacerBenchmark, Access)(State &state)
+{
+  const bool       scan_workload = state.range(1) == 1;
+  ZipfianGenerator zipfian(HOT_PAGE_NUM, 0.99, state.thread_index() + 1);
+  mt19937          random(state.thread_index() + 1);
+
+  int64_t hot_hits   = 0;
+  int64_t hot_misses = 0;
+  for (auto _ : state) {
+    if (scan_workload && static_cast<int>(random() % 100) < SCAN_PERCENTAGE) {
+      (void)Access(SCAN_POOL_ID, scan_cursor_.fetch_add(1) % SCAN_PAGE_NUM);
+      continue;
+    }
+
+    if (Access(BUFFER_POOL_ID, zipfian.next())) {
+      hot_hits++;
+    } else {
+      hot_misses++;
+    }
+  }
+
+  // 只统计热点页面的命中率，扫描访问的页面基本上不可能命中
+  state.counters["hot_hit_ratio"] =
+      Counter(static_cast<double>(hot_hits) / max<int64_t>(hot_hits + hot_misses, 1), Counter::kAvgThreads);
+  state.counters["accesses"] = Counter(static_cast<double>(state.iterations()), Counter::kIsRate);
+  state.SetLabel(string(frame_replacer_type_name(static_cast<FrameReplacerType>(state.range(0)))) +
+                 (scan_workload ? "/scan" : "/zipfian"));
+}
+
+static void ReplacerArguments(internal::Benchmark *b)
+{
+  for (FrameReplacerType type : {FrameReplacerType::LRU, FrameReplacerType::CLOCK, FrameReplacerType::TWO_QUEUE}) {
+    for (int workload : {0, 1}) {
+      b->Args({static_cast<int64_t>(type), workload});
+    }
+  }
+}
+
+BENCHMARK_REGISTER_F(FrameReplacerBenchmark, Access)->Apply(ReplacerArguments)->Threads(1)->Threads(8);
+
+////////////////////////////////////////////////////////////////////////////////
+
+BENCHMARK_MAIN();
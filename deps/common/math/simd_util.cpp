@@ -9,6 +9,7 @@ MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
 See the Mulan PSL v2 for more details. */
 
 #include <stdint.h>
+#include <string.h>
 #include "common/math/simd_util.h"
 
 #if defined(USE_SIMD)
@@ -40,6 +41,63 @@ float mm256_sum_ps(const float *values, int size)
   return sum;
 }
 
+void mm256_hash_epi32(const int *values, uint32_t *hashes, int size)
+{
+  const __m256i factor = _mm256_set1_epi32(static_cast<int>(0x9E3779B1U));
+
+  int i = 0;
+  for (; i + SIMD_WIDTH <= size; i += SIMD_WIDTH) {
+    __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(values + i));
+    __m256i hash  = _mm256_mullo_epi32(value, factor);
+    hash          = _mm256_xor_si256(hash, _mm256_srli_epi32(hash, 16));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(hashes + i), hash);
+  }
+  for (; i < size; i++) {
+    hashes[i] = hash_epi32(values[i]);
+  }
+}
+
+int mm256_count_less_epi32(const char *data, int stride, int size, int value)
+{
+  const __m256i offsets = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(stride));
+  const __m256i target  = _mm256_set1_epi32(value);
+
+  int count = 0;
+  int i     = 0;
+  for (; i + SIMD_WIDTH <= size; i += SIMD_WIDTH) {
+    __m256i values = _mm256_i32gather_epi32(reinterpret_cast<const int *>(data + i * stride), offsets, 1);
+    __m256i less   = _mm256_cmpgt_epi32(target, values);
+    count += __builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(less)));
+  }
+  for (; i < size; i++) {
+    int v;
+    memcpy(&v, data + i * stride, sizeof(v));
+    count += v < value ? 1 : 0;
+  }
+  return count;
+}
+
+int mm256_count_less_ps(const char *data, int stride, int size, float value, float epsilon)
+{
+  const __m256i offsets   = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(stride));
+  const __m256  target    = _mm256_set1_ps(value);
+  const __m256  threshold = _mm256_set1_ps(-epsilon);
+
+  int count = 0;
+  int i     = 0;
+  for (; i + SIMD_WIDTH <= size; i += SIMD_WIDTH) {
+    __m256 values = _mm256_i32gather_ps(reinterpret_cast<const float *>(data + i * stride), offsets, 1);
+    __m256 less   = _mm256_cmp_ps(_mm256_sub_ps(values, target), threshold, _CMP_LT_OQ);
+    count += __builtin_popcount(_mm256_movemask_ps(less));
+  }
+  for (; i < size; i++) {
+    float v;
+    memcpy(&v, data + i * stride, sizeof(v));
+    count += v - value < -epsilon ? 1 : 0;
+  }
+  return count;
+}
+
 template <typename V>
 void selective_load(V *memory, int offset, V *vec, __m256i &inv)
 {
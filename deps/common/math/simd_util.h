@@ -10,6 +10,15 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include <stdint.h>
+
+/// @brief 单个 int 值的乘法哈希（Fibonacci hashing）
+inline uint32_t hash_epi32(int value)
+{
+  uint32_t hash = static_cast<uint32_t>(value) * 0x9E3779B1U;
+  return hash ^ (hash >> 16);
+}
+
 #if defined(USE_SIMD)
 #include <immintrin.h>
 
@@ -22,6 +31,17 @@ int mm256_extract_epi32_var_indx(const __m256i vec, const unsigned int i);
 int   mm256_sum_epi32(const int *values, int size);
 float mm256_sum_ps(const float *values, int size);
 
+/// @brief 批量计算 int 值的哈希值，结果与 hash_epi32 相同
+void mm256_hash_epi32(const int *values, uint32_t *hashes, int size);
+
+/**
+ * @brief 统计按照 stride 字节间隔存放的有序 int 值中有多少个小于 value
+ * @details 用于B+树节点内的查找，节点中的键值与RID等数据交错存放，使用 gather 指令读取
+ */
+int mm256_count_less_epi32(const char *data, int stride, int size, int value);
+/// @brief 与 mm256_count_less_epi32 相同，统计 v - value < -epsilon 的 float 值个数
+int mm256_count_less_ps(const char *data, int stride, int size, float value, float epsilon);
+
 /// @brief selective load 的标量实现
 template <typename V>
 void selective_load(V *memory, int offset, V *vec, __m256i &inv);
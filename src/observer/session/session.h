@@ -83,6 +83,15 @@ public:
   void          set_execution_mode(const ExecutionMode mode) { execution_mode_ = mode; }
   ExecutionMode get_execution_mode() const { return execution_mode_; }
 
+  void    set_sort_buffer_size(int64_t size) { sort_buffer_size_ = size; }
+  int64_t sort_buffer_size() const { return sort_buffer_size_; }
+
+  void set_index_fill_factor(int fill_factor) { index_fill_factor_ = fill_factor; }
+  int  index_fill_factor() const { return index_fill_factor_; }
+
+  void set_index_scan_batch_size(int batch_size) { index_scan_batch_size_ = batch_size; }
+  int  index_scan_batch_size() const { return index_scan_batch_size_; }
+
   bool used_chunk_mode() { return used_chunk_mode_; }
 
   void set_used_chunk_mode(bool used_chunk_mode) { used_chunk_mode_ = used_chunk_mode; }
@@ -113,4 +122,8 @@ private:
   bool used_chunk_mode_ = false;
 
   ExecutionMode execution_mode_ = ExecutionMode::TUPLE_ITERATOR;
+
+  int64_t sort_buffer_size_      = 64 * 1024 * 1024;  ///< 排序可以使用的内存，超过后使用外部排序
+  int     index_fill_factor_     = 90;  ///< 批量构建索引时节点的填充比例，百分比
+  int     index_scan_batch_size_ = 0;  ///< 索引扫描时一次取出多少个RID按页面顺序读取记录，0表示不使用。会改变结果的顺序，默认关闭
 };
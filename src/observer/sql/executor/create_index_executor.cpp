@@ -32,5 +32,12 @@ RC CreateIndexExecutor::execute(SQLStageEvent *sql_event)
 
   Trx   *trx   = session->current_trx();
   Table *table = create_index_stmt->table();
-  return table->create_index(trx, create_index_stmt->field_meta(), create_index_stmt->index_name().c_str(), create_index_stmt->is_unique());
+  return table->create_index(trx,
+      create_index_stmt->field_metas(),
+      create_index_stmt->index_name().c_str(),
+      create_index_stmt->is_unique(),
+      session->index_fill_factor(),
+      session->sort_buffer_size(),
+      create_index_stmt->is_prefix_compressed(),
+      create_index_stmt->index_type());
 }
@@ -18,6 +18,7 @@ See the Mulan PSL v2 for more details. */
 #include "event/sql_event.h"
 #include "sql/executor/sql_result.h"
 #include "sql/stmt/load_data_stmt.h"
+#include "storage/buffer/buffer_ring.h"
 
 using namespace common;
 
@@ -38,10 +39,11 @@ RC LoadDataExecutor::execute(SQLStageEvent *sql_event)
  * @param file_values 从文件中读取到的一行数据，使用分隔符拆分后的几个字段值
  * @param record_values Table::insert_record使用的参数，为了防止频繁的申请内存
  * @param errmsg 如果出现错误，通过这个参数返回错误信息
+ * @param ring 导入数据使用的私有页帧环，写满的页面在环中回收，不会把其它表的页面挤出缓存
  * @return 成功返回RC::SUCCESS
  */
-RC insert_record_from_file(
-    Table *table, std::vector<std::string> &file_values, std::vector<Value> &record_values, std::stringstream &errmsg)
+RC insert_record_from_file(Table *table, std::vector<std::string> &file_values, std::vector<Value> &record_values,
+    std::stringstream &errmsg, BufferRing &ring)
 {
 
   const int field_num     = record_values.size();
@@ -69,8 +71,11 @@ RC insert_record_from_file(
     rc = table->make_record(field_num, record_values.data(), record);
     if (rc != RC::SUCCESS) {
       errmsg << "insert failed.";
-    } else if (RC::SUCCESS != (rc = table->insert_record(record))) {
+    } else if (RC::SUCCESS != (rc = table->insert_record(record, &ring))) {
       errmsg << "insert failed.";
+    } else {
+      // 导入的数据不经过事务，插入成功就相当于提交了
+      table->visibility_map().commit_change(record.rid().page_num, 0 /*commit_xid*/, false /*deleted*/);
     }
   }
   return rc;
@@ -101,6 +106,9 @@ void LoadDataExecutor::load_data(Table *table, const char *file_name, SqlResult
   int                      line_num        = 0;
   int                      insertion_count = 0;
   RC                       rc              = RC::SUCCESS;
+  BufferRing               ring;
+  // 导入的数据不经过事务，直接对所有事务可见
+  table->row_counter().begin_change();
   while (!fs.eof() && RC::SUCCESS == rc) {
     std::getline(fs, line);
     line_num++;
@@ -111,7 +119,7 @@ void LoadDataExecutor::load_data(Table *table, const char *file_name, SqlResult
     file_values.clear();
     common::split_string(line, delim, file_values);
     std::stringstream errmsg;
-    rc = insert_record_from_file(table, file_values, record_values, errmsg);
+    rc = insert_record_from_file(table, file_values, record_values, errmsg, ring);
     if (rc != RC::SUCCESS) {
       result_string << "Line:" << line_num << " insert record failed:" << errmsg.str() << ". error:" << strrc(rc)
                     << std::endl;
@@ -120,6 +128,7 @@ void LoadDataExecutor::load_data(Table *table, const char *file_name, SqlResult
     }
   }
   fs.close();
+  table->row_counter().commit_change(0 /*commit_xid*/, insertion_count);
 
   struct timespec end_time;
   clock_gettime(CLOCK_MONOTONIC, &end_time);
@@ -34,6 +34,27 @@ RC SetVariableExecutor::execute(SQLStageEvent *sql_event)
       } else {
         rc = RC::INVALID_ARGUMENT;
       }
+    } else if (strcasecmp(var_name, "sort_buffer_size") == 0) {
+      if (var_value.attr_type() == AttrType::INTS && var_value.get_int() > 0) {
+        session->set_sort_buffer_size(var_value.get_int());
+        LOG_TRACE("set sort_buffer_size to %d", var_value.get_int());
+      } else {
+        rc = RC::VARIABLE_NOT_VALID;
+      }
+    } else if (strcasecmp(var_name, "index_fill_factor") == 0) {
+      if (var_value.attr_type() == AttrType::INTS && var_value.get_int() >= 10 && var_value.get_int() <= 100) {
+        session->set_index_fill_factor(var_value.get_int());
+        LOG_TRACE("set index_fill_factor to %d", var_value.get_int());
+      } else {
+        rc = RC::VARIABLE_NOT_VALID;
+      }
+    } else if (strcasecmp(var_name, "index_scan_batch_size") == 0) {
+      if (var_value.attr_type() == AttrType::INTS && var_value.get_int() >= 0) {
+        session->set_index_scan_batch_size(var_value.get_int());
+        LOG_TRACE("set index_scan_batch_size to %d", var_value.get_int());
+      } else {
+        rc = RC::VARIABLE_NOT_VALID;
+      }
     } else {
       rc = RC::VARIABLE_NOT_EXISTS;
     }
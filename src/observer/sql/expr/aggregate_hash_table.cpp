@@ -12,10 +12,74 @@ See the Mulan PSL v2 for more details. */
 
 // ----------------------------------StandardAggregateHashTable------------------
 
+/**
+ * @brief 将 Value 追加到定长的列中
+ * @details 字符串类型的 Value 长度可能小于列宽，需要补齐后再写入
+ */
+static RC append_value(Column &column, const Value &value)
+{
+  if (value.length() >= column.attr_len()) {
+    return column.append_one(const_cast<char *>(value.data()));
+  }
+
+  vector<char> buffer(column.attr_len(), 0);
+  memcpy(buffer.data(), value.data(), value.length());
+  return column.append_one(buffer.data());
+}
+
 RC StandardAggregateHashTable::add_chunk(Chunk &groups_chunk, Chunk &aggrs_chunk)
 {
-  // your code here
-  exit(-1);
+  if (groups_chunk.rows() != aggrs_chunk.rows()) {
+    LOG_WARN("groups_chunk and aggrs_chunk rows must be equal.");
+    return RC::INVALID_ARGUMENT;
+  }
+  if (aggrs_chunk.column_num() != static_cast<int>(aggr_types_.size())) {
+    LOG_WARN("aggrs_chunk column num must be equal to aggregate num.");
+    return RC::INVALID_ARGUMENT;
+  }
+
+  RC rc = RC::SUCCESS;
+  for (int row = 0; row < groups_chunk.rows(); row++) {
+    // 跳过被过滤掉的行
+    if (!groups_chunk.selected(row)) {
+      continue;
+    }
+
+    vector<Value> group_by_values;
+    group_by_values.reserve(groups_chunk.column_num());
+    for (int col = 0; col < groups_chunk.column_num(); col++) {
+      group_by_values.emplace_back(groups_chunk.get_value(col, row));
+    }
+
+    auto iter = aggr_values_.find(group_by_values);
+    if (iter == aggr_values_.end()) {
+      vector<Value> aggr_values;
+      aggr_values.reserve(aggrs_chunk.column_num());
+      for (int col = 0; col < aggrs_chunk.column_num(); col++) {
+        aggr_values.emplace_back(aggrs_chunk.get_value(col, row));
+      }
+      aggr_values_.emplace(std::move(group_by_values), std::move(aggr_values));
+      continue;
+    }
+
+    vector<Value> &aggr_values = iter->second;
+    for (int col = 0; col < aggrs_chunk.column_num(); col++) {
+      Value value = aggrs_chunk.get_value(col, row);
+      switch (aggr_types_[col]) {
+        case AggregateExpr::Type::SUM: rc = Value::add(aggr_values[col], value, aggr_values[col]); break;
+        case AggregateExpr::Type::MAX: rc = Value::max(aggr_values[col], value, aggr_values[col]); break;
+        case AggregateExpr::Type::MIN: rc = Value::min(aggr_values[col], value, aggr_values[col]); break;
+        default: {
+          LOG_WARN("unsupported aggregate type: %d", aggr_types_[col]);
+          rc = RC::UNIMPLEMENTED;
+        }
+      }
+      if (OB_FAIL(rc)) {
+        return rc;
+      }
+    }
+  }
+  return rc;
 }
 
 void StandardAggregateHashTable::Scanner::open_scan()
@@ -29,15 +93,15 @@ RC StandardAggregateHashTable::Scanner::next(Chunk &output_chunk)
   if (it_ == end_) {
     return RC::RECORD_EOF;
   }
-  while (it_ != end_ && output_chunk.rows() <= output_chunk.capacity()) {
+  while (it_ != end_ && output_chunk.rows() < output_chunk.capacity()) {
     auto &group_by_values = it_->first;
     auto &aggrs           = it_->second;
     for (int i = 0; i < output_chunk.column_num(); i++) {
       auto col_idx = output_chunk.column_ids(i);
       if (col_idx >= static_cast<int>(group_by_values.size())) {
-        output_chunk.column(i).append_one((char *)aggrs[col_idx - group_by_values.size()].data());
+        append_value(output_chunk.column(i), aggrs[col_idx - group_by_values.size()]);
       } else {
-        output_chunk.column(i).append_one((char *)group_by_values[col_idx].data());
+        append_value(output_chunk.column(i), group_by_values[col_idx]);
       }
     }
     it_++;
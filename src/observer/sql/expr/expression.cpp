@@ -13,6 +13,7 @@ See the Mulan PSL v2 for more details. */
 //
 
 #include "sql/expr/expression.h"
+#include "common/lang/algorithm.h"
 #include "common/like.h"
 #include "common/log/log.h"
 #include "common/type/attr_type.h"
@@ -39,14 +40,34 @@ bool FieldExpr::equal(const Expression &other) const
   return table_name() == other_field_expr.table_name() && field_name() == other_field_expr.field_name();
 }
 
-// TODO: 在进行表达式计算时，`chunk` 包含了所有列，因此可以通过 `field_id` 获取到对应列。
-// 后续可以优化成在 `FieldExpr` 中存储 `chunk` 中某列的位置信息。
+// 表扫描输出的 `chunk` 只包含上层引用到的列，列 id 是字段在表元数据中的下标（包括系统字段），
+// 因此需要通过列 id 查找到对应的列。连接的结果中有多个表的列，还需要通过表 id 区分。
 RC FieldExpr::get_column(Chunk &chunk, Column &column)
 {
   if (pos_ != -1) {
     column.reference(chunk.column(pos_));
-  } else {
-    column.reference(chunk.column(field().meta()->field_id()));
+    return RC::SUCCESS;
+  }
+
+  int col_id   = field().meta()->field_id();
+  int table_id = -1;
+  if (field().table() != nullptr) {
+    col_id += field().table()->table_meta().sys_field_num();
+    table_id = field().table()->table_id();
+  }
+  int index = chunk.column_index(col_id, table_id);
+  if (index < 0) {
+    LOG_WARN("cannot find column in chunk. field=%s, col_id=%d", field_name(), col_id);
+    return RC::INTERNAL;
+  }
+  column.reference(chunk.column(index));
+  return RC::SUCCESS;
+}
+
+RC ValueExpr::eval(Chunk &chunk, std::vector<uint8_t> &select)
+{
+  if (!value_.get_boolean()) {
+    select.assign(select.size(), 0);
   }
   return RC::SUCCESS;
 }
@@ -324,6 +345,54 @@ RC ConjunctionExpr::get_value(const Tuple &tuple, Value &value) const
   return rc;
 }
 
+RC ConjunctionExpr::eval(Chunk &chunk, std::vector<uint8_t> &select)
+{
+  RC   rc          = RC::SUCCESS;
+  auto has_any_row = [](const vector<uint8_t> &rows) { return find(rows.begin(), rows.end(), 1) != rows.end(); };
+
+  if (conjunction_type_ == Type::AND) {
+    for (const unique_ptr<Expression> &expr : children_) {
+      if (!has_any_row(select)) {
+        break;
+      }
+      rc = expr->eval(chunk, select);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to eval child expression. rc=%s", strrc(rc));
+        return rc;
+      }
+    }
+    return rc;
+  }
+
+  if (children_.empty()) {
+    return rc;
+  }
+
+  // OR: result 记录已经满足条件的行，remain 是还需要计算的行
+  vector<uint8_t> result(select.size(), 0);
+  vector<uint8_t> remain(select);
+  for (const unique_ptr<Expression> &expr : children_) {
+    if (!has_any_row(remain)) {
+      break;
+    }
+
+    vector<uint8_t> child_select(remain);
+    rc = expr->eval(chunk, child_select);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to eval child expression. rc=%s", strrc(rc));
+      return rc;
+    }
+    for (size_t i = 0; i < child_select.size(); i++) {
+      if (child_select[i]) {
+        result[i] = 1;
+        remain[i] = 0;
+      }
+    }
+  }
+  select.swap(result);
+  return rc;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 ArithmeticExpr::ArithmeticExpr(ArithmeticExpr::Type type, Expression *left, Expression *right)
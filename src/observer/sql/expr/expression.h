@@ -231,6 +231,11 @@ public:
     return RC::SUCCESS;
   }
 
+  /**
+   * @brief 常量作为谓词时，值为 false 则过滤掉所有行
+   */
+  RC eval(Chunk &chunk, std::vector<uint8_t> &select) override;
+
   ExprType type() const override { return ExprType::VALUE; }
   AttrType value_type() const override { return value_.attr_type(); }
   int      value_length() const override { return value_.length(); }
@@ -338,6 +343,13 @@ public:
   AttrType value_type() const override { return AttrType::BOOLEANS; }
   RC       get_value(const Tuple &tuple, Value &value) const override;
 
+  /**
+   * @brief 向量化计算 AND/OR 的结果
+   * @details 与 ComparisonExpr 一样，只会把 select 中的有效行置为无效。AND 依次在 select 上计算子表达式，
+   * 所有行都无效时不再计算剩下的子表达式；OR 只对还没有满足条件的行计算子表达式，所有行都满足时不再计算。
+   */
+  RC eval(Chunk &chunk, std::vector<uint8_t> &select) override;
+
   Type conjunction_type() const { return conjunction_type_; }
 
   std::vector<std::unique_ptr<Expression>> &children() { return children_; }
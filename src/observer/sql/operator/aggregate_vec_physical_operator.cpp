@@ -72,9 +72,9 @@ RC AggregateVecPhysicalOperator::open(Trx *trx)
       auto *aggregate_expr = static_cast<AggregateExpr *>(aggregate_expressions_[aggr_idx]);
       if (aggregate_expr->aggregate_type() == AggregateExpr::Type::SUM) {
         if (aggregate_expr->value_type() == AttrType::INTS) {
-          update_aggregate_state<SumState<int>, int>(aggr_values_.at(aggr_idx), column);
+          update_aggregate_state<SumState<int>, int>(aggr_values_.at(aggr_idx), column, chunk_);
         } else if (aggregate_expr->value_type() == AttrType::FLOATS) {
-          update_aggregate_state<SumState<float>, float>(aggr_values_.at(aggr_idx), column);
+          update_aggregate_state<SumState<float>, float>(aggr_values_.at(aggr_idx), column, chunk_);
         } else {
           ASSERT(false, "not supported value type");
         }
@@ -91,17 +91,56 @@ RC AggregateVecPhysicalOperator::open(Trx *trx)
   return rc;
 }
 template <class STATE, typename T>
-void AggregateVecPhysicalOperator::update_aggregate_state(void *state, const Column &column)
+void AggregateVecPhysicalOperator::update_aggregate_state(void *state, const Column &column, const Chunk &chunk)
 {
   STATE *state_ptr = reinterpret_cast<STATE *>(state);
   T *    data      = (T *)column.data();
-  state_ptr->update(data, column.count());
+  if (!chunk.has_select()) {
+    state_ptr->update(data, column.count());
+    return;
+  }
+
+  // 只聚合选择向量中有效的行，连续的有效行作为一批更新
+  const int rows  = column.count();
+  int       start = 0;
+  while (start < rows) {
+    if (!chunk.selected(start)) {
+      start++;
+      continue;
+    }
+    int end = start + 1;
+    while (end < rows && chunk.selected(end)) {
+      end++;
+    }
+    state_ptr->update(data + start, end - start);
+    start = end;
+  }
 }
 
 RC AggregateVecPhysicalOperator::next(Chunk &chunk)
 {
-  // your code here
-  exit(-1);
+  if (outputted_) {
+    return RC::RECORD_EOF;
+  }
+
+  output_chunk_.reset_data();
+  for (size_t aggr_idx = 0; aggr_idx < aggregate_expressions_.size(); aggr_idx++) {
+    auto *aggregate_expr = static_cast<AggregateExpr *>(aggregate_expressions_[aggr_idx]);
+    if (aggregate_expr->aggregate_type() == AggregateExpr::Type::SUM) {
+      if (aggregate_expr->value_type() == AttrType::INTS) {
+        append_to_column<SumState<int>, int>(aggr_values_.at(aggr_idx), output_chunk_.column(aggr_idx));
+      } else if (aggregate_expr->value_type() == AttrType::FLOATS) {
+        append_to_column<SumState<float>, float>(aggr_values_.at(aggr_idx), output_chunk_.column(aggr_idx));
+      } else {
+        ASSERT(false, "not supported value type");
+      }
+    } else {
+      ASSERT(false, "not supported aggregation type");
+    }
+  }
+
+  outputted_ = true;
+  return chunk.reference(output_chunk_);
 }
 
 RC AggregateVecPhysicalOperator::close()
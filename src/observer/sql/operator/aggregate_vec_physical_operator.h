@@ -31,7 +31,7 @@ public:
 
 private:
   template <class STATE, typename T>
-  void update_aggregate_state(void *state, const Column &column);
+  void update_aggregate_state(void *state, const Column &column, const Chunk &chunk);
 
   template <class STATE, typename T>
   void append_to_column(void *state, Column &column)
@@ -71,4 +71,5 @@ private:
   Chunk                     chunk_;
   Chunk                     output_chunk_;
   AggregateValues           aggr_values_;
+  bool                      outputted_ = false;  /// 聚合结果只输出一次
 };
\ No newline at end of file
@@ -48,6 +48,10 @@ RC ExprVecPhysicalOperator::next(Chunk &chunk)
       expressions_[i]->get_column(chunk_, *column);
       evaled_chunk_.add_column(std::move(column), i);
     }
+    // 表达式按列计算所有行，过滤结果通过选择向量继续传递给上层算子
+    if (chunk_.has_select()) {
+      evaled_chunk_.set_select(chunk_.select());
+    }
     chunk.reference(evaled_chunk_);
   }
   return rc;
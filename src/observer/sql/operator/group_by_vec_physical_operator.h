@@ -16,20 +16,29 @@ See the Mulan PSL v2 for more details. */
 /**
  * @brief Group By 物理算子(vectorized)
  * @ingroup PhysicalOperator
+ * @details 使用 StandardAggregateHashTable 做 hash group by，会跳过子算子选择向量中无效的行
  */
 class GroupByVecPhysicalOperator : public PhysicalOperator
 {
 public:
   GroupByVecPhysicalOperator(
-      std::vector<std::unique_ptr<Expression>> &&group_by_exprs, std::vector<Expression *> &&expressions){};
+      std::vector<std::unique_ptr<Expression>> &&group_by_exprs, std::vector<Expression *> &&expressions);
 
   virtual ~GroupByVecPhysicalOperator() = default;
 
   PhysicalOperatorType type() const override { return PhysicalOperatorType::GROUP_BY_VEC; }
 
-  RC open(Trx *trx) override { return RC::UNIMPLEMENTED; }
-  RC next(Chunk &chunk) override { return RC::UNIMPLEMENTED; }
-  RC close() override { return RC::UNIMPLEMENTED; }
+  RC open(Trx *trx) override;
+  RC next(Chunk &chunk) override;
+  RC close() override;
 
 private:
-};
\ No newline at end of file
+  std::vector<std::unique_ptr<Expression>> group_by_expressions_;
+  std::vector<Expression *>                aggregate_expressions_;  /// 聚合表达式
+  std::vector<Expression *>                value_expressions_;      /// 聚合表达式的子表达式
+  StandardAggregateHashTable               hash_table_;
+  StandardAggregateHashTable::Scanner      scanner_;
+  Chunk                                    chunk_;
+  Chunk                                    output_chunk_;
+  bool                                     scan_opened_ = false;
+};
@@ -0,0 +1,209 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "sql/operator/hash_join_physical_operator.h"
+#include "common/log/log.h"
+
+using namespace std;
+
+HashJoinPhysicalOperator::HashJoinPhysicalOperator(
+    vector<unique_ptr<Expression>> &&left_keys, vector<unique_ptr<Expression>> &&right_keys, bool build_left)
+    : left_keys_(std::move(left_keys)), right_keys_(std::move(right_keys)), build_left_(build_left)
+{
+  ASSERT(left_keys_.size() == right_keys_.size(), "join keys of both sides should have the same size");
+}
+
+string HashJoinPhysicalOperator::param() const { return build_left_ ? "build=left" : "build=right"; }
+
+RC HashJoinPhysicalOperator::open(Trx *trx)
+{
+  if (children_.size() != 2) {
+    LOG_WARN("hash join operator should have 2 children");
+    return RC::INTERNAL;
+  }
+
+  RC rc = build(trx);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to build hash table of hash join. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  rc = probe_child()->open(trx);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to open probe child of hash join. rc=%s", strrc(rc));
+    return rc;
+  }
+  probe_opened_ = true;
+  probe_tuple_  = nullptr;
+  matches_      = nullptr;
+  match_pos_    = 0;
+  return rc;
+}
+
+RC HashJoinPhysicalOperator::build(Trx *trx)
+{
+  build_tuples_.clear();
+  hash_table_.clear();
+
+  PhysicalOperator *child = build_child();
+  RC                rc    = child->open(trx);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to open build child of hash join. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  vector<Value> key;
+  while (OB_SUCC(rc = child->next())) {
+    Tuple *tuple = child->current_tuple();
+    if (nullptr == tuple) {
+      LOG_WARN("failed to get tuple from build child of hash join");
+      rc = RC::INTERNAL;
+      break;
+    }
+
+    bool has_null = false;
+    rc            = make_key(build_keys(), *tuple, key, has_null);
+    if (OB_FAIL(rc)) {
+      break;
+    }
+    if (has_null) {
+      continue;
+    }
+
+    // 孩子算子返回的 tuple 在下次调用 next 后就失效了，需要物化下来
+    ValueListTuple value_list;
+    rc = ValueListTuple::make(*tuple, value_list);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to materialize tuple of build child. rc=%s", strrc(rc));
+      break;
+    }
+
+    hash_table_[key].push_back(build_tuples_.size());
+    build_tuples_.emplace_back(std::move(value_list));
+  }
+
+  RC close_rc = child->close();
+  if (rc == RC::RECORD_EOF) {
+    rc = close_rc;
+  }
+  LOG_TRACE("hash join build done. rows=%d, keys=%d", build_tuples_.size(), hash_table_.size());
+  return rc;
+}
+
+RC HashJoinPhysicalOperator::next()
+{
+  RC rc = RC::SUCCESS;
+  while (matches_ == nullptr || match_pos_ >= matches_->size()) {
+    PhysicalOperator *child = probe_child();
+    rc                      = child->next();
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+
+    probe_tuple_ = child->current_tuple();
+    if (nullptr == probe_tuple_) {
+      LOG_WARN("failed to get tuple from probe child of hash join");
+      return RC::INTERNAL;
+    }
+
+    bool has_null = false;
+    rc            = make_key(probe_keys(), *probe_tuple_, probe_key_, has_null);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+
+    matches_   = nullptr;
+    match_pos_ = 0;
+    if (has_null) {
+      continue;
+    }
+
+    auto iter = hash_table_.find(probe_key_);
+    if (iter != hash_table_.end()) {
+      matches_ = &iter->second;
+    }
+  }
+
+  Tuple *build_tuple = &build_tuples_[(*matches_)[match_pos_++]];
+  if (build_left_) {
+    joined_tuple_.set_left(build_tuple);
+    joined_tuple_.set_right(probe_tuple_);
+  } else {
+    joined_tuple_.set_left(probe_tuple_);
+    joined_tuple_.set_right(build_tuple);
+  }
+  return rc;
+}
+
+RC HashJoinPhysicalOperator::close()
+{
+  RC rc = RC::SUCCESS;
+  if (probe_opened_) {
+    rc = probe_child()->close();
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to close probe child of hash join. rc=%s", strrc(rc));
+    }
+    probe_opened_ = false;
+  }
+
+  build_tuples_.clear();
+  hash_table_.clear();
+  matches_ = nullptr;
+  return rc;
+}
+
+Tuple *HashJoinPhysicalOperator::current_tuple() { return &joined_tuple_; }
+
+RC HashJoinPhysicalOperator::make_key(
+    const vector<unique_ptr<Expression>> &key_exprs, const Tuple &tuple, vector<Value> &key, bool &has_null)
+{
+  key.resize(key_exprs.size());
+  has_null = false;
+  for (size_t i = 0; i < key_exprs.size(); i++) {
+    RC rc = key_exprs[i]->get_value(tuple, key[i]);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to get value of join key. rc=%s", strrc(rc));
+      return rc;
+    }
+    if (key[i].attr_type() == AttrType::NULLS) {
+      has_null = true;
+    }
+  }
+  return RC::SUCCESS;
+}
+
+size_t HashJoinPhysicalOperator::KeyHash::operator()(const vector<Value> &key) const
+{
+  size_t hash = 0;
+  for (const Value &value : key) {
+    size_t value_hash = 0;
+    switch (value.attr_type()) {
+      case AttrType::INTS: value_hash = std::hash<int>()(value.get_int()); break;
+      case AttrType::FLOATS: value_hash = std::hash<float>()(value.get_float()); break;
+      case AttrType::CHARS: value_hash = std::hash<string>()(value.get_string()); break;
+      default: value_hash = std::hash<string>()(value.to_string()); break;
+    }
+    hash ^= value_hash + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+  }
+  return hash;
+}
+
+bool HashJoinPhysicalOperator::KeyEqual::operator()(const vector<Value> &lhs, const vector<Value> &rhs) const
+{
+  if (lhs.size() != rhs.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < lhs.size(); i++) {
+    if (lhs[i].compare(rhs[i]) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
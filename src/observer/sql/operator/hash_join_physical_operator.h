@@ -0,0 +1,86 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/lang/unordered_map.h"
+#include "sql/expr/expression.h"
+#include "sql/operator/physical_operator.h"
+
+/**
+ * @brief 等值连接的 hash join 算子
+ * @ingroup PhysicalOperator
+ * @details 先把构建侧（build side）的数据全部读出来，按照连接键建立哈希表，然后逐行读取探测侧
+ * （probe side）的数据，到哈希表中查找连接键相等的行。与 NestedLoopJoin 只需要扫描两个孩子各一遍。
+ * 孩子的顺序与 NestedLoopJoin 一致，children_[0] 是左表，children_[1] 是右表，输出的 tuple
+ * 也总是左表在前；构建侧由 build_left 指定，一般选择数据量更小的一侧。
+ * 连接键中有 NULL 的行不会与任何行匹配。
+ */
+class HashJoinPhysicalOperator : public PhysicalOperator
+{
+public:
+  /**
+   * @param left_keys 在左孩子的 tuple 上计算的连接键
+   * @param right_keys 在右孩子的 tuple 上计算的连接键，与 left_keys 一一对应
+   * @param build_left 是否使用左孩子构建哈希表
+   */
+  HashJoinPhysicalOperator(std::vector<std::unique_ptr<Expression>> &&left_keys,
+      std::vector<std::unique_ptr<Expression>> &&right_keys, bool build_left);
+  virtual ~HashJoinPhysicalOperator() = default;
+
+  PhysicalOperatorType type() const override { return PhysicalOperatorType::HASH_JOIN; }
+
+  std::string param() const override;
+
+  RC     open(Trx *trx) override;
+  RC     next() override;
+  RC     close() override;
+  Tuple *current_tuple() override;
+
+private:
+  struct KeyHash
+  {
+    size_t operator()(const std::vector<Value> &key) const;
+  };
+  struct KeyEqual
+  {
+    bool operator()(const std::vector<Value> &lhs, const std::vector<Value> &rhs) const;
+  };
+  using HashTable = std::unordered_map<std::vector<Value>, std::vector<size_t>, KeyHash, KeyEqual>;
+
+  /**
+   * @brief 计算连接键
+   * @param has_null 连接键中是否有 NULL
+   */
+  static RC make_key(
+      const std::vector<std::unique_ptr<Expression>> &key_exprs, const Tuple &tuple, std::vector<Value> &key, bool &has_null);
+
+  RC build(Trx *trx);
+
+  PhysicalOperator *build_child() { return children_[build_left_ ? 0 : 1].get(); }
+  PhysicalOperator *probe_child() { return children_[build_left_ ? 1 : 0].get(); }
+  std::vector<std::unique_ptr<Expression>> &build_keys() { return build_left_ ? left_keys_ : right_keys_; }
+  std::vector<std::unique_ptr<Expression>> &probe_keys() { return build_left_ ? right_keys_ : left_keys_; }
+
+private:
+  std::vector<std::unique_ptr<Expression>> left_keys_;
+  std::vector<std::unique_ptr<Expression>> right_keys_;
+  bool                                     build_left_ = false;
+
+  std::vector<ValueListTuple> build_tuples_;  ///< 构建侧物化下来的数据
+  HashTable                   hash_table_;    ///< 连接键 -> 构建侧数据的下标
+
+  Tuple                     *probe_tuple_   = nullptr;
+  const std::vector<size_t> *matches_       = nullptr;  ///< 当前探测行匹配到的构建侧数据
+  size_t                     match_pos_     = 0;
+  bool                       probe_opened_  = false;
+  std::vector<Value>         probe_key_;
+  JoinedTuple                joined_tuple_;
+};
@@ -0,0 +1,354 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <string.h>
+
+#include "sql/operator/hash_join_vec_physical_operator.h"
+#include "common/lang/string_view.h"
+#include "common/log/log.h"
+#include "common/math/simd_util.h"
+
+using namespace std;
+
+HashJoinVecPhysicalOperator::HashJoinVecPhysicalOperator(
+    vector<unique_ptr<Expression>> &&left_keys, vector<unique_ptr<Expression>> &&right_keys, bool build_left)
+    : left_keys_(std::move(left_keys)), right_keys_(std::move(right_keys)), build_left_(build_left)
+{
+  ASSERT(left_keys_.size() == right_keys_.size(), "join keys of both sides should have the same size");
+}
+
+string HashJoinVecPhysicalOperator::param() const { return build_left_ ? "build=left" : "build=right"; }
+
+RC HashJoinVecPhysicalOperator::open(Trx *trx)
+{
+  if (children_.size() != 2) {
+    LOG_WARN("hash join operator should have 2 children");
+    return RC::INTERNAL;
+  }
+
+  RC rc = build(trx);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to build hash table of hash join. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  rc = probe_child()->open(trx);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to open probe child of hash join. rc=%s", strrc(rc));
+    return rc;
+  }
+  probe_opened_ = true;
+  probe_chunk_.reset();
+  probe_row_ = 0;
+  chain_row_ = CHAIN_NOT_STARTED;
+  output_chunk_.reset();
+  return rc;
+}
+
+RC HashJoinVecPhysicalOperator::build(Trx *trx)
+{
+  build_blocks_.clear();
+  build_rows_.clear();
+  build_hashes_.clear();
+
+  PhysicalOperator *child = build_child();
+  RC                rc    = child->open(trx);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to open build child of hash join. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  Chunk            chunk;
+  Chunk            keys;
+  vector<uint32_t> hashes;
+  while (OB_SUCC(rc = child->next(chunk))) {
+    const int selected_rows = chunk.selected_rows();
+    if (selected_rows == 0) {
+      continue;
+    }
+
+    if (OB_FAIL(rc = eval_keys(build_keys(), chunk, keys))) {
+      break;
+    }
+
+    // 孩子算子输出的数据在下次调用 next 后就失效了，把被选中的行和连接键拷贝到新的 block 中
+    auto block        = make_unique<Chunk>();
+    build_column_num_ = chunk.column_num();
+    if (OB_FAIL(rc = copy_selected_rows(chunk, keys, *block))) {
+      break;
+    }
+
+    Chunk block_keys;
+    for (int i = build_column_num_; i < block->column_num(); i++) {
+      auto key_column = make_unique<Column>();
+      key_column->reference(block->column(i));
+      block_keys.add_column(std::move(key_column), i - build_column_num_);
+    }
+    hash_keys(block_keys, hashes);
+
+    const int block_idx = static_cast<int>(build_blocks_.size());
+    for (int row = 0; row < selected_rows; row++) {
+      build_rows_.emplace_back(block_idx, row);
+    }
+    build_hashes_.insert(build_hashes_.end(), hashes.begin(), hashes.end());
+    build_blocks_.emplace_back(std::move(block));
+  }
+
+  RC close_rc = child->close();
+  if (rc != RC::RECORD_EOF) {
+    return rc;
+  }
+  if (OB_FAIL(close_rc)) {
+    return close_rc;
+  }
+
+  // 桶的个数是2的幂，并且至少是行数的两倍
+  const int row_num    = static_cast<int>(build_rows_.size());
+  uint32_t  bucket_num = 16;
+  while (bucket_num < static_cast<uint32_t>(row_num) * 2) {
+    bucket_num <<= 1;
+  }
+  bucket_mask_ = bucket_num - 1;
+  buckets_.assign(bucket_num, -1);
+  next_.resize(row_num);
+  for (int row = 0; row < row_num; row++) {
+    uint32_t bucket = build_hashes_[row] & bucket_mask_;
+    next_[row]      = buckets_[bucket];
+    buckets_[bucket] = row;
+  }
+  LOG_TRACE("hash join build done. rows=%d, blocks=%d", row_num, build_blocks_.size());
+  return RC::SUCCESS;
+}
+
+RC HashJoinVecPhysicalOperator::copy_selected_rows(Chunk &chunk, Chunk &keys, Chunk &block)
+{
+  const int rows          = chunk.rows();
+  const int selected_rows = chunk.selected_rows();
+  for (int i = 0; i < chunk.column_num() + keys.column_num(); i++) {
+    const bool is_key = i >= chunk.column_num();
+    Column    &column = is_key ? keys.column(i - chunk.column_num()) : chunk.column(i);
+    auto       output = make_unique<Column>(column.attr_type(), column.attr_len(), selected_rows);
+    // 连续的有效行一次拷贝
+    int start = 0;
+    while (start < rows) {
+      if (!chunk.selected(start)) {
+        start++;
+        continue;
+      }
+      int end = start + 1;
+      while (end < rows && chunk.selected(end)) {
+        end++;
+      }
+      RC rc = output->append(column.data() + start * column.attr_len(), end - start);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to append data to column. rc=%s", strrc(rc));
+        return rc;
+      }
+      start = end;
+    }
+    if (is_key) {
+      block.add_column(std::move(output), i - chunk.column_num());
+    } else {
+      block.add_column(std::move(output), chunk.column_ids(i), chunk.column_table_ids(i));
+    }
+  }
+  return RC::SUCCESS;
+}
+
+RC HashJoinVecPhysicalOperator::next(Chunk &chunk)
+{
+  if (build_rows_.empty()) {
+    return RC::RECORD_EOF;
+  }
+
+  RC rc = RC::SUCCESS;
+  probe_matches_.clear();
+  build_matches_.clear();
+  while (static_cast<int>(probe_matches_.size()) < OUTPUT_CAPACITY) {
+    if (probe_row_ >= probe_chunk_.rows()) {
+      // 匹配的行引用了当前探测的 chunk，需要在读取下一个 chunk 之前输出
+      if (!probe_matches_.empty()) {
+        break;
+      }
+
+      if (OB_FAIL(rc = probe_child()->next(probe_chunk_))) {
+        return rc;
+      }
+      if (OB_FAIL(rc = eval_keys(probe_keys(), probe_chunk_, probe_key_chunk_))) {
+        return rc;
+      }
+      hash_keys(probe_key_chunk_, probe_hashes_);
+      probe_row_ = 0;
+      chain_row_ = CHAIN_NOT_STARTED;
+      continue;
+    }
+
+    if (chain_row_ == CHAIN_NOT_STARTED) {
+      if (!probe_chunk_.selected(probe_row_)) {
+        probe_row_++;
+        continue;
+      }
+      chain_row_ = buckets_[probe_hashes_[probe_row_] & bucket_mask_];
+    }
+
+    const uint32_t hash = probe_hashes_[probe_row_];
+    while (chain_row_ != -1 && static_cast<int>(probe_matches_.size()) < OUTPUT_CAPACITY) {
+      if (build_hashes_[chain_row_] == hash && keys_equal(probe_row_, chain_row_)) {
+        probe_matches_.push_back(probe_row_);
+        build_matches_.push_back(chain_row_);
+      }
+      chain_row_ = next_[chain_row_];
+    }
+
+    if (chain_row_ == -1) {
+      probe_row_++;
+      chain_row_ = CHAIN_NOT_STARTED;
+    }
+  }
+
+  if (OB_FAIL(rc = output_matches())) {
+    return rc;
+  }
+  return chunk.reference(output_chunk_);
+}
+
+RC HashJoinVecPhysicalOperator::output_matches()
+{
+  const int probe_column_num = probe_chunk_.column_num();
+  if (output_chunk_.column_num() == 0) {
+    Chunk &build_block = *build_blocks_.front();
+    for (int side = 0; side < 2; side++) {
+      const bool is_build   = (side == 0) == build_left_;
+      Chunk     &source     = is_build ? build_block : probe_chunk_;
+      const int  column_num = is_build ? build_column_num_ : probe_column_num;
+      for (int i = 0; i < column_num; i++) {
+        Column &column = source.column(i);
+        output_chunk_.add_column(make_unique<Column>(column.attr_type(), column.attr_len(), OUTPUT_CAPACITY),
+            source.column_ids(i),
+            source.column_table_ids(i));
+      }
+    }
+  }
+
+  output_chunk_.reset_data();
+  const int match_num    = static_cast<int>(probe_matches_.size());
+  const int probe_offset = build_left_ ? build_column_num_ : 0;
+  const int build_offset = build_left_ ? 0 : probe_column_num;
+  for (int i = 0; i < probe_column_num; i++) {
+    Column &source = probe_chunk_.column(i);
+    Column &output = output_chunk_.column(probe_offset + i);
+    for (int row : probe_matches_) {
+      output.append_one(source.data() + row * source.attr_len());
+    }
+  }
+
+  for (int i = 0; i < build_column_num_; i++) {
+    Column &output = output_chunk_.column(build_offset + i);
+    for (int match = 0; match < match_num; match++) {
+      const auto &[block, row] = build_rows_[build_matches_[match]];
+      Column     &source       = build_blocks_[block]->column(i);
+      output.append_one(source.data() + row * source.attr_len());
+    }
+  }
+  return RC::SUCCESS;
+}
+
+RC HashJoinVecPhysicalOperator::close()
+{
+  RC rc = RC::SUCCESS;
+  if (probe_opened_) {
+    rc = probe_child()->close();
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to close probe child of hash join. rc=%s", strrc(rc));
+    }
+    probe_opened_ = false;
+  }
+
+  build_blocks_.clear();
+  build_rows_.clear();
+  build_hashes_.clear();
+  buckets_.clear();
+  next_.clear();
+  return rc;
+}
+
+RC HashJoinVecPhysicalOperator::eval_keys(vector<unique_ptr<Expression>> &key_exprs, Chunk &chunk, Chunk &keys)
+{
+  keys.reset();
+  for (size_t i = 0; i < key_exprs.size(); i++) {
+    auto column = make_unique<Column>();
+    RC   rc     = key_exprs[i]->get_column(chunk, *column);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to get column of join key. rc=%s", strrc(rc));
+      return rc;
+    }
+    keys.add_column(std::move(column), i);
+  }
+  return RC::SUCCESS;
+}
+
+void HashJoinVecPhysicalOperator::hash_keys(Chunk &keys, vector<uint32_t> &hashes)
+{
+  const int rows = keys.rows();
+  hashes.resize(rows);
+
+  vector<uint32_t> column_hashes(rows);
+  for (int col = 0; col < keys.column_num(); col++) {
+    Column         &column = keys.column(col);
+    const char     *data   = column.data();
+    const int       len    = column.attr_len();
+    vector<uint32_t> &target = (col == 0) ? hashes : column_hashes;
+    if (column.attr_type() != AttrType::CHARS && len == sizeof(int)) {
+#ifdef USE_SIMD
+      mm256_hash_epi32(reinterpret_cast<const int *>(data), target.data(), rows);
+#else
+      for (int row = 0; row < rows; row++) {
+        target[row] = hash_epi32(reinterpret_cast<const int *>(data)[row]);
+      }
+#endif
+    } else {
+      // 定长字符串后面可能有填充，只使用 '\0' 之前的部分
+      const bool is_chars = column.attr_type() == AttrType::CHARS;
+      for (int row = 0; row < rows; row++) {
+        const char *value = data + row * len;
+        target[row] = static_cast<uint32_t>(hash<string_view>()(string_view(value, is_chars ? strnlen(value, len) : len)));
+      }
+    }
+
+    if (col != 0) {
+      for (int row = 0; row < rows; row++) {
+        hashes[row] = (hashes[row] ^ column_hashes[row]) * 0x01000193U;
+      }
+    }
+  }
+}
+
+bool HashJoinVecPhysicalOperator::keys_equal(int probe_row, int build_row)
+{
+  const auto &[block_idx, row] = build_rows_[build_row];
+  Chunk      &block            = *build_blocks_[block_idx];
+  for (int i = 0; i < probe_key_chunk_.column_num(); i++) {
+    Column     &probe_column = probe_key_chunk_.column(i);
+    Column     &build_column = block.column(build_column_num_ + i);
+    const char *probe_value  = probe_column.data() + probe_row * probe_column.attr_len();
+    const char *build_value  = build_column.data() + row * build_column.attr_len();
+    if (probe_column.attr_type() == AttrType::CHARS) {
+      string_view probe_str(probe_value, strnlen(probe_value, probe_column.attr_len()));
+      string_view build_str(build_value, strnlen(build_value, build_column.attr_len()));
+      if (probe_str != build_str) {
+        return false;
+      }
+    } else if (probe_column.attr_len() != build_column.attr_len() ||
+               memcmp(probe_value, build_value, probe_column.attr_len()) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
@@ -0,0 +1,105 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "sql/expr/expression.h"
+#include "sql/operator/physical_operator.h"
+
+/**
+ * @brief 向量化的等值 hash join 算子
+ * @ingroup PhysicalOperator
+ * @details 与 HashJoinPhysicalOperator 的逻辑相同，但是按照 Chunk 处理数据：
+ * 1. 构建侧按列存放，每个 block 保存孩子输出的一个 chunk 中被选中的行，以及这些行的连接键；
+ * 2. 连接键的哈希值按列批量计算，开启 USE_SIMD 时使用 AVX2 计算 int 类型的哈希值；
+ * 3. 探测时先收集一批匹配的行号，再按列把数据拷贝到输出的 chunk 中。
+ * 输出 chunk 中左表的列在前，右表的列在后，列 id 和所属的表与孩子算子输出的一致。
+ */
+class HashJoinVecPhysicalOperator : public PhysicalOperator
+{
+public:
+  /**
+   * @param left_keys 在左孩子的 chunk 上计算的连接键
+   * @param right_keys 在右孩子的 chunk 上计算的连接键，与 left_keys 一一对应
+   * @param build_left 是否使用左孩子构建哈希表
+   */
+  HashJoinVecPhysicalOperator(std::vector<std::unique_ptr<Expression>> &&left_keys,
+      std::vector<std::unique_ptr<Expression>> &&right_keys, bool build_left);
+  virtual ~HashJoinVecPhysicalOperator() = default;
+
+  PhysicalOperatorType type() const override { return PhysicalOperatorType::HASH_JOIN_VEC; }
+
+  std::string param() const override;
+
+  RC open(Trx *trx) override;
+  RC next(Chunk &chunk) override;
+  RC close() override;
+
+private:
+  RC build(Trx *trx);
+
+  /**
+   * @brief 在 chunk 上计算连接键，每个连接键对应 keys 中的一列
+   */
+  static RC eval_keys(std::vector<std::unique_ptr<Expression>> &key_exprs, Chunk &chunk, Chunk &keys);
+
+  /**
+   * @brief 把 chunk 和 keys 中被选中的行拷贝到 block 中，keys 的列放在最后
+   */
+  static RC copy_selected_rows(Chunk &chunk, Chunk &keys, Chunk &block);
+
+  /**
+   * @brief 批量计算 keys 中每一行的哈希值
+   */
+  static void hash_keys(Chunk &keys, std::vector<uint32_t> &hashes);
+
+  /**
+   * @brief 探测侧第 probe_row 行与构建侧第 build_row 行的连接键是否相等
+   */
+  bool keys_equal(int probe_row, int build_row);
+
+  /**
+   * @brief 把收集到的匹配行按列拷贝到输出 chunk 中
+   */
+  RC output_matches();
+
+  PhysicalOperator *build_child() { return children_[build_left_ ? 0 : 1].get(); }
+  PhysicalOperator *probe_child() { return children_[build_left_ ? 1 : 0].get(); }
+  std::vector<std::unique_ptr<Expression>> &build_keys() { return build_left_ ? left_keys_ : right_keys_; }
+  std::vector<std::unique_ptr<Expression>> &probe_keys() { return build_left_ ? right_keys_ : left_keys_; }
+
+private:
+  static constexpr int OUTPUT_CAPACITY = 4096;  ///< 每次输出的最大行数
+  static constexpr int CHAIN_NOT_STARTED = -2;
+
+  std::vector<std::unique_ptr<Expression>> left_keys_;
+  std::vector<std::unique_ptr<Expression>> right_keys_;
+  bool                                     build_left_ = false;
+
+  /// 构建侧的数据。每个 block 的前 build_column_num_ 列是孩子输出的列，后面是连接键
+  std::vector<std::unique_ptr<Chunk>> build_blocks_;
+  int                                 build_column_num_ = 0;
+  std::vector<std::pair<int, int>>    build_rows_;    ///< 构建侧每一行所在的 block 和 block 中的行号
+  std::vector<uint32_t>               build_hashes_;  ///< 构建侧每一行连接键的哈希值
+  std::vector<int>                    buckets_;       ///< 每个桶中第一行的下标，-1 表示空
+  std::vector<int>                    next_;          ///< 同一个桶中的下一行，-1 表示结束
+  uint32_t                            bucket_mask_ = 0;
+
+  Chunk                 probe_chunk_;
+  Chunk                 probe_key_chunk_;
+  std::vector<uint32_t> probe_hashes_;
+  int                   probe_row_    = 0;                  ///< 当前探测的行
+  int                   chain_row_    = CHAIN_NOT_STARTED;  ///< 当前探测行在哈希链上的下一个候选行
+  bool                  probe_opened_ = false;
+
+  std::vector<int> probe_matches_;  ///< 本批匹配的探测侧行号
+  std::vector<int> build_matches_;  ///< 本批匹配的构建侧行号
+  Chunk            output_chunk_;
+};
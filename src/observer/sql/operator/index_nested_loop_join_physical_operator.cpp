@@ -0,0 +1,162 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "sql/operator/index_nested_loop_join_physical_operator.h"
+#include "common/log/log.h"
+#include "sql/operator/index_scan_physical_operator.h"
+
+using namespace std;
+
+IndexNestedLoopJoinPhysicalOperator::IndexNestedLoopJoinPhysicalOperator(
+    vector<unique_ptr<Expression>> &&left_keys, vector<unique_ptr<Expression>> &&right_keys, int index_key_num)
+    : left_keys_(std::move(left_keys)), right_keys_(std::move(right_keys)), index_key_num_(index_key_num)
+{
+  ASSERT(left_keys_.size() == right_keys_.size(), "join keys of both sides should have the same size");
+  ASSERT(index_key_num_ > 0 && index_key_num_ <= static_cast<int>(left_keys_.size()), "invalid index key num");
+}
+
+string IndexNestedLoopJoinPhysicalOperator::param() const { return "index keys=" + to_string(index_key_num_); }
+
+RC IndexNestedLoopJoinPhysicalOperator::open(Trx *trx)
+{
+  if (children_.size() != 2 || children_[1]->type() != PhysicalOperatorType::INDEX_SCAN) {
+    LOG_WARN("index nested loop join operator should have 2 children and the right one should be an index scan");
+    return RC::INTERNAL;
+  }
+
+  left_         = children_[0].get();
+  right_        = static_cast<IndexScanPhysicalOperator *>(children_[1].get());
+  right_opened_ = false;
+  trx_          = trx;
+
+  RC rc = left_->open(trx);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to open left child of index nested loop join. rc=%s", strrc(rc));
+  }
+  return rc;
+}
+
+RC IndexNestedLoopJoinPhysicalOperator::next()
+{
+  RC rc = RC::SUCCESS;
+  while (true) {
+    if (right_opened_) {
+      rc = right_next();
+      if (rc != RC::RECORD_EOF) {
+        return rc;
+      }
+
+      rc = close_right();
+      if (OB_FAIL(rc)) {
+        return rc;
+      }
+    }
+
+    bool has_null = false;
+    rc            = left_next(has_null);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+    if (has_null) {
+      continue;
+    }
+
+    right_->set_equal_key(vector<Value>(left_key_.begin(), left_key_.begin() + index_key_num_));
+    rc = right_->open(trx_);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to open index scan of index nested loop join. rc=%s", strrc(rc));
+      return rc;
+    }
+    right_opened_ = true;
+  }
+}
+
+RC IndexNestedLoopJoinPhysicalOperator::left_next(bool &has_null)
+{
+  RC rc = left_->next();
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  Tuple *left_tuple = left_->current_tuple();
+  if (nullptr == left_tuple) {
+    LOG_WARN("failed to get tuple from left child of index nested loop join");
+    return RC::INTERNAL;
+  }
+  joined_tuple_.set_left(left_tuple);
+
+  left_key_.resize(left_keys_.size());
+  has_null = false;
+  for (size_t i = 0; i < left_keys_.size(); i++) {
+    rc = left_keys_[i]->get_value(*left_tuple, left_key_[i]);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to get value of join key. rc=%s", strrc(rc));
+      return rc;
+    }
+    if (left_key_[i].attr_type() == AttrType::NULLS) {
+      has_null = true;
+    }
+  }
+  return rc;
+}
+
+RC IndexNestedLoopJoinPhysicalOperator::right_next()
+{
+  RC    rc = RC::SUCCESS;
+  Value value;
+  while (OB_SUCC(rc = right_->next())) {
+    Tuple *right_tuple = right_->current_tuple();
+
+    // 组合索引中超长的字符串会被截断，找到的数据不一定相等，所有的连接键都要再比较一遍
+    bool matched = true;
+    for (size_t i = 0; matched && i < right_keys_.size(); i++) {
+      rc = right_keys_[i]->get_value(*right_tuple, value);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to get value of join key. rc=%s", strrc(rc));
+        return rc;
+      }
+      matched = value.attr_type() != AttrType::NULLS && 0 == value.compare(left_key_[i]);
+    }
+
+    if (matched) {
+      joined_tuple_.set_right(right_tuple);
+      return rc;
+    }
+  }
+  return rc;
+}
+
+RC IndexNestedLoopJoinPhysicalOperator::close_right()
+{
+  right_opened_ = false;
+  RC rc         = right_->close();
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to close index scan of index nested loop join. rc=%s", strrc(rc));
+  }
+  return rc;
+}
+
+RC IndexNestedLoopJoinPhysicalOperator::close()
+{
+  RC rc = left_->close();
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to close left child of index nested loop join. rc=%s", strrc(rc));
+  }
+
+  if (right_opened_) {
+    RC right_rc = close_right();
+    if (OB_SUCC(rc)) {
+      rc = right_rc;
+    }
+  }
+  return rc;
+}
+
+Tuple *IndexNestedLoopJoinPhysicalOperator::current_tuple() { return &joined_tuple_; }
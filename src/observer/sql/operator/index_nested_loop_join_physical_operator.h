@@ -0,0 +1,67 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "sql/expr/expression.h"
+#include "sql/operator/physical_operator.h"
+
+class IndexScanPhysicalOperator;
+
+/**
+ * @brief 使用右表索引的 nested loop join 算子
+ * @ingroup PhysicalOperator
+ * @details 与 NestedLoopJoin 一样依次遍历左表（外表）的每一行，但是不再每次都扫描整个右表（内表），
+ * 而是用左表这一行上的连接键作为键值，在右表的索引上做等值查找。
+ * 右孩子必须是 IndexScanPhysicalOperator，每一行外表数据都会用新的键值重新打开它。
+ * 连接键的前 index_key_num 个与索引字段的顺序一致，用于构造索引的键值；所有的连接键仍然会在
+ * 找到的数据上比较一遍，索引只负责缩小范围。连接键中有 NULL 的行不会与任何行匹配。
+ */
+class IndexNestedLoopJoinPhysicalOperator : public PhysicalOperator
+{
+public:
+  /**
+   * @param left_keys 在左孩子的 tuple 上计算的连接键
+   * @param right_keys 在右孩子的 tuple 上计算的连接键，与 left_keys 一一对应
+   * @param index_key_num 前多少个连接键用于在右表的索引上查找
+   */
+  IndexNestedLoopJoinPhysicalOperator(std::vector<std::unique_ptr<Expression>> &&left_keys,
+      std::vector<std::unique_ptr<Expression>> &&right_keys, int index_key_num);
+  virtual ~IndexNestedLoopJoinPhysicalOperator() = default;
+
+  PhysicalOperatorType type() const override { return PhysicalOperatorType::INDEX_NESTED_LOOP_JOIN; }
+
+  std::string param() const override;
+
+  RC     open(Trx *trx) override;
+  RC     next() override;
+  RC     close() override;
+  Tuple *current_tuple() override;
+
+private:
+  /// @brief 左表遍历下一条数据，并计算连接键
+  RC left_next(bool &has_null);
+  /// @brief 从右表的索引扫描中找到下一条连接键都相等的数据
+  RC right_next();
+  RC close_right();
+
+private:
+  std::vector<std::unique_ptr<Expression>> left_keys_;
+  std::vector<std::unique_ptr<Expression>> right_keys_;
+  int                                      index_key_num_ = 0;
+
+  Trx                       *trx_          = nullptr;
+  PhysicalOperator          *left_         = nullptr;
+  IndexScanPhysicalOperator *right_        = nullptr;
+  bool                       right_opened_ = false;
+
+  std::vector<Value> left_key_;  ///< 当前左表数据上的连接键
+  JoinedTuple        joined_tuple_;
+};
@@ -13,24 +13,20 @@ See the Mulan PSL v2 for more details. */
 //
 
 #include "sql/operator/index_scan_physical_operator.h"
+#include "common/lang/algorithm.h"
 #include "storage/index/index.h"
 #include "storage/trx/trx.h"
 
-IndexScanPhysicalOperator::IndexScanPhysicalOperator(Table *table, Index *index, ReadWriteMode mode, const Value *left_value,
-    bool left_inclusive, const Value *right_value, bool right_inclusive)
+IndexScanPhysicalOperator::IndexScanPhysicalOperator(Table *table, Index *index, ReadWriteMode mode,
+    std::vector<Value> left_key, bool left_inclusive, std::vector<Value> right_key, bool right_inclusive)
     : table_(table),
       index_(index),
       mode_(mode),
+      left_key_(std::move(left_key)),
+      right_key_(std::move(right_key)),
       left_inclusive_(left_inclusive),
       right_inclusive_(right_inclusive)
-{
-  if (left_value) {
-    left_value_ = *left_value;
-  }
-  if (right_value) {
-    right_value_ = *right_value;
-  }
-}
+{}
 
 RC IndexScanPhysicalOperator::open(Trx *trx)
 {
@@ -38,12 +34,33 @@ RC IndexScanPhysicalOperator::open(Trx *trx)
     return RC::INTERNAL;
   }
 
-  IndexScanner *index_scanner = index_->create_scanner(left_value_.data(),
-      left_value_.length(),
+  tuple_.set_schema(table_, table_->table_meta().field_metas());
+  trx_ = trx;
+
+  index_eof_ = false;
+  rid_batch_.clear();
+  record_batch_.clear();
+  batch_pos_ = 0;
+
+  // 范围为空时不需要扫描索引，比如 a > 5 and a < 3
+  if (range_empty()) {
+    LOG_TRACE("index scan range is empty");
+    return RC::SUCCESS;
+  }
+
+  std::string left_key;
+  std::string right_key;
+  make_key(left_key_, left_key);
+  make_key(right_key_, right_key);
+
+  // 没有设置的边界表示不限制
+  IndexScanner *index_scanner = index_->create_scanner(left_key_.empty() ? nullptr : left_key.data(),
+      static_cast<int>(left_key.size()),
       left_inclusive_,
-      right_value_.data(),
-      right_value_.length(),
-      right_inclusive_);
+      right_key_.empty() ? nullptr : right_key.data(),
+      static_cast<int>(right_key.size()),
+      right_inclusive_,
+      reverse_);
   if (nullptr == index_scanner) {
     LOG_WARN("failed to create index scanner");
     return RC::INTERNAL;
@@ -57,9 +74,17 @@ RC IndexScanPhysicalOperator::open(Trx *trx)
   }
   index_scanner_ = index_scanner;
 
-  tuple_.set_schema(table_, table_->table_meta().field_metas());
+  if (index_only_) {
+    int key_len = 0;
+    for (const FieldMeta &field_meta : index_->field_metas()) {
+      key_len += field_meta.len();
+    }
+    index_key_.assign(key_len, '\0');
 
-  trx_ = trx;
+    const int record_size = table_->table_meta().record_size();
+    index_record_.new_record(record_size);
+    memset(index_record_.data(), 0, record_size);
+  }
   return RC::SUCCESS;
 }
 
@@ -68,17 +93,34 @@ RC IndexScanPhysicalOperator::next()
   RID rid;
   RC  rc = RC::SUCCESS;
 
+  if (nullptr == index_scanner_) {
+    return RC::RECORD_EOF;
+  }
+
+  if (rid_batch_size_ > 0) {
+    return next_in_batch();
+  }
+
   bool filter_result = false;
-  while (RC::SUCCESS == (rc = index_scanner_->next_entry(&rid))) {
-    rc = record_handler_->get_record(rid, current_record_);
-    if (OB_FAIL(rc)) {
-      LOG_TRACE("failed to get record. rid=%s, rc=%s", rid.to_string().c_str(), strrc(rc));
-      return rc;
+  while (RC::SUCCESS == (rc = index_only_ ? index_scanner_->next_entry(&rid, index_key_.data())
+                                          : index_scanner_->next_entry(&rid))) {
+    // 页面上的数据对当前事务都可见时，直接使用索引中的值，不需要读取记录再判断可见性
+    const bool from_index = index_only_ && trx_->is_page_all_visible(table_, rid.page_num);
+    if (from_index) {
+      fill_index_record(rid);
+      current_ = &index_record_;
+    } else {
+      rc = record_handler_->get_record(rid, current_record_);
+      if (OB_FAIL(rc)) {
+        LOG_TRACE("failed to get record. rid=%s, rc=%s", rid.to_string().c_str(), strrc(rc));
+        return rc;
+      }
+      current_ = &current_record_;
     }
 
-    LOG_TRACE("got a record. rid=%s", rid.to_string().c_str());
+    LOG_TRACE("got a record. rid=%s, from index=%d", rid.to_string().c_str(), from_index);
 
-    tuple_.set_record(&current_record_);
+    tuple_.set_record(current_);
     rc = filter(tuple_, filter_result);
     if (OB_FAIL(rc)) {
       LOG_TRACE("failed to filter record. rc=%s", strrc(rc));
@@ -90,6 +132,10 @@ RC IndexScanPhysicalOperator::next()
       continue;
     }
 
+    if (from_index) {
+      return RC::SUCCESS;
+    }
+
     rc = trx_->visit_record(table_, current_record_, mode_);
     if (rc == RC::RECORD_INVISIBLE) {
       LOG_TRACE("record invisible");
@@ -102,16 +148,87 @@ RC IndexScanPhysicalOperator::next()
   return rc;
 }
 
+RC IndexScanPhysicalOperator::next_in_batch()
+{
+  RC   rc            = RC::SUCCESS;
+  bool filter_result = false;
+  while (true) {
+    if (batch_pos_ >= record_batch_.size()) {
+      rc = fetch_batch();
+      if (OB_FAIL(rc)) {
+        return rc;
+      }
+      continue;
+    }
+
+    current_record_ = std::move(record_batch_[batch_pos_++]);
+    current_        = &current_record_;
+
+    tuple_.set_record(current_);
+    rc = filter(tuple_, filter_result);
+    if (OB_FAIL(rc)) {
+      LOG_TRACE("failed to filter record. rc=%s", strrc(rc));
+      return rc;
+    }
+
+    if (!filter_result) {
+      LOG_TRACE("record filtered");
+      continue;
+    }
+
+    rc = trx_->visit_record(table_, current_record_, mode_);
+    if (rc != RC::RECORD_INVISIBLE) {
+      return rc;
+    }
+    LOG_TRACE("record invisible");
+  }
+}
+
+RC IndexScanPhysicalOperator::fetch_batch()
+{
+  if (index_eof_) {
+    return RC::RECORD_EOF;
+  }
+
+  RID rid;
+  RC  rc = RC::SUCCESS;
+  while (static_cast<int>(rid_batch_.size()) < rid_batch_size_ && OB_SUCC(rc = index_scanner_->next_entry(&rid))) {
+    rid_batch_.push_back(rid);
+  }
+  if (RC::RECORD_EOF == rc) {
+    index_eof_ = true;
+  } else if (OB_FAIL(rc)) {
+    // 已经取出的RID保留下来，重试的时候继续
+    return rc;
+  }
+
+  if (rid_batch_.empty()) {
+    return RC::RECORD_EOF;
+  }
+
+  // 按照页面排序，每个页面只需要加载一次
+  std::sort(rid_batch_.begin(), rid_batch_.end(), [](const RID &left, const RID &right) {
+    return RID::compare(&left, &right) < 0;
+  });
+  LOG_TRACE("fetch a batch of records from index scan. rid num=%d", static_cast<int>(rid_batch_.size()));
+  rc = record_handler_->get_records(rid_batch_, record_batch_);
+  rid_batch_.clear();
+  batch_pos_ = 0;
+  return rc;
+}
+
 RC IndexScanPhysicalOperator::close()
 {
-  index_scanner_->destroy();
-  index_scanner_ = nullptr;
+  if (index_scanner_ != nullptr) {
+    index_scanner_->destroy();
+    index_scanner_ = nullptr;
+  }
   return RC::SUCCESS;
 }
 
 Tuple *IndexScanPhysicalOperator::current_tuple()
 {
-  tuple_.set_record(&current_record_);
+  tuple_.set_record(current_);
   return &tuple_;
 }
 
@@ -141,7 +258,87 @@ RC IndexScanPhysicalOperator::filter(RowTuple &tuple, bool &result)
   return rc;
 }
 
+void IndexScanPhysicalOperator::make_key(const std::vector<Value> &values, std::string &key) const
+{
+  key.clear();
+  if (values.size() == 1 && index_->field_metas().size() == 1) {
+    key.assign(values[0].data(), values[0].length());
+    return;
+  }
+
+  const std::vector<FieldMeta> &field_metas = index_->field_metas();
+  for (size_t i = 0; i < values.size(); i++) {
+    // 组合索引中每个字段都占用定义的长度，CHARS 的值短于字段长度时补0
+    const int field_len = field_metas[i].len();
+    const int value_len = std::min(values[i].length(), field_len);
+    key.append(values[i].data(), value_len);
+    key.append(field_len - value_len, '\0');
+  }
+}
+
+bool IndexScanPhysicalOperator::range_empty() const
+{
+  if (left_key_.empty() || right_key_.empty()) {
+    return false;
+  }
+
+  const size_t num = std::min(left_key_.size(), right_key_.size());
+  for (size_t i = 0; i < num; i++) {
+    const int result = left_key_[i].compare(right_key_[i]);
+    if (result != 0) {
+      return result > 0;
+    }
+  }
+  // 前缀相同，只有两个边界包含的字段个数相同时才能判断
+  return left_key_.size() == right_key_.size() && (!left_inclusive_ || !right_inclusive_);
+}
+
+void IndexScanPhysicalOperator::fill_index_record(const RID &rid)
+{
+  // 索引的键值是各个字段按照定义的长度拼接起来的
+  const char *key = index_key_.data();
+  for (const FieldMeta &field_meta : index_->field_metas()) {
+    memcpy(index_record_.data() + field_meta.offset(), key, field_meta.len());
+    key += field_meta.len();
+  }
+  index_record_.set_rid(rid);
+}
+
+static std::string key_to_string(const std::vector<Value> &key)
+{
+  if (key.size() == 1) {
+    return key[0].to_string();
+  }
+
+  std::string result = "(";
+  for (size_t i = 0; i < key.size(); i++) {
+    result += (i > 0 ? "," : "") + key[i].to_string();
+  }
+  return result + ")";
+}
+
 std::string IndexScanPhysicalOperator::param() const
 {
-  return std::string(index_->index_meta().name()) + " ON " + table_->name();
+  std::string param     = std::string(index_->index_meta().name()) + " ON " + table_->name();
+  const bool  has_left  = !left_key_.empty();
+  const bool  has_right = !right_key_.empty();
+  if (has_left && has_right && left_inclusive_ && right_inclusive_ && left_key_.size() == right_key_.size() &&
+      std::equal(left_key_.begin(), left_key_.end(), right_key_.begin(),
+                            [](const Value &left, const Value &right) { return left.compare(right) == 0; })) {
+    param += " (=" + key_to_string(left_key_) + ")";
+  } else if (has_left || has_right) {
+    param += has_left ? (left_inclusive_ ? " [" : " (") + key_to_string(left_key_) : " (-inf";
+    param += ", ";
+    param += has_right ? key_to_string(right_key_) + (right_inclusive_ ? "]" : ")") : "+inf)";
+  }
+  if (index_only_) {
+    param += " INDEX ONLY";
+  }
+  if (rid_batch_size_ > 0) {
+    param += " RID BATCH";
+  }
+  if (reverse_) {
+    param += " REVERSE";
+  }
+  return param;
 }
@@ -21,12 +21,21 @@ See the Mulan PSL v2 for more details. */
 /**
  * @brief 索引扫描物理算子
  * @ingroup PhysicalOperator
+ * @details 扫描索引中 [left_key, right_key] 范围内的数据，边界是否包含由 inclusive 参数指定。
+ * 边界为空时表示这一侧不限制。
+ * 每个边界是索引字段上的一组值，可以只包含组合索引最左边的几个字段，比如索引 (a, b) 上的条件
+ * a = 1 and b > 5 对应的范围是 ((1, 5), (1)]。
+ * 如果查询用到的字段都在索引中(索引覆盖)，可以使用 index only 的方式扫描，记录所在页面上的数据
+ * 都可见时直接用索引中的值构造行数据，不再读取记录。
+ * 需要读取记录时，可以先从索引中取出一批RID，按照页面排序后再读取(bitmap heap scan)，
+ * 这样每个页面只需要访问一次，而不是按照键值的顺序随机访问页面。
+ * 不使用批量读取时，输出的数据按照索引键值有序，可以从大到小(reverse)扫描，上层的排序就可以省掉。
  */
 class IndexScanPhysicalOperator : public PhysicalOperator
 {
 public:
-  IndexScanPhysicalOperator(Table *table, Index *index, ReadWriteMode mode, const Value *left_value,
-      bool left_inclusive, const Value *right_value, bool right_inclusive);
+  IndexScanPhysicalOperator(Table *table, Index *index, ReadWriteMode mode, std::vector<Value> left_key,
+      bool left_inclusive, std::vector<Value> right_key, bool right_inclusive);
 
   virtual ~IndexScanPhysicalOperator() = default;
 
@@ -42,10 +51,56 @@ public:
 
   void set_predicates(std::vector<std::unique_ptr<Expression>> &&exprs);
 
+  /// @brief 查询用到的字段都在索引中时，尽量直接使用索引中的值
+  void set_index_only(bool index_only) { index_only_ = index_only; }
+
+  /// @brief 每次从索引中取出多少个RID，按照页面排序之后再读取记录。0表示不使用批量读取
+  void set_rid_batch_size(int batch_size) { rid_batch_size_ = batch_size; }
+
+  /**
+   * @brief 要求按照索引键值的顺序返回数据，上层就不需要再排序了
+   * @param reverse 是否从大到小
+   */
+  void set_keep_order(bool reverse)
+  {
+    keep_order_ = true;
+    reverse_    = reverse;
+  }
+  bool keep_order() const { return keep_order_; }
+
+  /**
+   * @brief 把扫描范围换成一个键值上的等值查找，下次 open 时生效
+   * @details 用于 index nested loop join，每一行外表数据都会用新的键值重新打开扫描
+   */
+  void set_equal_key(const std::vector<Value> &key)
+  {
+    left_key_        = key;
+    right_key_       = key;
+    left_inclusive_  = true;
+    right_inclusive_ = true;
+  }
+
 private:
   // 与TableScanPhysicalOperator代码相同，可以优化
   RC filter(RowTuple &tuple, bool &result);
 
+  /**
+   * @brief 把边界上的值按照索引字段的长度拼接成索引的键值
+   * @details 单字段索引直接使用值本身，CHARS 类型的长度由索引自己处理
+   */
+  void make_key(const std::vector<Value> &values, std::string &key) const;
+
+  /// @brief 扫描范围是否一定为空
+  bool range_empty() const;
+
+  /// @brief 把索引中的字段值复制到 index_record_ 对应的位置上
+  void fill_index_record(const RID &rid);
+
+  /// @brief 从批量读取的记录中返回下一条
+  RC next_in_batch();
+  /// @brief 从索引中取出一批RID，按照页面排序后读取记录
+  RC fetch_batch();
+
 private:
   Trx               *trx_            = nullptr;
   Table             *table_          = nullptr;
@@ -57,10 +112,24 @@ private:
   Record   current_record_;
   RowTuple tuple_;
 
-  Value left_value_;
-  Value right_value_;
-  bool  left_inclusive_  = false;
-  bool  right_inclusive_ = false;
+  bool        index_only_ = false;
+  std::string index_key_;     ///< 从索引中读出的字段值
+  Record      index_record_;  ///< 使用索引中的值构造的记录，不在索引中的字段都是0
+  Record     *current_ = &current_record_;
+
+  int                 rid_batch_size_ = 0;
+  bool                index_eof_      = false;
+  std::vector<RID>    rid_batch_;
+  std::vector<Record> record_batch_;
+  size_t              batch_pos_ = 0;
+
+  bool keep_order_ = false;
+  bool reverse_    = false;
+
+  std::vector<Value> left_key_;
+  std::vector<Value> right_key_;
+  bool               left_inclusive_  = false;
+  bool               right_inclusive_ = false;
 
   std::vector<std::unique_ptr<Expression>> predicates_;
 };
@@ -20,6 +20,8 @@ See the Mulan PSL v2 for more details. */
  * @brief 连接算子
  * @ingroup LogicalOperator
  * @details 连接算子，用于连接两个表。对应的物理算子或者实现，可能有NestedLoopJoin，HashJoin等等。
+ * expressions() 中保存的是谓词下推过来的等值连接条件，每个条件的左边只引用左孩子中的表，
+ * 右边只引用右孩子中的表。有连接条件时会生成 HashJoin。
  */
 class JoinLogicalOperator : public LogicalOperator
 {
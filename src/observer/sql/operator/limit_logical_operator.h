@@ -0,0 +1,33 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "sql/operator/logical_operator.h"
+
+/**
+ * @brief limit 逻辑算子，跳过前 offset 行，最多输出 limit 行
+ * @ingroup LogicalOperator
+ */
+class LimitLogicalOperator : public LogicalOperator
+{
+public:
+  LimitLogicalOperator(int limit, int offset) : limit_(limit), offset_(offset) {}
+  virtual ~LimitLogicalOperator() = default;
+
+  LogicalOperatorType type() const override { return LogicalOperatorType::LIMIT; }
+
+  int limit() const { return limit_; }
+  int offset() const { return offset_; }
+
+private:
+  int limit_  = 0;
+  int offset_ = 0;
+};
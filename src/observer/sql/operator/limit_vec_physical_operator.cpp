@@ -0,0 +1,77 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "sql/operator/limit_vec_physical_operator.h"
+#include "common/lang/algorithm.h"
+#include "common/log/log.h"
+
+using namespace std;
+
+string LimitVecPhysicalOperator::param() const { return to_string(limit_) + " offset " + to_string(offset_); }
+
+RC LimitVecPhysicalOperator::open(Trx *trx)
+{
+  if (children_.size() != 1) {
+    LOG_WARN("limit operator must has one child");
+    return RC::INTERNAL;
+  }
+
+  skipped_  = 0;
+  returned_ = 0;
+  return children_[0]->open(trx);
+}
+
+RC LimitVecPhysicalOperator::next(Chunk &chunk)
+{
+  RC                rc    = RC::SUCCESS;
+  PhysicalOperator *child = children_[0].get();
+  while (returned_ < limit_) {
+    if (OB_FAIL(rc = child->next(chunk_))) {
+      return rc;
+    }
+
+    if (chunk_.has_select()) {
+      select_ = chunk_.select();
+    } else {
+      select_.assign(chunk_.rows(), 1);
+    }
+
+    int selected = 0;
+    for (int i = 0; i < chunk_.rows(); i++) {
+      if (select_[i] == 0) {
+        continue;
+      }
+      if (skipped_ < offset_) {
+        select_[i] = 0;
+        skipped_++;
+      } else if (returned_ < limit_) {
+        returned_++;
+        selected++;
+      } else {
+        select_[i] = 0;
+      }
+    }
+
+    if (selected == 0) {
+      continue;
+    }
+
+    chunk.reference(chunk_);
+    if (find(select_.begin(), select_.end(), 0) != select_.end()) {
+      chunk.set_select(select_);
+    } else {
+      chunk.clear_select();
+    }
+    return RC::SUCCESS;
+  }
+  return RC::RECORD_EOF;
+}
+
+RC LimitVecPhysicalOperator::close() { return children_[0]->close(); }
@@ -0,0 +1,42 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "sql/operator/physical_operator.h"
+
+/**
+ * @brief limit 物理算子(vectorized)
+ * @ingroup PhysicalOperator
+ * @details 通过输出 chunk 的选择向量去掉 offset 之前和 limit 之后的行，不拷贝数据。
+ * 输出足够的行之后不再调用孩子算子的 next。
+ */
+class LimitVecPhysicalOperator : public PhysicalOperator
+{
+public:
+  LimitVecPhysicalOperator(int limit, int offset) : limit_(limit), offset_(offset) {}
+  virtual ~LimitVecPhysicalOperator() = default;
+
+  PhysicalOperatorType type() const override { return PhysicalOperatorType::LIMIT_VEC; }
+
+  std::string param() const override;
+
+  RC open(Trx *trx) override;
+  RC next(Chunk &chunk) override;
+  RC close() override;
+
+private:
+  int                  limit_    = 0;
+  int                  offset_   = 0;
+  int                  skipped_  = 0;  ///< 已经跳过的行数
+  int                  returned_ = 0;  ///< 已经输出的行数
+  Chunk                chunk_;
+  std::vector<uint8_t> select_;
+};
@@ -5,24 +5,29 @@
 #include "storage/field/field.h"
 #include "storage/record/record.h"
 #include <algorithm>
+#include <atomic>
+#include <unistd.h>
 
 class cmp
 {
 private:
-    vector<bool> sortRules; // 多少个SortUnit 就有多少个规则，大于0表示升序
+    vector<bool> const &sortRules; // 多少个SortUnit 就有多少个规则，大于0表示升序
 public:
-    cmp(vector<bool> const &sortRules){
-        this->sortRules = sortRules;
+    cmp(vector<bool> const &sortRules) : sortRules(sortRules) {}
+
+    bool operator () (const SortTarget &A, const SortTarget &B) const {     // whether B should put ahead of A
+        return less(A.value, B.value);
     }
 
-    bool operator () (SortTarget A, SortTarget B) const {     // whether B should put ahead of A
+    // 排序键 a 是否应该排在 b 的前面
+    bool less(const vector<Value> &a, const vector<Value> &b) const {
         for(size_t i = 0; i < sortRules.size(); i++ ){
             // 获得当前排序规则
             bool rule = sortRules.at(i);
 
             // 取出 A 和 B 当前value
-            Value va = A.value.at(i);
-            Value vb = B.value.at(i);
+            const Value &va = a.at(i);
+            const Value &vb = b.at(i);
 
             // 获得 A 和 B 的类型
             AttrType aa = va.attr_type();
@@ -89,10 +94,12 @@ RC OtherTuple2ValueListTuple(ValueListTuple *resTuple, Tuple* oriTuple){
 
 RC OrderPhysicalOperator::open(Trx *trx)
 {
+  clear();
+
   // 1 - 获得排序规则
-  vector<bool> sortRules;
+  sort_rules_.clear();
   for(auto const &ou: order_units_){
-    sortRules.push_back(ou->inc_order_);
+    sort_rules_.push_back(ou->inc_order_);
   }
 
   // 2 - 递归处理子算子，要求保证本层在倒数第二层，即上层有且仅能有 过滤算子
@@ -117,8 +124,26 @@ RC OrderPhysicalOperator::open(Trx *trx)
     }
 
 
-    // 3 - 保存原始 tuple， 以 ValueListTuple 的形式
-    // TODO 优化：将 ValueListTuple 对象存储在文件之中，在磁盘进行排序 Big Data Order
+    // 3 - 筛选出需要排序的值
+    vector<Value> values;
+    for(auto const &ou: order_units_){
+        auto const &fieldExpr = ou->field_expr_;
+        Value curValue;
+        rc = fieldExpr->get_value(*child_tuple, curValue);
+        if(rc != RC::SUCCESS){
+            LOG_WARN("failed to get value from child tuple");
+            return RC::INTERNAL;
+        }
+        values.push_back(curValue);
+    }
+
+    // Top-N 时堆已经满了，并且这一行排不进前 N 行，就不需要保存
+    const bool heap_full = top_n_ >= 0 && static_cast<int64_t>(sort_targer_.size()) >= top_n_;
+    if (heap_full && (top_n_ == 0 || !cmp(sort_rules_).less(values, sort_targer_.front().value))) {
+      continue;
+    }
+
+    // 4 - 保存原始 tuple， 以 ValueListTuple 的形式
     ValueListTuple resTuple;
 
     if(child_tuple->getType() != TupleType::ROW_TUPLE && child_tuple->getType() != TupleType::JOINED_TUPLE){
@@ -132,34 +157,92 @@ RC OrderPhysicalOperator::open(Trx *trx)
         return RC::INTERNAL;
       }
     }
-    scanned_tuples_.emplace_back(resTuple);
 
-    // 4 - 筛选出需要排序的值
-    vector<Value> values;
-    for(auto const &ou: order_units_){
-        auto const &fieldExpr = ou->field_expr_;
-        Value curValue;
-        rc = fieldExpr->get_value(*child_tuple, curValue);
-        if(rc != RC::SUCCESS){
-            LOG_WARN("failed to get value from child tuple");
-            return RC::INTERNAL;
-        }
-        values.push_back(curValue);
+    // Top-N：sort_targer_ 是一个堆，保存当前排在最前面的 N 行，堆顶是其中排在最后的一行
+    if (top_n_ >= 0) {
+      if (heap_full) {
+        std::pop_heap(sort_targer_.begin(), sort_targer_.end(), cmp(sort_rules_));
+        SortTarget &evicted = sort_targer_.back();
+        scanned_tuples_[evicted.scanned_tuples_idx] = std::move(resTuple);
+        evicted.value = std::move(values);
+      } else {
+        scanned_tuples_.emplace_back(std::move(resTuple));
+        addSortTarget(values, scanned_tuples_.size()-1);
+      }
+      std::push_heap(sort_targer_.begin(), sort_targer_.end(), cmp(sort_rules_));
+      continue;
+    }
+
+    // 粗略估计这一行占用的内存，超过限制时把内存中的数据写到临时文件中
+    if (specs_.empty()) {
+      for (int i = 0; i < resTuple.cell_num(); i++) {
+        TupleCellSpec spec;
+        resTuple.spec_at(i, spec);
+        specs_.push_back(spec);
+      }
     }
+    memory_used_ += sizeof(ValueListTuple) + sizeof(SortTarget);
+    for (const Value &value : values) {
+      memory_used_ += sizeof(Value) + (value.attr_type() == AttrType::CHARS ? value.length() : 0);
+    }
+    for (int i = 0; i < resTuple.cell_num(); i++) {
+      Value cell;
+      resTuple.cell_at(i, cell);
+      memory_used_ += sizeof(Value) + sizeof(TupleCellSpec) + (cell.attr_type() == AttrType::CHARS ? cell.length() : 0);
+    }
+
+    scanned_tuples_.emplace_back(std::move(resTuple));
     // 保存需要排序的值（以封装的对象形式）
     addSortTarget(values, scanned_tuples_.size()-1);
+
+    if (memory_used_ > memory_limit_) {
+      rc = spill();
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to spill sorted rows to disk. rc=%s", strrc(rc));
+        return rc;
+      }
+    }
   }
 
-    // 5 - 对所有记录加以排序
-    std::sort(sort_targer_.begin(), sort_targer_.end(), cmp(sortRules));
+  if (rc != RC::RECORD_EOF) {
+    LOG_WARN("failed to get next tuple from child operator. rc=%s", strrc(rc));
+    return rc;
+  }
 
+  // 5 - 数据都在内存中时直接排序，否则把剩余的数据也写到临时文件中，再做多路归并
+  if (runs_.empty()) {
+    if (top_n_ >= 0) {
+      std::sort_heap(sort_targer_.begin(), sort_targer_.end(), cmp(sort_rules_));
+    } else {
+      std::sort(sort_targer_.begin(), sort_targer_.end(), cmp(sort_rules_));
+    }
     it_ = sort_targer_.begin();
-
     return RC::SUCCESS;
+  }
+
+  if (!sort_targer_.empty()) {
+    rc = spill();
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to spill sorted rows to disk. rc=%s", strrc(rc));
+      return rc;
+    }
+  }
+  LOG_INFO("external sort. runs=%d", runs_.size());
+  return open_merge();
 }
 
 RC OrderPhysicalOperator::next()
 {
+    if (!runs_.empty()) {
+      SortRun *run = merger_->top();
+      if (nullptr == run) {
+        return RC::RECORD_EOF;
+      }
+      merged_tuple_.set_cells(static_cast<RowSortRun *>(run)->cells());
+      tuple_ = &merged_tuple_;
+      return merger_->advance();
+    }
+
     if (sort_targer_.end() != it_) {
       auto current_idx = (*it_).scanned_tuples_idx;
       tuple_ = &scanned_tuples_.at(current_idx);
@@ -169,12 +252,15 @@ RC OrderPhysicalOperator::next()
     return RC::RECORD_EOF;
 }
 
+string OrderPhysicalOperator::param() const { return top_n_ >= 0 ? "top=" + std::to_string(top_n_) : ""; }
+
 Tuple *OrderPhysicalOperator::current_tuple() {
   return tuple_;
 }
 
 RC OrderPhysicalOperator::close()
 {
+  clear();
   return children_[0]->close();
 }
 
@@ -186,6 +272,78 @@ RC OrderPhysicalOperator::tuple_schema(TupleSchema &schema) const
 void OrderPhysicalOperator::addSortTarget(vector<Value>& values, int idx){
     SortTarget sort_targer;
     sort_targer.scanned_tuples_idx = idx;
-    sort_targer.value = values;
-    sort_targer_.push_back(sort_targer);
+    sort_targer.value = std::move(values);
+    sort_targer_.push_back(std::move(sort_targer));
+}
+
+void OrderPhysicalOperator::clear()
+{
+  scanned_tuples_.clear();
+  sort_targer_.clear();
+  it_ = sort_targer_.begin();
+  specs_.clear();
+  merger_.reset();
+  runs_.clear();  // 删除所有的临时文件
+  memory_used_ = 0;
+  tuple_       = nullptr;
+}
+
+string OrderPhysicalOperator::make_run_file_name()
+{
+  static std::atomic<uint64_t> sequence{0};
+  return temp_dir_ + "/sort_" + std::to_string(getpid()) + "_" + std::to_string(sequence++) + ".run";
+}
+
+RC OrderPhysicalOperator::spill()
+{
+  std::sort(sort_targer_.begin(), sort_targer_.end(), cmp(sort_rules_));
+
+  auto run = make_unique<RowSortRun>(make_run_file_name());
+  RC   rc  = run->open_write();
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  vector<Value> cells;
+  for (const SortTarget &target : sort_targer_) {
+    const ValueListTuple &tuple = scanned_tuples_[target.scanned_tuples_idx];
+    cells.resize(tuple.cell_num());
+    for (int i = 0; i < tuple.cell_num(); i++) {
+      tuple.cell_at(i, cells[i]);
+    }
+    rc = run->write(target.value, cells);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
+  rc = run->finish_write();
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  LOG_TRACE("spill sorted rows to disk. file=%s, rows=%d", run->file_name().c_str(), run->row_num());
+  runs_.push_back(std::move(run));
+  scanned_tuples_.clear();
+  sort_targer_.clear();
+  memory_used_ = 0;
+  return rc;
+}
+
+RC OrderPhysicalOperator::open_merge()
+{
+  cmp                 key_less(sort_rules_);
+  SortRunMerger::Less run_less = [key_less](const SortRun &left, const SortRun &right) {
+    return key_less.less(static_cast<const RowSortRun &>(left).keys(), static_cast<const RowSortRun &>(right).keys());
+  };
+
+  RC rc = SortRunMerger::reduce(
+      runs_, MAX_MERGE_RUNS, run_less, [this]() { return make_unique<RowSortRun>(make_run_file_name()); });
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to merge sort runs. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  merged_tuple_.set_names(specs_);
+  merger_ = make_unique<SortRunMerger>(run_less);
+  return merger_->open(runs_);
 }
@@ -2,6 +2,7 @@
 
 #include "sql/expr/expression.h"
 #include "sql/operator/physical_operator.h"
+#include "sql/operator/row_sort_run.h"
 #include "sql/stmt/order_stmt.h"
 #include "sql/expr/tuple.h"
 #include <memory>
@@ -12,6 +13,14 @@ struct SortTarget{
 };
 
 
+/**
+ * @brief 排序算子
+ * @ingroup PhysicalOperator
+ * @details 数据量不超过内存限制时在内存中排序。超过限制时使用外部排序：每当内存中的数据超过限制，
+ * 就把这部分数据排好序写到一个临时文件中（参考 RowSortRun）。读完所有数据后，有序段超过 MAX_MERGE_RUNS 个时
+ * 先做多趟归并（参考 SortRunMerger::reduce），最后一次多路归并的结果在 next 中流式输出。
+ * 设置了 top_n 时只在内存中维护一个有界堆。
+ */
 class OrderPhysicalOperator : public PhysicalOperator
 {
 public:
@@ -19,8 +28,27 @@ public:
 
   virtual ~OrderPhysicalOperator() = default;
 
+  /**
+   * @brief 设置排序可以使用的内存和临时文件存放的目录
+   * @param memory_limit 内存中的数据超过这个大小（字节）时写到临时文件中
+   * @param temp_dir 临时文件存放的目录，一般是数据库的目录
+   */
+  void set_sort_buffer(int64_t memory_limit, const string &temp_dir)
+  {
+    memory_limit_ = memory_limit;
+    temp_dir_     = temp_dir;
+  }
+
+  /**
+   * @brief 只需要排在最前面的 n 行，比如 ORDER BY + LIMIT
+   * @details 使用大小为 n 的有界堆代替全量排序，内存中最多保存 n 行，不会写临时文件
+   */
+  void set_top_n(int64_t n) { top_n_ = n; }
+
   PhysicalOperatorType type() const override { return PhysicalOperatorType::ORDER_BY; }
 
+  std::string param() const override;
+
   RC open(Trx *trx) override;
   RC next() override;
   RC close() override;
@@ -32,10 +60,34 @@ public:
 private:
   void addSortTarget(vector<Value>& values, int idx);
 
+  /// @brief 把内存中的数据排序后写到一个新的临时文件中
+  RC spill();
+  /// @brief 有序段太多时先做多趟归并，然后打开最后一次归并
+  RC open_merge();
+
+  string make_run_file_name();
+
+  void clear();
+
+private:
+  static constexpr int64_t DEFAULT_MEMORY_LIMIT = 64 * 1024 * 1024;
+  static constexpr size_t  MAX_MERGE_RUNS       = 64;
+
   vector<unique_ptr<OrderUnit>> order_units_;  // 排序规则的算子单元
+  vector<bool>                  sort_rules_;   // 每个排序单元是否为升序
   vector<ValueListTuple> scanned_tuples_;   // 扫描出的所有元组
   vector<SortTarget> sort_targer_;  // 排序即对此集合排序
   vector<SortTarget>::iterator it_;
 
+  int64_t memory_limit_ = DEFAULT_MEMORY_LIMIT;
+  string  temp_dir_     = ".";
+  int64_t memory_used_  = 0;  // 内存中的数据大概占用的空间
+  int64_t top_n_        = -1;  // 大于等于 0 时只保留排在最前面的 top_n_ 行
+
+  vector<TupleCellSpec>       specs_;         // 输出的列信息
+  vector<unique_ptr<SortRun>> runs_;          // 写到临时文件中的有序段，都是 RowSortRun
+  unique_ptr<SortRunMerger>   merger_;        // 最后一次多路归并
+  ValueListTuple              merged_tuple_;  // 归并输出的当前行
+
   Tuple *tuple_ = nullptr;
 };
@@ -20,8 +20,15 @@ std::string physical_operator_type_name(PhysicalOperatorType type)
     case PhysicalOperatorType::TABLE_SCAN: return "TABLE_SCAN";
     case PhysicalOperatorType::INDEX_SCAN: return "INDEX_SCAN";
     case PhysicalOperatorType::NESTED_LOOP_JOIN: return "NESTED_LOOP_JOIN";
+    case PhysicalOperatorType::INDEX_NESTED_LOOP_JOIN: return "INDEX_NESTED_LOOP_JOIN";
+    case PhysicalOperatorType::HASH_JOIN: return "HASH_JOIN";
+    case PhysicalOperatorType::HASH_JOIN_VEC: return "HASH_JOIN_VEC";
     case PhysicalOperatorType::EXPLAIN: return "EXPLAIN";
     case PhysicalOperatorType::PREDICATE: return "PREDICATE";
+    case PhysicalOperatorType::PREDICATE_VEC: return "PREDICATE_VEC";
+    case PhysicalOperatorType::ORDER_BY: return "ORDER_BY";
+    case PhysicalOperatorType::LIMIT: return "LIMIT";
+    case PhysicalOperatorType::LIMIT_VEC: return "LIMIT_VEC";
     case PhysicalOperatorType::INSERT: return "INSERT";
     case PhysicalOperatorType::DELETE: return "DELETE";
     case PhysicalOperatorType::PROJECT: return "PROJECT";
@@ -41,10 +41,15 @@ enum class PhysicalOperatorType
   TABLE_SCAN_VEC,
   INDEX_SCAN,
   NESTED_LOOP_JOIN,
+  INDEX_NESTED_LOOP_JOIN,
+  HASH_JOIN,
+  HASH_JOIN_VEC,
   EXPLAIN,
   PREDICATE,
   PREDICATE_VEC,
   ORDER_BY,
+  LIMIT,
+  LIMIT_VEC,
   PROJECT,
   PROJECT_VEC,
   CALC,
@@ -0,0 +1,70 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "sql/operator/predicate_vec_physical_operator.h"
+#include "common/lang/algorithm.h"
+#include "common/log/log.h"
+
+using namespace std;
+
+PredicateVecPhysicalOperator::PredicateVecPhysicalOperator(unique_ptr<Expression> expr) : expression_(std::move(expr))
+{
+  ASSERT(expression_->value_type() == AttrType::BOOLEANS, "predicate's expression should be BOOLEAN type");
+}
+
+RC PredicateVecPhysicalOperator::open(Trx *trx)
+{
+  if (children_.size() != 1) {
+    LOG_WARN("predicate operator must has one child");
+    return RC::INTERNAL;
+  }
+
+  return children_[0]->open(trx);
+}
+
+RC PredicateVecPhysicalOperator::next(Chunk &chunk)
+{
+  RC                rc    = RC::SUCCESS;
+  PhysicalOperator *child = children_[0].get();
+  while (OB_SUCC(rc = child->next(chunk_))) {
+    // 在子算子的选择向量基础上继续过滤
+    if (chunk_.has_select()) {
+      select_ = chunk_.select();
+    } else {
+      select_.assign(chunk_.rows(), 1);
+    }
+
+    rc = expression_->eval(chunk_, select_);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to eval predicate. rc=%s", strrc(rc));
+      return rc;
+    }
+
+    // 没有满足条件的行，直接获取下一批数据
+    if (find(select_.begin(), select_.end(), 1) == select_.end()) {
+      continue;
+    }
+
+    chunk.reference(chunk_);
+    if (find(select_.begin(), select_.end(), 0) != select_.end()) {
+      chunk.set_select(select_);
+    } else {
+      chunk.clear_select();
+    }
+    break;
+  }
+  return rc;
+}
+
+RC PredicateVecPhysicalOperator::close()
+{
+  children_[0]->close();
+  return RC::SUCCESS;
+}
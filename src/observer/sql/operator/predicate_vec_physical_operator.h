@@ -0,0 +1,38 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "sql/expr/expression.h"
+#include "sql/operator/physical_operator.h"
+
+/**
+ * @brief 过滤/谓词物理算子(vectorized)
+ * @ingroup PhysicalOperator
+ * @details 过滤结果记录在输出 chunk 的选择向量中，不拷贝数据
+ */
+class PredicateVecPhysicalOperator : public PhysicalOperator
+{
+public:
+  PredicateVecPhysicalOperator(std::unique_ptr<Expression> expr);
+
+  virtual ~PredicateVecPhysicalOperator() = default;
+
+  PhysicalOperatorType type() const override { return PhysicalOperatorType::PREDICATE_VEC; }
+
+  RC open(Trx *trx) override;
+  RC next(Chunk &chunk) override;
+  RC close() override;
+
+private:
+  std::unique_ptr<Expression> expression_;
+  Chunk                       chunk_;
+  std::vector<uint8_t>        select_;
+};
@@ -9,6 +9,8 @@ MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
 See the Mulan PSL v2 for more details. */
 
 #include "sql/operator/project_vec_physical_operator.h"
+#include "common/lang/string_view.h"
+#include "common/lang/unordered_set.h"
 #include "common/log/log.h"
 #include "storage/record/record.h"
 #include "storage/table/table.h"
@@ -48,7 +50,12 @@ RC ProjectVecPhysicalOperator::next(Chunk &chunk)
   if (rc == RC::RECORD_EOF) {
     return rc;
   } else if (rc == RC::SUCCESS) {
-    rc = chunk.reference(chunk_);
+    if (!chunk_.has_select()) {
+      rc = chunk.reference(chunk_);
+    } else if (OB_SUCC(rc = compact_selected_rows())) {
+      // 投影是输出结果前的最后一个算子，只在这里物化被选中的行，并且只包含输出的列
+      rc = chunk.reference(output_chunk_);
+    }
   } else {
     LOG_WARN("failed to get next tuple: %s", strrc(rc));
     return rc;
@@ -56,6 +63,41 @@ RC ProjectVecPhysicalOperator::next(Chunk &chunk)
   return rc;
 }
 
+RC ProjectVecPhysicalOperator::compact_selected_rows()
+{
+  output_chunk_.reset();
+  const int rows = chunk_.rows();
+  for (int i = 0; i < chunk_.column_num(); i++) {
+    Column &column = chunk_.column(i);
+    auto    output = make_unique<Column>();
+    if (column.column_type() == Column::Type::CONSTANT_COLUMN) {
+      output->reference(column);
+    } else {
+      output->init(column.attr_type(), column.attr_len(), rows);
+      // 连续的有效行一次拷贝
+      int start = 0;
+      while (start < rows) {
+        if (!chunk_.selected(start)) {
+          start++;
+          continue;
+        }
+        int end = start + 1;
+        while (end < rows && chunk_.selected(end)) {
+          end++;
+        }
+        RC rc = output->append(column.data() + start * column.attr_len(), end - start);
+        if (OB_FAIL(rc)) {
+          LOG_WARN("failed to append data to column. rc=%s", strrc(rc));
+          return rc;
+        }
+        start = end;
+      }
+    }
+    output_chunk_.add_column(std::move(output), chunk_.column_ids(i));
+  }
+  return RC::SUCCESS;
+}
+
 RC ProjectVecPhysicalOperator::close()
 {
   if (!children_.empty()) {
@@ -66,8 +108,22 @@ RC ProjectVecPhysicalOperator::close()
 
 RC ProjectVecPhysicalOperator::tuple_schema(TupleSchema &schema) const
 {
+  // 与 ProjectPhysicalOperator 一致，投影多个表的字段时列名带上表名
+  unordered_set<string_view> tables;
+  for (const unique_ptr<Expression> &expression : expressions_) {
+    if (expression->type() == ExprType::FIELD) {
+      tables.insert(static_cast<FieldExpr *>(expression.get())->table_name());
+    }
+  }
+
   for (const unique_ptr<Expression> &expression : expressions_) {
-    schema.append_cell(expression->name());
+    if (tables.size() > 1 && expression->type() == ExprType::FIELD) {
+      auto  *field_expr = static_cast<FieldExpr *>(expression.get());
+      string name       = string(field_expr->table_name()) + "." + field_expr->field_name();
+      schema.append_cell(name.c_str());
+    } else {
+      schema.append_cell(expression->name());
+    }
   }
   return RC::SUCCESS;
 }
@@ -35,7 +35,14 @@ public:
 
   std::vector<std::unique_ptr<Expression>> &expressions() { return expressions_; }
 
+private:
+  /**
+   * @brief 按照选择向量将 chunk_ 中有效的行拷贝到 output_chunk_ 中
+   */
+  RC compact_selected_rows();
+
 private:
   std::vector<std::unique_ptr<Expression>> expressions_;
   Chunk                                    chunk_;
+  Chunk                                    output_chunk_;
 };
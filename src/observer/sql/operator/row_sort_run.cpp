@@ -0,0 +1,136 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <string.h>
+
+#include "sql/operator/row_sort_run.h"
+#include "common/log/log.h"
+
+RC RowSortRun::write(const vector<Value> &keys, const vector<Value> &cells)
+{
+  buffer_.clear();
+  const uint16_t counts[2] = {static_cast<uint16_t>(keys.size()), static_cast<uint16_t>(cells.size())};
+  buffer_.append(reinterpret_cast<const char *>(counts), sizeof(counts));
+
+  RC rc = RC::SUCCESS;
+  for (size_t i = 0; OB_SUCC(rc) && i < keys.size(); i++) {
+    rc = encode_value(keys[i]);
+  }
+  for (size_t i = 0; OB_SUCC(rc) && i < cells.size(); i++) {
+    rc = encode_value(cells[i]);
+  }
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+  return SortRun::write(buffer_.data(), static_cast<int>(buffer_.size()));
+}
+
+RC RowSortRun::decode_record()
+{
+  const char *data = record().data();
+  const char *end  = data + record().size();
+
+  uint16_t counts[2] = {0, 0};
+  if (end - data < static_cast<ptrdiff_t>(sizeof(counts))) {
+    LOG_WARN("invalid sort run record. file=%s", file_name().c_str());
+    return RC::INTERNAL;
+  }
+  memcpy(counts, data, sizeof(counts));
+  data += sizeof(counts);
+
+  RC rc = RC::SUCCESS;
+  keys_.resize(counts[0]);
+  cells_.resize(counts[1]);
+  for (size_t i = 0; OB_SUCC(rc) && i < keys_.size(); i++) {
+    rc = decode_value(data, end, keys_[i]);
+  }
+  for (size_t i = 0; OB_SUCC(rc) && i < cells_.size(); i++) {
+    rc = decode_value(data, end, cells_[i]);
+  }
+  return rc;
+}
+
+RC RowSortRun::encode_value(const Value &value)
+{
+  const uint8_t type = static_cast<uint8_t>(value.attr_type());
+  buffer_.push_back(static_cast<char>(type));
+
+  switch (value.attr_type()) {
+    case AttrType::NULLS: break;
+    case AttrType::INTS:
+    case AttrType::FLOATS:
+    case AttrType::DATES: buffer_.append(value.data(), 4); break;
+    case AttrType::BOOLEANS: buffer_.push_back(value.get_boolean() ? 1 : 0); break;
+    case AttrType::CHARS: {
+      const int32_t len = value.length();
+      buffer_.append(reinterpret_cast<const char *>(&len), sizeof(len));
+      buffer_.append(value.data(), len);
+    } break;
+    default: {
+      LOG_WARN("unsupported value type in sort run. type=%s", attr_type_to_string(value.attr_type()));
+      return RC::UNSUPPORTED;
+    }
+  }
+  return RC::SUCCESS;
+}
+
+RC RowSortRun::decode_value(const char *&data, const char *end, Value &value)
+{
+  auto take = [&data, end](void *output, size_t len) {
+    if (end - data < static_cast<ptrdiff_t>(len)) {
+      return false;
+    }
+    memcpy(output, data, len);
+    data += len;
+    return true;
+  };
+
+  uint8_t type = 0;
+  if (!take(&type, sizeof(type))) {
+    LOG_WARN("invalid sort run record. file=%s", file_name().c_str());
+    return RC::INTERNAL;
+  }
+
+  bool           ok        = true;
+  const AttrType attr_type = static_cast<AttrType>(type);
+  switch (attr_type) {
+    case AttrType::NULLS: value.set_null(); break;
+    case AttrType::INTS:
+    case AttrType::FLOATS:
+    case AttrType::DATES: {
+      char buf[4];
+      if ((ok = take(buf, sizeof(buf)))) {
+        value = Value(attr_type, buf, sizeof(buf));
+      }
+    } break;
+    case AttrType::BOOLEANS: {
+      uint8_t bool_value = 0;
+      if ((ok = take(&bool_value, sizeof(bool_value)))) {
+        value.set_boolean(bool_value != 0);
+      }
+    } break;
+    case AttrType::CHARS: {
+      int32_t len = 0;
+      ok          = take(&len, sizeof(len)) && len >= 0 && end - data >= len;
+      if (ok) {
+        // 长度为0时 Value 会使用 strlen 计算长度，不能直接传入 data
+        value = Value(len > 0 ? data : "", len);
+        data += len;
+      }
+    } break;
+    default: ok = false; break;
+  }
+
+  if (!ok) {
+    LOG_WARN("invalid sort run record. file=%s, type=%d", file_name().c_str(), type);
+    return RC::INTERNAL;
+  }
+  return RC::SUCCESS;
+}
@@ -0,0 +1,47 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/lang/string.h"
+#include "common/lang/vector.h"
+#include "common/value.h"
+#include "storage/common/sort_run.h"
+
+/**
+ * @brief 排序算子写到临时文件中的有序段
+ * @ingroup PhysicalOperator
+ * @details 每条记录由排序键和行中所有的列值组成。每个值按照紧凑的二进制格式编码：1 字节类型，
+ * INTS/FLOATS/DATES 为 4 字节数据，BOOLEANS 为 1 字节，NULLS 没有数据，CHARS 为 4 字节长度加上字符串内容。
+ * 读到一条记录时就解码出来，归并比较时直接使用 keys()。
+ */
+class RowSortRun : public SortRun
+{
+public:
+  using SortRun::SortRun;
+  using SortRun::write;
+
+  RC write(const vector<Value> &keys, const vector<Value> &cells);
+
+  const vector<Value> &keys() const { return keys_; }
+  const vector<Value> &cells() const { return cells_; }
+
+protected:
+  RC decode_record() override;
+
+private:
+  RC encode_value(const Value &value);
+  RC decode_value(const char *&data, const char *end, Value &value);
+
+private:
+  string        buffer_;  ///< 编码一条记录使用的缓冲区
+  vector<Value> keys_;
+  vector<Value> cells_;
+};
@@ -16,6 +16,8 @@ See the Mulan PSL v2 for more details. */
 #include "sql/operator/scalar_group_by_physical_operator.h"
 #include "sql/expr/expression_tuple.h"
 #include "sql/expr/composite_tuple.h"
+#include "storage/table/table.h"
+#include "storage/trx/trx.h"
 
 using namespace std;
 using namespace common;
@@ -28,8 +30,16 @@ RC ScalarGroupByPhysicalOperator::open(Trx *trx)
 {
   ASSERT(children_.size() == 1, "group by operator only support one child, but got %d", children_.size());
 
+  emitted_ = false;
+
+  bool counted = false;
+  RC   rc      = count_rows(trx, counted);
+  if (OB_FAIL(rc) || counted) {
+    return rc;
+  }
+
   PhysicalOperator &child = *children_[0];
-  RC                rc    = child.open(trx);
+  rc                      = child.open(trx);
   if (OB_FAIL(rc)) {
     LOG_INFO("failed to open child operator. rc=%s", strrc(rc));
     return rc;
@@ -91,6 +101,37 @@ RC ScalarGroupByPhysicalOperator::open(Trx *trx)
   return rc;
 }
 
+RC ScalarGroupByPhysicalOperator::count_rows(Trx *trx, bool &counted)
+{
+  int64_t rows = 0;
+  counted      = row_count_table_ != nullptr && trx->count_visible_rows(row_count_table_, rows);
+  if (!counted) {
+    return RC::SUCCESS;
+  }
+
+  // 与扫描计算的结果保持一致，空表不输出任何数据
+  if (rows == 0) {
+    return RC::SUCCESS;
+  }
+
+  vector<TupleCellSpec> aggregator_names;
+  vector<Value>         values;
+  for (Expression *expr : aggregate_expressions_) {
+    aggregator_names.emplace_back(expr->name());
+    values.emplace_back(static_cast<int>(rows));
+  }
+
+  ValueListTuple count_tuple;
+  count_tuple.set_cells(values);
+  count_tuple.set_names(aggregator_names);
+
+  CompositeTuple composite_tuple;
+  composite_tuple.add_tuple(make_unique<ValueListTuple>(std::move(count_tuple)));
+  group_value_ = make_unique<GroupValueType>(AggregatorList(), std::move(composite_tuple));
+  LOG_TRACE("count rows from table metadata. table=%s, rows=%ld", row_count_table_->name(), rows);
+  return RC::SUCCESS;
+}
+
 RC ScalarGroupByPhysicalOperator::next()
 {
   if (group_value_ == nullptr || emitted_) {
@@ -116,4 +157,9 @@ Tuple *ScalarGroupByPhysicalOperator::current_tuple()
   }
 
   return &get<1>(*group_value_);
-}
\ No newline at end of file
+}
+
+string ScalarGroupByPhysicalOperator::param() const
+{
+  return row_count_table_ == nullptr ? "" : string("ROW COUNT ") + row_count_table_->name();
+}
@@ -16,6 +16,8 @@ See the Mulan PSL v2 for more details. */
 
 #include "sql/operator/group_by_physical_operator.h"
 
+class Table;
+
 /**
  * @brief 没有 group by 表达式的 group by 物理算子
  * @ingroup PhysicalOperator
@@ -34,7 +36,20 @@ public:
 
   Tuple *current_tuple() override;
 
+  std::string param() const override;
+
+  /**
+   * @brief 所有的聚合都是 COUNT 并且没有过滤条件时，设置要统计行数的表
+   * @details 事务可以直接拿到表的行数时不再扫描孩子算子，拿不到时仍然扫描计算
+   */
+  void set_row_count_table(Table *table) { row_count_table_ = table; }
+
+private:
+  /// @brief 使用表中维护的行数作为所有 COUNT 的结果
+  RC count_rows(Trx *trx, bool &counted);
+
 private:
+  Table                          *row_count_table_ = nullptr;
   std::unique_ptr<GroupValueType> group_value_;
   bool                            emitted_ = false;  /// 标识是否已经输出过
 };
\ No newline at end of file
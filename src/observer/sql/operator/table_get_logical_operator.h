@@ -36,6 +36,18 @@ public:
   void set_predicates(std::vector<std::unique_ptr<Expression>> &&exprs);
   auto predicates() -> std::vector<std::unique_ptr<Expression>> & { return predicates_; }
 
+  void                      set_fields(std::vector<Field> &&fields) { fields_ = std::move(fields); }
+  const std::vector<Field> &fields() const { return fields_; }
+
+  /// @brief 上层需要数据按照这些字段排序，可以按照索引的顺序扫描时就不需要再排序了
+  void set_order(std::vector<Field> &&fields, bool asc)
+  {
+    order_fields_ = std::move(fields);
+    order_asc_    = asc;
+  }
+  const std::vector<Field> &order_fields() const { return order_fields_; }
+  bool                      order_asc() const { return order_asc_; }
+
 private:
   Table        *table_ = nullptr;
   ReadWriteMode mode_  = ReadWriteMode::READ_WRITE;
@@ -45,4 +57,10 @@ private:
   // 不包含复杂的表达式运算，比如加减乘除、或者conjunction expression
   // 如果有多个表达式，他们的关系都是 AND
   std::vector<std::unique_ptr<Expression>> predicates_;
+
+  // 上层算子引用到的当前表的字段，向量化扫描时只需要读取这些列
+  std::vector<Field> fields_;
+
+  std::vector<Field> order_fields_;       ///< 期望的输出顺序，为空表示没有要求
+  bool               order_asc_ = true;  ///< 所有字段都是升序还是都是降序
 };
@@ -9,6 +9,7 @@ MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
 See the Mulan PSL v2 for more details. */
 
 #include "sql/operator/table_scan_vec_physical_operator.h"
+#include "common/lang/algorithm.h"
 #include "event/sql_debug.h"
 #include "storage/table/table.h"
 
@@ -21,12 +22,20 @@ RC TableScanVecPhysicalOperator::open(Trx *trx)
     LOG_WARN("failed to get chunk scanner", strrc(rc));
     return rc;
   }
-  // TODO: don't need to fetch all columns from record manager
-  for (int i = 0; i < table_->table_meta().field_num(); ++i) {
-    all_columns_.add_column(
-        make_unique<Column>(*table_->table_meta().field(i)), table_->table_meta().field(i)->field_id());
-    filterd_columns_.add_column(
-        make_unique<Column>(*table_->table_meta().field(i)), table_->table_meta().field(i)->field_id());
+  // 只读取上层算子引用到的列
+  // NOTE: column id is the index of field in table meta, which is also the column index in PAX page
+  const TableMeta &table_meta = table_->table_meta();
+  vector<int>      col_ids;
+  for (const Field &field : fields_) {
+    col_ids.push_back(field.meta()->field_id() + table_meta.sys_field_num());
+  }
+  if (col_ids.empty()) {
+    // 没有引用任何字段（比如 count(*)），仍然需要一列来获取行数
+    col_ids.push_back(0);
+  }
+
+  for (int col_id : col_ids) {
+    all_columns_.add_column(make_unique<Column>(*table_meta.field(col_id)), col_id, table_->table_id());
   }
   return rc;
 }
@@ -36,29 +45,29 @@ RC TableScanVecPhysicalOperator::next(Chunk &chunk)
   RC rc = RC::SUCCESS;
 
   all_columns_.reset_data();
-  filterd_columns_.reset_data();
-  if (OB_SUCC(rc = chunk_scanner_.next_chunk(all_columns_))) {
-    select_.assign(all_columns_.rows(), 1);
+  while (OB_SUCC(rc = chunk_scanner_.next_chunk(all_columns_))) {
     if (predicates_.empty()) {
       chunk.reference(all_columns_);
-    } else {
-      rc = filter(all_columns_);
-      if (rc != RC::SUCCESS) {
-        LOG_TRACE("filtered failed=%s", strrc(rc));
-        return rc;
-      }
-      // TODO: if all setted, it doesn't need to set one by one
-      for (int i = 0; i < all_columns_.rows(); i++) {
-        if (select_[i] == 0) {
-          continue;
-        }
-        for (int j = 0; j < all_columns_.column_num(); j++) {
-          filterd_columns_.column(j).append_one(
-              (char *)all_columns_.column(filterd_columns_.column_ids(j)).get_value(i).data());
-        }
-      }
-      chunk.reference(filterd_columns_);
+      break;
+    }
+
+    select_.assign(all_columns_.rows(), 1);
+    rc = filter(all_columns_);
+    if (rc != RC::SUCCESS) {
+      LOG_TRACE("filtered failed=%s", strrc(rc));
+      return rc;
+    }
+
+    // 过滤结果只记录在选择向量中，不拷贝数据。整个页面都被过滤掉时直接读取下一个页面
+    if (find(select_.begin(), select_.end(), 1) == select_.end()) {
+      all_columns_.reset_data();
+      continue;
+    }
+    chunk.reference(all_columns_);
+    if (find(select_.begin(), select_.end(), 0) != select_.end()) {
+      chunk.set_select(select_);
     }
+    break;
   }
   return rc;
 }
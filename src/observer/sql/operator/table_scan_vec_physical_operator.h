@@ -12,6 +12,7 @@ See the Mulan PSL v2 for more details. */
 
 #include "common/rc.h"
 #include "sql/operator/physical_operator.h"
+#include "storage/field/field.h"
 #include "storage/record/record_manager.h"
 #include "common/types.h"
 
@@ -38,6 +39,11 @@ public:
 
   void set_predicates(std::vector<std::unique_ptr<Expression>> &&exprs);
 
+  /**
+   * @brief 设置需要读取的字段，为空时只读取一列用于计数
+   */
+  void set_fields(const std::vector<Field> &fields) { fields_ = fields; }
+
 private:
   RC filter(Chunk &chunk);
 
@@ -46,7 +52,7 @@ private:
   ReadWriteMode                            mode_  = ReadWriteMode::READ_WRITE;
   ChunkFileScanner                         chunk_scanner_;
   Chunk                                    all_columns_;
-  Chunk                                    filterd_columns_;
   std::vector<uint8_t>                     select_;
   std::vector<std::unique_ptr<Expression>> predicates_;
+  std::vector<Field>                       fields_;
 };
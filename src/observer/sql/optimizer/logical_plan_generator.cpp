@@ -23,6 +23,7 @@ See the Mulan PSL v2 for more details. */
 #include "sql/operator/insert_logical_operator.h"
 #include "sql/operator/join_logical_operator.h"
 #include "sql/operator/logical_operator.h"
+#include "sql/operator/limit_logical_operator.h"
 #include "sql/operator/order_logical_operator.h"
 #include "sql/operator/predicate_logical_operator.h"
 #include "sql/operator/project_logical_operator.h"
@@ -164,6 +165,14 @@ RC LogicalPlanGenerator::create_plan(SelectStmt *select_stmt, unique_ptr<Logical
     }
   }
 
+  unique_ptr<LogicalOperator> limit_oper;
+  if (select_stmt->limit() >= 0) {
+    limit_oper = make_unique<LimitLogicalOperator>(select_stmt->limit(), select_stmt->offset());
+    if (*last_oper) {
+      limit_oper->add_child(std::move(*last_oper));
+    }
+    last_oper = &limit_oper;
+  }
 
   auto project_oper = make_unique<ProjectLogicalOperator>(std::move(select_stmt->query_expressions()));
   if (*last_oper) {
@@ -171,6 +180,82 @@ RC LogicalPlanGenerator::create_plan(SelectStmt *select_stmt, unique_ptr<Logical
   }
 
   logical_operator = std::move(project_oper);
+  return bind_table_get_fields(*logical_operator);
+}
+
+RC LogicalPlanGenerator::bind_table_get_fields(LogicalOperator &root)
+{
+  vector<Field> fields;
+  function<RC(unique_ptr<Expression> &)> field_collector = [&](unique_ptr<Expression> &expr) -> RC {
+    if (expr->type() != ExprType::FIELD) {
+      return ExpressionIterator::iterate_child_expr(*expr, field_collector);
+    }
+
+    const Field &field = static_cast<FieldExpr *>(expr.get())->field();
+    auto         iter  = find_if(fields.begin(), fields.end(), [&field](const Field &f) {
+      return f.table() == field.table() && f.meta() == field.meta();
+    });
+    if (iter == fields.end()) {
+      fields.push_back(field);
+    }
+    return RC::SUCCESS;
+  };
+
+  vector<TableGetLogicalOperator *> table_gets;
+  function<RC(LogicalOperator &)> oper_collector = [&](LogicalOperator &oper) -> RC {
+    RC rc = RC::SUCCESS;
+    for (unique_ptr<Expression> &expr : oper.expressions()) {
+      if (OB_FAIL(rc = field_collector(expr))) {
+        return rc;
+      }
+    }
+
+    if (oper.type() == LogicalOperatorType::GROUP_BY) {
+      // 聚合表达式是投影表达式的一部分，已经收集过了
+      for (unique_ptr<Expression> &expr : static_cast<GroupByLogicalOperator &>(oper).group_by_expressions()) {
+        if (OB_FAIL(rc = field_collector(expr))) {
+          return rc;
+        }
+      }
+    } else if (oper.type() == LogicalOperatorType::ORDER_BY) {
+      for (const unique_ptr<OrderUnit> &order_unit : static_cast<const OrderLogicalOperator &>(oper).OrderUnits()) {
+        if (OB_FAIL(rc = field_collector(order_unit->field_expr_))) {
+          return rc;
+        }
+      }
+    } else if (oper.type() == LogicalOperatorType::TABLE_GET) {
+      auto &table_get = static_cast<TableGetLogicalOperator &>(oper);
+      for (unique_ptr<Expression> &expr : table_get.predicates()) {
+        if (OB_FAIL(rc = field_collector(expr))) {
+          return rc;
+        }
+      }
+      table_gets.push_back(&table_get);
+    }
+
+    for (unique_ptr<LogicalOperator> &child : oper.children()) {
+      if (OB_FAIL(rc = oper_collector(*child))) {
+        return rc;
+      }
+    }
+    return rc;
+  };
+
+  RC rc = oper_collector(root);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to collect referenced fields. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  for (TableGetLogicalOperator *table_get : table_gets) {
+    vector<Field> table_fields;
+    for (const Field &field : fields) {
+      if (field.table() == table_get->table()) {
+        table_fields.push_back(field);
+      }
+    }
+    table_get->set_fields(std::move(table_fields));
+  }
   return RC::SUCCESS;
 }
 
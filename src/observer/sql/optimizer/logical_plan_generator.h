@@ -50,5 +50,11 @@ private:
 
   RC create_group_by_plan(SelectStmt *select_stmt, std::unique_ptr<LogicalOperator> &logical_operator);
 
+  /**
+   * @brief 收集算子树中引用到的所有字段，设置到对应的 TableGetLogicalOperator 中
+   * @details 向量化执行时表扫描只需要读取这些列，避免解码整行数据
+   */
+  RC bind_table_get_fields(LogicalOperator &root);
+
   int implicit_cast_cost(AttrType from, AttrType to);
 };
@@ -15,7 +15,9 @@ See the Mulan PSL v2 for more details. */
 #include <utility>
 
 #include "common/log/log.h"
+#include "session/session.h"
 #include "sql/expr/expression.h"
+#include "sql/expr/expression_iterator.h"
 #include "sql/operator/aggregate_vec_physical_operator.h"
 #include "sql/operator/calc_logical_operator.h"
 #include "sql/operator/calc_physical_operator.h"
@@ -25,9 +27,15 @@ See the Mulan PSL v2 for more details. */
 #include "sql/operator/explain_physical_operator.h"
 #include "sql/operator/expr_vec_physical_operator.h"
 #include "sql/operator/group_by_vec_physical_operator.h"
+#include "sql/operator/hash_join_physical_operator.h"
+#include "sql/operator/hash_join_vec_physical_operator.h"
+#include "sql/operator/index_nested_loop_join_physical_operator.h"
 #include "sql/operator/index_scan_physical_operator.h"
 #include "sql/operator/insert_logical_operator.h"
 #include "sql/operator/insert_physical_operator.h"
+#include "sql/operator/limit_logical_operator.h"
+#include "sql/operator/limit_physical_operator.h"
+#include "sql/operator/limit_vec_physical_operator.h"
 #include "sql/operator/order_logical_operator.h"
 #include "sql/operator/order_physical_operator.h"
 #include "sql/operator/physical_operator.h"
@@ -37,6 +45,7 @@ See the Mulan PSL v2 for more details. */
 #include "sql/operator/join_physical_operator.h"
 #include "sql/operator/predicate_logical_operator.h"
 #include "sql/operator/predicate_physical_operator.h"
+#include "sql/operator/predicate_vec_physical_operator.h"
 #include "sql/operator/project_logical_operator.h"
 #include "sql/operator/project_physical_operator.h"
 #include "sql/operator/project_vec_physical_operator.h"
@@ -49,9 +58,393 @@ See the Mulan PSL v2 for more details. */
 #include "sql/operator/table_scan_vec_physical_operator.h"
 #include "sql/stmt/update_stmt.h"
 #include "sql/optimizer/physical_plan_generator.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/db/db.h"
+#include "storage/index/index.h"
+#include "storage/table/table.h"
 
 using namespace std;
 
+/**
+ * @brief 粗略估计一个逻辑算子输出的数据量，用于选择 hash join 的构建侧
+ * @details 以表数据文件的页面数作为数据量。连接的结果按照较大的一侧估计（假设是主外键连接），
+ * 其它算子按照孩子估计。
+ */
+static int64_t estimate_pages(LogicalOperator &oper)
+{
+  if (oper.type() == LogicalOperatorType::TABLE_GET) {
+    DiskBufferPool *buffer_pool = static_cast<TableGetLogicalOperator &>(oper).table()->data_buffer_pool();
+    return buffer_pool == nullptr ? 0 : buffer_pool->allocated_pages();
+  }
+
+  int64_t pages = 0;
+  for (unique_ptr<LogicalOperator> &child : oper.children()) {
+    pages = max(pages, estimate_pages(*child));
+  }
+  return pages;
+}
+
+/**
+ * @brief 从连接算子的等值条件中拆分出左右两边的连接键
+ * @details 连接条件的左边引用左孩子，右边引用右孩子，参考 PredicatePushdownRewriter
+ */
+static void split_join_keys(
+    JoinLogicalOperator &join_oper, vector<unique_ptr<Expression>> &left_keys, vector<unique_ptr<Expression>> &right_keys)
+{
+  for (unique_ptr<Expression> &expr : join_oper.expressions()) {
+    ASSERT(expr->type() == ExprType::COMPARISON, "join condition should be a comparison expression");
+    auto comparison_expr = static_cast<ComparisonExpr *>(expr.get());
+    left_keys.emplace_back(std::move(comparison_expr->left()));
+    right_keys.emplace_back(std::move(comparison_expr->right()));
+  }
+}
+
+/**
+ * @brief 同一个字段上的过滤条件合并成的范围
+ */
+struct ColumnRange
+{
+  const Value *left            = nullptr;
+  bool         left_inclusive  = false;
+  const Value *right           = nullptr;
+  bool         right_inclusive = false;
+
+  /// @brief 用一个新的下界收紧范围
+  void narrow_left(const Value &value, bool inclusive)
+  {
+    const int result = left == nullptr ? 1 : value.compare(*left);
+    if (result > 0 || (result == 0 && !inclusive)) {
+      left           = &value;
+      left_inclusive = inclusive;
+    }
+  }
+
+  /// @brief 用一个新的上界收紧范围
+  void narrow_right(const Value &value, bool inclusive)
+  {
+    const int result = right == nullptr ? -1 : value.compare(*right);
+    if (result < 0 || (result == 0 && !inclusive)) {
+      right           = &value;
+      right_inclusive = inclusive;
+    }
+  }
+
+  bool is_equal() const
+  {
+    return left != nullptr && right != nullptr && left_inclusive && right_inclusive && left->compare(*right) == 0;
+  }
+};
+
+/**
+ * @brief 可以用于索引扫描的条件：字段 比较 常量
+ */
+struct IndexCondition
+{
+  const char  *field_name = nullptr;
+  CompOp       comp       = NO_OP;
+  const Value *value      = nullptr;
+};
+
+/**
+ * @brief 在一个索引上扫描的范围
+ * @details 组合索引按照最左前缀使用：从第一个字段开始，连续的等值条件组成键值的前缀，
+ * 第一个不是等值条件的字段上如果有范围条件，就作为边界的最后一个字段，后面的字段都不再使用。
+ */
+struct IndexRange
+{
+  Index        *index           = nullptr;
+  vector<Value> left_key;
+  bool          left_inclusive  = true;
+  vector<Value> right_key;
+  bool          right_inclusive = true;
+  int           equal_num       = 0;  ///< 键值前缀中等值条件的个数
+
+  /// @brief 唯一索引的所有字段上都是等值条件，最多一行
+  bool unique_match() const
+  {
+    return index->index_meta().is_unique() && equal_num == index->index_meta().field_num();
+  }
+
+  /// @brief 等值前缀之后的范围条件：0 两端都有边界，1 只有一端边界，2 没有
+  int range_rank() const
+  {
+    const bool has_left  = static_cast<int>(left_key.size()) > equal_num;
+    const bool has_right = static_cast<int>(right_key.size()) > equal_num;
+    if (has_left && has_right) {
+      return 0;
+    }
+    return (has_left || has_right) ? 1 : 2;
+  }
+
+  bool is_hash() const { return index->index_meta().type() == IndexType::HASH; }
+
+  /**
+   * @brief 粗略比较两个扫描范围的代价
+   * @details 唯一索引上的等值查询最多一行，其次是等值条件更多的。等值条件一样多时，还有范围条件的更好，两端都有边界的范围优于只有一端边界的。
+   * 都一样时优先使用哈希索引，等值查找不需要从根节点逐层查找
+   */
+  bool better_than(const IndexRange &other) const
+  {
+    if (unique_match() != other.unique_match()) {
+      return unique_match();
+    }
+    if (equal_num != other.equal_num) {
+      return equal_num > other.equal_num;
+    }
+    if (range_rank() != other.range_rank()) {
+      return range_rank() < other.range_rank();
+    }
+    return is_hash() && !other.is_hash();
+  }
+};
+
+/**
+ * @brief 按照最左前缀计算在索引上扫描的范围
+ * @return 索引的第一个字段上没有可以使用的条件时返回 false。哈希索引只能用于所有字段上的等值条件，否则也返回 false
+ */
+static bool make_index_range(Index *index, const vector<IndexCondition> &conditions, IndexRange &range)
+{
+  const vector<FieldMeta> &field_metas = index->field_metas();
+
+  range.index = index;
+  for (const FieldMeta &field_meta : field_metas) {
+    ColumnRange column;
+    for (const IndexCondition &condition : conditions) {
+      if (0 != strcmp(condition.field_name, field_meta.name())) {
+        continue;
+      }
+      // 组合索引中每个字段的长度是固定的，超长的字符串没法放到键值里，这个条件只在扫描时过滤
+      if (field_metas.size() > 1 && condition.value->attr_type() == AttrType::CHARS &&
+          condition.value->length() > field_meta.len()) {
+        continue;
+      }
+
+      switch (condition.comp) {
+        case EQUAL_TO: {
+          column.narrow_left(*condition.value, true);
+          column.narrow_right(*condition.value, true);
+        } break;
+        case GREAT_THAN: column.narrow_left(*condition.value, false); break;
+        case GREAT_EQUAL: column.narrow_left(*condition.value, true); break;
+        case LESS_THAN: column.narrow_right(*condition.value, false); break;
+        case LESS_EQUAL: column.narrow_right(*condition.value, true); break;
+        default: break;
+      }
+    }
+
+    if (column.is_equal()) {
+      range.left_key.push_back(*column.left);
+      range.right_key.push_back(*column.right);
+      range.equal_num++;
+      continue;
+    }
+
+    if (column.left != nullptr) {
+      range.left_key.push_back(*column.left);
+      range.left_inclusive = column.left_inclusive;
+    }
+    if (column.right != nullptr) {
+      range.right_key.push_back(*column.right);
+      range.right_inclusive = column.right_inclusive;
+    }
+    break;
+  }
+
+  if (range.is_hash()) {
+    return range.equal_num == static_cast<int>(field_metas.size());
+  }
+  return !range.left_key.empty() || !range.right_key.empty();
+}
+
+/**
+ * @brief 从过滤条件中找出可以使用索引的字段，按照最左前缀计算每个索引上的扫描范围，
+ * 再从多个候选的索引中选择代价最小的一个
+ * @details 只考虑 “字段 比较 常量” 形式的条件，并且常量与字段的类型相同。没有可用的索引时 index 为空
+ */
+static void choose_index_range(Table *table, vector<unique_ptr<Expression>> &predicates, IndexRange &best)
+{
+  vector<IndexCondition> conditions;
+  for (auto &expr : predicates) {
+    if (expr->type() != ExprType::COMPARISON) {
+      continue;
+    }
+
+    auto    comparison_expr = static_cast<ComparisonExpr *>(expr.get());
+    CompOp  comp            = comparison_expr->comp();
+    if (comp != EQUAL_TO && comp != LESS_THAN && comp != LESS_EQUAL && comp != GREAT_THAN && comp != GREAT_EQUAL) {
+      continue;
+    }
+
+    unique_ptr<Expression> &left_expr  = comparison_expr->left();
+    unique_ptr<Expression> &right_expr = comparison_expr->right();
+
+    FieldExpr *field_expr = nullptr;
+    ValueExpr *value_expr = nullptr;
+    if (left_expr->type() == ExprType::FIELD && right_expr->type() == ExprType::VALUE) {
+      field_expr = static_cast<FieldExpr *>(left_expr.get());
+      value_expr = static_cast<ValueExpr *>(right_expr.get());
+    } else if (right_expr->type() == ExprType::FIELD && left_expr->type() == ExprType::VALUE) {
+      // 常量在左边时，把比较符号反过来，比如 5 < a 等价于 a > 5
+      field_expr = static_cast<FieldExpr *>(right_expr.get());
+      value_expr = static_cast<ValueExpr *>(left_expr.get());
+      switch (comp) {
+        case LESS_THAN: comp = GREAT_THAN; break;
+        case LESS_EQUAL: comp = GREAT_EQUAL; break;
+        case GREAT_THAN: comp = LESS_THAN; break;
+        case GREAT_EQUAL: comp = LESS_EQUAL; break;
+        default: break;
+      }
+    } else {
+      continue;
+    }
+
+    const Value &value = value_expr->get_value();
+    if (value.attr_type() != field_expr->field().attr_type()) {
+      continue;
+    }
+
+    conditions.push_back(IndexCondition{field_expr->field().field_name(), comp, &value});
+  }
+
+  if (conditions.empty()) {
+    return;
+  }
+
+  for (Index *index : table->indexes()) {
+    IndexRange range;
+    if (make_index_range(index, conditions, range) && (best.index == nullptr || range.better_than(best))) {
+      best = std::move(range);
+    }
+  }
+}
+
+/**
+ * @brief 查询用到的字段是否都在索引中(索引覆盖)
+ * @details 索引中没有记录字段是否为NULL，所以只考虑不能为NULL的字段
+ */
+static bool index_covers(const Index &index, const vector<Field> &fields, vector<unique_ptr<Expression>> &predicates)
+{
+  const vector<FieldMeta> &index_fields = index.field_metas();
+  for (const FieldMeta &field_meta : index_fields) {
+    if (field_meta.nullable()) {
+      return false;
+    }
+  }
+
+  auto in_index = [&index_fields](const char *field_name) {
+    return std::any_of(index_fields.begin(), index_fields.end(), [field_name](const FieldMeta &field_meta) {
+      return 0 == strcmp(field_meta.name(), field_name);
+    });
+  };
+
+  for (const Field &field : fields) {
+    if (!in_index(field.field_name())) {
+      return false;
+    }
+  }
+
+  // 过滤条件用到的字段在生成逻辑计划时已经收集过了，这里再检查一遍，避免改写之后出现新的字段
+  bool covered = true;
+  function<RC(unique_ptr<Expression> &)> checker = [&](unique_ptr<Expression> &expr) -> RC {
+    if (expr->type() == ExprType::FIELD) {
+      covered = covered && in_index(static_cast<FieldExpr *>(expr.get())->field().field_name());
+      return RC::SUCCESS;
+    }
+    return ExpressionIterator::iterate_child_expr(*expr, checker);
+  };
+  for (unique_ptr<Expression> &expr : predicates) {
+    checker(expr);
+  }
+  return covered;
+}
+
+/**
+ * @brief 在索引上扫描时，输出的数据是否已经按照指定的字段排好序了
+ * @details 等值前缀之后的索引字段依次与排序字段相同，排序字段也可以是等值前缀中的字段。
+ * 索引中没有记录字段是否为NULL，所以只考虑不能为NULL的字段。哈希索引的输出没有顺序
+ */
+static bool index_provides_order(const IndexRange &range, const vector<Field> &order_fields)
+{
+  if (range.is_hash()) {
+    return false;
+  }
+
+  const vector<FieldMeta> &index_fields = range.index->field_metas();
+
+  int pos = range.equal_num;
+  for (const Field &field : order_fields) {
+    auto equal_end = index_fields.begin() + range.equal_num;
+    auto iter      = find_if(index_fields.begin(), equal_end, [&field](const FieldMeta &field_meta) {
+      return 0 == strcmp(field_meta.name(), field.field_name());
+    });
+    if (iter != equal_end) {
+      continue;  // 等值条件上的字段都是相同的值
+    }
+
+    if (pos >= static_cast<int>(index_fields.size()) || 0 != strcmp(index_fields[pos].name(), field.field_name()) ||
+        index_fields[pos].nullable()) {
+      return false;
+    }
+    pos++;
+  }
+  return true;
+}
+
+/**
+ * @brief 为 index nested loop join 在右表上选择一个索引
+ * @details 连接条件的右边是右表的字段时可以用于索引查找。从索引的第一个字段开始，依次找到对应的连接条件，
+ * 组成键值的最左前缀，哈希索引需要所有字段上都有连接条件。唯一索引的所有字段都匹配时最多一行，优先选择，
+ * 其次是匹配字段更多的
+ * @param key_indexes 返回用于构造索引键值的连接条件下标，与索引字段的顺序一致
+ * @return 没有可用的索引时返回空
+ */
+static Index *choose_join_index(
+    const Table *table, vector<unique_ptr<Expression>> &join_conditions, vector<int> &key_indexes)
+{
+  auto find_condition = [&join_conditions, table](const FieldMeta &field_meta) -> int {
+    for (size_t i = 0; i < join_conditions.size(); i++) {
+      auto                    comparison_expr = static_cast<ComparisonExpr *>(join_conditions[i].get());
+      unique_ptr<Expression> &right_expr      = comparison_expr->right();
+      if (right_expr->type() != ExprType::FIELD) {
+        continue;
+      }
+      const Field &field = static_cast<FieldExpr *>(right_expr.get())->field();
+      if (field.table() == table && 0 == strcmp(field.field_name(), field_meta.name())) {
+        return static_cast<int>(i);
+      }
+    }
+    return -1;
+  };
+
+  Index *best_index        = nullptr;
+  bool   best_unique_match = false;
+  key_indexes.clear();
+  for (Index *index : table->indexes()) {
+    vector<int> indexes;
+    for (const FieldMeta &field_meta : index->field_metas()) {
+      const int condition_index = find_condition(field_meta);
+      if (condition_index < 0) {
+        break;
+      }
+      indexes.push_back(condition_index);
+    }
+
+    const bool all_fields = indexes.size() == index->field_metas().size();
+    if (indexes.empty() || (index->index_meta().type() == IndexType::HASH && !all_fields)) {
+      continue;
+    }
+
+    const bool unique_match = all_fields && index->index_meta().is_unique();
+    if (best_index == nullptr || (unique_match && !best_unique_match) ||
+        (unique_match == best_unique_match && indexes.size() > key_indexes.size())) {
+      best_index        = index;
+      best_unique_match = unique_match;
+      key_indexes       = std::move(indexes);
+    }
+  }
+  return best_index;
+}
+
 RC PhysicalPlanGenerator::create(LogicalOperator &logical_operator, unique_ptr<PhysicalOperator> &oper)
 {
   RC rc = RC::SUCCESS;
@@ -101,6 +494,10 @@ RC PhysicalPlanGenerator::create(LogicalOperator &logical_operator, unique_ptr<P
       return create_plan(static_cast<OrderLogicalOperator &>(logical_operator), oper);
     } break;
 
+    case LogicalOperatorType::LIMIT: {
+      return create_plan(static_cast<LimitLogicalOperator &>(logical_operator), oper);
+    } break;
+
     default: {
       ASSERT(false, "unknown logical operator type");
       return RC::INVALID_ARGUMENT;
@@ -117,15 +514,24 @@ RC PhysicalPlanGenerator::create_vec(LogicalOperator &logical_operator, unique_p
     case LogicalOperatorType::TABLE_GET: {
       return create_vec_plan(static_cast<TableGetLogicalOperator &>(logical_operator), oper);
     } break;
+    case LogicalOperatorType::PREDICATE: {
+      return create_vec_plan(static_cast<PredicateLogicalOperator &>(logical_operator), oper);
+    } break;
     case LogicalOperatorType::PROJECTION: {
       return create_vec_plan(static_cast<ProjectLogicalOperator &>(logical_operator), oper);
     } break;
     case LogicalOperatorType::GROUP_BY: {
       return create_vec_plan(static_cast<GroupByLogicalOperator &>(logical_operator), oper);
     } break;
+    case LogicalOperatorType::JOIN: {
+      return create_vec_plan(static_cast<JoinLogicalOperator &>(logical_operator), oper);
+    } break;
     case LogicalOperatorType::EXPLAIN: {
       return create_vec_plan(static_cast<ExplainLogicalOperator &>(logical_operator), oper);
     } break;
+    case LogicalOperatorType::LIMIT: {
+      return create_vec_plan(static_cast<LimitLogicalOperator &>(logical_operator), oper);
+    } break;
     default: {
       return RC::INVALID_ARGUMENT;
     }
@@ -141,58 +547,52 @@ RC PhysicalPlanGenerator::create_plan(TableGetLogicalOperator &table_get_oper, u
   // 看看是否有可以用于索引查找的表达式
   Table *table = table_get_oper.table();
 
-  Index     *index      = nullptr;
-  ValueExpr *value_expr = nullptr;
-  for (auto &expr : predicates) {
-    if (expr->type() == ExprType::COMPARISON) {
-      auto comparison_expr = static_cast<ComparisonExpr *>(expr.get());
-      // 简单处理，就找等值查询
-      if (comparison_expr->comp() != EQUAL_TO) {
-        continue;
-      }
-
-      unique_ptr<Expression> &left_expr  = comparison_expr->left();
-      unique_ptr<Expression> &right_expr = comparison_expr->right();
-      // 左右比较的一边最少是一个值
-      if (left_expr->type() != ExprType::VALUE && right_expr->type() != ExprType::VALUE) {
-        continue;
-      }
-
-      FieldExpr *field_expr = nullptr;
-      if (left_expr->type() == ExprType::FIELD) {
-        ASSERT(right_expr->type() == ExprType::VALUE, "right expr should be a value expr while left is field expr");
-        field_expr = static_cast<FieldExpr *>(left_expr.get());
-        value_expr = static_cast<ValueExpr *>(right_expr.get());
-      } else if (right_expr->type() == ExprType::FIELD) {
-        ASSERT(left_expr->type() == ExprType::VALUE, "left expr should be a value expr while right is a field expr");
-        field_expr = static_cast<FieldExpr *>(right_expr.get());
-        value_expr = static_cast<ValueExpr *>(left_expr.get());
-      }
-
-      if (field_expr == nullptr) {
-        continue;
-      }
-
-      const Field &field = field_expr->field();
-      index              = table->find_index_by_field(field.field_name());
-      if (nullptr != index) {
-        break;
+  IndexRange index_range;
+  choose_index_range(table, predicates, index_range);
+
+  // 上层需要排序时，选中的索引刚好有序就按照索引的顺序输出。没有可用的过滤条件时，找一个有序的索引做全范围的扫描
+  const vector<Field> &order_fields = table_get_oper.order_fields();
+  bool                 keep_order   = false;
+  if (!order_fields.empty()) {
+    if (index_range.index != nullptr) {
+      keep_order = index_provides_order(index_range, order_fields);
+    } else {
+      for (Index *index : table->indexes()) {
+        IndexRange range;
+        range.index = index;
+        if (index_provides_order(range, order_fields)) {
+          index_range = std::move(range);
+          keep_order  = true;
+          break;
+        }
       }
     }
   }
 
-  if (index != nullptr) {
-    ASSERT(value_expr != nullptr, "got an index but value expr is null ?");
-
-    const Value               &value           = value_expr->get_value();
+  if (index_range.index != nullptr) {
     IndexScanPhysicalOperator *index_scan_oper = new IndexScanPhysicalOperator(table,
-        index,
+        index_range.index,
         table_get_oper.read_write_mode(),
-        &value,
-        true /*left_inclusive*/,
-        &value,
-        true /*right_inclusive*/);
+        std::move(index_range.left_key),
+        index_range.left_inclusive,
+        std::move(index_range.right_key),
+        index_range.right_inclusive);
+
+    // 只读的查询用到的字段都在索引中时，可以直接使用索引中的值
+    const bool read_only  = table_get_oper.read_write_mode() == ReadWriteMode::READ_ONLY;
+    const bool index_only = read_only && index_covers(*index_range.index, table_get_oper.fields(), predicates);
+    index_scan_oper->set_index_only(index_only);
+
+    // 可能返回多条记录时，先从索引中取出一批RID，按照页面顺序读取记录，批量大小来自会话变量，默认不开启。
+    // 批量读取会打乱索引的顺序，需要保持顺序时不能使用
+    Session *session = Session::current_session();
+    if (keep_order) {
+      index_scan_oper->set_keep_order(!table_get_oper.order_asc() /*reverse*/);
+    } else if (read_only && !index_only && !index_range.unique_match() && session != nullptr) {
+      index_scan_oper->set_rid_batch_size(session->index_scan_batch_size());
+    }
 
+    // 索引只负责缩小扫描范围，所有的条件仍然需要在扫描时过滤
     index_scan_oper->set_predicates(std::move(predicates));
     oper = unique_ptr<PhysicalOperator>(index_scan_oper);
     LOG_TRACE("use index scan");
@@ -351,6 +751,16 @@ RC PhysicalPlanGenerator::create_plan(JoinLogicalOperator &join_oper, unique_ptr
     return RC::INTERNAL;
   }
 
+  if (!join_oper.expressions().empty()) {
+    if (child_opers[1]->type() == LogicalOperatorType::TABLE_GET) {
+      rc = create_index_join_plan(join_oper, oper);
+      if (OB_FAIL(rc) || oper) {
+        return rc;
+      }
+    }
+    return create_hash_join_plan(join_oper, oper);
+  }
+
   unique_ptr<PhysicalOperator> join_physical_oper(new NestedLoopJoinPhysicalOperator);
   for (auto &child_oper : child_opers) {
     unique_ptr<PhysicalOperator> child_physical_oper;
@@ -367,6 +777,90 @@ RC PhysicalPlanGenerator::create_plan(JoinLogicalOperator &join_oper, unique_ptr
   return rc;
 }
 
+RC PhysicalPlanGenerator::create_index_join_plan(JoinLogicalOperator &join_oper, unique_ptr<PhysicalOperator> &oper)
+{
+  vector<unique_ptr<LogicalOperator>> &child_opers    = join_oper.children();
+  auto                                &table_get_oper = static_cast<TableGetLogicalOperator &>(*child_opers[1]);
+  Table                               *table          = table_get_oper.table();
+
+  vector<int> key_indexes;
+  Index      *index = choose_join_index(table, join_oper.expressions(), key_indexes);
+  if (nullptr == index) {
+    return RC::SUCCESS;
+  }
+
+  // 用于索引查找的连接键放在前面，顺序与索引字段一致
+  vector<unique_ptr<Expression>> left_keys;
+  vector<unique_ptr<Expression>> right_keys;
+  split_join_keys(join_oper, left_keys, right_keys);
+
+  vector<unique_ptr<Expression>> ordered_left_keys;
+  vector<unique_ptr<Expression>> ordered_right_keys;
+  for (int key_index : key_indexes) {
+    ordered_left_keys.emplace_back(std::move(left_keys[key_index]));
+    ordered_right_keys.emplace_back(std::move(right_keys[key_index]));
+  }
+  for (size_t i = 0; i < left_keys.size(); i++) {
+    if (left_keys[i]) {
+      ordered_left_keys.emplace_back(std::move(left_keys[i]));
+      ordered_right_keys.emplace_back(std::move(right_keys[i]));
+    }
+  }
+
+  unique_ptr<PhysicalOperator> left_physical_oper;
+  RC                           rc = create(*child_opers[0], left_physical_oper);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to create physical child oper. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  // 键值在每次打开扫描前由连接算子设置
+  vector<unique_ptr<Expression>> &predicates      = table_get_oper.predicates();
+  auto                            index_scan_oper = make_unique<IndexScanPhysicalOperator>(
+      table, index, table_get_oper.read_write_mode(), vector<Value>(), true, vector<Value>(), true);
+  const bool read_only = table_get_oper.read_write_mode() == ReadWriteMode::READ_ONLY;
+  index_scan_oper->set_index_only(read_only && index_covers(*index, table_get_oper.fields(), predicates));
+  index_scan_oper->set_predicates(std::move(predicates));
+
+  const int                    index_key_num = static_cast<int>(key_indexes.size());
+  unique_ptr<PhysicalOperator> join_physical_oper(new IndexNestedLoopJoinPhysicalOperator(
+      std::move(ordered_left_keys), std::move(ordered_right_keys), index_key_num));
+  join_physical_oper->add_child(std::move(left_physical_oper));
+  join_physical_oper->add_child(std::move(index_scan_oper));
+
+  oper = std::move(join_physical_oper);
+  LOG_TRACE("use index nested loop join. index=%s, index key num=%d", index->index_meta().name(), index_key_num);
+  return RC::SUCCESS;
+}
+
+RC PhysicalPlanGenerator::create_hash_join_plan(JoinLogicalOperator &join_oper, unique_ptr<PhysicalOperator> &oper)
+{
+  vector<unique_ptr<Expression>> left_keys;
+  vector<unique_ptr<Expression>> right_keys;
+  split_join_keys(join_oper, left_keys, right_keys);
+
+  vector<unique_ptr<LogicalOperator>> &child_opers = join_oper.children();
+
+  const bool build_left = estimate_pages(*child_opers[0]) <= estimate_pages(*child_opers[1]);
+
+  unique_ptr<PhysicalOperator> join_physical_oper(
+      new HashJoinPhysicalOperator(std::move(left_keys), std::move(right_keys), build_left));
+  for (auto &child_oper : child_opers) {
+    unique_ptr<PhysicalOperator> child_physical_oper;
+    RC                           rc = create(*child_oper, child_physical_oper);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to create physical child oper. rc=%s", strrc(rc));
+      return rc;
+    }
+
+    join_physical_oper->add_child(std::move(child_physical_oper));
+  }
+
+  oper = std::move(join_physical_oper);
+  LOG_TRACE("use hash join. build_left=%d", build_left);
+  return RC::SUCCESS;
+}
+
 RC PhysicalPlanGenerator::create_plan(CalcLogicalOperator &logical_oper, std::unique_ptr<PhysicalOperator> &oper)
 {
   RC rc = RC::SUCCESS;
@@ -376,14 +870,149 @@ RC PhysicalPlanGenerator::create_plan(CalcLogicalOperator &logical_oper, std::un
   return rc;
 }
 
+/**
+ * @brief 找到算子下面获取表数据的算子
+ * @details 中间只能有过滤算子，过滤不会改变数据的顺序
+ */
+static TableGetLogicalOperator *find_table_get(LogicalOperator &oper)
+{
+  LogicalOperator *child_oper = oper.children().empty() ? nullptr : oper.children().front().get();
+  while (child_oper != nullptr && child_oper->type() == LogicalOperatorType::PREDICATE &&
+         child_oper->children().size() == 1) {
+    child_oper = child_oper->children().front().get();
+  }
+  if (child_oper == nullptr || child_oper->type() != LogicalOperatorType::TABLE_GET) {
+    return nullptr;
+  }
+  return static_cast<TableGetLogicalOperator *>(child_oper);
+}
+
+/**
+ * @brief 排序字段都来自下面的一个表并且方向相同时，把期望的顺序告诉获取表数据的算子
+ */
+static void push_order_to_table_get(OrderLogicalOperator &order_oper)
+{
+  TableGetLogicalOperator *table_get = find_table_get(order_oper);
+  if (table_get == nullptr) {
+    return;
+  }
+
+  auto         &table_get_oper = *table_get;
+  vector<Field> order_fields;
+  const bool    asc            = order_oper.OrderUnits().front()->inc_order_;
+  for (const unique_ptr<OrderUnit> &order_unit : order_oper.OrderUnits()) {
+    if (order_unit->inc_order_ != asc || order_unit->field_expr_->type() != ExprType::FIELD) {
+      return;
+    }
+    const Field &field = static_cast<FieldExpr *>(order_unit->field_expr_.get())->field();
+    if (field.table() != table_get_oper.table()) {
+      return;
+    }
+    order_fields.push_back(field);
+  }
+  table_get_oper.set_order(std::move(order_fields), asc);
+}
+
+/**
+ * @brief 物理算子输出的数据是否已经按照索引的顺序排好了
+ */
+static bool keep_index_order(PhysicalOperator &oper)
+{
+  PhysicalOperator *child_oper = &oper;
+  while (child_oper->type() == PhysicalOperatorType::PREDICATE && child_oper->children().size() == 1) {
+    child_oper = child_oper->children().front().get();
+  }
+  return child_oper->type() == PhysicalOperatorType::INDEX_SCAN &&
+         static_cast<IndexScanPhysicalOperator *>(child_oper)->keep_order();
+}
+
+/**
+ * @brief 没有过滤条件，所有的聚合都是 COUNT(*) 或者 COUNT(非空字段) 时，返回要统计行数的表
+ */
+static Table *count_rows_table(GroupByLogicalOperator &group_by_oper)
+{
+  LogicalOperator &child_oper = *group_by_oper.children().front();
+  if (child_oper.type() != LogicalOperatorType::TABLE_GET) {
+    return nullptr;
+  }
+
+  auto &table_get_oper = static_cast<TableGetLogicalOperator &>(child_oper);
+  if (!table_get_oper.predicates().empty()) {
+    return nullptr;
+  }
+
+  for (Expression *expr : group_by_oper.aggregate_expressions()) {
+    auto *aggregate_expr = static_cast<AggregateExpr *>(expr);
+    if (aggregate_expr->aggregate_type() != AggregateExpr::Type::COUNT) {
+      return nullptr;
+    }
+
+    const Expression *child_expr = aggregate_expr->child().get();
+    if (child_expr->type() == ExprType::FIELD) {
+      if (static_cast<const FieldExpr *>(child_expr)->field().meta()->nullable()) {
+        return nullptr;
+      }
+    } else if (child_expr->type() != ExprType::VALUE ||
+               static_cast<const ValueExpr *>(child_expr)->get_value().attr_type() == AttrType::NULLS) {
+      // COUNT(*) 和 COUNT(1) 就是行数，COUNT(NULL) 永远是0
+      return nullptr;
+    }
+  }
+  return table_get_oper.table();
+}
+
+/**
+ * @brief 所有的聚合都是同一个非空字段上的 MIN 或者都是 MAX 时，让获取表数据的算子按照这个字段排序
+ * @details 有序的索引可以提供这个顺序时，第一条可见的记录就是结果，参考 keep_index_order
+ */
+static bool push_min_max_to_table_get(GroupByLogicalOperator &group_by_oper)
+{
+  const FieldExpr    *field_expr = nullptr;
+  AggregateExpr::Type type       = AggregateExpr::Type::MIN;
+  for (Expression *expr : group_by_oper.aggregate_expressions()) {
+    auto *aggregate_expr = static_cast<AggregateExpr *>(expr);
+    if (aggregate_expr->aggregate_type() != AggregateExpr::Type::MIN &&
+        aggregate_expr->aggregate_type() != AggregateExpr::Type::MAX) {
+      return false;
+    }
+    if (aggregate_expr->child()->type() != ExprType::FIELD) {
+      return false;
+    }
+
+    auto *child_expr = static_cast<const FieldExpr *>(aggregate_expr->child().get());
+    if (field_expr == nullptr) {
+      field_expr = child_expr;
+      type       = aggregate_expr->aggregate_type();
+    } else if (!field_expr->equal(*child_expr) || type != aggregate_expr->aggregate_type()) {
+      return false;
+    }
+  }
+
+  TableGetLogicalOperator *table_get_oper = find_table_get(group_by_oper);
+  if (field_expr == nullptr || table_get_oper == nullptr || field_expr->field().table() != table_get_oper->table() ||
+      field_expr->field().meta()->nullable()) {
+    return false;
+  }
+
+  table_get_oper->set_order({field_expr->field()}, type == AggregateExpr::Type::MIN /*asc*/);
+  return true;
+}
+
 RC PhysicalPlanGenerator::create_plan(GroupByLogicalOperator &logical_oper, std::unique_ptr<PhysicalOperator> &oper)
 {
   RC rc = RC::SUCCESS;
 
   vector<unique_ptr<Expression>> &group_by_expressions = logical_oper.group_by_expressions();
   unique_ptr<GroupByPhysicalOperator> group_by_oper;
+  bool                                min_max_pushed = false;
   if (group_by_expressions.empty()) {
-    group_by_oper = make_unique<ScalarGroupByPhysicalOperator>(std::move(logical_oper.aggregate_expressions()));
+    Table *count_table = count_rows_table(logical_oper);
+    min_max_pushed     = count_table == nullptr && push_min_max_to_table_get(logical_oper);
+
+    auto scalar_group_by_oper =
+        make_unique<ScalarGroupByPhysicalOperator>(std::move(logical_oper.aggregate_expressions()));
+    scalar_group_by_oper->set_row_count_table(count_table);
+    group_by_oper = std::move(scalar_group_by_oper);
   } else {
     group_by_oper = make_unique<HashGroupByPhysicalOperator>(std::move(logical_oper.group_by_expressions()),
         std::move(logical_oper.aggregate_expressions()));
@@ -399,6 +1028,14 @@ RC PhysicalPlanGenerator::create_plan(GroupByLogicalOperator &logical_oper, std:
     return rc;
   }
 
+  // 索引按照聚合字段的顺序输出时，MIN/MAX 就是第一条记录，不需要再读后面的数据
+  if (min_max_pushed && keep_index_order(*child_physical_oper)) {
+    auto limit_oper = make_unique<LimitPhysicalOperator>(1 /*limit*/, 0 /*offset*/);
+    limit_oper->add_child(std::move(child_physical_oper));
+    child_physical_oper = std::move(limit_oper);
+    LOG_TRACE("min/max is answered by the first entry of index scan");
+  }
+
   group_by_oper->add_child(std::move(child_physical_oper));
 
   oper = std::move(group_by_oper);
@@ -411,12 +1048,74 @@ RC PhysicalPlanGenerator::create_vec_plan(TableGetLogicalOperator &table_get_ope
   Table *table = table_get_oper.table();
   TableScanVecPhysicalOperator *table_scan_oper = new TableScanVecPhysicalOperator(table, table_get_oper.read_write_mode());
   table_scan_oper->set_predicates(std::move(predicates));
+  table_scan_oper->set_fields(table_get_oper.fields());
   oper = unique_ptr<PhysicalOperator>(table_scan_oper);
   LOG_TRACE("use vectorized table scan");
 
   return RC::SUCCESS;
 }
 
+RC PhysicalPlanGenerator::create_vec_plan(PredicateLogicalOperator &pred_oper, unique_ptr<PhysicalOperator> &oper)
+{
+  vector<unique_ptr<LogicalOperator>> &children_opers = pred_oper.children();
+  ASSERT(children_opers.size() == 1, "predicate logical operator's sub oper number should be 1");
+
+  LogicalOperator &child_oper = *children_opers.front();
+
+  unique_ptr<PhysicalOperator> child_phy_oper;
+  RC                           rc = create_vec(child_oper, child_phy_oper);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to create child operator of predicate(vec) operator. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  vector<unique_ptr<Expression>> &expressions = pred_oper.expressions();
+  ASSERT(expressions.size() == 1, "predicate logical operator's children should be 1");
+
+  unique_ptr<Expression> expression = std::move(expressions.front());
+  oper = unique_ptr<PhysicalOperator>(new PredicateVecPhysicalOperator(std::move(expression)));
+  oper->add_child(std::move(child_phy_oper));
+  return rc;
+}
+
+RC PhysicalPlanGenerator::create_vec_plan(JoinLogicalOperator &join_oper, unique_ptr<PhysicalOperator> &oper)
+{
+  vector<unique_ptr<LogicalOperator>> &child_opers = join_oper.children();
+  if (child_opers.size() != 2) {
+    LOG_WARN("join operator should have 2 children, but have %d", child_opers.size());
+    return RC::INTERNAL;
+  }
+
+  // 向量化执行只支持等值连接
+  if (join_oper.expressions().empty()) {
+    LOG_WARN("vectorized join without equi-join condition is not supported");
+    return RC::INVALID_ARGUMENT;
+  }
+
+  vector<unique_ptr<Expression>> left_keys;
+  vector<unique_ptr<Expression>> right_keys;
+  split_join_keys(join_oper, left_keys, right_keys);
+
+  const bool build_left = estimate_pages(*child_opers[0]) <= estimate_pages(*child_opers[1]);
+
+  unique_ptr<PhysicalOperator> join_physical_oper(
+      new HashJoinVecPhysicalOperator(std::move(left_keys), std::move(right_keys), build_left));
+  for (auto &child_oper : child_opers) {
+    unique_ptr<PhysicalOperator> child_physical_oper;
+    RC                           rc = create_vec(*child_oper, child_physical_oper);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to create physical child oper. rc=%s", strrc(rc));
+      return rc;
+    }
+
+    join_physical_oper->add_child(std::move(child_physical_oper));
+  }
+
+  oper = std::move(join_physical_oper);
+  LOG_TRACE("use vectorized hash join. build_left=%d", build_left);
+  return RC::SUCCESS;
+}
+
 RC PhysicalPlanGenerator::create_vec_plan(GroupByLogicalOperator &logical_oper, unique_ptr<PhysicalOperator> &oper)
 {
   RC rc = RC::SUCCESS;
@@ -513,14 +1212,30 @@ RC PhysicalPlanGenerator::create_plan(OrderLogicalOperator &order_oper, unique_p
   if (!child_opers.empty()) {
     LogicalOperator *child_oper = child_opers.front().get();
 
+    if (!order_oper.OrderUnits().empty()) {
+      push_order_to_table_get(order_oper);
+    }
+
     rc = create(*child_oper, child_phy_oper);
     if (OB_FAIL(rc)) {
       LOG_WARN("failed to create project logical operator's child physical operator. rc=%s", strrc(rc));
       return rc;
     }
+
+    // 索引扫描已经按照需要的顺序输出了，不需要再排序
+    if (keep_index_order(*child_phy_oper)) {
+      oper = std::move(child_phy_oper);
+      LOG_TRACE("order by is satisfied by index scan");
+      return rc;
+    }
   }
 
   auto order_physical_oper = make_unique<OrderPhysicalOperator>(std::move(order_oper.OrderUnits()));
+  // 排序的内存限制来自会话变量 sort_buffer_size，溢出的临时文件放在当前数据库的目录中
+  Session *session = Session::current_session();
+  if (session != nullptr && session->get_current_db() != nullptr) {
+    order_physical_oper->set_sort_buffer(session->sort_buffer_size(), session->get_current_db()->path());
+  }
   if (child_phy_oper) {
     order_physical_oper->add_child(std::move(child_phy_oper));
   }
@@ -529,3 +1244,43 @@ RC PhysicalPlanGenerator::create_plan(OrderLogicalOperator &order_oper, unique_p
   LOG_TRACE("create a order physical operator");
   return rc;
 }
+
+RC PhysicalPlanGenerator::create_plan(LimitLogicalOperator &limit_oper, unique_ptr<PhysicalOperator> &oper)
+{
+  vector<unique_ptr<LogicalOperator>> &child_opers = limit_oper.children();
+  ASSERT(child_opers.size() == 1, "limit logical operator's children should be 1");
+
+  unique_ptr<PhysicalOperator> child_phy_oper;
+  RC                           rc = create(*child_opers.front(), child_phy_oper);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to create limit logical operator's child physical operator. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  // ORDER BY + LIMIT 只需要保留排在最前面的 limit + offset 行，排序算子使用有界堆代替全量排序
+  if (child_phy_oper->type() == PhysicalOperatorType::ORDER_BY) {
+    static_cast<OrderPhysicalOperator *>(child_phy_oper.get())
+        ->set_top_n(static_cast<int64_t>(limit_oper.limit()) + limit_oper.offset());
+  }
+
+  oper = make_unique<LimitPhysicalOperator>(limit_oper.limit(), limit_oper.offset());
+  oper->add_child(std::move(child_phy_oper));
+  return rc;
+}
+
+RC PhysicalPlanGenerator::create_vec_plan(LimitLogicalOperator &limit_oper, unique_ptr<PhysicalOperator> &oper)
+{
+  vector<unique_ptr<LogicalOperator>> &child_opers = limit_oper.children();
+  ASSERT(child_opers.size() == 1, "limit logical operator's children should be 1");
+
+  unique_ptr<PhysicalOperator> child_phy_oper;
+  RC                           rc = create_vec(*child_opers.front(), child_phy_oper);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to create limit logical operator's child physical operator. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  oper = make_unique<LimitVecPhysicalOperator>(limit_oper.limit(), limit_oper.offset());
+  oper->add_child(std::move(child_phy_oper));
+  return rc;
+}
@@ -13,11 +13,15 @@ See the Mulan PSL v2 for more details. */
 //
 
 #include "sql/optimizer/predicate_pushdown_rewriter.h"
+#include "common/lang/algorithm.h"
 #include "common/log/log.h"
 #include "sql/expr/expression.h"
+#include "sql/expr/expression_iterator.h"
 #include "sql/operator/logical_operator.h"
 #include "sql/operator/table_get_logical_operator.h"
 
+using namespace std;
+
 RC PredicatePushdownRewriter::rewrite(std::unique_ptr<LogicalOperator> &oper, bool &change_made)
 {
   RC rc = RC::SUCCESS;
@@ -30,6 +34,14 @@ RC PredicatePushdownRewriter::rewrite(std::unique_ptr<LogicalOperator> &oper, bo
   }
 
   std::unique_ptr<LogicalOperator> &child_oper = oper->children().front();
+  if (child_oper->type() == LogicalOperatorType::JOIN) {
+    std::vector<std::unique_ptr<Expression>> &predicate_oper_exprs = oper->expressions();
+    if (predicate_oper_exprs.size() != 1 || !predicate_oper_exprs.front()) {
+      return rc;
+    }
+    return pushdown_join_conditions(predicate_oper_exprs.front(), *child_oper, change_made);
+  }
+
   if (child_oper->type() != LogicalOperatorType::TABLE_GET) {
     return rc;
   }
@@ -136,3 +148,122 @@ RC PredicatePushdownRewriter::get_exprs_can_pushdown(
   }
   return rc;
 }
+
+RC PredicatePushdownRewriter::pushdown_join_conditions(
+    unique_ptr<Expression> &expr, LogicalOperator &join_oper, bool &change_made)
+{
+  if (expr->type() == ExprType::CONJUNCTION) {
+    auto conjunction_expr = static_cast<ConjunctionExpr *>(expr.get());
+    if (conjunction_expr->conjunction_type() != ConjunctionExpr::Type::AND) {
+      return RC::SUCCESS;
+    }
+
+    vector<unique_ptr<Expression>> &child_exprs = conjunction_expr->children();
+    for (auto iter = child_exprs.begin(); iter != child_exprs.end();) {
+      if (try_pushdown_join_condition(join_oper, *iter)) {
+        change_made = true;
+        iter        = child_exprs.erase(iter);
+      } else {
+        ++iter;
+      }
+    }
+  } else if (try_pushdown_join_condition(join_oper, expr)) {
+    change_made = true;
+    expr.reset();
+  }
+
+  if (!expr || is_empty_predicate(expr)) {
+    // 与下推到 table get 一样，留下一个恒为真的表达式，由 PredicateRewriteRule 删除
+    expr = unique_ptr<Expression>(new ValueExpr(Value((bool)true)));
+  }
+  return RC::SUCCESS;
+}
+
+bool PredicatePushdownRewriter::try_pushdown_join_condition(LogicalOperator &oper, unique_ptr<Expression> &expr)
+{
+  if (oper.type() != LogicalOperatorType::JOIN || oper.children().size() != 2) {
+    return false;
+  }
+
+  if (expr->type() != ExprType::COMPARISON) {
+    return false;
+  }
+
+  auto comparison_expr = static_cast<ComparisonExpr *>(expr.get());
+  if (comparison_expr->comp() != CompOp::EQUAL_TO) {
+    return false;
+  }
+
+  // 连接键按照值做哈希，两边类型不同时（比如 int 和 float）哈希值不一致，不能作为连接键
+  unique_ptr<Expression> &left_expr  = comparison_expr->left();
+  unique_ptr<Expression> &right_expr = comparison_expr->right();
+  if (left_expr->value_type() != right_expr->value_type()) {
+    return false;
+  }
+
+  // 浮点数的相等使用了误差范围，相等的值哈希值可能不同，留给 nested loop join
+  if (left_expr->value_type() == AttrType::FLOATS) {
+    return false;
+  }
+
+  unordered_set<const Table *> left_expr_tables;
+  unordered_set<const Table *> right_expr_tables;
+  collect_tables(*left_expr, left_expr_tables);
+  collect_tables(*right_expr, right_expr_tables);
+  if (left_expr_tables.empty() || right_expr_tables.empty()) {
+    return false;
+  }
+
+  unordered_set<const Table *> left_oper_tables;
+  unordered_set<const Table *> right_oper_tables;
+  collect_tables(*oper.children()[0], left_oper_tables);
+  collect_tables(*oper.children()[1], right_oper_tables);
+
+  auto contains = [](const unordered_set<const Table *> &tables, const unordered_set<const Table *> &sub_tables) {
+    return all_of(sub_tables.begin(), sub_tables.end(), [&tables](const Table *t) { return tables.count(t) > 0; });
+  };
+
+  // 两边引用的表都在同一个子树中，说明这是更下层连接的条件
+  if (contains(left_oper_tables, left_expr_tables) && contains(left_oper_tables, right_expr_tables)) {
+    return try_pushdown_join_condition(*oper.children()[0], expr);
+  }
+  if (contains(right_oper_tables, left_expr_tables) && contains(right_oper_tables, right_expr_tables)) {
+    return try_pushdown_join_condition(*oper.children()[1], expr);
+  }
+
+  if (contains(left_oper_tables, left_expr_tables) && contains(right_oper_tables, right_expr_tables)) {
+    oper.expressions().emplace_back(std::move(expr));
+    return true;
+  }
+
+  if (contains(left_oper_tables, right_expr_tables) && contains(right_oper_tables, left_expr_tables)) {
+    // 保证条件的左边引用的是连接算子的左孩子，右边引用的是右孩子
+    oper.expressions().emplace_back(
+        make_unique<ComparisonExpr>(CompOp::EQUAL_TO, std::move(right_expr), std::move(left_expr)));
+    expr.reset();
+    return true;
+  }
+  return false;
+}
+
+void PredicatePushdownRewriter::collect_tables(LogicalOperator &oper, unordered_set<const Table *> &tables)
+{
+  if (oper.type() == LogicalOperatorType::TABLE_GET) {
+    tables.insert(static_cast<TableGetLogicalOperator &>(oper).table());
+  }
+  for (unique_ptr<LogicalOperator> &child : oper.children()) {
+    collect_tables(*child, tables);
+  }
+}
+
+void PredicatePushdownRewriter::collect_tables(Expression &expr, unordered_set<const Table *> &tables)
+{
+  if (expr.type() == ExprType::FIELD) {
+    tables.insert(static_cast<FieldExpr &>(expr).field().table());
+    return;
+  }
+  ExpressionIterator::iterate_child_expr(expr, [&tables](unique_ptr<Expression> &child) {
+    collect_tables(*child, tables);
+    return RC::SUCCESS;
+  });
+}
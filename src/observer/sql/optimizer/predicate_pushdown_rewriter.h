@@ -14,13 +14,17 @@ See the Mulan PSL v2 for more details. */
 
 #pragma once
 
+#include "common/lang/unordered_set.h"
 #include "sql/optimizer/rewrite_rule.h"
 #include <vector>
 
+class Table;
+
 /**
  * @brief 将一些谓词表达式下推到表数据扫描中
  * @ingroup Rewriter
- * @details 这样可以提前过滤一些数据
+ * @details 这样可以提前过滤一些数据。如果谓词下面是连接算子，会把两表之间的等值条件下推到
+ * 对应的连接算子中作为连接键，以便生成 hash join
  */
 class PredicatePushdownRewriter : public RewriteRule
 {
@@ -34,4 +38,20 @@ private:
   RC get_exprs_can_pushdown(
       std::unique_ptr<Expression> &expr, std::vector<std::unique_ptr<Expression>> &pushdown_exprs);
   bool is_empty_predicate(std::unique_ptr<Expression> &expr);
+
+  /**
+   * @brief 把谓词中的等值连接条件下推到连接算子中
+   * @param expr 谓词表达式，下推出去的子表达式会从中删除
+   * @param join_oper 谓词算子下面的连接算子
+   */
+  RC pushdown_join_conditions(std::unique_ptr<Expression> &expr, LogicalOperator &join_oper, bool &change_made);
+
+  /**
+   * @brief 尝试把一个等值条件放到 oper 所在子树中最深的、能够作为连接键的连接算子上
+   * @return 是否下推成功。下推成功后 expr 就失效了
+   */
+  bool try_pushdown_join_condition(LogicalOperator &oper, std::unique_ptr<Expression> &expr);
+
+  static void collect_tables(LogicalOperator &oper, std::unordered_set<const Table *> &tables);
+  static void collect_tables(Expression &expr, std::unordered_set<const Table *> &tables);
 };
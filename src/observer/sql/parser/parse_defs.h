@@ -109,6 +109,17 @@ struct OrderSqlNode
   Expression *unbound_field_expr_;  // 排序属性
 };
 
+/**
+ * @brief 描述 limit 子句
+ * @ingroup SQLParser
+ * @details 支持 LIMIT count、LIMIT count OFFSET offset 和 LIMIT offset, count 三种写法
+ */
+struct LimitSqlNode
+{
+  int limit  = -1;  ///< 最多返回的行数，-1 表示没有 limit
+  int offset = 0;   ///< 跳过前面的行数
+};
+
 /**
  * @brief 描述一个select语句
  * @ingroup SQLParser
@@ -127,6 +138,7 @@ struct SelectSqlNode
   std::vector<ConditionSqlNode>            conditions;   ///< 查询条件，使用AND串联起来多个条件
   std::vector<std::unique_ptr<Expression>> group_by;     ///< group by clause
   std::vector<OrderSqlNode>                order_sql_nodes;
+  LimitSqlNode                             limit;        ///< limit 子句
 };
 
 /**
@@ -217,6 +229,8 @@ struct CreateIndexSqlNode
   std::string              relation_name;   ///< Relation name
   std::vector<std::string> attribute_names; ///< Attribute name
   bool                     unique;          ///< 支持unique index语句
+  bool                     prefix_compressed = false;  ///< 叶子节点使用前缀压缩
+  std::string              index_type;      ///< USING 指定的索引类型，为空时使用B+树
 };
 
 /**
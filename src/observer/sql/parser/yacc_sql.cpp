@@ -85,6 +85,36 @@
 
 using namespace std;
 
+/**
+ * @brief 读取下一个词法单元，把 LIMIT、OFFSET、COMPRESS 和 USING 从 ID 中识别出来
+ * @details 这几个关键字没有写在 lex_sql.l 中，lex_sql.cpp 保持 flex 生成的原样。
+ * 与 lex_sql.l 一样不区分大小写，只有整个单词相同时才是关键字，比如 limits 仍然是 ID。
+ */
+static int keyword_yylex(YYSTYPE *yylval, YYLTYPE *yylloc, yyscan_t scanner)
+{
+  static const struct
+  {
+    const char *name;
+    int         token;
+  } keywords[] = {{"LIMIT", LIMIT}, {"OFFSET", OFFSET}, {"COMPRESS", COMPRESS}, {"USING", USING}};
+
+  const int token = yylex(yylval, yylloc, scanner);
+  if (token != ID) {
+    return token;
+  }
+
+  for (const auto &keyword : keywords) {
+    if (0 == strcasecmp(yylval->string, keyword.name)) {
+      free(yylval->string);
+      yylval->string = nullptr;
+      return keyword.token;
+    }
+  }
+  return token;
+}
+
+#define yylex keyword_yylex
+
 string token_name(const char *sql_string, YYLTYPE *llocp)
 {
   return string(sql_string + llocp->first_column, llocp->last_column - llocp->first_column + 1);
@@ -122,7 +152,7 @@ UnboundAggregateExpr *create_aggregate_expression(const char *aggregate_name,
 }
 
 
-#line 126 "yacc_sql.cpp"
+#line 156 "yacc_sql.cpp"
 
 # ifndef YY_CAST
 #  ifdef __cplusplus
@@ -217,64 +247,71 @@ enum yysymbol_kind_t
   YYSYMBOL_NULLABLE_SYM = 64,              /* NULLABLE_SYM  */
   YYSYMBOL_ORDER = 65,                     /* ORDER  */
   YYSYMBOL_ASC = 66,                       /* ASC  */
-  YYSYMBOL_NUMBER = 67,                    /* NUMBER  */
-  YYSYMBOL_FLOAT = 68,                     /* FLOAT  */
-  YYSYMBOL_ID = 69,                        /* ID  */
-  YYSYMBOL_SSS = 70,                       /* SSS  */
-  YYSYMBOL_71_ = 71,                       /* '+'  */
-  YYSYMBOL_72_ = 72,                       /* '-'  */
-  YYSYMBOL_73_ = 73,                       /* '*'  */
-  YYSYMBOL_74_ = 74,                       /* '/'  */
-  YYSYMBOL_UMINUS = 75,                    /* UMINUS  */
-  YYSYMBOL_YYACCEPT = 76,                  /* $accept  */
-  YYSYMBOL_commands = 77,                  /* commands  */
-  YYSYMBOL_command_wrapper = 78,           /* command_wrapper  */
-  YYSYMBOL_exit_stmt = 79,                 /* exit_stmt  */
-  YYSYMBOL_help_stmt = 80,                 /* help_stmt  */
-  YYSYMBOL_sync_stmt = 81,                 /* sync_stmt  */
-  YYSYMBOL_begin_stmt = 82,                /* begin_stmt  */
-  YYSYMBOL_commit_stmt = 83,               /* commit_stmt  */
-  YYSYMBOL_rollback_stmt = 84,             /* rollback_stmt  */
-  YYSYMBOL_drop_table_stmt = 85,           /* drop_table_stmt  */
-  YYSYMBOL_show_tables_stmt = 86,          /* show_tables_stmt  */
-  YYSYMBOL_desc_table_stmt = 87,           /* desc_table_stmt  */
-  YYSYMBOL_create_index_stmt = 88,         /* create_index_stmt  */
-  YYSYMBOL_opt_unique = 89,                /* opt_unique  */
-  YYSYMBOL_ID_list = 90,                   /* ID_list  */
-  YYSYMBOL_drop_index_stmt = 91,           /* drop_index_stmt  */
-  YYSYMBOL_create_table_stmt = 92,         /* create_table_stmt  */
-  YYSYMBOL_attr_def_list = 93,             /* attr_def_list  */
-  YYSYMBOL_attr_def = 94,                  /* attr_def  */
-  YYSYMBOL_opt_null = 95,                  /* opt_null  */
-  YYSYMBOL_number = 96,                    /* number  */
-  YYSYMBOL_type = 97,                      /* type  */
-  YYSYMBOL_insert_stmt = 98,               /* insert_stmt  */
-  YYSYMBOL_value_list = 99,                /* value_list  */
-  YYSYMBOL_value = 100,                    /* value  */
-  YYSYMBOL_storage_format = 101,           /* storage_format  */
-  YYSYMBOL_delete_stmt = 102,              /* delete_stmt  */
-  YYSYMBOL_update_stmt = 103,              /* update_stmt  */
-  YYSYMBOL_select_stmt = 104,              /* select_stmt  */
-  YYSYMBOL_opt_order_by = 105,             /* opt_order_by  */
-  YYSYMBOL_order_by_list = 106,            /* order_by_list  */
-  YYSYMBOL_order_by = 107,                 /* order_by  */
-  YYSYMBOL_calc_stmt = 108,                /* calc_stmt  */
-  YYSYMBOL_expression_list = 109,          /* expression_list  */
-  YYSYMBOL_expression = 110,               /* expression  */
-  YYSYMBOL_rel_attr = 111,                 /* rel_attr  */
-  YYSYMBOL_relation = 112,                 /* relation  */
-  YYSYMBOL_table_ref_list = 113,           /* table_ref_list  */
-  YYSYMBOL_comma_ref_list = 114,           /* comma_ref_list  */
-  YYSYMBOL_join_ref_list = 115,            /* join_ref_list  */
-  YYSYMBOL_where = 116,                    /* where  */
-  YYSYMBOL_condition_list = 117,           /* condition_list  */
-  YYSYMBOL_condition = 118,                /* condition  */
-  YYSYMBOL_comp_op = 119,                  /* comp_op  */
-  YYSYMBOL_group_by = 120,                 /* group_by  */
-  YYSYMBOL_load_data_stmt = 121,           /* load_data_stmt  */
-  YYSYMBOL_explain_stmt = 122,             /* explain_stmt  */
-  YYSYMBOL_set_variable_stmt = 123,        /* set_variable_stmt  */
-  YYSYMBOL_opt_semicolon = 124             /* opt_semicolon  */
+  YYSYMBOL_LIMIT = 67,                     /* LIMIT  */
+  YYSYMBOL_OFFSET = 68,                    /* OFFSET  */
+  YYSYMBOL_COMPRESS = 69,                  /* COMPRESS  */
+  YYSYMBOL_USING = 70,                     /* USING  */
+  YYSYMBOL_NUMBER = 71,                    /* NUMBER  */
+  YYSYMBOL_FLOAT = 72,                     /* FLOAT  */
+  YYSYMBOL_ID = 73,                        /* ID  */
+  YYSYMBOL_SSS = 74,                       /* SSS  */
+  YYSYMBOL_75_ = 75,                       /* '+'  */
+  YYSYMBOL_76_ = 76,                       /* '-'  */
+  YYSYMBOL_77_ = 77,                       /* '*'  */
+  YYSYMBOL_78_ = 78,                       /* '/'  */
+  YYSYMBOL_UMINUS = 79,                    /* UMINUS  */
+  YYSYMBOL_YYACCEPT = 80,                  /* $accept  */
+  YYSYMBOL_commands = 81,                  /* commands  */
+  YYSYMBOL_command_wrapper = 82,           /* command_wrapper  */
+  YYSYMBOL_exit_stmt = 83,                 /* exit_stmt  */
+  YYSYMBOL_help_stmt = 84,                 /* help_stmt  */
+  YYSYMBOL_sync_stmt = 85,                 /* sync_stmt  */
+  YYSYMBOL_begin_stmt = 86,                /* begin_stmt  */
+  YYSYMBOL_commit_stmt = 87,               /* commit_stmt  */
+  YYSYMBOL_rollback_stmt = 88,             /* rollback_stmt  */
+  YYSYMBOL_drop_table_stmt = 89,           /* drop_table_stmt  */
+  YYSYMBOL_show_tables_stmt = 90,          /* show_tables_stmt  */
+  YYSYMBOL_desc_table_stmt = 91,           /* desc_table_stmt  */
+  YYSYMBOL_create_index_stmt = 92,         /* create_index_stmt  */
+  YYSYMBOL_opt_index_type = 93,            /* opt_index_type  */
+  YYSYMBOL_opt_unique = 94,                /* opt_unique  */
+  YYSYMBOL_opt_compress = 95,              /* opt_compress  */
+  YYSYMBOL_ID_list = 96,                   /* ID_list  */
+  YYSYMBOL_drop_index_stmt = 97,           /* drop_index_stmt  */
+  YYSYMBOL_create_table_stmt = 98,         /* create_table_stmt  */
+  YYSYMBOL_attr_def_list = 99,             /* attr_def_list  */
+  YYSYMBOL_attr_def = 100,                 /* attr_def  */
+  YYSYMBOL_opt_null = 101,                 /* opt_null  */
+  YYSYMBOL_number = 102,                   /* number  */
+  YYSYMBOL_type = 103,                     /* type  */
+  YYSYMBOL_insert_stmt = 104,              /* insert_stmt  */
+  YYSYMBOL_value_list = 105,               /* value_list  */
+  YYSYMBOL_value = 106,                    /* value  */
+  YYSYMBOL_storage_format = 107,           /* storage_format  */
+  YYSYMBOL_delete_stmt = 108,              /* delete_stmt  */
+  YYSYMBOL_update_stmt = 109,              /* update_stmt  */
+  YYSYMBOL_select_stmt = 110,              /* select_stmt  */
+  YYSYMBOL_opt_order_by = 111,             /* opt_order_by  */
+  YYSYMBOL_opt_limit = 112,                /* opt_limit  */
+  YYSYMBOL_order_by_list = 113,            /* order_by_list  */
+  YYSYMBOL_order_by = 114,                 /* order_by  */
+  YYSYMBOL_calc_stmt = 115,                /* calc_stmt  */
+  YYSYMBOL_expression_list = 116,          /* expression_list  */
+  YYSYMBOL_expression = 117,               /* expression  */
+  YYSYMBOL_rel_attr = 118,                 /* rel_attr  */
+  YYSYMBOL_relation = 119,                 /* relation  */
+  YYSYMBOL_table_ref_list = 120,           /* table_ref_list  */
+  YYSYMBOL_comma_ref_list = 121,           /* comma_ref_list  */
+  YYSYMBOL_join_ref_list = 122,            /* join_ref_list  */
+  YYSYMBOL_where = 123,                    /* where  */
+  YYSYMBOL_condition_list = 124,           /* condition_list  */
+  YYSYMBOL_condition = 125,                /* condition  */
+  YYSYMBOL_comp_op = 126,                  /* comp_op  */
+  YYSYMBOL_group_by = 127,                 /* group_by  */
+  YYSYMBOL_load_data_stmt = 128,           /* load_data_stmt  */
+  YYSYMBOL_explain_stmt = 129,             /* explain_stmt  */
+  YYSYMBOL_set_variable_stmt = 130,        /* set_variable_stmt  */
+  YYSYMBOL_opt_semicolon = 131             /* opt_semicolon  */
 };
 typedef enum yysymbol_kind_t yysymbol_kind_t;
 
@@ -605,19 +642,19 @@ union yyalloc
 /* YYFINAL -- State number of the termination state.  */
 #define YYFINAL  72
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   240
+#define YYLAST   249
 
 /* YYNTOKENS -- Number of terminals.  */
-#define YYNTOKENS  76
+#define YYNTOKENS  80
 /* YYNNTS -- Number of nonterminals.  */
-#define YYNNTS  49
+#define YYNNTS  52
 /* YYNRULES -- Number of rules.  */
-#define YYNRULES  123
+#define YYNRULES  131
 /* YYNSTATES -- Number of states.  */
-#define YYNSTATES  235
+#define YYNSTATES  247
 
 /* YYMAXUTOK -- Last valid token kind.  */
-#define YYMAXUTOK   326
+#define YYMAXUTOK   330
 
 
 /* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
@@ -635,7 +672,7 @@ static const yytype_int8 yytranslate[] =
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
-       2,     2,    73,    71,     2,    72,     2,    74,     2,     2,
+       2,     2,    77,    75,     2,    76,     2,    78,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -663,26 +700,28 @@ static const yytype_int8 yytranslate[] =
       35,    36,    37,    38,    39,    40,    41,    42,    43,    44,
       45,    46,    47,    48,    49,    50,    51,    52,    53,    54,
       55,    56,    57,    58,    59,    60,    61,    62,    63,    64,
-      65,    66,    67,    68,    69,    70,    75
+      65,    66,    67,    68,    69,    70,    71,    72,    73,    74,
+      79
 };
 
 #if YYDEBUG
 /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
 static const yytype_int16 yyrline[] =
 {
-       0,   218,   218,   226,   227,   228,   229,   230,   231,   232,
-     233,   234,   235,   236,   237,   238,   239,   240,   241,   242,
-     243,   244,   245,   249,   255,   260,   266,   272,   278,   284,
-     291,   297,   305,   320,   323,   328,   334,   347,   357,   381,
-     384,   397,   406,   430,   433,   436,   439,   444,   447,   448,
-     449,   450,   451,   454,   471,   474,   485,   498,   503,   507,
-     511,   520,   523,   530,   542,   558,   590,   593,   600,   606,
-     619,   631,   643,   658,   667,   672,   683,   687,   690,   693,
-     696,   699,   703,   708,   714,   718,   727,   736,   745,   754,
-     760,   765,   775,   780,   783,   788,   793,   805,   819,   840,
-     843,   849,   852,   857,   864,   920,   931,   942,   953,   967,
-     968,   969,   970,   971,   972,   973,   974,   980,   983,   989,
-    1002,  1010,  1020,  1021
+       0,   256,   256,   264,   265,   266,   267,   268,   269,   270,
+     271,   272,   273,   274,   275,   276,   277,   278,   279,   280,
+     281,   282,   283,   287,   293,   298,   304,   310,   316,   322,
+     329,   335,   343,   364,   367,   374,   377,   382,   385,   390,
+     396,   409,   419,   443,   446,   459,   468,   492,   495,   498,
+     501,   506,   509,   510,   511,   512,   513,   516,   533,   536,
+     547,   560,   565,   569,   573,   582,   585,   592,   604,   620,
+     657,   660,   667,   670,   675,   681,   690,   696,   709,   721,
+     733,   748,   757,   762,   773,   777,   780,   783,   786,   789,
+     793,   798,   804,   808,   817,   826,   835,   844,   850,   855,
+     865,   870,   873,   878,   883,   895,   909,   930,   933,   939,
+     942,   947,   954,  1010,  1021,  1032,  1043,  1057,  1058,  1059,
+    1060,  1061,  1062,  1063,  1064,  1070,  1073,  1079,  1092,  1100,
+    1110,  1111
 };
 #endif
 
@@ -706,15 +745,16 @@ static const char *const yytname[] =
   "FROM", "WHERE", "AND", "SET", "ON", "LOAD", "DATA", "INFILE", "EXPLAIN",
   "STORAGE", "FORMAT", "EQ", "LT", "GT", "LE", "GE", "NE", "MAX", "MIN",
   "SUM", "AVG", "COUNT", "INNER", "JOIN", "UNIQUE", "IS_SYM", "NOT",
-  "LIKE", "NULL_SYM", "NULLABLE_SYM", "ORDER", "ASC", "NUMBER", "FLOAT",
-  "ID", "SSS", "'+'", "'-'", "'*'", "'/'", "UMINUS", "$accept", "commands",
-  "command_wrapper", "exit_stmt", "help_stmt", "sync_stmt", "begin_stmt",
-  "commit_stmt", "rollback_stmt", "drop_table_stmt", "show_tables_stmt",
-  "desc_table_stmt", "create_index_stmt", "opt_unique", "ID_list",
-  "drop_index_stmt", "create_table_stmt", "attr_def_list", "attr_def",
-  "opt_null", "number", "type", "insert_stmt", "value_list", "value",
-  "storage_format", "delete_stmt", "update_stmt", "select_stmt",
-  "opt_order_by", "order_by_list", "order_by", "calc_stmt",
+  "LIKE", "NULL_SYM", "NULLABLE_SYM", "ORDER", "ASC", "LIMIT", "OFFSET",
+  "COMPRESS", "USING", "NUMBER", "FLOAT", "ID", "SSS", "'+'", "'-'", "'*'",
+  "'/'", "UMINUS", "$accept", "commands", "command_wrapper", "exit_stmt",
+  "help_stmt", "sync_stmt", "begin_stmt", "commit_stmt", "rollback_stmt",
+  "drop_table_stmt", "show_tables_stmt", "desc_table_stmt",
+  "create_index_stmt", "opt_index_type", "opt_unique", "opt_compress",
+  "ID_list", "drop_index_stmt", "create_table_stmt", "attr_def_list",
+  "attr_def", "opt_null", "number", "type", "insert_stmt", "value_list",
+  "value", "storage_format", "delete_stmt", "update_stmt", "select_stmt",
+  "opt_order_by", "opt_limit", "order_by_list", "order_by", "calc_stmt",
   "expression_list", "expression", "rel_attr", "relation",
   "table_ref_list", "comma_ref_list", "join_ref_list", "where",
   "condition_list", "condition", "comp_op", "group_by", "load_data_stmt",
@@ -728,7 +768,7 @@ yysymbol_name (yysymbol_kind_t yysymbol)
 }
 #endif
 
-#define YYPACT_NINF (-157)
+#define YYPACT_NINF (-207)
 
 #define yypact_value_is_default(Yyn) \
   ((Yyn) == YYPACT_NINF)
@@ -742,81 +782,85 @@ yysymbol_name (yysymbol_kind_t yysymbol)
    STATE-NUM.  */
 static const yytype_int16 yypact[] =
 {
-     156,     7,     0,    45,    45,   -50,    13,  -157,    19,    -2,
-     -29,  -157,  -157,  -157,  -157,  -157,   -15,    14,   156,    62,
-      64,  -157,  -157,  -157,  -157,  -157,  -157,  -157,  -157,  -157,
-    -157,  -157,  -157,  -157,  -157,  -157,  -157,  -157,  -157,  -157,
-    -157,     3,  -157,    73,    18,    20,    45,    69,    74,    87,
-      88,    90,  -157,  -157,  -157,    78,  -157,    45,  -157,  -157,
-    -157,    75,  -157,    59,  -157,  -157,    42,    47,    86,    79,
-      85,  -157,  -157,  -157,  -157,   115,    67,  -157,   102,   -13,
-      45,    45,    45,    45,    45,    81,  -157,  -157,    45,    45,
-      45,    45,    45,    82,   118,   117,    89,   -47,    94,    91,
-     116,   106,  -157,     8,    31,    49,    66,    71,  -157,  -157,
-     -60,   -60,  -157,  -157,  -157,    -9,   117,  -157,    99,   140,
-      45,  -157,   130,   -47,  -157,   144,   104,   160,   113,  -157,
-    -157,  -157,  -157,  -157,  -157,    82,   127,   188,   139,   -47,
-     138,   142,   141,  -157,   163,   -47,  -157,   194,  -157,  -157,
-    -157,  -157,  -157,   -14,    91,   185,   187,  -157,    82,   203,
-     143,    82,   189,   -22,  -157,  -157,  -157,  -157,  -157,  -157,
-     147,  -157,    45,    10,    45,   117,   148,   145,   155,  -157,
-    -157,  -157,   160,   167,   150,   181,    45,   217,  -157,   183,
-     -47,   204,   162,  -157,  -157,   -42,   164,  -157,  -157,  -157,
-    -157,  -157,   206,  -157,  -157,   178,  -157,   207,   209,    45,
-    -157,    45,    45,   189,  -157,  -157,  -157,   -37,   184,   150,
-    -157,  -157,  -157,   210,     4,  -157,  -157,  -157,   165,  -157,
-      45,  -157,  -157,  -157,  -157
+     164,     2,     8,    60,    60,   -65,    32,  -207,     7,   -18,
+     -24,  -207,  -207,  -207,  -207,  -207,   -23,    13,   164,    66,
+      64,  -207,  -207,  -207,  -207,  -207,  -207,  -207,  -207,  -207,
+    -207,  -207,  -207,  -207,  -207,  -207,  -207,  -207,  -207,  -207,
+    -207,    37,  -207,    63,    38,    44,    60,   102,   103,   105,
+     106,   108,  -207,  -207,  -207,    97,  -207,    60,  -207,  -207,
+    -207,    18,  -207,    95,  -207,  -207,    70,    72,   112,    98,
+     109,  -207,  -207,  -207,  -207,   133,    80,  -207,   116,     0,
+      60,    60,    60,    60,    60,    83,  -207,  -207,    60,    60,
+      60,    60,    60,    84,   124,   125,    87,   -48,    88,    91,
+     127,    94,  -207,     5,    11,    27,    31,    71,  -207,  -207,
+     -56,   -56,  -207,  -207,  -207,    -2,   125,  -207,   114,   153,
+      60,  -207,   128,   -48,  -207,   140,   113,   163,   117,  -207,
+    -207,  -207,  -207,  -207,  -207,    84,   134,   178,   135,   -48,
+     131,   150,   143,  -207,   168,   -48,  -207,   198,  -207,  -207,
+    -207,  -207,  -207,    -5,    91,   188,   190,  -207,    84,   206,
+     148,    84,   193,     1,  -207,  -207,  -207,  -207,  -207,  -207,
+     154,  -207,    60,    57,    60,   125,   142,   146,   155,  -207,
+    -207,  -207,   163,   175,   147,   182,    60,   218,   156,   185,
+     -48,   209,   167,  -207,  -207,    23,   169,  -207,  -207,  -207,
+    -207,  -207,   211,  -207,  -207,   189,  -207,   212,   215,    60,
+    -207,    60,   146,  -207,    60,   193,  -207,  -207,  -207,   -34,
+     191,   147,   166,  -207,  -207,   217,    -6,   -16,  -207,  -207,
+    -207,   170,  -207,   171,   172,    60,  -207,  -207,   146,   146,
+    -207,  -207,  -207,  -207,  -207,  -207,  -207
 };
 
 /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
    Performed when YYTABLE does not specify something else to do.  Zero
    means the default is an error.  */
-static const yytype_int8 yydefact[] =
+static const yytype_uint8 yydefact[] =
 {
-       0,    33,     0,     0,     0,     0,     0,    25,     0,     0,
+       0,    35,     0,     0,     0,     0,     0,    25,     0,     0,
        0,    26,    27,    28,    24,    23,     0,     0,     0,     0,
-     122,    22,    21,    14,    15,    16,    17,     9,    10,    11,
+     130,    22,    21,    14,    15,    16,    17,     9,    10,    11,
       12,    13,     8,     5,     7,     6,     4,     3,    18,    19,
-      20,     0,    34,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,    57,    58,    59,    90,    60,     0,    84,    82,
-      73,    74,    83,     0,    31,    30,     0,     0,     0,     0,
-       0,   120,     1,   123,     2,     0,     0,    29,     0,     0,
-       0,     0,     0,     0,     0,     0,    56,    76,     0,     0,
-       0,     0,     0,     0,     0,    99,     0,     0,     0,     0,
-       0,     0,    81,     0,     0,     0,     0,     0,    91,    75,
-      77,    78,    79,    80,    92,    95,    99,    93,    94,     0,
-     101,    63,     0,     0,   121,     0,     0,    39,     0,    37,
-      85,    86,    87,    88,    89,     0,     0,   117,     0,     0,
-      82,     0,    83,   100,   102,     0,    56,     0,    48,    49,
-      50,    51,    52,    43,     0,     0,     0,    96,     0,     0,
-      66,     0,    54,     0,   109,   110,   111,   112,   113,   114,
-       0,   115,     0,     0,   101,    99,     0,     0,     0,    45,
-      44,    42,    39,    61,     0,     0,     0,     0,    65,     0,
-       0,     0,     0,   107,   116,   104,     0,   105,   103,    64,
-     119,    47,     0,    46,    40,     0,    38,    35,     0,   101,
-     118,     0,   101,    54,    53,   108,   106,    43,     0,     0,
-      32,    97,    67,    68,    70,    98,    55,    41,     0,    36,
-       0,    72,    71,    62,    69
+      20,     0,    36,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,    61,    62,    63,    98,    64,     0,    92,    90,
+      81,    82,    91,     0,    31,    30,     0,     0,     0,     0,
+       0,   128,     1,   131,     2,     0,     0,    29,     0,     0,
+       0,     0,     0,     0,     0,     0,    60,    84,     0,     0,
+       0,     0,     0,     0,     0,   107,     0,     0,     0,     0,
+       0,     0,    89,     0,     0,     0,     0,     0,    99,    83,
+      85,    86,    87,    88,   100,   103,   107,   101,   102,     0,
+     109,    67,     0,     0,   129,     0,     0,    43,     0,    41,
+      93,    94,    95,    96,    97,     0,     0,   125,     0,     0,
+      90,     0,    91,   108,   110,     0,    60,     0,    52,    53,
+      54,    55,    56,    47,     0,     0,     0,   104,     0,     0,
+      70,     0,    58,     0,   117,   118,   119,   120,   121,   122,
+       0,   123,     0,     0,   109,   107,     0,     0,     0,    49,
+      48,    46,    43,    65,     0,     0,     0,     0,    72,     0,
+       0,     0,     0,   115,   124,   112,     0,   113,   111,    68,
+     127,    51,     0,    50,    44,     0,    42,    39,     0,   109,
+     126,     0,     0,    69,   109,    58,    57,   116,   114,    47,
+       0,     0,    33,   105,    71,    76,    78,    73,   106,    59,
+      45,     0,    40,     0,    37,     0,    80,    79,     0,     0,
+      66,    34,    38,    32,    77,    75,    74
 };
 
 /* YYPGOTO[NTERM-NUM].  */
 static const yytype_int16 yypgoto[] =
 {
-    -157,  -157,   214,  -157,  -157,  -157,  -157,  -157,  -157,  -157,
-    -157,  -157,  -157,  -157,    16,  -157,  -157,    51,    83,    21,
-    -157,  -157,  -157,    23,   -55,  -157,  -157,  -157,  -157,  -157,
-       9,  -157,  -157,    -3,   -46,  -117,  -152,   105,  -157,  -157,
-    -112,  -156,  -157,  -157,  -157,  -157,  -157,  -157,  -157
+    -207,  -207,   221,  -207,  -207,  -207,  -207,  -207,  -207,  -207,
+    -207,  -207,  -207,  -207,  -207,  -207,    19,  -207,  -207,    65,
+      92,    26,  -206,  -207,  -207,    33,   -55,  -207,  -207,  -207,
+    -207,  -207,  -207,    14,  -207,  -207,    -3,   -46,  -117,  -149,
+     107,  -207,  -207,  -112,  -161,  -207,  -207,  -207,  -207,  -207,
+    -207,  -207
 };
 
 /* YYDEFGOTO[NTERM-NUM].  */
 static const yytype_uint8 yydefgoto[] =
 {
        0,    19,    20,    21,    22,    23,    24,    25,    26,    27,
-      28,    29,    30,    43,   208,    31,    32,   155,   127,   181,
-     202,   153,    33,   191,    59,   206,    34,    35,    36,   188,
-     222,   223,    37,    60,    61,    62,   115,   116,   117,   118,
-     121,   143,   144,   172,   160,    38,    39,    40,    74
+      28,    29,    30,   234,    43,   243,   208,    31,    32,   155,
+     127,   181,   202,   153,    33,   191,    59,   206,    34,    35,
+      36,   188,   213,   224,   225,    37,    60,    61,    62,   115,
+     116,   117,   118,   121,   143,   144,   172,   160,    38,    39,
+      40,    74
 };
 
 /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
@@ -824,108 +868,110 @@ static const yytype_uint8 yydefgoto[] =
    number is the opposite.  If YYTABLE_NINF, syntax error.  */
 static const yytype_uint8 yytable[] =
 {
-      79,    63,    86,   142,   137,   177,   185,   102,    44,   189,
-      45,    87,   135,    91,    92,    41,    52,   231,   198,    64,
-      53,    54,    65,    56,   178,   123,   179,   180,   130,    89,
-      90,    91,    92,    67,   103,   104,   105,   106,   107,   192,
-      68,   193,   124,   110,   111,   112,   113,   178,   136,   179,
-     180,   131,    66,   221,    69,    70,   225,   142,    89,    90,
-      91,    92,    72,   199,    46,   140,    42,    73,   146,   132,
-     232,   196,    75,   197,   141,    89,    90,    91,    92,    89,
-      90,    91,    92,    76,   162,   109,   133,    77,    80,    78,
-     175,   134,   142,    81,    93,   142,    88,    47,    48,    49,
-      50,    51,    89,    90,    91,    92,    82,    83,    52,    84,
-      85,    94,    53,    54,    55,    56,    95,    57,    58,   140,
-      89,    90,    91,    92,    96,    97,   195,    98,   141,   148,
-     149,   150,   151,   152,    99,   213,   100,    89,    90,    91,
-      92,   101,    89,    90,    91,    92,    89,    90,    91,    92,
-     108,   114,   119,   120,   140,   128,   138,   140,   122,   139,
-     126,     1,     2,   141,   125,   224,   141,     3,     4,     5,
-       6,     7,     8,     9,    10,   129,   145,   147,    11,    12,
-      13,   154,   156,   210,   224,   158,    14,    15,   164,   165,
-     166,   167,   168,   169,    16,   159,    17,   161,   163,    18,
-     174,   173,   176,   170,   171,   183,   184,   186,   187,   194,
-     190,   205,   201,    89,    90,    91,    92,   200,   203,   207,
-     209,   211,   212,   218,   214,   215,   217,   216,   219,   220,
-     228,   230,    71,   204,   233,   229,   226,   182,   227,   234,
-     157
+      79,    63,    86,   142,   137,   238,   227,   236,    64,   185,
+      41,    87,   189,   198,   177,    52,    44,    67,    45,   135,
+     102,    91,    92,    53,    54,   130,    56,   178,   123,   179,
+     180,   131,   245,   246,   103,   104,   105,   106,   107,    88,
+      66,    65,   124,   110,   111,   112,   113,   132,   223,    68,
+      69,   133,   239,   228,    70,   136,   178,   142,   179,   180,
+     237,    42,   192,   199,   193,   140,    72,    73,   146,    89,
+      90,    91,    92,    76,   141,    89,    90,    91,    92,    46,
+      89,    90,    91,    92,   162,   109,    89,    90,    91,    92,
+     175,   134,   142,    89,    90,    91,    92,   142,    89,    90,
+      91,    92,    89,    90,    91,    92,    89,    90,    91,    92,
+      75,    77,    47,    48,    49,    50,    51,    78,   196,   140,
+     197,    80,    81,    52,    82,    83,   195,    84,   141,    85,
+      93,    53,    54,    55,    56,   215,    57,    58,   148,   149,
+     150,   151,   152,    94,    97,    95,    89,    90,    91,    92,
+      96,    98,    99,   100,   140,   101,   108,   114,   119,   140,
+     122,   120,   125,   141,   126,   226,   128,   129,   141,     1,
+       2,   138,   139,   147,   145,     3,     4,     5,     6,     7,
+       8,     9,    10,   210,   154,   159,    11,    12,    13,   226,
+     156,   163,   158,   161,    14,    15,   164,   165,   166,   167,
+     168,   169,    16,   173,    17,   174,   176,    18,   183,   184,
+     186,   170,   171,   187,   190,   200,   194,   201,   203,   205,
+     207,   209,   211,   212,   214,    89,    90,    91,    92,   216,
+     217,   219,   218,   221,   220,   222,   233,   231,   235,    71,
+     232,   242,   157,   240,   241,   230,   182,   204,   229,   244
 };
 
 static const yytype_uint8 yycheck[] =
 {
-      46,     4,    57,   120,   116,    19,   158,    20,     8,   161,
-      10,    57,    21,    73,    74,     8,    63,    13,   174,    69,
-      67,    68,     9,    70,    61,    72,    63,    64,    20,    71,
-      72,    73,    74,    35,    80,    81,    82,    83,    84,    61,
-      69,    63,    97,    89,    90,    91,    92,    61,    57,    63,
-      64,    20,    33,   209,    69,    41,   212,   174,    71,    72,
-      73,    74,     0,   175,    19,   120,    59,     3,   123,    20,
-      66,    61,    69,    63,   120,    71,    72,    73,    74,    71,
-      72,    73,    74,    10,   139,    88,    20,    69,    19,    69,
-     145,    20,   209,    19,    35,   212,    21,    52,    53,    54,
-      55,    56,    71,    72,    73,    74,    19,    19,    63,    19,
-      32,    69,    67,    68,    69,    70,    69,    72,    73,   174,
-      71,    72,    73,    74,    38,    46,   172,    42,   174,    25,
-      26,    27,    28,    29,    19,   190,    69,    71,    72,    73,
-      74,    39,    71,    72,    73,    74,    71,    72,    73,    74,
-      69,    69,    34,    36,   209,    39,    57,   212,    69,    19,
-      69,     5,     6,   209,    70,   211,   212,    11,    12,    13,
-      14,    15,    16,    17,    18,    69,    46,    33,    22,    23,
-      24,    21,    69,   186,   230,    58,    30,    31,    46,    47,
-      48,    49,    50,    51,    38,     7,    40,    58,    60,    43,
-      37,    60,     8,    61,    62,    20,    19,     4,    65,    62,
-      21,    44,    67,    71,    72,    73,    74,    69,    63,    69,
-      39,     4,    39,    45,    20,    63,    20,    63,    21,    20,
-      46,    21,    18,   182,    69,   219,   213,   154,   217,   230,
-     135
+      46,     4,    57,   120,   116,    21,   212,    13,    73,   158,
+       8,    57,   161,   174,    19,    63,     8,    35,    10,    21,
+      20,    77,    78,    71,    72,    20,    74,    61,    76,    63,
+      64,    20,   238,   239,    80,    81,    82,    83,    84,    21,
+      33,     9,    97,    89,    90,    91,    92,    20,   209,    73,
+      73,    20,    68,   214,    41,    57,    61,   174,    63,    64,
+      66,    59,    61,   175,    63,   120,     0,     3,   123,    75,
+      76,    77,    78,    10,   120,    75,    76,    77,    78,    19,
+      75,    76,    77,    78,   139,    88,    75,    76,    77,    78,
+     145,    20,   209,    75,    76,    77,    78,   214,    75,    76,
+      77,    78,    75,    76,    77,    78,    75,    76,    77,    78,
+      73,    73,    52,    53,    54,    55,    56,    73,    61,   174,
+      63,    19,    19,    63,    19,    19,   172,    19,   174,    32,
+      35,    71,    72,    73,    74,   190,    76,    77,    25,    26,
+      27,    28,    29,    73,    46,    73,    75,    76,    77,    78,
+      38,    42,    19,    73,   209,    39,    73,    73,    34,   214,
+      73,    36,    74,   209,    73,   211,    39,    73,   214,     5,
+       6,    57,    19,    33,    46,    11,    12,    13,    14,    15,
+      16,    17,    18,   186,    21,     7,    22,    23,    24,   235,
+      73,    60,    58,    58,    30,    31,    46,    47,    48,    49,
+      50,    51,    38,    60,    40,    37,     8,    43,    20,    19,
+       4,    61,    62,    65,    21,    73,    62,    71,    63,    44,
+      73,    39,     4,    67,    39,    75,    76,    77,    78,    20,
+      63,    20,    63,    21,    45,    20,    70,    46,    21,    18,
+     221,    69,   135,    73,    73,   219,   154,   182,   215,   235
 };
 
 /* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
    state STATE-NUM.  */
-static const yytype_int8 yystos[] =
+static const yytype_uint8 yystos[] =
 {
        0,     5,     6,    11,    12,    13,    14,    15,    16,    17,
-      18,    22,    23,    24,    30,    31,    38,    40,    43,    77,
-      78,    79,    80,    81,    82,    83,    84,    85,    86,    87,
-      88,    91,    92,    98,   102,   103,   104,   108,   121,   122,
-     123,     8,    59,    89,     8,    10,    19,    52,    53,    54,
-      55,    56,    63,    67,    68,    69,    70,    72,    73,   100,
-     109,   110,   111,   109,    69,     9,    33,    35,    69,    69,
-      41,    78,     0,     3,   124,    69,    10,    69,    69,   110,
-      19,    19,    19,    19,    19,    32,   100,   110,    21,    71,
-      72,    73,    74,    35,    69,    69,    38,    46,    42,    19,
-      69,    39,    20,   110,   110,   110,   110,   110,    69,   109,
-     110,   110,   110,   110,    69,   112,   113,   114,   115,    34,
-      36,   116,    69,    72,   100,    70,    69,    94,    39,    69,
-      20,    20,    20,    20,    20,    21,    57,   116,    57,    19,
-     100,   110,   111,   117,   118,    46,   100,    33,    25,    26,
-      27,    28,    29,    97,    21,    93,    69,   113,    58,     7,
-     120,    58,   100,    60,    46,    47,    48,    49,    50,    51,
-      61,    62,   119,    60,    37,   100,     8,    19,    61,    63,
-      64,    95,    94,    20,    19,   112,     4,    65,   105,   112,
-      21,    99,    61,    63,    62,   110,    61,    63,   117,   116,
-      69,    67,    96,    63,    93,    44,   101,    69,    90,    39,
-     109,     4,    39,   100,    20,    63,    63,    20,    45,    21,
-      20,   117,   106,   107,   110,   117,    99,    95,    46,    90,
-      21,    13,    66,    69,   106
+      18,    22,    23,    24,    30,    31,    38,    40,    43,    81,
+      82,    83,    84,    85,    86,    87,    88,    89,    90,    91,
+      92,    97,    98,   104,   108,   109,   110,   115,   128,   129,
+     130,     8,    59,    94,     8,    10,    19,    52,    53,    54,
+      55,    56,    63,    71,    72,    73,    74,    76,    77,   106,
+     116,   117,   118,   116,    73,     9,    33,    35,    73,    73,
+      41,    82,     0,     3,   131,    73,    10,    73,    73,   117,
+      19,    19,    19,    19,    19,    32,   106,   117,    21,    75,
+      76,    77,    78,    35,    73,    73,    38,    46,    42,    19,
+      73,    39,    20,   117,   117,   117,   117,   117,    73,   116,
+     117,   117,   117,   117,    73,   119,   120,   121,   122,    34,
+      36,   123,    73,    76,   106,    74,    73,   100,    39,    73,
+      20,    20,    20,    20,    20,    21,    57,   123,    57,    19,
+     106,   117,   118,   124,   125,    46,   106,    33,    25,    26,
+      27,    28,    29,   103,    21,    99,    73,   120,    58,     7,
+     127,    58,   106,    60,    46,    47,    48,    49,    50,    51,
+      61,    62,   126,    60,    37,   106,     8,    19,    61,    63,
+      64,   101,   100,    20,    19,   119,     4,    65,   111,   119,
+      21,   105,    61,    63,    62,   117,    61,    63,   124,   123,
+      73,    71,   102,    63,    99,    44,   107,    73,    96,    39,
+     116,     4,    67,   112,    39,   106,    20,    63,    63,    20,
+      45,    21,    20,   124,   113,   114,   117,   102,   124,   105,
+     101,    46,    96,    70,    93,    21,    13,    66,    21,    68,
+      73,    73,    69,    95,   113,   102,   102
 };
 
 /* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
-static const yytype_int8 yyr1[] =
+static const yytype_uint8 yyr1[] =
 {
-       0,    76,    77,    78,    78,    78,    78,    78,    78,    78,
-      78,    78,    78,    78,    78,    78,    78,    78,    78,    78,
-      78,    78,    78,    79,    80,    81,    82,    83,    84,    85,
-      86,    87,    88,    89,    89,    90,    90,    91,    92,    93,
-      93,    94,    94,    95,    95,    95,    95,    96,    97,    97,
-      97,    97,    97,    98,    99,    99,   100,   100,   100,   100,
-     100,   101,   101,   102,   103,   104,   105,   105,   106,   106,
-     107,   107,   107,   108,   109,   109,   110,   110,   110,   110,
-     110,   110,   110,   110,   110,   110,   110,   110,   110,   110,
-     111,   111,   112,   113,   113,   114,   114,   115,   115,   116,
-     116,   117,   117,   117,   118,   118,   118,   118,   118,   119,
-     119,   119,   119,   119,   119,   119,   119,   120,   120,   121,
-     122,   123,   124,   124
+       0,    80,    81,    82,    82,    82,    82,    82,    82,    82,
+      82,    82,    82,    82,    82,    82,    82,    82,    82,    82,
+      82,    82,    82,    83,    84,    85,    86,    87,    88,    89,
+      90,    91,    92,    93,    93,    94,    94,    95,    95,    96,
+      96,    97,    98,    99,    99,   100,   100,   101,   101,   101,
+     101,   102,   103,   103,   103,   103,   103,   104,   105,   105,
+     106,   106,   106,   106,   106,   107,   107,   108,   109,   110,
+     111,   111,   112,   112,   112,   112,   113,   113,   114,   114,
+     114,   115,   116,   116,   117,   117,   117,   117,   117,   117,
+     117,   117,   117,   117,   117,   117,   117,   117,   118,   118,
+     119,   120,   120,   121,   121,   122,   122,   123,   123,   124,
+     124,   124,   125,   125,   125,   125,   125,   126,   126,   126,
+     126,   126,   126,   126,   126,   127,   127,   128,   129,   130,
+     131,   131
 };
 
 /* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
@@ -934,16 +980,17 @@ static const yytype_int8 yyr2[] =
        0,     2,     2,     1,     1,     1,     1,     1,     1,     1,
        1,     1,     1,     1,     1,     1,     1,     1,     1,     1,
        1,     1,     1,     1,     1,     1,     1,     1,     1,     3,
-       2,     2,     9,     0,     1,     1,     3,     5,     8,     0,
-       3,     6,     3,     0,     1,     1,     2,     1,     1,     1,
-       1,     1,     1,     8,     0,     3,     2,     1,     1,     1,
-       1,     0,     4,     4,     7,     7,     0,     3,     1,     3,
-       1,     2,     2,     2,     1,     3,     2,     3,     3,     3,
-       3,     3,     1,     1,     1,     4,     4,     4,     4,     4,
-       1,     3,     1,     1,     1,     1,     3,     6,     6,     0,
-       2,     0,     1,     3,     3,     3,     4,     3,     4,     1,
-       1,     1,     1,     1,     1,     1,     2,     0,     3,     7,
-       2,     4,     0,     1
+       2,     2,    11,     0,     2,     0,     1,     0,     1,     1,
+       3,     5,     8,     0,     3,     6,     3,     0,     1,     1,
+       2,     1,     1,     1,     1,     1,     1,     8,     0,     3,
+       2,     1,     1,     1,     1,     0,     4,     4,     7,     8,
+       0,     3,     0,     2,     4,     4,     1,     3,     1,     2,
+       2,     2,     1,     3,     2,     3,     3,     3,     3,     3,
+       1,     1,     1,     4,     4,     4,     4,     4,     1,     3,
+       1,     1,     1,     1,     3,     6,     6,     0,     2,     0,
+       1,     3,     3,     3,     4,     3,     4,     1,     1,     1,
+       1,     1,     1,     1,     2,     0,     3,     7,     2,     4,
+       0,     1
 };
 
 
@@ -1805,135 +1852,172 @@ yyreduce:
   switch (yyn)
     {
   case 2: /* commands: command_wrapper opt_semicolon  */
-#line 219 "yacc_sql.y"
+#line 257 "yacc_sql.y"
   {
     std::unique_ptr<ParsedSqlNode> sql_node = std::unique_ptr<ParsedSqlNode>((yyvsp[-1].sql_node));
     sql_result->add_sql_node(std::move(sql_node));
   }
-#line 1814 "yacc_sql.cpp"
+#line 1861 "yacc_sql.cpp"
     break;
 
   case 23: /* exit_stmt: EXIT  */
-#line 249 "yacc_sql.y"
+#line 287 "yacc_sql.y"
          {
       (void)yynerrs;  // 这么写为了消除yynerrs未使用的告警。如果你有更好的方法欢迎提PR
       (yyval.sql_node) = new ParsedSqlNode(SCF_EXIT);
     }
-#line 1823 "yacc_sql.cpp"
+#line 1870 "yacc_sql.cpp"
     break;
 
   case 24: /* help_stmt: HELP  */
-#line 255 "yacc_sql.y"
+#line 293 "yacc_sql.y"
          {
       (yyval.sql_node) = new ParsedSqlNode(SCF_HELP);
     }
-#line 1831 "yacc_sql.cpp"
+#line 1878 "yacc_sql.cpp"
     break;
 
   case 25: /* sync_stmt: SYNC  */
-#line 260 "yacc_sql.y"
+#line 298 "yacc_sql.y"
          {
       (yyval.sql_node) = new ParsedSqlNode(SCF_SYNC);
     }
-#line 1839 "yacc_sql.cpp"
+#line 1886 "yacc_sql.cpp"
     break;
 
   case 26: /* begin_stmt: TRX_BEGIN  */
-#line 266 "yacc_sql.y"
+#line 304 "yacc_sql.y"
                {
       (yyval.sql_node) = new ParsedSqlNode(SCF_BEGIN);
     }
-#line 1847 "yacc_sql.cpp"
+#line 1894 "yacc_sql.cpp"
     break;
 
   case 27: /* commit_stmt: TRX_COMMIT  */
-#line 272 "yacc_sql.y"
+#line 310 "yacc_sql.y"
                {
       (yyval.sql_node) = new ParsedSqlNode(SCF_COMMIT);
     }
-#line 1855 "yacc_sql.cpp"
+#line 1902 "yacc_sql.cpp"
     break;
 
   case 28: /* rollback_stmt: TRX_ROLLBACK  */
-#line 278 "yacc_sql.y"
+#line 316 "yacc_sql.y"
                   {
       (yyval.sql_node) = new ParsedSqlNode(SCF_ROLLBACK);
     }
-#line 1863 "yacc_sql.cpp"
+#line 1910 "yacc_sql.cpp"
     break;
 
   case 29: /* drop_table_stmt: DROP TABLE ID  */
-#line 284 "yacc_sql.y"
+#line 322 "yacc_sql.y"
                   {
       (yyval.sql_node) = new ParsedSqlNode(SCF_DROP_TABLE);
       (yyval.sql_node)->drop_table.relation_name = (yyvsp[0].string);
       free((yyvsp[0].string));
     }
-#line 1873 "yacc_sql.cpp"
+#line 1920 "yacc_sql.cpp"
     break;
 
   case 30: /* show_tables_stmt: SHOW TABLES  */
-#line 291 "yacc_sql.y"
+#line 329 "yacc_sql.y"
                 {
       (yyval.sql_node) = new ParsedSqlNode(SCF_SHOW_TABLES);
     }
-#line 1881 "yacc_sql.cpp"
+#line 1928 "yacc_sql.cpp"
     break;
 
   case 31: /* desc_table_stmt: DESC ID  */
-#line 297 "yacc_sql.y"
+#line 335 "yacc_sql.y"
              {
       (yyval.sql_node) = new ParsedSqlNode(SCF_DESC_TABLE);
       (yyval.sql_node)->desc_table.relation_name = (yyvsp[0].string);
       free((yyvsp[0].string));
     }
-#line 1891 "yacc_sql.cpp"
+#line 1938 "yacc_sql.cpp"
     break;
 
-  case 32: /* create_index_stmt: CREATE opt_unique INDEX ID ON ID LBRACE ID_list RBRACE  */
-#line 306 "yacc_sql.y"
+  case 32: /* create_index_stmt: CREATE opt_unique INDEX ID ON ID LBRACE ID_list RBRACE opt_index_type opt_compress  */
+#line 344 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_CREATE_INDEX);
       CreateIndexSqlNode &create_index = (yyval.sql_node)->create_index;
-      create_index.unique = (yyvsp[-7].bools);
-      create_index.index_name = (yyvsp[-5].string);
-      create_index.relation_name = (yyvsp[-3].string);
-      create_index.attribute_names.swap(*(yyvsp[-1].id_list));
+      create_index.unique = (yyvsp[-9].bools);
+      create_index.prefix_compressed = (yyvsp[0].bools);
+      create_index.index_name = (yyvsp[-7].string);
+      create_index.relation_name = (yyvsp[-5].string);
+      create_index.attribute_names.swap(*(yyvsp[-3].id_list));
+      if ((yyvsp[-1].string) != nullptr) {
+        create_index.index_type = (yyvsp[-1].string);
+        free((yyvsp[-1].string));
+      }
+      free((yyvsp[-7].string));
       free((yyvsp[-5].string));
-      free((yyvsp[-3].string));
-      delete (yyvsp[-1].id_list);
+      delete (yyvsp[-3].id_list);
     }
-#line 1907 "yacc_sql.cpp"
+#line 1959 "yacc_sql.cpp"
     break;
 
-  case 33: /* opt_unique: %empty  */
-#line 320 "yacc_sql.y"
+  case 33: /* opt_index_type: %empty  */
+#line 364 "yacc_sql.y"
+    {
+      (yyval.string) = nullptr;
+    }
+#line 1967 "yacc_sql.cpp"
+    break;
+
+  case 34: /* opt_index_type: USING ID  */
+#line 368 "yacc_sql.y"
+    {
+      (yyval.string) = (yyvsp[0].string);
+    }
+#line 1975 "yacc_sql.cpp"
+    break;
+
+  case 35: /* opt_unique: %empty  */
+#line 374 "yacc_sql.y"
     {
       (yyval.bools) = false;
     }
-#line 1915 "yacc_sql.cpp"
+#line 1983 "yacc_sql.cpp"
     break;
 
-  case 34: /* opt_unique: UNIQUE  */
-#line 323 "yacc_sql.y"
+  case 36: /* opt_unique: UNIQUE  */
+#line 377 "yacc_sql.y"
              {
       (yyval.bools) = true;
     }
-#line 1923 "yacc_sql.cpp"
+#line 1991 "yacc_sql.cpp"
     break;
 
-  case 35: /* ID_list: ID  */
-#line 329 "yacc_sql.y"
+  case 37: /* opt_compress: %empty  */
+#line 382 "yacc_sql.y"
+    {
+      (yyval.bools) = false;
+    }
+#line 1999 "yacc_sql.cpp"
+    break;
+
+  case 38: /* opt_compress: COMPRESS  */
+#line 385 "yacc_sql.y"
+               {
+      (yyval.bools) = true;
+    }
+#line 2007 "yacc_sql.cpp"
+    break;
+
+  case 39: /* ID_list: ID  */
+#line 391 "yacc_sql.y"
     {
       (yyval.id_list) = new std::vector<std::string>;
       (yyval.id_list)->emplace_back((yyvsp[0].string));
       free((yyvsp[0].string));
     }
-#line 1933 "yacc_sql.cpp"
+#line 2017 "yacc_sql.cpp"
     break;
 
-  case 36: /* ID_list: ID COMMA ID_list  */
-#line 335 "yacc_sql.y"
+  case 40: /* ID_list: ID COMMA ID_list  */
+#line 397 "yacc_sql.y"
     {
       if ((yyvsp[0].id_list) != nullptr) {
         (yyval.id_list) = (yyvsp[0].id_list);
@@ -1943,11 +2027,11 @@ yyreduce:
       (yyval.id_list)->emplace((yyval.id_list)->begin(), (yyvsp[-2].string));
       free((yyvsp[-2].string));
     }
-#line 1947 "yacc_sql.cpp"
+#line 2031 "yacc_sql.cpp"
     break;
 
-  case 37: /* drop_index_stmt: DROP INDEX ID ON ID  */
-#line 348 "yacc_sql.y"
+  case 41: /* drop_index_stmt: DROP INDEX ID ON ID  */
+#line 410 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_DROP_INDEX);
       (yyval.sql_node)->drop_index.index_name = (yyvsp[-2].string);
@@ -1955,11 +2039,11 @@ yyreduce:
       free((yyvsp[-2].string));
       free((yyvsp[0].string));
     }
-#line 1959 "yacc_sql.cpp"
+#line 2043 "yacc_sql.cpp"
     break;
 
-  case 38: /* create_table_stmt: CREATE TABLE ID LBRACE attr_def attr_def_list RBRACE storage_format  */
-#line 358 "yacc_sql.y"
+  case 42: /* create_table_stmt: CREATE TABLE ID LBRACE attr_def attr_def_list RBRACE storage_format  */
+#line 420 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_CREATE_TABLE);
       CreateTableSqlNode &create_table = (yyval.sql_node)->create_table;
@@ -1980,19 +2064,19 @@ yyreduce:
         free((yyvsp[0].string));
       }
     }
-#line 1984 "yacc_sql.cpp"
+#line 2068 "yacc_sql.cpp"
     break;
 
-  case 39: /* attr_def_list: %empty  */
-#line 381 "yacc_sql.y"
+  case 43: /* attr_def_list: %empty  */
+#line 443 "yacc_sql.y"
     {
       (yyval.attr_infos) = nullptr;
     }
-#line 1992 "yacc_sql.cpp"
+#line 2076 "yacc_sql.cpp"
     break;
 
-  case 40: /* attr_def_list: COMMA attr_def attr_def_list  */
-#line 385 "yacc_sql.y"
+  case 44: /* attr_def_list: COMMA attr_def attr_def_list  */
+#line 447 "yacc_sql.y"
     {
       if ((yyvsp[0].attr_infos) != nullptr) {
         (yyval.attr_infos) = (yyvsp[0].attr_infos);
@@ -2002,11 +2086,11 @@ yyreduce:
       (yyval.attr_infos)->emplace_back(*(yyvsp[-1].attr_info));
       delete (yyvsp[-1].attr_info);
     }
-#line 2006 "yacc_sql.cpp"
+#line 2090 "yacc_sql.cpp"
     break;
 
-  case 41: /* attr_def: ID type LBRACE number RBRACE opt_null  */
-#line 398 "yacc_sql.y"
+  case 45: /* attr_def: ID type LBRACE number RBRACE opt_null  */
+#line 460 "yacc_sql.y"
     {
       (yyval.attr_info) = new AttrInfoSqlNode;
       (yyval.attr_info)->type = (AttrType)(yyvsp[-4].number);
@@ -2015,11 +2099,11 @@ yyreduce:
       (yyval.attr_info)->nullable = (yyvsp[0].bools);
       free((yyvsp[-5].string));
     }
-#line 2019 "yacc_sql.cpp"
+#line 2103 "yacc_sql.cpp"
     break;
 
-  case 42: /* attr_def: ID type opt_null  */
-#line 407 "yacc_sql.y"
+  case 46: /* attr_def: ID type opt_null  */
+#line 469 "yacc_sql.y"
     {
       (yyval.attr_info) = new AttrInfoSqlNode;
       (yyval.attr_info)->type = (AttrType)(yyvsp[-1].number);
@@ -2041,79 +2125,79 @@ yyreduce:
       (yyval.attr_info)->nullable = (yyvsp[0].bools);
       free((yyvsp[-2].string));
     }
-#line 2045 "yacc_sql.cpp"
+#line 2129 "yacc_sql.cpp"
     break;
 
-  case 43: /* opt_null: %empty  */
-#line 430 "yacc_sql.y"
+  case 47: /* opt_null: %empty  */
+#line 492 "yacc_sql.y"
     {
       (yyval.bools) = false;
     }
-#line 2053 "yacc_sql.cpp"
+#line 2137 "yacc_sql.cpp"
     break;
 
-  case 44: /* opt_null: NULLABLE_SYM  */
-#line 433 "yacc_sql.y"
+  case 48: /* opt_null: NULLABLE_SYM  */
+#line 495 "yacc_sql.y"
                    {
       (yyval.bools) = true;
     }
-#line 2061 "yacc_sql.cpp"
+#line 2145 "yacc_sql.cpp"
     break;
 
-  case 45: /* opt_null: NULL_SYM  */
-#line 436 "yacc_sql.y"
+  case 49: /* opt_null: NULL_SYM  */
+#line 498 "yacc_sql.y"
                {
       (yyval.bools) = true;
     }
-#line 2069 "yacc_sql.cpp"
+#line 2153 "yacc_sql.cpp"
     break;
 
-  case 46: /* opt_null: NOT NULL_SYM  */
-#line 439 "yacc_sql.y"
+  case 50: /* opt_null: NOT NULL_SYM  */
+#line 501 "yacc_sql.y"
                    {
       (yyval.bools) = false;
     }
-#line 2077 "yacc_sql.cpp"
+#line 2161 "yacc_sql.cpp"
     break;
 
-  case 47: /* number: NUMBER  */
-#line 444 "yacc_sql.y"
+  case 51: /* number: NUMBER  */
+#line 506 "yacc_sql.y"
            {(yyval.number) = (yyvsp[0].number);}
-#line 2083 "yacc_sql.cpp"
+#line 2167 "yacc_sql.cpp"
     break;
 
-  case 48: /* type: INT_T  */
-#line 447 "yacc_sql.y"
+  case 52: /* type: INT_T  */
+#line 509 "yacc_sql.y"
                { (yyval.number) = static_cast<int>(AttrType::INTS); }
-#line 2089 "yacc_sql.cpp"
+#line 2173 "yacc_sql.cpp"
     break;
 
-  case 49: /* type: STRING_T  */
-#line 448 "yacc_sql.y"
+  case 53: /* type: STRING_T  */
+#line 510 "yacc_sql.y"
                { (yyval.number) = static_cast<int>(AttrType::CHARS); }
-#line 2095 "yacc_sql.cpp"
+#line 2179 "yacc_sql.cpp"
     break;
 
-  case 50: /* type: FLOAT_T  */
-#line 449 "yacc_sql.y"
+  case 54: /* type: FLOAT_T  */
+#line 511 "yacc_sql.y"
                { (yyval.number) = static_cast<int>(AttrType::FLOATS); }
-#line 2101 "yacc_sql.cpp"
+#line 2185 "yacc_sql.cpp"
     break;
 
-  case 51: /* type: DATE_T  */
-#line 450 "yacc_sql.y"
+  case 55: /* type: DATE_T  */
+#line 512 "yacc_sql.y"
               { (yyval.number) = static_cast<int>(AttrType::DATES); }
-#line 2107 "yacc_sql.cpp"
+#line 2191 "yacc_sql.cpp"
     break;
 
-  case 52: /* type: TEXT_T  */
-#line 451 "yacc_sql.y"
+  case 56: /* type: TEXT_T  */
+#line 513 "yacc_sql.y"
              { (yyval.number) = static_cast<int>(AttrType::TEXTS); }
-#line 2113 "yacc_sql.cpp"
+#line 2197 "yacc_sql.cpp"
     break;
 
-  case 53: /* insert_stmt: INSERT INTO ID VALUES LBRACE value value_list RBRACE  */
-#line 455 "yacc_sql.y"
+  case 57: /* insert_stmt: INSERT INTO ID VALUES LBRACE value value_list RBRACE  */
+#line 517 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_INSERT);
       (yyval.sql_node)->insertion.relation_name = (yyvsp[-5].string);
@@ -2126,19 +2210,19 @@ yyreduce:
       delete (yyvsp[-2].value);
       free((yyvsp[-5].string));
     }
-#line 2130 "yacc_sql.cpp"
+#line 2214 "yacc_sql.cpp"
     break;
 
-  case 54: /* value_list: %empty  */
-#line 471 "yacc_sql.y"
+  case 58: /* value_list: %empty  */
+#line 533 "yacc_sql.y"
     {
       (yyval.value_list) = nullptr;
     }
-#line 2138 "yacc_sql.cpp"
+#line 2222 "yacc_sql.cpp"
     break;
 
-  case 55: /* value_list: COMMA value value_list  */
-#line 474 "yacc_sql.y"
+  case 59: /* value_list: COMMA value value_list  */
+#line 536 "yacc_sql.y"
                               { 
       if ((yyvsp[0].value_list) != nullptr) {
         (yyval.value_list) = (yyvsp[0].value_list);
@@ -2148,11 +2232,11 @@ yyreduce:
       (yyval.value_list)->emplace_back(*(yyvsp[-1].value));
       delete (yyvsp[-1].value);
     }
-#line 2152 "yacc_sql.cpp"
+#line 2236 "yacc_sql.cpp"
     break;
 
-  case 56: /* value: '-' value  */
-#line 485 "yacc_sql.y"
+  case 60: /* value: '-' value  */
+#line 547 "yacc_sql.y"
              {
       if((yyvsp[0].value)->attr_type() == AttrType::INTS){
         (yyval.value) = new Value(-1 * int((yyvsp[0].value)->get_int()));
@@ -2166,66 +2250,66 @@ yyreduce:
       }
       delete (yyvsp[0].value);
     }
-#line 2170 "yacc_sql.cpp"
+#line 2254 "yacc_sql.cpp"
     break;
 
-  case 57: /* value: NULL_SYM  */
-#line 498 "yacc_sql.y"
+  case 61: /* value: NULL_SYM  */
+#line 560 "yacc_sql.y"
                {
       (yyval.value) = new Value;
       *((yyval.value)) = Value::Null(); /* NULL value */
       (yyloc) = (yylsp[0]);
     }
-#line 2180 "yacc_sql.cpp"
+#line 2264 "yacc_sql.cpp"
     break;
 
-  case 58: /* value: NUMBER  */
-#line 503 "yacc_sql.y"
+  case 62: /* value: NUMBER  */
+#line 565 "yacc_sql.y"
              {
       (yyval.value) = new Value((int)(yyvsp[0].number));
       (yyloc) = (yylsp[0]);
     }
-#line 2189 "yacc_sql.cpp"
+#line 2273 "yacc_sql.cpp"
     break;
 
-  case 59: /* value: FLOAT  */
-#line 507 "yacc_sql.y"
+  case 63: /* value: FLOAT  */
+#line 569 "yacc_sql.y"
             {
       (yyval.value) = new Value((float)(yyvsp[0].floats));
       (yyloc) = (yylsp[0]);
     }
-#line 2198 "yacc_sql.cpp"
+#line 2282 "yacc_sql.cpp"
     break;
 
-  case 60: /* value: SSS  */
-#line 511 "yacc_sql.y"
+  case 64: /* value: SSS  */
+#line 573 "yacc_sql.y"
           {
       char *tmp = common::substr((yyvsp[0].string),1,strlen((yyvsp[0].string))-2);
       (yyval.value) = new Value(tmp);
       free(tmp);
       free((yyvsp[0].string));
     }
-#line 2209 "yacc_sql.cpp"
+#line 2293 "yacc_sql.cpp"
     break;
 
-  case 61: /* storage_format: %empty  */
-#line 520 "yacc_sql.y"
+  case 65: /* storage_format: %empty  */
+#line 582 "yacc_sql.y"
     {
       (yyval.string) = nullptr;
     }
-#line 2217 "yacc_sql.cpp"
+#line 2301 "yacc_sql.cpp"
     break;
 
-  case 62: /* storage_format: STORAGE FORMAT EQ ID  */
-#line 524 "yacc_sql.y"
+  case 66: /* storage_format: STORAGE FORMAT EQ ID  */
+#line 586 "yacc_sql.y"
     {
       (yyval.string) = (yyvsp[0].string);
     }
-#line 2225 "yacc_sql.cpp"
+#line 2309 "yacc_sql.cpp"
     break;
 
-  case 63: /* delete_stmt: DELETE FROM ID where  */
-#line 531 "yacc_sql.y"
+  case 67: /* delete_stmt: DELETE FROM ID where  */
+#line 593 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_DELETE);
       (yyval.sql_node)->deletion.relation_name = (yyvsp[-1].string);
@@ -2235,11 +2319,11 @@ yyreduce:
       }
       free((yyvsp[-1].string));
     }
-#line 2239 "yacc_sql.cpp"
+#line 2323 "yacc_sql.cpp"
     break;
 
-  case 64: /* update_stmt: UPDATE ID SET ID EQ value where  */
-#line 543 "yacc_sql.y"
+  case 68: /* update_stmt: UPDATE ID SET ID EQ value where  */
+#line 605 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_UPDATE);
       (yyval.sql_node)->update.relation_name = (yyvsp[-5].string);
@@ -2253,70 +2337,112 @@ yyreduce:
       free((yyvsp[-3].string));
       delete (yyvsp[-1].value);
     }
-#line 2257 "yacc_sql.cpp"
+#line 2341 "yacc_sql.cpp"
     break;
 
-  case 65: /* select_stmt: SELECT expression_list FROM table_ref_list where group_by opt_order_by  */
-#line 559 "yacc_sql.y"
+  case 69: /* select_stmt: SELECT expression_list FROM table_ref_list where group_by opt_order_by opt_limit  */
+#line 621 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_SELECT);
-      if ((yyvsp[-5].expression_list) != nullptr) {
-        (yyval.sql_node)->selection.expressions.swap(*(yyvsp[-5].expression_list));
-        delete (yyvsp[-5].expression_list);
+      if ((yyvsp[-6].expression_list) != nullptr) {
+        (yyval.sql_node)->selection.expressions.swap(*(yyvsp[-6].expression_list));
+        delete (yyvsp[-6].expression_list);
+      }
+
+      if ((yyvsp[-4].table_ref_list) != nullptr) {
+        (yyval.sql_node)->selection.relations.swap((yyvsp[-4].table_ref_list)->relations);
+        (yyval.sql_node)->selection.conditions.swap((yyvsp[-4].table_ref_list)->conditions);
+        delete (yyvsp[-4].table_ref_list);
       }
 
-      if ((yyvsp[-3].table_ref_list) != nullptr) {
-        (yyval.sql_node)->selection.relations.swap((yyvsp[-3].table_ref_list)->relations);
-        (yyval.sql_node)->selection.conditions.swap((yyvsp[-3].table_ref_list)->conditions);
-        delete (yyvsp[-3].table_ref_list);
+      if ((yyvsp[-3].condition_list) != nullptr) {
+        (yyval.sql_node)->selection.conditions.insert((yyval.sql_node)->selection.conditions.end(), (yyvsp[-3].condition_list)->begin(), (yyvsp[-3].condition_list)->end());
+        delete (yyvsp[-3].condition_list);
       }
 
-      if ((yyvsp[-2].condition_list) != nullptr) {
-        (yyval.sql_node)->selection.conditions.insert((yyval.sql_node)->selection.conditions.end(), (yyvsp[-2].condition_list)->begin(), (yyvsp[-2].condition_list)->end());
-        delete (yyvsp[-2].condition_list);
+      if ((yyvsp[-2].expression_list) != nullptr) {
+        (yyval.sql_node)->selection.group_by.swap(*(yyvsp[-2].expression_list));
+        delete (yyvsp[-2].expression_list);
       }
 
-      if ((yyvsp[-1].expression_list) != nullptr) {
-        (yyval.sql_node)->selection.group_by.swap(*(yyvsp[-1].expression_list));
-        delete (yyvsp[-1].expression_list);
+      if ((yyvsp[-1].order_by_list) != nullptr) {
+        (yyval.sql_node)->selection.order_sql_nodes.swap(*(yyvsp[-1].order_by_list));
+        delete (yyvsp[-1].order_by_list);
       }
 
-      if ((yyvsp[0].order_by_list) != nullptr) {
-        (yyval.sql_node)->selection.order_sql_nodes.swap(*(yyvsp[0].order_by_list));
-        delete (yyvsp[0].order_by_list);
+      if ((yyvsp[0].limit) != nullptr) {
+        (yyval.sql_node)->selection.limit = *(yyvsp[0].limit);
+        delete (yyvsp[0].limit);
       }
     }
-#line 2290 "yacc_sql.cpp"
+#line 2379 "yacc_sql.cpp"
     break;
 
-  case 66: /* opt_order_by: %empty  */
-#line 590 "yacc_sql.y"
+  case 70: /* opt_order_by: %empty  */
+#line 657 "yacc_sql.y"
   {
     (yyval.order_by_list) = nullptr;   // empty
   }
-#line 2298 "yacc_sql.cpp"
+#line 2387 "yacc_sql.cpp"
     break;
 
-  case 67: /* opt_order_by: ORDER BY order_by_list  */
-#line 594 "yacc_sql.y"
+  case 71: /* opt_order_by: ORDER BY order_by_list  */
+#line 661 "yacc_sql.y"
   {
     (yyval.order_by_list) = (yyvsp[0].order_by_list);
   }
-#line 2306 "yacc_sql.cpp"
+#line 2395 "yacc_sql.cpp"
+    break;
+
+  case 72: /* opt_limit: %empty  */
+#line 667 "yacc_sql.y"
+  {
+    (yyval.limit) = nullptr;   // empty
+  }
+#line 2403 "yacc_sql.cpp"
+    break;
+
+  case 73: /* opt_limit: LIMIT number  */
+#line 671 "yacc_sql.y"
+  {
+    (yyval.limit) = new LimitSqlNode;
+    (yyval.limit)->limit = (yyvsp[0].number);
+  }
+#line 2412 "yacc_sql.cpp"
     break;
 
-  case 68: /* order_by_list: order_by  */
-#line 601 "yacc_sql.y"
+  case 74: /* opt_limit: LIMIT number OFFSET number  */
+#line 676 "yacc_sql.y"
+  {
+    (yyval.limit) = new LimitSqlNode;
+    (yyval.limit)->limit  = (yyvsp[-2].number);
+    (yyval.limit)->offset = (yyvsp[0].number);
+  }
+#line 2422 "yacc_sql.cpp"
+    break;
+
+  case 75: /* opt_limit: LIMIT number COMMA number  */
+#line 682 "yacc_sql.y"
+  {
+    (yyval.limit) = new LimitSqlNode;
+    (yyval.limit)->offset = (yyvsp[-2].number);
+    (yyval.limit)->limit  = (yyvsp[0].number);
+  }
+#line 2432 "yacc_sql.cpp"
+    break;
+
+  case 76: /* order_by_list: order_by  */
+#line 691 "yacc_sql.y"
   {
     (yyval.order_by_list) = new std::vector<OrderSqlNode>;
     (yyval.order_by_list)->emplace_back(*(yyvsp[0].order_by));
     delete (yyvsp[0].order_by);
   }
-#line 2316 "yacc_sql.cpp"
+#line 2442 "yacc_sql.cpp"
     break;
 
-  case 69: /* order_by_list: order_by COMMA order_by_list  */
-#line 607 "yacc_sql.y"
+  case 77: /* order_by_list: order_by COMMA order_by_list  */
+#line 697 "yacc_sql.y"
   {
     if ((yyvsp[0].order_by_list) != nullptr) {
         (yyval.order_by_list) = (yyvsp[0].order_by_list);
@@ -2326,11 +2452,11 @@ yyreduce:
     (yyval.order_by_list)->emplace((yyval.order_by_list)->begin(), *(yyvsp[-2].order_by));
     delete (yyvsp[-2].order_by);
   }
-#line 2330 "yacc_sql.cpp"
+#line 2456 "yacc_sql.cpp"
     break;
 
-  case 70: /* order_by: expression  */
-#line 620 "yacc_sql.y"
+  case 78: /* order_by: expression  */
+#line 710 "yacc_sql.y"
   {
     if((yyvsp[0].expression) == nullptr || (yyvsp[0].expression)->type() != ExprType::UNBOUND_FIELD){
         delete (yyvsp[0].expression);
@@ -2342,11 +2468,11 @@ yyreduce:
     (yyval.order_by)->unbound_field_expr_ = (yyvsp[0].expression);
     (yyvsp[0].expression) = nullptr;
   }
-#line 2346 "yacc_sql.cpp"
+#line 2472 "yacc_sql.cpp"
     break;
 
-  case 71: /* order_by: expression ASC  */
-#line 632 "yacc_sql.y"
+  case 79: /* order_by: expression ASC  */
+#line 722 "yacc_sql.y"
   {
     if((yyvsp[-1].expression) == nullptr || (yyvsp[-1].expression)->type() != ExprType::UNBOUND_FIELD){
         delete (yyvsp[-1].expression);
@@ -2358,11 +2484,11 @@ yyreduce:
     (yyval.order_by)->unbound_field_expr_ = (yyvsp[-1].expression);
     (yyvsp[-1].expression) = nullptr;
   }
-#line 2362 "yacc_sql.cpp"
+#line 2488 "yacc_sql.cpp"
     break;
 
-  case 72: /* order_by: expression DESC  */
-#line 644 "yacc_sql.y"
+  case 80: /* order_by: expression DESC  */
+#line 734 "yacc_sql.y"
   {
    if((yyvsp[-1].expression) == nullptr || (yyvsp[-1].expression)->type() != ExprType::UNBOUND_FIELD){
         delete (yyvsp[-1].expression);
@@ -2374,30 +2500,30 @@ yyreduce:
     (yyval.order_by)->unbound_field_expr_ = (yyvsp[-1].expression);
     (yyvsp[-1].expression) = nullptr;
   }
-#line 2378 "yacc_sql.cpp"
+#line 2504 "yacc_sql.cpp"
     break;
 
-  case 73: /* calc_stmt: CALC expression_list  */
-#line 659 "yacc_sql.y"
+  case 81: /* calc_stmt: CALC expression_list  */
+#line 749 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_CALC);
       (yyval.sql_node)->calc.expressions.swap(*(yyvsp[0].expression_list));
       delete (yyvsp[0].expression_list);
     }
-#line 2388 "yacc_sql.cpp"
+#line 2514 "yacc_sql.cpp"
     break;
 
-  case 74: /* expression_list: expression  */
-#line 668 "yacc_sql.y"
+  case 82: /* expression_list: expression  */
+#line 758 "yacc_sql.y"
     {
       (yyval.expression_list) = new std::vector<std::unique_ptr<Expression>>;
       (yyval.expression_list)->emplace_back((yyvsp[0].expression));
     }
-#line 2397 "yacc_sql.cpp"
+#line 2523 "yacc_sql.cpp"
     break;
 
-  case 75: /* expression_list: expression COMMA expression_list  */
-#line 673 "yacc_sql.y"
+  case 83: /* expression_list: expression COMMA expression_list  */
+#line 763 "yacc_sql.y"
     {
       if ((yyvsp[0].expression_list) != nullptr) {
         (yyval.expression_list) = (yyvsp[0].expression_list);
@@ -2406,90 +2532,90 @@ yyreduce:
       }
       (yyval.expression_list)->emplace((yyval.expression_list)->begin(), (yyvsp[-2].expression));
     }
-#line 2410 "yacc_sql.cpp"
+#line 2536 "yacc_sql.cpp"
     break;
 
-  case 76: /* expression: '-' expression  */
-#line 683 "yacc_sql.y"
+  case 84: /* expression: '-' expression  */
+#line 773 "yacc_sql.y"
                                 {
       ValueExpr* vepr = new ValueExpr(Value((int)0));
       (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::SUB, vepr, (yyvsp[0].expression), sql_string, &(yyloc));
     }
-#line 2419 "yacc_sql.cpp"
+#line 2545 "yacc_sql.cpp"
     break;
 
-  case 77: /* expression: expression '+' expression  */
-#line 687 "yacc_sql.y"
+  case 85: /* expression: expression '+' expression  */
+#line 777 "yacc_sql.y"
                                 {
       (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::ADD, (yyvsp[-2].expression), (yyvsp[0].expression), sql_string, &(yyloc));
     }
-#line 2427 "yacc_sql.cpp"
+#line 2553 "yacc_sql.cpp"
     break;
 
-  case 78: /* expression: expression '-' expression  */
-#line 690 "yacc_sql.y"
+  case 86: /* expression: expression '-' expression  */
+#line 780 "yacc_sql.y"
                                 {
       (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::SUB, (yyvsp[-2].expression), (yyvsp[0].expression), sql_string, &(yyloc));
     }
-#line 2435 "yacc_sql.cpp"
+#line 2561 "yacc_sql.cpp"
     break;
 
-  case 79: /* expression: expression '*' expression  */
-#line 693 "yacc_sql.y"
+  case 87: /* expression: expression '*' expression  */
+#line 783 "yacc_sql.y"
                                 {
       (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::MUL, (yyvsp[-2].expression), (yyvsp[0].expression), sql_string, &(yyloc));
     }
-#line 2443 "yacc_sql.cpp"
+#line 2569 "yacc_sql.cpp"
     break;
 
-  case 80: /* expression: expression '/' expression  */
-#line 696 "yacc_sql.y"
+  case 88: /* expression: expression '/' expression  */
+#line 786 "yacc_sql.y"
                                 {
       (yyval.expression) = create_arithmetic_expression(ArithmeticExpr::Type::DIV, (yyvsp[-2].expression), (yyvsp[0].expression), sql_string, &(yyloc));
     }
-#line 2451 "yacc_sql.cpp"
+#line 2577 "yacc_sql.cpp"
     break;
 
-  case 81: /* expression: LBRACE expression RBRACE  */
-#line 699 "yacc_sql.y"
+  case 89: /* expression: LBRACE expression RBRACE  */
+#line 789 "yacc_sql.y"
                                {
       (yyval.expression) = (yyvsp[-1].expression);
       (yyval.expression)->set_name(token_name(sql_string, &(yyloc)));
     }
-#line 2460 "yacc_sql.cpp"
+#line 2586 "yacc_sql.cpp"
     break;
 
-  case 82: /* expression: value  */
-#line 703 "yacc_sql.y"
+  case 90: /* expression: value  */
+#line 793 "yacc_sql.y"
             {
       (yyval.expression) = new ValueExpr(*(yyvsp[0].value));
       (yyval.expression)->set_name(token_name(sql_string, &(yyloc)));
       delete (yyvsp[0].value);
     }
-#line 2470 "yacc_sql.cpp"
+#line 2596 "yacc_sql.cpp"
     break;
 
-  case 83: /* expression: rel_attr  */
-#line 708 "yacc_sql.y"
+  case 91: /* expression: rel_attr  */
+#line 798 "yacc_sql.y"
                {
       RelAttrSqlNode *node = (yyvsp[0].rel_attr);
       (yyval.expression) = new UnboundFieldExpr(node->relation_name, node->attribute_name);
       (yyval.expression)->set_name(token_name(sql_string, &(yyloc)));
       delete (yyvsp[0].rel_attr);
     }
-#line 2481 "yacc_sql.cpp"
+#line 2607 "yacc_sql.cpp"
     break;
 
-  case 84: /* expression: '*'  */
-#line 714 "yacc_sql.y"
+  case 92: /* expression: '*'  */
+#line 804 "yacc_sql.y"
           {
       (yyval.expression) = new StarExpr();
     }
-#line 2489 "yacc_sql.cpp"
+#line 2615 "yacc_sql.cpp"
     break;
 
-  case 85: /* expression: MAX LBRACE expression RBRACE  */
-#line 718 "yacc_sql.y"
+  case 93: /* expression: MAX LBRACE expression RBRACE  */
+#line 808 "yacc_sql.y"
                                   {
       if((yyvsp[-1].expression) -> type() != ExprType::UNBOUND_FIELD){
         delete (yyvsp[-1].expression);
@@ -2499,11 +2625,11 @@ yyreduce:
         (yyval.expression) = create_aggregate_expression("MAX", (yyvsp[-1].expression), sql_string, &(yyloc));
       }
     }
-#line 2503 "yacc_sql.cpp"
+#line 2629 "yacc_sql.cpp"
     break;
 
-  case 86: /* expression: MIN LBRACE expression RBRACE  */
-#line 727 "yacc_sql.y"
+  case 94: /* expression: MIN LBRACE expression RBRACE  */
+#line 817 "yacc_sql.y"
                                   {
       if((yyvsp[-1].expression) -> type() != ExprType::UNBOUND_FIELD){
         delete (yyvsp[-1].expression);
@@ -2513,11 +2639,11 @@ yyreduce:
         (yyval.expression) = create_aggregate_expression("MIN", (yyvsp[-1].expression), sql_string, &(yyloc));
       }
     }
-#line 2517 "yacc_sql.cpp"
+#line 2643 "yacc_sql.cpp"
     break;
 
-  case 87: /* expression: SUM LBRACE expression RBRACE  */
-#line 736 "yacc_sql.y"
+  case 95: /* expression: SUM LBRACE expression RBRACE  */
+#line 826 "yacc_sql.y"
                                   {
       if((yyvsp[-1].expression) -> type() != ExprType::UNBOUND_FIELD){
         delete (yyvsp[-1].expression);
@@ -2527,11 +2653,11 @@ yyreduce:
         (yyval.expression) = create_aggregate_expression("SUM", (yyvsp[-1].expression), sql_string, &(yyloc));
       }
     }
-#line 2531 "yacc_sql.cpp"
+#line 2657 "yacc_sql.cpp"
     break;
 
-  case 88: /* expression: AVG LBRACE expression RBRACE  */
-#line 745 "yacc_sql.y"
+  case 96: /* expression: AVG LBRACE expression RBRACE  */
+#line 835 "yacc_sql.y"
                                   {
       if((yyvsp[-1].expression) -> type() != ExprType::UNBOUND_FIELD){
         delete (yyvsp[-1].expression);
@@ -2541,29 +2667,29 @@ yyreduce:
         (yyval.expression) = create_aggregate_expression("AVG", (yyvsp[-1].expression), sql_string, &(yyloc));
       }
     }
-#line 2545 "yacc_sql.cpp"
+#line 2671 "yacc_sql.cpp"
     break;
 
-  case 89: /* expression: COUNT LBRACE expression RBRACE  */
-#line 754 "yacc_sql.y"
+  case 97: /* expression: COUNT LBRACE expression RBRACE  */
+#line 844 "yacc_sql.y"
                                     {
       (yyval.expression) = create_aggregate_expression("COUNT", (yyvsp[-1].expression), sql_string, &(yyloc));
     }
-#line 2553 "yacc_sql.cpp"
+#line 2679 "yacc_sql.cpp"
     break;
 
-  case 90: /* rel_attr: ID  */
-#line 760 "yacc_sql.y"
+  case 98: /* rel_attr: ID  */
+#line 850 "yacc_sql.y"
        {
       (yyval.rel_attr) = new RelAttrSqlNode;
       (yyval.rel_attr)->attribute_name = (yyvsp[0].string);
       free((yyvsp[0].string));
     }
-#line 2563 "yacc_sql.cpp"
+#line 2689 "yacc_sql.cpp"
     break;
 
-  case 91: /* rel_attr: ID DOT ID  */
-#line 765 "yacc_sql.y"
+  case 99: /* rel_attr: ID DOT ID  */
+#line 855 "yacc_sql.y"
                 {
       (yyval.rel_attr) = new RelAttrSqlNode;
       (yyval.rel_attr)->relation_name  = (yyvsp[-2].string);
@@ -2571,45 +2697,45 @@ yyreduce:
       free((yyvsp[-2].string));
       free((yyvsp[0].string));
     }
-#line 2575 "yacc_sql.cpp"
+#line 2701 "yacc_sql.cpp"
     break;
 
-  case 92: /* relation: ID  */
-#line 775 "yacc_sql.y"
+  case 100: /* relation: ID  */
+#line 865 "yacc_sql.y"
        {
       (yyval.string) = (yyvsp[0].string);
     }
-#line 2583 "yacc_sql.cpp"
+#line 2709 "yacc_sql.cpp"
     break;
 
-  case 93: /* table_ref_list: comma_ref_list  */
-#line 780 "yacc_sql.y"
+  case 101: /* table_ref_list: comma_ref_list  */
+#line 870 "yacc_sql.y"
                    {  // 返回逗号连接的表列表
       (yyval.table_ref_list) = (yyvsp[0].table_ref_list);
     }
-#line 2591 "yacc_sql.cpp"
+#line 2717 "yacc_sql.cpp"
     break;
 
-  case 94: /* table_ref_list: join_ref_list  */
-#line 783 "yacc_sql.y"
+  case 102: /* table_ref_list: join_ref_list  */
+#line 873 "yacc_sql.y"
                     { // 返回 INNER JOIN 的表列表
       (yyval.table_ref_list) = (yyvsp[0].table_ref_list);
     }
-#line 2599 "yacc_sql.cpp"
+#line 2725 "yacc_sql.cpp"
     break;
 
-  case 95: /* comma_ref_list: relation  */
-#line 788 "yacc_sql.y"
+  case 103: /* comma_ref_list: relation  */
+#line 878 "yacc_sql.y"
              {
       (yyval.table_ref_list) = new TableRefSqlNode();
       (yyval.table_ref_list)->relations.push_back((yyvsp[0].string));
       free((yyvsp[0].string));
     }
-#line 2609 "yacc_sql.cpp"
+#line 2735 "yacc_sql.cpp"
     break;
 
-  case 96: /* comma_ref_list: relation COMMA table_ref_list  */
-#line 793 "yacc_sql.y"
+  case 104: /* comma_ref_list: relation COMMA table_ref_list  */
+#line 883 "yacc_sql.y"
                                     {
       if ((yyvsp[0].table_ref_list) != nullptr) {
         (yyval.table_ref_list) = (yyvsp[0].table_ref_list);
@@ -2620,11 +2746,11 @@ yyreduce:
       (yyval.table_ref_list)->relations.insert((yyval.table_ref_list)->relations.begin(), (yyvsp[-2].string));
       free((yyvsp[-2].string));
     }
-#line 2624 "yacc_sql.cpp"
+#line 2750 "yacc_sql.cpp"
     break;
 
-  case 97: /* join_ref_list: relation INNER JOIN relation ON condition_list  */
-#line 805 "yacc_sql.y"
+  case 105: /* join_ref_list: relation INNER JOIN relation ON condition_list  */
+#line 895 "yacc_sql.y"
                                                    {
       (yyval.table_ref_list) = new TableRefSqlNode();
 
@@ -2639,11 +2765,11 @@ yyreduce:
         delete (yyvsp[0].condition_list);
       }
     }
-#line 2643 "yacc_sql.cpp"
+#line 2769 "yacc_sql.cpp"
     break;
 
-  case 98: /* join_ref_list: join_ref_list INNER JOIN relation ON condition_list  */
-#line 819 "yacc_sql.y"
+  case 106: /* join_ref_list: join_ref_list INNER JOIN relation ON condition_list  */
+#line 909 "yacc_sql.y"
                                                           {
       // 处理嵌套的 INNER JOIN
       if ((yyvsp[-5].table_ref_list) != nullptr) {
@@ -2661,55 +2787,55 @@ yyreduce:
         delete (yyvsp[0].condition_list);
       }
     }
-#line 2665 "yacc_sql.cpp"
+#line 2791 "yacc_sql.cpp"
     break;
 
-  case 99: /* where: %empty  */
-#line 840 "yacc_sql.y"
+  case 107: /* where: %empty  */
+#line 930 "yacc_sql.y"
     {
       (yyval.condition_list) = nullptr;
     }
-#line 2673 "yacc_sql.cpp"
+#line 2799 "yacc_sql.cpp"
     break;
 
-  case 100: /* where: WHERE condition_list  */
-#line 843 "yacc_sql.y"
+  case 108: /* where: WHERE condition_list  */
+#line 933 "yacc_sql.y"
                            {
       (yyval.condition_list) = (yyvsp[0].condition_list);  
     }
-#line 2681 "yacc_sql.cpp"
+#line 2807 "yacc_sql.cpp"
     break;
 
-  case 101: /* condition_list: %empty  */
-#line 849 "yacc_sql.y"
+  case 109: /* condition_list: %empty  */
+#line 939 "yacc_sql.y"
     {
       (yyval.condition_list) = nullptr;
     }
-#line 2689 "yacc_sql.cpp"
+#line 2815 "yacc_sql.cpp"
     break;
 
-  case 102: /* condition_list: condition  */
-#line 852 "yacc_sql.y"
+  case 110: /* condition_list: condition  */
+#line 942 "yacc_sql.y"
                 {
       (yyval.condition_list) = new std::vector<ConditionSqlNode>;
       (yyval.condition_list)->emplace_back(*(yyvsp[0].condition));
       delete (yyvsp[0].condition);
     }
-#line 2699 "yacc_sql.cpp"
+#line 2825 "yacc_sql.cpp"
     break;
 
-  case 103: /* condition_list: condition AND condition_list  */
-#line 857 "yacc_sql.y"
+  case 111: /* condition_list: condition AND condition_list  */
+#line 947 "yacc_sql.y"
                                    {
       (yyval.condition_list) = (yyvsp[0].condition_list);
       (yyval.condition_list)->emplace_back(*(yyvsp[-2].condition));
       delete (yyvsp[-2].condition);
     }
-#line 2709 "yacc_sql.cpp"
+#line 2835 "yacc_sql.cpp"
     break;
 
-  case 104: /* condition: expression comp_op expression  */
-#line 865 "yacc_sql.y"
+  case 112: /* condition: expression comp_op expression  */
+#line 955 "yacc_sql.y"
      {
           (yyval.condition) = new ConditionSqlNode;
           // 说明是 () op () 型的算数表达式,$1类型为 ArithmeticExpr*
@@ -2765,11 +2891,11 @@ yyreduce:
 
           (yyval.condition)->comp = (yyvsp[-1].comp);
     }
-#line 2769 "yacc_sql.cpp"
+#line 2895 "yacc_sql.cpp"
     break;
 
-  case 105: /* condition: rel_attr IS_SYM NULL_SYM  */
-#line 921 "yacc_sql.y"
+  case 113: /* condition: rel_attr IS_SYM NULL_SYM  */
+#line 1011 "yacc_sql.y"
     {
       (yyval.condition) = new ConditionSqlNode;
       (yyval.condition)->left_is_attr = 1;
@@ -2780,11 +2906,11 @@ yyreduce:
 
       delete (yyvsp[-2].rel_attr);
     }
-#line 2784 "yacc_sql.cpp"
+#line 2910 "yacc_sql.cpp"
     break;
 
-  case 106: /* condition: rel_attr IS_SYM NOT NULL_SYM  */
-#line 932 "yacc_sql.y"
+  case 114: /* condition: rel_attr IS_SYM NOT NULL_SYM  */
+#line 1022 "yacc_sql.y"
     {
       (yyval.condition) = new ConditionSqlNode;
       (yyval.condition)->left_is_attr = 1;
@@ -2795,11 +2921,11 @@ yyreduce:
 
       delete (yyvsp[-3].rel_attr);
     }
-#line 2799 "yacc_sql.cpp"
+#line 2925 "yacc_sql.cpp"
     break;
 
-  case 107: /* condition: value IS_SYM NULL_SYM  */
-#line 943 "yacc_sql.y"
+  case 115: /* condition: value IS_SYM NULL_SYM  */
+#line 1033 "yacc_sql.y"
     {
       (yyval.condition) = new ConditionSqlNode;
       (yyval.condition)->left_is_attr = 0;
@@ -2810,11 +2936,11 @@ yyreduce:
 
       delete (yyvsp[-2].value);
     }
-#line 2814 "yacc_sql.cpp"
+#line 2940 "yacc_sql.cpp"
     break;
 
-  case 108: /* condition: value IS_SYM NOT NULL_SYM  */
-#line 954 "yacc_sql.y"
+  case 116: /* condition: value IS_SYM NOT NULL_SYM  */
+#line 1044 "yacc_sql.y"
     {
       (yyval.condition) = new ConditionSqlNode;
       (yyval.condition)->left_is_attr = 0;
@@ -2825,75 +2951,75 @@ yyreduce:
 
       delete (yyvsp[-3].value);
     }
-#line 2829 "yacc_sql.cpp"
+#line 2955 "yacc_sql.cpp"
     break;
 
-  case 109: /* comp_op: EQ  */
-#line 967 "yacc_sql.y"
+  case 117: /* comp_op: EQ  */
+#line 1057 "yacc_sql.y"
          { (yyval.comp) = EQUAL_TO; }
-#line 2835 "yacc_sql.cpp"
+#line 2961 "yacc_sql.cpp"
     break;
 
-  case 110: /* comp_op: LT  */
-#line 968 "yacc_sql.y"
+  case 118: /* comp_op: LT  */
+#line 1058 "yacc_sql.y"
          { (yyval.comp) = LESS_THAN; }
-#line 2841 "yacc_sql.cpp"
+#line 2967 "yacc_sql.cpp"
     break;
 
-  case 111: /* comp_op: GT  */
-#line 969 "yacc_sql.y"
+  case 119: /* comp_op: GT  */
+#line 1059 "yacc_sql.y"
          { (yyval.comp) = GREAT_THAN; }
-#line 2847 "yacc_sql.cpp"
+#line 2973 "yacc_sql.cpp"
     break;
 
-  case 112: /* comp_op: LE  */
-#line 970 "yacc_sql.y"
+  case 120: /* comp_op: LE  */
+#line 1060 "yacc_sql.y"
          { (yyval.comp) = LESS_EQUAL; }
-#line 2853 "yacc_sql.cpp"
+#line 2979 "yacc_sql.cpp"
     break;
 
-  case 113: /* comp_op: GE  */
-#line 971 "yacc_sql.y"
+  case 121: /* comp_op: GE  */
+#line 1061 "yacc_sql.y"
          { (yyval.comp) = GREAT_EQUAL; }
-#line 2859 "yacc_sql.cpp"
+#line 2985 "yacc_sql.cpp"
     break;
 
-  case 114: /* comp_op: NE  */
-#line 972 "yacc_sql.y"
+  case 122: /* comp_op: NE  */
+#line 1062 "yacc_sql.y"
          { (yyval.comp) = NOT_EQUAL; }
-#line 2865 "yacc_sql.cpp"
+#line 2991 "yacc_sql.cpp"
     break;
 
-  case 115: /* comp_op: LIKE  */
-#line 973 "yacc_sql.y"
+  case 123: /* comp_op: LIKE  */
+#line 1063 "yacc_sql.y"
            { (yyval.comp) = LIKE_OP; }
-#line 2871 "yacc_sql.cpp"
+#line 2997 "yacc_sql.cpp"
     break;
 
-  case 116: /* comp_op: NOT LIKE  */
-#line 974 "yacc_sql.y"
+  case 124: /* comp_op: NOT LIKE  */
+#line 1064 "yacc_sql.y"
                { (yyval.comp) = NO_LIKE_OP; }
-#line 2877 "yacc_sql.cpp"
+#line 3003 "yacc_sql.cpp"
     break;
 
-  case 117: /* group_by: %empty  */
-#line 980 "yacc_sql.y"
+  case 125: /* group_by: %empty  */
+#line 1070 "yacc_sql.y"
     {
       (yyval.expression_list) = nullptr;
     }
-#line 2885 "yacc_sql.cpp"
+#line 3011 "yacc_sql.cpp"
     break;
 
-  case 118: /* group_by: GROUP BY expression_list  */
-#line 984 "yacc_sql.y"
+  case 126: /* group_by: GROUP BY expression_list  */
+#line 1074 "yacc_sql.y"
     {
         (yyval.expression_list) = (yyvsp[0].expression_list);
     }
-#line 2893 "yacc_sql.cpp"
+#line 3019 "yacc_sql.cpp"
     break;
 
-  case 119: /* load_data_stmt: LOAD DATA INFILE SSS INTO TABLE ID  */
-#line 990 "yacc_sql.y"
+  case 127: /* load_data_stmt: LOAD DATA INFILE SSS INTO TABLE ID  */
+#line 1080 "yacc_sql.y"
     {
       char *tmp_file_name = common::substr((yyvsp[-3].string), 1, strlen((yyvsp[-3].string)) - 2);
       
@@ -2903,20 +3029,20 @@ yyreduce:
       free((yyvsp[0].string));
       free(tmp_file_name);
     }
-#line 2907 "yacc_sql.cpp"
+#line 3033 "yacc_sql.cpp"
     break;
 
-  case 120: /* explain_stmt: EXPLAIN command_wrapper  */
-#line 1003 "yacc_sql.y"
+  case 128: /* explain_stmt: EXPLAIN command_wrapper  */
+#line 1093 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_EXPLAIN);
       (yyval.sql_node)->explain.sql_node = std::unique_ptr<ParsedSqlNode>((yyvsp[0].sql_node));
     }
-#line 2916 "yacc_sql.cpp"
+#line 3042 "yacc_sql.cpp"
     break;
 
-  case 121: /* set_variable_stmt: SET ID EQ value  */
-#line 1011 "yacc_sql.y"
+  case 129: /* set_variable_stmt: SET ID EQ value  */
+#line 1101 "yacc_sql.y"
     {
       (yyval.sql_node) = new ParsedSqlNode(SCF_SET_VARIABLE);
       (yyval.sql_node)->set_variable.name  = (yyvsp[-2].string);
@@ -2924,11 +3050,11 @@ yyreduce:
       free((yyvsp[-2].string));
       delete (yyvsp[0].value);
     }
-#line 2928 "yacc_sql.cpp"
+#line 3054 "yacc_sql.cpp"
     break;
 
 
-#line 2932 "yacc_sql.cpp"
+#line 3058 "yacc_sql.cpp"
 
       default: break;
     }
@@ -3157,7 +3283,7 @@ yyreturnlab:
   return yyresult;
 }
 
-#line 1023 "yacc_sql.y"
+#line 1113 "yacc_sql.y"
 
 //_____________________________________________________________________
 extern void scan_string(const char *str, yyscan_t scanner);
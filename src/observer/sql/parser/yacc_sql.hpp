@@ -118,11 +118,15 @@ extern int yydebug;
     NULLABLE_SYM = 319,            /* NULLABLE_SYM  */
     ORDER = 320,                   /* ORDER  */
     ASC = 321,                     /* ASC  */
-    NUMBER = 322,                  /* NUMBER  */
-    FLOAT = 323,                   /* FLOAT  */
-    ID = 324,                      /* ID  */
-    SSS = 325,                     /* SSS  */
-    UMINUS = 326                   /* UMINUS  */
+    LIMIT = 322,                   /* LIMIT  */
+    OFFSET = 323,                  /* OFFSET  */
+    COMPRESS = 324,                /* COMPRESS  */
+    USING = 325,                   /* USING  */
+    NUMBER = 326,                  /* NUMBER  */
+    FLOAT = 327,                   /* FLOAT  */
+    ID = 328,                      /* ID  */
+    SSS = 329,                     /* SSS  */
+    UMINUS = 330                   /* UMINUS  */
   };
   typedef enum yytokentype yytoken_kind_t;
 #endif
@@ -131,12 +135,13 @@ extern int yydebug;
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
 union YYSTYPE
 {
-#line 134 "yacc_sql.y"
+#line 168 "yacc_sql.y"
 
   ParsedSqlNode *                            sql_node;
   ConditionSqlNode *                         condition;
   OrderSqlNode *                             order_by;
   std::vector<OrderSqlNode> *                order_by_list;
+  LimitSqlNode *                             limit;
   Value *                                    value;
   enum CompOp                                comp;
   RelAttrSqlNode *                           rel_attr;
@@ -154,7 +159,7 @@ union YYSTYPE
   float                                      floats;
   bool                                       bools;
 
-#line 158 "yacc_sql.hpp"
+#line 163 "yacc_sql.hpp"
 
 };
 typedef union YYSTYPE YYSTYPE;
@@ -16,6 +16,36 @@
 
 using namespace std;
 
+/**
+ * @brief 读取下一个词法单元，把 LIMIT、OFFSET、COMPRESS 和 USING 从 ID 中识别出来
+ * @details 这几个关键字没有写在 lex_sql.l 中，lex_sql.cpp 保持 flex 生成的原样。
+ * 与 lex_sql.l 一样不区分大小写，只有整个单词相同时才是关键字，比如 limits 仍然是 ID。
+ */
+static int keyword_yylex(YYSTYPE *yylval, YYLTYPE *yylloc, yyscan_t scanner)
+{
+  static const struct
+  {
+    const char *name;
+    int         token;
+  } keywords[] = {{"LIMIT", LIMIT}, {"OFFSET", OFFSET}, {"COMPRESS", COMPRESS}, {"USING", USING}};
+
+  const int token = yylex(yylval, yylloc, scanner);
+  if (token != ID) {
+    return token;
+  }
+
+  for (const auto &keyword : keywords) {
+    if (0 == strcasecmp(yylval->string, keyword.name)) {
+      free(yylval->string);
+      yylval->string = nullptr;
+      return keyword.token;
+    }
+  }
+  return token;
+}
+
+#define yylex keyword_yylex
+
 string token_name(const char *sql_string, YYLTYPE *llocp)
 {
   return string(sql_string + llocp->first_column, llocp->last_column - llocp->first_column + 1);
@@ -129,6 +159,10 @@ UnboundAggregateExpr *create_aggregate_expression(const char *aggregate_name,
         NULLABLE_SYM
         ORDER
         ASC
+        LIMIT
+        OFFSET
+        COMPRESS
+        USING
 
 /** union 中定义各种数据类型，真实生成的代码也是union类型，所以不能有非POD类型的数据 **/
 %union {
@@ -136,6 +170,7 @@ UnboundAggregateExpr *create_aggregate_expression(const char *aggregate_name,
   ConditionSqlNode *                         condition;
   OrderSqlNode *                             order_by;
   std::vector<OrderSqlNode> *                order_by_list;
+  LimitSqlNode *                             limit;
   Value *                                    value;
   enum CompOp                                comp;
   RelAttrSqlNode *                           rel_attr;
@@ -164,6 +199,7 @@ UnboundAggregateExpr *create_aggregate_expression(const char *aggregate_name,
 %type <order_by>            order_by
 %type <order_by_list>       order_by_list
 %type <order_by_list>       opt_order_by
+%type <limit>               opt_limit
 %type <number>              type
 %type <condition>           condition
 %type <value>               value
@@ -184,6 +220,8 @@ UnboundAggregateExpr *create_aggregate_expression(const char *aggregate_name,
 %type <expression_list>     expression_list
 %type <expression_list>     group_by
 %type <bools>               opt_unique
+%type <bools>               opt_compress
+%type <string>              opt_index_type
 %type <bools>               opt_null;
 %type <id_list>             ID_list;
 %type <sql_node>            calc_stmt
@@ -302,20 +340,36 @@ desc_table_stmt:
     ;
 
 create_index_stmt:    /*create index 语句的语法解析树*/
-    CREATE opt_unique INDEX ID ON ID LBRACE ID_list RBRACE
+    CREATE opt_unique INDEX ID ON ID LBRACE ID_list RBRACE opt_index_type opt_compress
     {
       $$ = new ParsedSqlNode(SCF_CREATE_INDEX);
       CreateIndexSqlNode &create_index = $$->create_index;
       create_index.unique = $2;
+      create_index.prefix_compressed = $11;
       create_index.index_name = $4;
       create_index.relation_name = $6;
       create_index.attribute_names.swap(*$8);
+      if ($10 != nullptr) {
+        create_index.index_type = $10;
+        free($10);
+      }
       free($4);
       free($6);
       delete $8;
     }
     ;
 
+opt_index_type:
+    /* empty */
+    {
+      $$ = nullptr;
+    }
+    | USING ID
+    {
+      $$ = $2;
+    }
+    ;
+
 opt_unique:
     {
       $$ = false;
@@ -324,6 +378,14 @@ opt_unique:
       $$ = true;
     }
 
+opt_compress:
+    {
+      $$ = false;
+    }
+    | COMPRESS {
+      $$ = true;
+    }
+
 ID_list:
     ID
     {
@@ -555,7 +617,7 @@ update_stmt:      /*  update 语句的语法解析树*/
     }
     ;
 select_stmt:        /*  select 语句的语法解析树*/
-    SELECT expression_list FROM table_ref_list where group_by opt_order_by
+    SELECT expression_list FROM table_ref_list where group_by opt_order_by opt_limit
     {
       $$ = new ParsedSqlNode(SCF_SELECT);
       if ($2 != nullptr) {
@@ -583,6 +645,11 @@ select_stmt:        /*  select 语句的语法解析树*/
         $$->selection.order_sql_nodes.swap(*$7);
         delete $7;
       }
+
+      if ($8 != nullptr) {
+        $$->selection.limit = *$8;
+        delete $8;
+      }
     }
     ;
 
@@ -596,6 +663,29 @@ opt_order_by:
   }
   ;
 
+opt_limit:
+  {
+    $$ = nullptr;   // empty
+  }
+  | LIMIT number
+  {
+    $$ = new LimitSqlNode;
+    $$->limit = $2;
+  }
+  | LIMIT number OFFSET number
+  {
+    $$ = new LimitSqlNode;
+    $$->limit  = $2;
+    $$->offset = $4;
+  }
+  | LIMIT number COMMA number
+  {
+    $$ = new LimitSqlNode;
+    $$->offset = $2;
+    $$->limit  = $4;
+  }
+  ;
+
 order_by_list:
   order_by
   {
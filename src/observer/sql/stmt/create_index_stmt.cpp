@@ -13,6 +13,7 @@ See the Mulan PSL v2 for more details. */
 //
 
 #include "sql/stmt/create_index_stmt.h"
+#include "common/lang/algorithm.h"
 #include "common/lang/string.h"
 #include "common/log/log.h"
 #include "storage/db/db.h"
@@ -47,6 +48,7 @@ RC CreateIndexStmt::create(Db *db, const CreateIndexSqlNode &create_index, Stmt
     return RC::SCHEMA_TABLE_NOT_EXIST;
   }
 
+  vector<const FieldMeta *> field_metas;
   for (auto const &attr_name : create_index.attribute_names) {
     const FieldMeta *field_meta = table->table_meta().field(attr_name.c_str());
     if (nullptr == field_meta) {
@@ -54,8 +56,32 @@ RC CreateIndexStmt::create(Db *db, const CreateIndexSqlNode &create_index, Stmt
                db->name(), table_name, attr_name.c_str());
       return RC::SCHEMA_FIELD_NOT_EXIST;
     }
+    if (find(field_metas.begin(), field_metas.end(), field_meta) != field_metas.end()) {
+      LOG_WARN("duplicate field in index. db=%s, table=%s, field name=%s",
+               db->name(), table_name, attr_name.c_str());
+      return RC::INVALID_ARGUMENT;
+    }
+    field_metas.push_back(field_meta);
+  }
+
+  if (create_index.prefix_compressed && (field_metas.size() != 1 || field_metas[0]->type() != AttrType::CHARS)) {
+    LOG_WARN("prefix compressed index only supports one chars field. db=%s, table=%s, index=%s",
+             db->name(), table_name, create_index.index_name.c_str());
+    return RC::INVALID_ARGUMENT;
+  }
+
+  IndexType index_type = IndexType::BPLUS_TREE;
+  if (!create_index.index_type.empty() && OB_FAIL(index_type_from_string(create_index.index_type.c_str(), index_type))) {
+    LOG_WARN("unknown index type. db=%s, table=%s, index=%s, type=%s",
+             db->name(), table_name, create_index.index_name.c_str(), create_index.index_type.c_str());
+    return RC::INVALID_ARGUMENT;
+  }
+
+  if (index_type == IndexType::HASH && create_index.prefix_compressed) {
+    LOG_WARN("hash index does not support prefix compression. db=%s, table=%s, index=%s",
+             db->name(), table_name, create_index.index_name.c_str());
+    return RC::INVALID_ARGUMENT;
   }
-  const FieldMeta *field_meta = table->table_meta().field(create_index.attribute_names.front().c_str());
 
   Index *index = table->find_index(create_index.index_name.c_str());
   if (nullptr != index) {
@@ -63,6 +89,11 @@ RC CreateIndexStmt::create(Db *db, const CreateIndexSqlNode &create_index, Stmt
     return RC::SCHEMA_INDEX_NAME_REPEAT;
   }
 
-  stmt = new CreateIndexStmt(table, field_meta, create_index.index_name, create_index.unique);
+  stmt = new CreateIndexStmt(table,
+      std::move(field_metas),
+      create_index.index_name,
+      create_index.unique,
+      create_index.prefix_compressed,
+      index_type);
   return RC::SUCCESS;
 }
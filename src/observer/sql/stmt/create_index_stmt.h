@@ -15,8 +15,10 @@ See the Mulan PSL v2 for more details. */
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "sql/stmt/stmt.h"
+#include "storage/index/index_meta.h"
 
 struct CreateIndexSqlNode;
 class Table;
@@ -29,8 +31,14 @@ class FieldMeta;
 class CreateIndexStmt : public Stmt
 {
 public:
-  CreateIndexStmt(Table *table, const FieldMeta *field_meta, const std::string &index_name, bool unique)
-      : table_(table), field_meta_(field_meta), index_name_(index_name), unique_(unique)
+  CreateIndexStmt(Table *table, std::vector<const FieldMeta *> field_metas, const std::string &index_name,
+      bool unique, bool prefix_compressed = false, IndexType index_type = IndexType::BPLUS_TREE)
+      : table_(table),
+        field_metas_(std::move(field_metas)),
+        index_name_(index_name),
+        unique_(unique),
+        prefix_compressed_(prefix_compressed),
+        index_type_(index_type)
   {}
 
   virtual ~CreateIndexStmt() = default;
@@ -38,16 +46,22 @@ public:
   StmtType type() const override { return StmtType::CREATE_INDEX; }
 
   Table             *table() const { return table_; }
-  const FieldMeta   *field_meta() const { return field_meta_; }
+  /// @brief 索引包含的字段，多于一个时是组合索引
+  const std::vector<const FieldMeta *> &field_metas() const { return field_metas_; }
   const std::string &index_name() const { return index_name_; }
   bool               is_unique() const { return unique_; }
+  /// @brief 叶子节点是否使用前缀压缩
+  bool               is_prefix_compressed() const { return prefix_compressed_; }
+  IndexType          index_type() const { return index_type_; }
 
 public:
   static RC create(Db *db, const CreateIndexSqlNode &create_index, Stmt *&stmt);
 
 private:
-  Table           *table_      = nullptr;
-  const FieldMeta *field_meta_ = nullptr;
-  std::string      index_name_;
-  bool             unique_     = false;
+  Table                         *table_ = nullptr;
+  std::vector<const FieldMeta *> field_metas_;
+  std::string                    index_name_;
+  bool                           unique_ = false;
+  bool                           prefix_compressed_ = false;
+  IndexType                      index_type_        = IndexType::BPLUS_TREE;
 };
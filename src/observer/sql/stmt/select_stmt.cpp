@@ -130,6 +130,8 @@ RC SelectStmt::create(Db *db, SelectSqlNode &select_sql, Stmt *&stmt)
   select_stmt->filter_stmt_ = filter_stmt;
   select_stmt->group_by_.swap(group_by_expressions);
   select_stmt->orders_by_   = order_stmt;
+  select_stmt->limit_       = select_sql.limit.limit;
+  select_stmt->offset_      = select_sql.limit.offset;
   stmt                      = select_stmt;
   return RC::SUCCESS;
 }
@@ -46,6 +46,8 @@ public:
   const std::vector<Table *> &tables() const { return tables_; }
   FilterStmt                 *filter_stmt() const { return filter_stmt_; }
   OrderStmt                  *order_stmt()  const { return orders_by_; }
+  int                         limit() const { return limit_; }
+  int                         offset() const { return offset_; }
 
   std::vector<std::unique_ptr<Expression>> &query_expressions() { return query_expressions_; }
   std::vector<std::unique_ptr<Expression>> &group_by() { return group_by_; }
@@ -56,4 +58,6 @@ private:
   FilterStmt                              *filter_stmt_ = nullptr;
   OrderStmt                               *orders_by_ = nullptr;
   std::vector<std::unique_ptr<Expression>> group_by_;
+  int                                      limit_  = -1;  ///< 最多返回的行数，-1 表示没有 limit
+  int                                      offset_ = 0;
 };
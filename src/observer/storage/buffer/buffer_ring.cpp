@@ -0,0 +1,23 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "storage/buffer/buffer_ring.h"
+#include "common/lang/algorithm.h"
+
+BufferRing::BufferRing(int size) : pages_(std::max(size, 1), BP_INVALID_PAGE_NUM) {}
+
+void BufferRing::push(PageNum page_num)
+{
+  pages_[pos_] = page_num;
+  pos_         = (pos_ + 1) % pages_.size();
+  if (count_ < pages_.size()) {
+    count_++;
+  }
+}
@@ -0,0 +1,52 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <stddef.h>
+
+#include "common/lang/vector.h"
+#include "storage/buffer/page.h"
+
+/**
+ * @brief 批量访问页面时使用的私有页帧环
+ * @ingroup BufferPool
+ * @details 全表扫描、LOAD DATA和批量创建索引会顺序访问大量只用一次的页面，如果这些页面都进入共享的页面置换队列，
+ * 就会把真正的热点页面挤出去。这类操作可以带上一个 BufferRing 访问 DiskBufferPool：通过环加载的页面会记录在环中，
+ * 环满了之后，再加载新页面前先把环中最早加载的页面淘汰掉，腾出来的页帧就可以给新页面使用。
+ * 这样批量操作最多只占用环大小个页帧，不会淘汰共享缓存中的其它页面。
+ * 已经在缓存中的页面不会记录到环中，也就不会被淘汰。
+ * 一个 BufferRing 只能在一个线程中给一个 DiskBufferPool 使用。
+ */
+class BufferRing
+{
+public:
+  static constexpr int DEFAULT_SIZE = 32;
+
+  explicit BufferRing(int size = DEFAULT_SIZE);
+
+  int  size() const { return static_cast<int>(pages_.size()); }
+  bool full() const { return count_ == pages_.size(); }
+
+  /**
+   * @brief 环满时，下一个需要淘汰的页面
+   */
+  PageNum oldest() const { return pages_[pos_]; }
+
+  /**
+   * @brief 记录一个通过环加载的页面，环满时替换掉最早的页面
+   */
+  void push(PageNum page_num);
+
+private:
+  vector<PageNum> pages_;
+  size_t          pos_   = 0;  ///< 环满时指向最早的页面，否则指向下一个空位置
+  size_t          count_ = 0;
+};
@@ -13,11 +13,15 @@ See the Mulan PSL v2 for more details. */
 //
 #include <ctime>
 #include <errno.h>
+#include <limits.h>
 #include <string.h>
+#include <sys/uio.h>
 
 #include "common/io/io.h"
+#include "common/lang/defer.h"
 #include "common/lang/mutex.h"
 #include "common/lang/algorithm.h"
+#include "common/lang/thread.h"
 #include "common/log/log.h"
 #include "common/math/crc.h"
 #include "storage/buffer/disk_buffer_pool.h"
@@ -30,6 +34,9 @@ using namespace common;
 
 static const int MEM_POOL_ITEM_NUM = 20;
 
+/// 释放页面时等待其它线程放开 pin 的最多重试次数
+static const int DISPOSE_PAGE_RETRY_TIMES = 1000;
+
 ////////////////////////////////////////////////////////////////////////////////
 
 string BPFileHeader::to_string() const
@@ -48,58 +55,136 @@ string TPFileHeader::to_string() const
 
 ////////////////////////////////////////////////////////////////////////////////
 
-BPFrameManager::BPFrameManager(const char *name) : allocator_(name) {}
+BPFrameManager::BPFrameManager(const char *name, int shard_num /*= DEFAULT_SHARD_NUM*/,
+    FrameReplacerType replacer_type /*= FrameReplacerType::LRU*/)
+    : replacer_type_(replacer_type), allocator_(name)
+{
+  while ((1 << shard_bits_) < shard_num) {
+    shard_bits_++;
+  }
+  for (int i = 0; i < (1 << shard_bits_); i++) {
+    shards_.emplace_back(make_unique<FrameShard>());
+  }
+}
 
 RC BPFrameManager::init(int pool_num)
 {
   int ret = allocator_.init(false, pool_num);
-  if (ret == 0) {
-    return RC::SUCCESS;
+  if (ret != 0) {
+    return RC::NOMEM;
+  }
+
+  // 内存池不能扩展，初始化时就把所有的页帧取出来分给各个分片
+  size_t index = 0;
+  for (Frame *frame = allocator_.alloc(); frame != nullptr; frame = allocator_.alloc()) {
+    shards_[index++ % shards_.size()]->free_frames.push_back(frame);
+  }
+  for (unique_ptr<FrameShard> &shard : shards_) {
+    shard->replacer = FrameReplacer::create(replacer_type_, shard->free_frames.size());
   }
-  return RC::NOMEM;
+  LOG_INFO("frame manager init with %d frames in %d shards, replacer=%s",
+           static_cast<int>(index), shard_num(), frame_replacer_type_name(replacer_type_));
+  return RC::SUCCESS;
 }
 
 RC BPFrameManager::cleanup()
 {
-  if (frames_.count() > 0) {
+  if (frame_num() > 0) {
     return RC::INTERNAL;
   }
 
-  frames_.destroy();
+  for (unique_ptr<FrameShard> &shard : shards_) {
+    for (Frame *frame : shard->free_frames) {
+      allocator_.free(frame);
+    }
+    shard->free_frames.clear();
+    shard->frames.clear();
+  }
   return RC::SUCCESS;
 }
 
-int BPFrameManager::purge_frames(int count, function<RC(Frame *frame)> purger)
+size_t BPFrameManager::frame_num() const
 {
-  lock_guard<mutex> lock_guard(lock_);
+  size_t num = 0;
+  for (const unique_ptr<FrameShard> &shard : shards_) {
+    num += shard->frames.size();
+  }
+  return num;
+}
 
-  vector<Frame *> frames_can_purge;
+BPFrameManager::FrameShard &BPFrameManager::shard_of(const FrameId &frame_id)
+{
+  // 同一个文件中相邻的页面只有低位不同，乘以一个奇数常量把低位的差异扩散到高位，再取高位作为分片号
+  if (shard_bits_ == 0) {
+    return *shards_[0];
+  }
+  const uint64_t hash = static_cast<uint64_t>(frame_id.hash()) * 0x9E3779B97F4A7C15ULL;
+  return *shards_[hash >> (64 - shard_bits_)];
+}
+
+int BPFrameManager::purge_frames(int count, function<RC(Frame *frame)> purger)
+{
   if (count <= 0) {
     count = 1;
   }
+
+  // 每次从不同的分片开始，避免总是淘汰同一个分片中的页面
+  // 先在所有分片中找干净的页面，都找不到时才淘汰脏页
+  const size_t start       = purge_cursor_.fetch_add(1, std::memory_order_relaxed);
+  int          freed_count = 0;
+  for (bool allow_dirty : {false, true}) {
+    for (size_t i = 0; i < shards_.size() && freed_count < count; i++) {
+      FrameShard &shard = *shards_[(start + i) % shards_.size()];
+      freed_count += purge_shard(shard, count - freed_count, allow_dirty, purger);
+    }
+  }
+  LOG_INFO("purge frame done. number=%d", freed_count);
+  return freed_count;
+}
+
+int BPFrameManager::purge_shard(
+    FrameShard &shard, int count, bool allow_dirty, const function<RC(Frame *frame)> &purger)
+{
+  lock_guard<mutex> lock_guard(shard.lock);
+
+  vector<Frame *> frames_can_purge;
+  vector<Frame *> dirty_frames;
   frames_can_purge.reserve(count);
 
-  auto purge_finder = [&frames_can_purge, count](const FrameId &frame_id, Frame *const frame) {
+  int  scanned      = 0;
+  auto purge_finder = [&](Frame *frame) {
+    scanned++;
     if (frame->can_purge()) {
-      frame->pin();
-      frames_can_purge.push_back(frame);
-      if (frames_can_purge.size() >= static_cast<size_t>(count)) {
-        return false;  // false to break the progress
+      if (!frame->dirty()) {
+        frames_can_purge.push_back(frame);
+      } else if (allow_dirty && dirty_frames.size() < static_cast<size_t>(count)) {
+        dirty_frames.push_back(frame);
       }
     }
-    return true;  // true continue to look up
+    if (frames_can_purge.size() >= static_cast<size_t>(count)) {
+      return false;  // false to break the progress
+    }
+    // 脏页需要在前台刷盘，所以多看几个页帧，尽量找干净的页面
+    return scanned < PURGE_SCAN_DEPTH ||
+           (allow_dirty && frames_can_purge.size() + dirty_frames.size() < static_cast<size_t>(count));
   };
 
-  frames_.foreach_reverse(purge_finder);
-  LOG_INFO("purge frames find %ld pages total", frames_can_purge.size());
+  shard.replacer->foreach_victim(purge_finder);
+  for (size_t i = 0; i < dirty_frames.size() && frames_can_purge.size() < static_cast<size_t>(count); i++) {
+    frames_can_purge.push_back(dirty_frames[i]);
+  }
+  for (Frame *frame : frames_can_purge) {
+    frame->pin();
+  }
+  LOG_TRACE("purge frames find %ld pages in shard", frames_can_purge.size());
 
-  /// 当前还在frameManager的锁内，而 purger 是一个非常耗时的操作
-  /// 他需要把脏页数据刷新到磁盘上去，所以这里会极大地降低并发度
+  /// 当前还在分片的锁内，而 purger 是一个非常耗时的操作
+  /// 他需要把脏页数据刷新到磁盘上去，只是不再影响其它分片中页面的访问
   int freed_count = 0;
   for (Frame *frame : frames_can_purge) {
     RC rc = purger(frame);
     if (RC::SUCCESS == rc) {
-      free_internal(frame->frame_id(), frame);
+      free_internal(shard, frame->frame_id(), frame);
       freed_count++;
     } else {
       frame->unpin();
@@ -107,87 +192,172 @@ int BPFrameManager::purge_frames(int count, function<RC(Frame *frame)> purger)
                frame->frame_id().to_string().c_str(), strrc(rc));
     }
   }
-  LOG_INFO("purge frame done. number=%d", freed_count);
   return freed_count;
 }
 
 Frame *BPFrameManager::get(int buffer_pool_id, PageNum page_num)
 {
-  FrameId                     frame_id(buffer_pool_id, page_num);
+  FrameId     frame_id(buffer_pool_id, page_num);
+  FrameShard &shard = shard_of(frame_id);
 
-  lock_guard<mutex> lock_guard(lock_);
-  return get_internal(frame_id);
+  lock_guard<mutex> lock_guard(shard.lock);
+  return get_internal(shard, frame_id);
 }
 
-Frame *BPFrameManager::get_internal(const FrameId &frame_id)
+Frame *BPFrameManager::get_internal(FrameShard &shard, const FrameId &frame_id)
 {
-  Frame *frame = nullptr;
-  (void)frames_.get(frame_id, frame);
-  if (frame != nullptr) {
-    frame->pin();
+  auto iter = shard.frames.find(frame_id);
+  if (iter == shard.frames.end()) {
+    return nullptr;
   }
+
+  Frame *frame = iter->second;
+  frame->pin();
+  shard.replacer->on_access(frame);
   return frame;
 }
 
 Frame *BPFrameManager::alloc(int buffer_pool_id, PageNum page_num)
 {
-  FrameId frame_id(buffer_pool_id, page_num);
+  FrameId     frame_id(buffer_pool_id, page_num);
+  FrameShard &shard = shard_of(frame_id);
 
-  lock_guard<mutex> lock_guard(lock_);
+  {
+    lock_guard<mutex> lock_guard(shard.lock);
 
-  Frame                      *frame = get_internal(frame_id);
-  if (frame != nullptr) {
-    return frame;
+    Frame *frame = get_internal(shard, frame_id);
+    if (frame != nullptr) {
+      return frame;
+    }
+
+    if (!shard.free_frames.empty()) {
+      frame = shard.free_frames.back();
+      shard.free_frames.pop_back();
+      return install(shard, frame_id, frame);
+    }
   }
 
-  frame = allocator_.alloc();
+  // 同时持有两个分片的锁可能会死锁，所以先放开当前分片的锁再去其它分片找
+  Frame *free_frame = steal_free_frame(shard);
+  if (nullptr == free_frame) {
+    return nullptr;
+  }
+
+  lock_guard<mutex> lock_guard(shard.lock);
+
+  // 放开锁的这段时间里，其它线程可能已经分配了同一个页面
+  Frame *frame = get_internal(shard, frame_id);
   if (frame != nullptr) {
-    ASSERT(frame->pin_count() == 0, "got an invalid frame that pin count is not 0. frame=%s", 
-           frame->to_string().c_str());
-    frame->set_buffer_pool_id(buffer_pool_id);
-    frame->set_page_num(page_num);
-    frame->pin();
-    frames_.put(frame_id, frame);
+    shard.free_frames.push_back(free_frame);
+    return frame;
   }
+  return install(shard, frame_id, free_frame);
+}
+
+Frame *BPFrameManager::install(FrameShard &shard, const FrameId &frame_id, Frame *frame)
+{
+  ASSERT(frame->pin_count() == 0, "got an invalid frame that pin count is not 0. frame=%s", 
+         frame->to_string().c_str());
+  frame->set_buffer_pool_id(frame_id.buffer_pool_id());
+  frame->set_page_num(frame_id.page_num());
+  frame->clear_prefetched();
+  frame->pin();
+  shard.frames.emplace(frame_id, frame);
+  shard.replacer->on_insert(frame);
   return frame;
 }
 
+Frame *BPFrameManager::steal_free_frame(const FrameShard &excluded)
+{
+  for (unique_ptr<FrameShard> &shard : shards_) {
+    if (shard.get() == &excluded) {
+      continue;
+    }
+
+    lock_guard<mutex> lock_guard(shard->lock);
+    if (!shard->free_frames.empty()) {
+      Frame *frame = shard->free_frames.back();
+      shard->free_frames.pop_back();
+      return frame;
+    }
+  }
+  return nullptr;
+}
+
 RC BPFrameManager::free(int buffer_pool_id, PageNum page_num, Frame *frame)
 {
-  FrameId frame_id(buffer_pool_id, page_num);
+  FrameId     frame_id(buffer_pool_id, page_num);
+  FrameShard &shard = shard_of(frame_id);
 
-  lock_guard<mutex> lock_guard(lock_);
-  return free_internal(frame_id, frame);
+  lock_guard<mutex> lock_guard(shard.lock);
+  if (frame->pin_count() != 1) {
+    return RC::LOCKED_UNLOCK;
+  }
+  return free_internal(shard, frame_id, frame);
 }
 
-RC BPFrameManager::free_internal(const FrameId &frame_id, Frame *frame)
+RC BPFrameManager::free_internal(FrameShard &shard, const FrameId &frame_id, Frame *frame)
 {
-  Frame                *frame_source = nullptr;
-  [[maybe_unused]] bool found        = frames_.get(frame_id, frame_source);
+  auto                  iter         = shard.frames.find(frame_id);
+  [[maybe_unused]] bool found        = iter != shard.frames.end();
+  [[maybe_unused]] Frame *frame_source = found ? iter->second : nullptr;
   ASSERT(found && frame == frame_source && frame->pin_count() == 1,
       "failed to free frame. found=%d, frameId=%s, frame_source=%p, frame=%p, pinCount=%d, lbt=%s",
       found, frame_id.to_string().c_str(), frame_source, frame, frame->pin_count(), lbt());
 
+  shard.replacer->on_remove(frame);
   frame->set_page_num(-1);
   frame->unpin();
-  frames_.remove(frame_id);
-  allocator_.free(frame);
+  shard.frames.erase(iter);
+  shard.free_frames.push_back(frame);
   return RC::SUCCESS;
 }
 
-list<Frame *> BPFrameManager::find_list(int buffer_pool_id)
+void BPFrameManager::collect_dirty_victims(
+    int shard_index, int depth, vector<Frame *> &frames, const function<bool(Frame *)> &filter)
 {
-  lock_guard<mutex> lock_guard(lock_);
+  FrameShard       &shard = *shards_[shard_index];
+  lock_guard<mutex> lock_guard(shard.lock);
 
-  list<Frame *> frames;
-  auto               fetcher = [&frames, buffer_pool_id](const FrameId &frame_id, Frame *const frame) -> bool {
-    if (buffer_pool_id == frame_id.buffer_pool_id()) {
+  int remain = depth - static_cast<int>(shard.free_frames.size());
+  if (remain <= 0) {
+    return;
+  }
+
+  shard.replacer->peek_victims([&frames, &remain, &filter](Frame *frame) {
+    if (frame->can_purge() && frame->dirty() && (!filter || filter(frame))) {
       frame->pin();
       frames.push_back(frame);
     }
-    return true;
-  };
-  frames_.foreach (fetcher);
+    return --remain > 0;
+  });
+}
+
+void BPFrameManager::collect_dirty_frames(int buffer_pool_id, vector<Frame *> &frames)
+{
+  for (unique_ptr<FrameShard> &shard : shards_) {
+    lock_guard<mutex> lock_guard(shard->lock);
+    for (auto &[frame_id, frame] : shard->frames) {
+      if (buffer_pool_id == frame_id.buffer_pool_id() && frame->dirty()) {
+        frame->pin();
+        frames.push_back(frame);
+      }
+    }
+  }
+}
+
+list<Frame *> BPFrameManager::find_list(int buffer_pool_id)
+{
+  list<Frame *> frames;
+  for (unique_ptr<FrameShard> &shard : shards_) {
+    lock_guard<mutex> lock_guard(shard->lock);
+    for (auto &[frame_id, frame] : shard->frames) {
+      if (buffer_pool_id == frame_id.buffer_pool_id()) {
+        frame->pin();
+        frames.push_back(frame);
+      }
+    }
+  }
   return frames;
 }
 
@@ -293,6 +463,16 @@ RC DiskBufferPool::close_file()
 
   hdr_frame_->unpin();
 
+  // 预读线程会访问这个文件，先等它们结束
+  bp_manager_.page_prefetcher().discard(*this);
+
+  // 等待后台刷脏线程释放这个文件的页面，关闭完成之前不再刷这个文件的页面
+  // 最后 bp_manager_.close_file 会释放当前对象，这里不能再访问成员变量
+  PageCleaner  &page_cleaner   = bp_manager_.page_cleaner();
+  const int32_t buffer_pool_id = id();
+  page_cleaner.begin_close(buffer_pool_id);
+  DEFER(page_cleaner.end_close(buffer_pool_id));
+
   // TODO: 理论上是在回放时回滚未提交事务，但目前没有undo log，因此不下刷数据page，只通过redo log回放
   rc = purge_all_pages();
   if (rc != RC::SUCCESS) {
@@ -319,20 +499,46 @@ RC DiskBufferPool::close_file()
   return RC::SUCCESS;
 }
 
-RC DiskBufferPool::get_this_page(PageNum page_num, Frame **frame)
+RC DiskBufferPool::get_this_page(PageNum page_num, Frame **frame, BufferRing *ring)
 {
   RC rc  = RC::SUCCESS;
   *frame = nullptr;
 
+  check_read_ahead(page_num);
+
   Frame *used_match_frame = frame_manager_.get(id(), page_num);
   if (used_match_frame != nullptr) {
     used_match_frame->access();
+    if (first_access_prefetched(used_match_frame)) {
+      // 预读的页面也是批量访问加载进来的，同样通过环回收，不要挤占共享缓存
+      if (ring != nullptr) {
+        scoped_lock lock_guard(lock_);
+        recycle_ring_page(ring);
+        ring->push(page_num);
+      }
+    }
     *frame = used_match_frame;
     return RC::SUCCESS;
   }
 
   scoped_lock lock_guard(lock_);  // 直接加了一把大锁，其实可以根据访问的页面来细化提高并行度
 
+  // 等锁的时候，页面可能已经被其它线程或者预读线程加载了
+  used_match_frame = frame_manager_.get(id(), page_num);
+  if (used_match_frame != nullptr) {
+    used_match_frame->access();
+    if (first_access_prefetched(used_match_frame)) {
+      if (ring != nullptr) {
+        recycle_ring_page(ring);
+        ring->push(page_num);
+      }
+    }
+    *frame = used_match_frame;
+    return RC::SUCCESS;
+  }
+
+  recycle_ring_page(ring);
+
   // Allocate one page and load the data into this page
   Frame *allocated_frame = nullptr;
 
@@ -352,11 +558,15 @@ RC DiskBufferPool::get_this_page(PageNum page_num, Frame **frame)
     return rc;
   }
 
+  if (ring != nullptr) {
+    ring->push(page_num);
+  }
+
   *frame = allocated_frame;
   return RC::SUCCESS;
 }
 
-RC DiskBufferPool::allocate_page(Frame **frame)
+RC DiskBufferPool::allocate_page(Frame **frame, BufferRing *ring)
 {
   RC rc = RC::SUCCESS;
 
@@ -383,7 +593,7 @@ RC DiskBufferPool::allocate_page(Frame **frame)
         hdr_frame_->set_lsn(lsn);
 
         lock_.unlock();
-        return get_this_page(i, frame);
+        return get_this_page(i, frame, ring);
       }
     }
   }
@@ -403,6 +613,8 @@ RC DiskBufferPool::allocate_page(Frame **frame)
   }
   hdr_frame_->set_lsn(lsn);
 
+  recycle_ring_page(ring);
+
   PageNum page_num        = file_header_->page_count;
   Frame  *allocated_frame = nullptr;
   if ((rc = allocate_frame(page_num, &allocated_frame)) != RC::SUCCESS) {
@@ -434,6 +646,10 @@ RC DiskBufferPool::allocate_page(Frame **frame)
     // return tmp;
   }
 
+  if (ring != nullptr) {
+    ring->push(page_num);
+  }
+
   lock_.unlock();
 
   *frame = allocated_frame;
@@ -447,15 +663,28 @@ RC DiskBufferPool::dispose_page(PageNum page_num)
     return RC::INTERNAL;
   }
   
-  scoped_lock lock_guard(lock_);
-  Frame           *used_frame = frame_manager_.get(id(), page_num);
+  Frame *used_frame = frame_manager_.get(id(), page_num);
   if (used_frame != nullptr) {
-    ASSERT("the page try to dispose is in use. frame:%s", used_frame->to_string().c_str());
-    frame_manager_.free(id(), page_num, used_frame);
+    // B+树乐观地查找叶子节点时，内部节点只pin住不加锁，可能还有线程pin着这个页面。
+    // 它们校验版本号失败后很快就会释放。等待时不能持有 lock_，否则它们加载其它页面时会被阻塞。
+    // 一直没有释放时说明页面还在使用，不能释放
+    RC rc = frame_manager_.free(id(), page_num, used_frame);
+    for (int i = 0; rc == RC::LOCKED_UNLOCK && i < DISPOSE_PAGE_RETRY_TIMES; i++) {
+      this_thread::yield();
+      rc = frame_manager_.free(id(), page_num, used_frame);
+    }
+    if (OB_FAIL(rc)) {
+      LOG_ERROR("Failed to dispose page %d, because it is still in use. frame=%s, rc=%s",
+          page_num, used_frame->to_string().c_str(), strrc(rc));
+      used_frame->unpin();
+      return rc;
+    }
   } else {
     LOG_DEBUG("page not found in memory while disposing it. pageNum=%d", page_num);
   }
 
+  scoped_lock lock_guard(lock_);
+
   LSN lsn = 0;
   RC rc = log_handler_.deallocate_page(page_num, lsn);
   if (OB_FAIL(rc)) {
@@ -498,6 +727,178 @@ RC DiskBufferPool::purge_frame(PageNum page_num, Frame *buf)
   return RC::SUCCESS;
 }
 
+unique_ptr<BufferRing> DiskBufferPool::make_buffer_ring() const
+{
+  const size_t total_frame_num = frame_manager_.total_frame_num();
+  if (static_cast<size_t>(file_header_->page_count) <= total_frame_num / 4) {
+    return nullptr;
+  }
+  // 缓存很小时环也要相应小一些
+  return make_unique<BufferRing>(static_cast<int>(std::min<size_t>(BufferRing::DEFAULT_SIZE, total_frame_num / 8)));
+}
+
+void DiskBufferPool::recycle_ring_page(BufferRing *ring)
+{
+  if (ring == nullptr || !ring->full()) {
+    return;
+  }
+
+  const PageNum page_num = ring->oldest();
+  Frame        *frame    = frame_manager_.get(id(), page_num);
+  if (frame == nullptr) {
+    return;  // 已经被正常的页面置换淘汰了
+  }
+
+  if (frame->pin_count() > 1) {
+    frame->unpin();
+    return;
+  }
+
+  RC rc = purge_frame(page_num, frame);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to recycle ring page. file=%s, page=%d, rc=%s", file_name_.c_str(), page_num, strrc(rc));
+    frame->unpin();
+  }
+}
+
+void DiskBufferPool::check_read_ahead(PageNum page_num)
+{
+  PagePrefetcher &prefetcher = bp_manager_.page_prefetcher();
+  if (!prefetcher.running()) {
+    return;
+  }
+
+  const PageNum last_page = last_access_page_.exchange(page_num, std::memory_order_relaxed);
+  if (page_num <= last_page || page_num > last_page + SEQUENTIAL_MAX_GAP) {
+    sequential_count_.store(0, std::memory_order_relaxed);
+    return;
+  }
+  if (sequential_count_.fetch_add(1, std::memory_order_relaxed) + 1 < SEQUENTIAL_TRIGGER_COUNT) {
+    return;
+  }
+
+  const int window = prefetcher.window_pages();
+  if (window <= 1) {
+    return;
+  }
+
+  // 上一次预读的范围就在当前页面后面时接着读，否则说明是一次新的扫描，从当前页面开始
+  PageNum end_page   = read_ahead_end_.load(std::memory_order_relaxed);
+  PageNum start_page = page_num + 1;
+  if (end_page > page_num && end_page <= page_num + 1 + window) {
+    if (end_page - page_num > window / 2) {
+      return;  // 预读的页面还没有访问过半
+    }
+    start_page = end_page;
+  }
+  if (start_page >= file_header_->page_count) {
+    return;
+  }
+
+  // 同时有多个线程发现需要预读时，只有一个提交请求
+  if (!read_ahead_end_.compare_exchange_strong(end_page, start_page + window)) {
+    return;
+  }
+  prefetcher.submit(*this, start_page, window);
+}
+
+bool DiskBufferPool::first_access_prefetched(Frame *frame)
+{
+  if (!frame->clear_prefetched()) {
+    return false;
+  }
+
+  // 预读线程读取页面时加着写锁，加一次读锁等待读取完成
+  frame->read_latch();
+  frame->read_unlatch();
+  bp_manager_.page_prefetcher().on_hit();
+  return true;
+}
+
+void DiskBufferPool::prefetch_pages(PageNum start_page, int count)
+{
+  bp_manager_.page_prefetcher().submit(*this, start_page, count);
+}
+
+int DiskBufferPool::load_pages(PageNum start_page, int count)
+{
+  // 需要从磁盘读取的页面，按照页号排序。页帧都加着写锁，其它线程访问时会等待读取完成
+  vector<Frame *> frames;
+  int             loaded = 0;
+
+  {
+    scoped_lock lock_guard(lock_);
+    if (file_desc_ < 0) {
+      return 0;
+    }
+
+    const PageNum end_page = std::min(start_page + count, file_header_->page_count);
+    for (PageNum page_num = std::max(start_page, BP_HEADER_PAGE + 1); page_num < end_page; page_num++) {
+      if ((file_header_->bitmap[page_num / 8] & (1 << (page_num % 8))) == 0) {
+        continue;
+      }
+
+      Frame *frame = frame_manager_.get(id(), page_num);
+      if (frame != nullptr) {
+        frame->unpin();
+        continue;
+      }
+
+      RC rc = allocate_frame(page_num, &frame);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to allocate frame for prefetch. file=%s, page=%d, rc=%s",
+                 file_name_.c_str(), page_num, strrc(rc));
+        break;
+      }
+      frame->set_buffer_pool_id(id());
+      frame->write_latch();
+      frame->mark_prefetched();
+
+      // 还没有写回数据文件的页面要从 double write buffer 中读取
+      rc = dblwr_manager_.read_page(this, page_num, frame->page());
+      if (OB_SUCC(rc)) {
+        frame->write_unlatch();
+        frame->unpin();
+        loaded++;
+        continue;
+      }
+
+      frames.push_back(frame);
+    }
+  }
+
+  // 页帧已经在页帧表中并且被pin住了，不会被其它线程加载或者淘汰，读磁盘时不需要持有 lock_，
+  // 这样同一个文件上前台线程的加载和其它预读线程的读取都不用等待这次IO
+  vector<Page *> pages;
+  for (size_t begin = 0, end = 0; begin < frames.size(); begin = end) {
+    pages.clear();
+    const PageNum first_page = frames[begin]->page_num();
+    for (end = begin; end < frames.size() && frames[end]->page_num() == first_page + static_cast<PageNum>(end - begin);
+         end++) {
+      pages.push_back(&frames[end]->page());
+    }
+
+    RC rc = read_pages(first_page, pages);
+    for (size_t i = begin; i < end; i++) {
+      Frame *frame = frames[i];
+      frame->write_unlatch();
+      if (OB_SUCC(rc)) {
+        frame->unpin();
+        loaded++;
+        continue;
+      }
+
+      // 读取失败时释放页帧，已经有其它线程在访问的页面，由它们自己去重新加载
+      frame->clear_prefetched();
+      scoped_lock lock_guard(lock_);
+      if (OB_FAIL(purge_frame(frame->page_num(), frame))) {
+        frame->unpin();
+      }
+    }
+  }
+  return loaded;
+}
+
 RC DiskBufferPool::purge_page(PageNum page_num)
 {
   scoped_lock lock_guard(lock_);
@@ -574,16 +975,11 @@ RC DiskBufferPool::flush_page_internal(Frame &frame)
 
 RC DiskBufferPool::flush_all_pages()
 {
-  list<Frame *> used = frame_manager_.find_list(id());
-  for (Frame *frame : used) {
-    RC rc = flush_page(*frame);
-    frame->unpin();
-    if (rc != RC::SUCCESS) {
-      LOG_WARN("failed to flush all pages");
-      return rc;
-    }
+  RC rc = bp_manager_.page_cleaner().flush_all(id());
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to flush all pages");
   }
-  return RC::SUCCESS;
+  return rc;
 }
 
 RC DiskBufferPool::recover_page(PageNum page_num)
@@ -620,6 +1016,71 @@ RC DiskBufferPool::write_page(PageNum page_num, Page &page)
   return RC::SUCCESS;
 }
 
+RC DiskBufferPool::write_pages(PageNum page_num, span<Page *const> pages)
+{
+  scoped_lock lock_guard(wr_lock_);
+
+  vector<iovec> iovs;
+  size_t        written = 0;
+  while (written < pages.size()) {
+    const size_t count = std::min<size_t>(pages.size() - written, IOV_MAX);
+    iovs.resize(count);
+    for (size_t i = 0; i < count; i++) {
+      iovs[i].iov_base = pages[written + i];
+      iovs[i].iov_len  = sizeof(Page);
+    }
+
+    const int64_t offset = ((int64_t)(page_num + written)) * sizeof(Page);
+    const ssize_t ret    = pwritev(file_desc_, iovs.data(), static_cast<int>(count), offset);
+    if (ret < 0 && errno == EINTR) {
+      continue;
+    }
+    if (ret <= 0) {
+      LOG_ERROR("Failed to write %d pages from %d of %s due to %s.",
+          static_cast<int>(count), page_num + static_cast<int>(written), file_name_.c_str(), strerror(errno));
+      return RC::IOERR_WRITE;
+    }
+
+    // 只写了一部分时，从第一个没有写完整的页面重新开始写
+    written += ret / sizeof(Page);
+  }
+
+  LOG_TRACE("write_pages: buffer_pool_id:%d, page_num:%d, count:%d", id(), page_num, static_cast<int>(pages.size()));
+  return RC::SUCCESS;
+}
+
+RC DiskBufferPool::read_pages(PageNum page_num, span<Page *const> pages)
+{
+  // preadv 不使用文件偏移，不需要加 wr_lock_
+  vector<iovec> iovs;
+  size_t        read_count = 0;
+  while (read_count < pages.size()) {
+    const size_t count = std::min<size_t>(pages.size() - read_count, IOV_MAX);
+    iovs.resize(count);
+    for (size_t i = 0; i < count; i++) {
+      iovs[i].iov_base = pages[read_count + i];
+      iovs[i].iov_len  = sizeof(Page);
+    }
+
+    const int64_t offset = ((int64_t)(page_num + read_count)) * sizeof(Page);
+    const ssize_t ret    = preadv(file_desc_, iovs.data(), static_cast<int>(count), offset);
+    if (ret < 0 && errno == EINTR) {
+      continue;
+    }
+    if (ret < static_cast<ssize_t>(sizeof(Page))) {
+      LOG_ERROR("Failed to read %d pages from %d of %s due to %s. ret=%ld",
+          static_cast<int>(count), page_num + static_cast<int>(read_count), file_name_.c_str(), strerror(errno), ret);
+      return RC::IOERR_READ;
+    }
+
+    // 只读了一部分时，从第一个没有读完整的页面重新开始读
+    read_count += ret / sizeof(Page);
+  }
+
+  LOG_TRACE("read_pages: buffer_pool_id:%d, page_num:%d, count:%d", id(), page_num, static_cast<int>(pages.size()));
+  return RC::SUCCESS;
+}
+
 RC DiskBufferPool::redo_allocate_page(LSN lsn, PageNum page_num)
 {
   if (hdr_frame_->lsn() >= lsn) {
@@ -698,6 +1159,9 @@ RC DiskBufferPool::allocate_frame(PageNum page_num, Frame **buffer)
       return RC::SUCCESS;
     }
 
+    // 后台刷脏跟不上了，前台线程只能自己刷盘
+    bp_manager_.page_cleaner().wakeup();
+
     RC rc = RC::SUCCESS;
     if (frame->buffer_pool_id() == id()) {
       rc = this->flush_page_internal(*frame);
@@ -771,7 +1235,10 @@ RC DiskBufferPool::load_page(PageNum page_num, Frame *frame)
 int DiskBufferPool::file_desc() const { return file_desc_; }
 
 ////////////////////////////////////////////////////////////////////////////////
-BufferPoolManager::BufferPoolManager(int memory_size /* = 0 */)
+BufferPoolManager::BufferPoolManager(int memory_size /* = 0 */, FrameReplacerType replacer_type /*= FrameReplacerType::LRU*/)
+    : frame_manager_("BufPool", BPFrameManager::DEFAULT_SHARD_NUM, replacer_type),
+      page_cleaner_(*this),
+      page_prefetcher_(frame_manager_)
 {
   if (memory_size <= 0) {
     memory_size = MEM_POOL_ITEM_NUM * DEFAULT_ITEM_NUM_PER_POOL * BP_PAGE_SIZE;
@@ -784,6 +1251,9 @@ BufferPoolManager::BufferPoolManager(int memory_size /* = 0 */)
 
 BufferPoolManager::~BufferPoolManager()
 {
+  page_prefetcher_.stop();
+  page_cleaner_.stop();
+
   unordered_map<string, DiskBufferPool *> tmp_bps;
   tmp_bps.swap(buffer_pools_);
 
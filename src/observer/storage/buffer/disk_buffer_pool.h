@@ -25,16 +25,22 @@ See the Mulan PSL v2 for more details. */
 #include <time.h>
 #include <optional>
 
+#include "common/lang/atomic.h"
 #include "common/lang/bitmap.h"
-#include "common/lang/lru_cache.h"
 #include "common/lang/mutex.h"
 #include "common/lang/memory.h"
+#include "common/lang/span.h"
 #include "common/lang/unordered_map.h"
+#include "common/lang/vector.h"
 #include "common/mm/mem_pool.h"
 #include "common/rc.h"
 #include "common/types.h"
+#include "storage/buffer/buffer_ring.h"
 #include "storage/buffer/frame.h"
+#include "storage/buffer/frame_replacer.h"
 #include "storage/buffer/page.h"
+#include "storage/buffer/page_cleaner.h"
+#include "storage/buffer/page_prefetcher.h"
 #include "storage/buffer/buffer_pool_log.h"
 
 class BufferPoolManager;
@@ -83,11 +89,21 @@ struct BPFileHeader
  * 当内存中的页帧不够用时，需要从内存中淘汰一些页帧，以便为新的页帧腾出空间。
  * 这个管理器负责为所有的BufferPool提供页帧管理服务，也就是所有的BufferPool磁盘文件
  * 在访问时都使用这个管理器映射到内存。
+ * 所有的页面访问都要经过这里，为了避免所有线程竞争同一把锁，页帧按照 FrameId 的哈希值划分到多个分片中，
+ * 每个分片有自己的锁、页面置换策略和空闲页帧列表。空闲页帧在初始化时从内存池中一次性取出，平均分给各个分片，
+ * 某个分片没有空闲页帧时可以从其它分片取一个。淘汰时按照分片轮流进行，每个分片内部按照置换策略选择页面。
  */
 class BPFrameManager
 {
 public:
-  BPFrameManager(const char *tag);
+  static constexpr int DEFAULT_SHARD_NUM = 16;
+
+  /**
+   * @param shard_num 分片的个数，会向上取整为2的幂
+   * @param replacer_type 页面置换策略
+   */
+  BPFrameManager(
+      const char *tag, int shard_num = DEFAULT_SHARD_NUM, FrameReplacerType replacer_type = FrameReplacerType::LRU);
 
   RC init(int pool_num);
   RC cleanup();
@@ -121,28 +137,47 @@ public:
   /**
    * 尽管frame中已经包含了buffer_pool_id和page_num，但是依然要求
    * 传入，因为frame可能忘记初始化或者没有初始化
+   * 调用者需要pin住frame。如果还有其它地方pin着这个frame，返回 LOCKED_UNLOCK
    */
   RC free(int buffer_pool_id, PageNum page_num, Frame *frame);
 
   /**
    * 如果不能从空闲链表中分配新的页面，就使用这个接口，
-   * 尝试从pin count=0的页面中淘汰一些
+   * 尝试从pin count=0的页面中淘汰一些。每次从不同的分片开始淘汰，一个分片不够时再找下一个
    * @param count 想要purge多少个页面
    * @param purger 需要在释放frame之前，对页面做些什么操作。当前是刷新脏数据到磁盘
    * @return 返回本次清理了多少个页面
    */
   int purge_frames(int count, function<RC(Frame *frame)> purger);
 
-  size_t frame_num() const { return frames_.count(); }
+  /**
+   * @brief 找出分片中即将被淘汰的脏页，交给后台刷脏线程
+   * @details 从淘汰顺序的开头检查 depth 个页帧(空闲页帧也算在内)，返回其中没有被pin住的脏页。
+   * 返回的页帧都被pin住了，调用者使用完后需要unpin。检查时不会改变置换策略的状态
+   * @param shard_index 分片的编号，[0, shard_num())
+   * @param depth 需要保持干净的页帧个数
+   * @param filter 不为空时，在分片的锁内对每个脏页调用，返回false的页面跳过
+   */
+  void collect_dirty_victims(
+      int shard_index, int depth, vector<Frame *> &frames, const function<bool(Frame *)> &filter = nullptr);
+
+  /**
+   * @brief 列出指定文件的所有脏页，返回的页帧都被pin住了
+   */
+  void collect_dirty_frames(int buffer_pool_id, vector<Frame *> &frames);
+
+  /**
+   * 正在使用的页帧个数。没有加锁，并发访问时只是一个近似值
+   */
+  size_t frame_num() const;
 
   /**
    * 测试使用。返回已经从内存申请的个数
    */
   size_t total_frame_num() const { return allocator_.get_size(); }
 
-private:
-  Frame *get_internal(const FrameId &frame_id);
-  RC     free_internal(const FrameId &frame_id, Frame *frame);
+  int               shard_num() const { return static_cast<int>(shards_.size()); }
+  FrameReplacerType replacer_type() const { return replacer_type_; }
 
 private:
   class BPFrameIdHasher
@@ -151,12 +186,46 @@ private:
     size_t operator()(const FrameId &frame_id) const { return frame_id.hash(); }
   };
 
-  using FrameLruCache  = common::LruCache<FrameId, Frame *, BPFrameIdHasher>;
   using FrameAllocator = common::MemPoolSimple<Frame>;
 
-  mutex          lock_;
-  FrameLruCache  frames_;
-  FrameAllocator allocator_;
+  /**
+   * @brief 页帧表的一个分片
+   * @details 分片中的页帧、置换策略和空闲页帧都由 lock 保护
+   */
+  struct FrameShard
+  {
+    mutex                                            lock;
+    unordered_map<FrameId, Frame *, BPFrameIdHasher> frames;
+    unique_ptr<FrameReplacer>                        replacer;
+    vector<Frame *>                                  free_frames;
+  };
+
+  FrameShard &shard_of(const FrameId &frame_id);
+
+  Frame *get_internal(FrameShard &shard, const FrameId &frame_id);
+  RC     free_internal(FrameShard &shard, const FrameId &frame_id, Frame *frame);
+
+  /// @brief 把一个空闲页帧放到分片中，作为 frame_id 对应的页面，调用者需要持有分片的锁
+  Frame *install(FrameShard &shard, const FrameId &frame_id, Frame *frame);
+
+  /// @brief 从其它分片中取一个空闲页帧，调用者不能持有任何分片的锁
+  Frame *steal_free_frame(const FrameShard &excluded);
+
+  /**
+   * @brief 在一个分片中淘汰最多 count 个页面，返回淘汰的个数
+   * @details 优先淘汰干净的页面，在淘汰顺序的前 PURGE_SCAN_DEPTH 个页帧中找不到足够的干净页面时，
+   * 如果 allow_dirty 为 true 才会淘汰脏页，这时需要在前台线程刷盘
+   */
+  int purge_shard(FrameShard &shard, int count, bool allow_dirty, const function<RC(Frame *frame)> &purger);
+
+private:
+  static constexpr int PURGE_SCAN_DEPTH = 32;
+
+  vector<unique_ptr<FrameShard>> shards_;
+  int                            shard_bits_ = 0;
+  atomic<uint32_t>               purge_cursor_{0};  ///< 下次从哪个分片开始淘汰
+  FrameReplacerType              replacer_type_ = FrameReplacerType::LRU;
+  FrameAllocator                 allocator_;
 };
 
 /**
@@ -204,20 +273,43 @@ public:
 
   /**
    * 根据文件ID和页号获取指定页面到缓冲区，返回页面句柄指针。
+   * @param ring 批量访问时使用的私有页帧环，不在缓存中的页面会通过环加载，参考 BufferRing
    */
-  RC get_this_page(PageNum page_num, Frame **frame);
+  RC get_this_page(PageNum page_num, Frame **frame, BufferRing *ring = nullptr);
 
   /**
    * @brief 在指定文件中分配一个新的页面，并将其放入缓冲区，返回页面句柄指针。
    * @details 分配页面时，如果文件中有空闲页，就直接分配一个空闲页；
    * 如果文件中没有空闲页，则扩展文件规模来增加新的空闲页。
+   * @param ring 批量写入时使用的私有页帧环，参考 BufferRing
    */
-  RC allocate_page(Frame **frame);
+  RC allocate_page(Frame **frame, BufferRing *ring = nullptr);
+
+  /**
+   * @brief 给全表扫描这类批量读操作创建私有页帧环
+   * @details 文件页面数超过缓存页帧数的1/4时才需要，小文件扫描时所有页面都可以留在共享缓存中，返回空指针
+   */
+  unique_ptr<BufferRing> make_buffer_ring() const;
+
+  /**
+   * @brief 提示接下来会访问这些页面，由后台线程异步读取到缓存中，参考 PagePrefetcher
+   * @details 按照页号顺序访问时会自动预读，扫描器在访问顺序与页号无关时(比如B+树的叶子节点)可以主动调用
+   */
+  void prefetch_pages(PageNum start_page, int count);
+
+  /**
+   * @brief 把 [start_page, start_page + count) 中已经分配并且不在缓存中的页面读到缓存中
+   * @details 由 PagePrefetcher 的后台线程调用。在 lock_ 内分配页帧并加写锁，放开锁以后再读取，
+   * 页号连续的页面使用一次 preadv 读取
+   * @return 读取的页面个数
+   */
+  int load_pages(PageNum start_page, int count);
 
   /**
    * @brief 释放某个页面，将此页面设置为未分配状态
    *
    * @param page_num 待释放的页面
+   * @return 其它线程一直 pin 着这个页面时返回 LOCKED_UNLOCK，页面不会释放
    */
   RC dispose_page(PageNum page_num);
 
@@ -251,7 +343,7 @@ public:
   RC flush_page(Frame &frame);
 
   /**
-   * 刷新所有页面到double write buffer，即使pin count不是0
+   * 按照页号顺序刷新所有脏页到double write buffer，即使pin count不是0。参考 PageCleaner::flush_all
    */
   RC flush_all_pages();
 
@@ -265,6 +357,12 @@ public:
    */
   RC write_page(PageNum page_num, Page &page);
 
+  /**
+   * @brief 把页号连续的多个页面合并成一次写
+   * @param page_num 第一个页面的页号
+   */
+  RC write_pages(PageNum page_num, span<Page *const> pages);
+
   RC redo_allocate_page(LSN lsn, PageNum page_num);
   RC redo_deallocate_page(LSN lsn, PageNum page_num);
 
@@ -273,6 +371,11 @@ public:
 
   const char *filename() const { return file_name_.c_str(); }
 
+  /**
+   * @brief 文件中已经分配的页面个数（包括文件头页面），可以用来粗略估计数据量
+   */
+  int32_t allocated_pages() const { return file_header_ == nullptr ? 0 : file_header_->allocated_pages; }
+
 protected:
   RC allocate_frame(PageNum page_num, Frame **buf);
 
@@ -280,6 +383,30 @@ protected:
    * 刷新指定页面到磁盘(flush)，并且释放关联的Frame
    */
   RC purge_frame(PageNum page_num, Frame *used_frame);
+
+  /**
+   * @brief 环满时，淘汰环中最早加载的页面，给通过环加载的新页面腾出页帧
+   * @details 需要在 lock_ 内调用。页面如果还被其他人使用，就留给正常的页面置换处理
+   */
+  void recycle_ring_page(BufferRing *ring);
+
+  /**
+   * @brief 检查是否在按照页号顺序访问页面，是的话提前读取后面的页面
+   * @details 预读窗口的前一半被访问完时，提交下一个窗口的预读请求
+   */
+  void check_read_ahead(PageNum page_num);
+
+  /**
+   * @brief 第一次访问预读的页面时调用，预读线程可能还在读取这个页面，需要等待读取完成
+   * @return 是否是预读但是还没有被访问过的页面
+   */
+  bool first_access_prefetched(Frame *frame);
+
+  /**
+   * @brief 把页号连续的多个页面用一次 preadv 读取到内存中
+   */
+  RC read_pages(PageNum page_num, span<Page *const> pages);
+
   RC check_page_num(PageNum page_num);
 
   /**
@@ -310,6 +437,13 @@ private:
   common::Mutex lock_;
   common::Mutex wr_lock_;
 
+  /// 顺序访问检测。多个线程同时扫描时会互相干扰，只是少做一些预读
+  static constexpr int SEQUENTIAL_TRIGGER_COUNT = 2;  ///< 连续几次顺序访问以后开始预读
+  static constexpr int SEQUENTIAL_MAX_GAP       = 2;  ///< 页号间隔不超过这个值都算顺序访问，可以跳过释放掉的页面
+  atomic<PageNum> last_access_page_{BP_INVALID_PAGE_NUM};
+  atomic<int>     sequential_count_{0};
+  atomic<PageNum> read_ahead_end_{BP_INVALID_PAGE_NUM};  ///< 已经提交预读的最后一个页面的下一个页面
+
 private:
   friend class BufferPoolIterator;
 };
@@ -321,7 +455,7 @@ private:
 class BufferPoolManager final
 {
 public:
-  BufferPoolManager(int memory_size = 0);
+  BufferPoolManager(int memory_size = 0, FrameReplacerType replacer_type = FrameReplacerType::LRU);
   ~BufferPoolManager();
 
   RC init(unique_ptr<DoubleWriteBuffer> dblwr_buffer);
@@ -334,6 +468,8 @@ public:
 
   BPFrameManager    &get_frame_manager() { return frame_manager_; }
   DoubleWriteBuffer *get_dblwr_buffer() { return dblwr_buffer_.get(); }
+  PageCleaner       &page_cleaner() { return page_cleaner_; }
+  PagePrefetcher    &page_prefetcher() { return page_prefetcher_; }
 
   /**
    * @brief 根据ID获取对应的BufferPool对象
@@ -344,7 +480,9 @@ public:
   RC get_buffer_pool(int32_t id, DiskBufferPool *&bp);
 
 private:
-  BPFrameManager frame_manager_{"BufPool"};
+  BPFrameManager frame_manager_;
+  PageCleaner    page_cleaner_;     ///< 后台刷脏，依赖 frame_manager_，需要在它之后构造
+  PagePrefetcher page_prefetcher_;  ///< 页面预读，依赖 frame_manager_
 
   unique_ptr<DoubleWriteBuffer> dblwr_buffer_;
 
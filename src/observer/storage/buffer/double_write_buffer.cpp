@@ -79,11 +79,36 @@ RC DiskDoubleWriteBuffer::flush_page()
 {
   sync();
 
+  // 按照文件和页号排序，页号连续的页面合并成一次写
+  vector<DoubleWritePage *> pages;
+  pages.reserve(dblwr_pages_.size());
   for (const auto &pair : dblwr_pages_) {
-    RC rc = write_page(pair.second);
+    if (pair.second->valid) {
+      pages.push_back(pair.second);
+    }
+  }
+  sort(pages.begin(), pages.end(), [](const DoubleWritePage *left, const DoubleWritePage *right) {
+    if (left->key.buffer_pool_id != right->key.buffer_pool_id) {
+      return left->key.buffer_pool_id < right->key.buffer_pool_id;
+    }
+    return left->key.page_num < right->key.page_num;
+  });
+
+  size_t end = 0;
+  for (size_t begin = 0; begin < pages.size(); begin = end) {
+    end = begin + 1;
+    while (end < pages.size() && pages[end]->key.buffer_pool_id == pages[begin]->key.buffer_pool_id &&
+           pages[end]->key.page_num == pages[end - 1]->key.page_num + 1) {
+      end++;
+    }
+
+    RC rc = end - begin == 1 ? write_page(pages[begin]) : write_pages(span(pages.data() + begin, end - begin));
     if (rc != RC::SUCCESS) {
       return rc;
     }
+  }
+
+  for (const auto &pair : dblwr_pages_) {
     pair.second->valid = false;
     write_page_internal(pair.second);
     delete pair.second;
@@ -179,6 +204,23 @@ RC DiskDoubleWriteBuffer::write_page(DoubleWritePage *dblwr_page)
   return disk_buffer->write_page(dblwr_page->key.page_num, dblwr_page->page);
 }
 
+RC DiskDoubleWriteBuffer::write_pages(span<DoubleWritePage *const> dblwr_pages)
+{
+  DiskBufferPool *disk_buffer = nullptr;
+  RC              rc          = bp_manager_.get_buffer_pool(dblwr_pages[0]->key.buffer_pool_id, disk_buffer);
+  ASSERT(OB_SUCC(rc) && disk_buffer != nullptr, "failed to get disk buffer pool of %d", dblwr_pages[0]->key.buffer_pool_id);
+
+  vector<Page *> pages;
+  pages.reserve(dblwr_pages.size());
+  for (DoubleWritePage *dblwr_page : dblwr_pages) {
+    pages.push_back(&dblwr_page->page);
+  }
+
+  LOG_TRACE("double write buffer write pages. buffer_pool_id:%d,page_num:%d,count=%d",
+            dblwr_pages[0]->key.buffer_pool_id, dblwr_pages[0]->key.page_num, static_cast<int>(pages.size()));
+  return disk_buffer->write_pages(dblwr_pages[0]->key.page_num, pages);
+}
+
 RC DiskDoubleWriteBuffer::read_page(DiskBufferPool *bp, PageNum page_num, Page &page)
 {
   scoped_lock lock_guard(lock_);
@@ -15,6 +15,7 @@ See the Mulan PSL v2 for more details. */
 #pragma once
 
 #include "common/lang/mutex.h"
+#include "common/lang/span.h"
 #include "common/lang/unordered_map.h"
 #include "common/types.h"
 #include "common/rc.h"
@@ -101,7 +102,8 @@ public:
 
   /**
    * 将buffer中的页全部写入磁盘，并且清空buffer
-   * TODO 目前的解决方案是等buffer装满后再刷盘，可能会导致程序卡住一段时间
+   * @details 页面按照文件和页号排序后写入，页号连续的页面合并成一次写。
+   * buffer 装满后才会刷盘，后台刷脏线程(PageCleaner)会承担大部分的刷盘，前台线程很少会在这里等待
    */
   RC flush_page();
 
@@ -128,6 +130,11 @@ private:
    */
   RC write_page(DoubleWritePage *page);
 
+  /**
+   * 将同一个文件中页号连续的多个页面一次写入磁盘
+   */
+  RC write_pages(span<DoubleWritePage *const> pages);
+
   /**
    * 将页面写到当前double write buffer文件中
    * @details 每次页面更新都应该写入到磁盘中。保证double write buffer
@@ -76,6 +76,11 @@ void Frame::write_latch(intptr_t xid)
 
   lock_.lock();
 
+  if (write_latch_depth_++ == 0) {
+    version_.store(version_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+  }
+
 #ifdef DEBUG
   write_locker_ = xid;
   ++write_recursive_count_;
@@ -110,6 +115,9 @@ void Frame::write_unlatch(intptr_t xid)
   }
   debug_lock_.unlock();
 
+  if (--write_latch_depth_ == 0) {
+    version_.store(version_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
   lock_.unlock();
 }
 
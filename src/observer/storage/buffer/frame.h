@@ -121,6 +121,26 @@ public:
    */
   void access();
 
+  /**
+   * @brief 设置访问标记，CLOCK 置换策略使用
+   * @details 页面命中时设置，时钟指针经过时清除，不需要加锁
+   */
+  void mark_referenced() { referenced_.store(true, std::memory_order_relaxed); }
+
+  /// @brief 清除访问标记，返回之前是否设置了
+  bool clear_referenced() { return referenced_.exchange(false, std::memory_order_relaxed); }
+
+  /// @brief 是否设置了访问标记
+  bool referenced() const { return referenced_.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief 预读标记，页面是由 PagePrefetcher 读到缓存中的，并且还没有被访问过
+   */
+  void mark_prefetched() { prefetched_.store(true, std::memory_order_relaxed); }
+
+  /// @brief 清除预读标记，返回之前是否设置了。第一次访问预读的页面时调用
+  bool clear_prefetched() { return prefetched_.exchange(false, std::memory_order_relaxed); }
+
   /**
    * @brief 标记指定页面为“脏”页。
    * @details 如果修改了页面的内容，则应调用此函数，
@@ -166,13 +186,30 @@ public:
   void read_unlatch();
   void read_unlatch(intptr_t xid);
 
+  /**
+   * @brief 页面的版本号，用于不加锁地读取页面
+   * @details 加写锁时版本号变成奇数，释放写锁时再变成偶数。不加锁读取页面的线程，在读之前取一次版本号，
+   * 读完之后使用 validate_version 校验。版本号没有变化并且是偶数，说明读取期间没有其它线程修改页面。
+   * 读取的线程需要pin住页面，防止页面被淘汰。
+   */
+  uint64_t read_version() const { return version_.load(std::memory_order_acquire); }
+  bool     validate_version(uint64_t version) const
+  {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return (version & 1) == 0 && version_.load(std::memory_order_relaxed) == version;
+  }
+
   string to_string() const;
 
 private:
   friend class BufferPool;
 
-  bool          dirty_ = false;
-  atomic<int>   pin_count_{0};
+  bool             dirty_ = false;
+  atomic<int>      pin_count_{0};
+  atomic<uint64_t> version_{0};
+  atomic<bool>     referenced_{false};
+  atomic<bool>     prefetched_{false};
+  int              write_latch_depth_ = 0;  ///< 写锁的重入次数，只有持有写锁的线程会访问
   unsigned long acc_time_ = 0;
   FrameId       frame_id_;
   Page          page_;
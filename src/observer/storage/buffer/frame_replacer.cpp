@@ -0,0 +1,217 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "storage/buffer/frame_replacer.h"
+#include "common/lang/algorithm.h"
+#include "common/lang/string.h"
+
+const char *frame_replacer_type_name(FrameReplacerType type)
+{
+  switch (type) {
+    case FrameReplacerType::LRU: return "lru";
+    case FrameReplacerType::CLOCK: return "clock";
+    case FrameReplacerType::TWO_QUEUE: return "2q";
+    default: return "unknown";
+  }
+}
+
+RC frame_replacer_type_from_string(const char *name, FrameReplacerType &type)
+{
+  for (FrameReplacerType candidate : {FrameReplacerType::LRU, FrameReplacerType::CLOCK, FrameReplacerType::TWO_QUEUE}) {
+    if (0 == strcasecmp(name, frame_replacer_type_name(candidate))) {
+      type = candidate;
+      return RC::SUCCESS;
+    }
+  }
+  return RC::INVALID_ARGUMENT;
+}
+
+unique_ptr<FrameReplacer> FrameReplacer::create(FrameReplacerType type, size_t capacity)
+{
+  switch (type) {
+    case FrameReplacerType::CLOCK: return make_unique<ClockFrameReplacer>();
+    case FrameReplacerType::TWO_QUEUE: return make_unique<TwoQueueFrameReplacer>(capacity);
+    default: return make_unique<LruFrameReplacer>();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void LruFrameReplacer::on_insert(Frame *frame)
+{
+  frames_.push_front(frame);
+  positions_[frame] = frames_.begin();
+}
+
+void LruFrameReplacer::on_access(Frame *frame)
+{
+  auto iter = positions_.find(frame);
+  if (iter != positions_.end()) {
+    frames_.splice(frames_.begin(), frames_, iter->second);
+  }
+}
+
+void LruFrameReplacer::on_remove(Frame *frame)
+{
+  auto iter = positions_.find(frame);
+  if (iter != positions_.end()) {
+    frames_.erase(iter->second);
+    positions_.erase(iter);
+  }
+}
+
+void LruFrameReplacer::foreach_victim(const function<bool(Frame *)> &visitor)
+{
+  for (auto iter = frames_.rbegin(); iter != frames_.rend(); ++iter) {
+    if (!visitor(*iter)) {
+      break;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void ClockFrameReplacer::on_insert(Frame *frame)
+{
+  frame->mark_referenced();
+
+  size_t slot = slots_.size();
+  if (!free_slots_.empty()) {
+    slot = free_slots_.back();
+    free_slots_.pop_back();
+    slots_[slot] = frame;
+  } else {
+    slots_.push_back(frame);
+  }
+  positions_[frame] = slot;
+}
+
+void ClockFrameReplacer::on_access(Frame *frame) { frame->mark_referenced(); }
+
+void ClockFrameReplacer::on_remove(Frame *frame)
+{
+  auto iter = positions_.find(frame);
+  if (iter != positions_.end()) {
+    slots_[iter->second] = nullptr;
+    free_slots_.push_back(iter->second);
+    positions_.erase(iter);
+  }
+}
+
+void ClockFrameReplacer::foreach_victim(const function<bool(Frame *)> &visitor)
+{
+  if (slots_.empty()) {
+    return;
+  }
+
+  // 第一圈会清除所有的访问标记，所以转两圈一定能访问到每个页帧
+  const size_t max_steps = slots_.size() * 2;
+  for (size_t step = 0; step < max_steps; step++) {
+    Frame *frame = slots_[hand_];
+    hand_        = (hand_ + 1) % slots_.size();
+    if (nullptr == frame || frame->clear_referenced()) {
+      continue;
+    }
+
+    if (!visitor(frame)) {
+      break;
+    }
+  }
+}
+
+void ClockFrameReplacer::peek_victims(const function<bool(Frame *)> &visitor)
+{
+  // 指针转第一圈时会淘汰没有访问标记的页帧，第二圈才轮到有访问标记的页帧
+  for (bool referenced : {false, true}) {
+    for (size_t step = 0; step < slots_.size(); step++) {
+      Frame *frame = slots_[(hand_ + step) % slots_.size()];
+      if (nullptr == frame || frame->referenced() != referenced) {
+        continue;
+      }
+
+      if (!visitor(frame)) {
+        return;
+      }
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TwoQueueFrameReplacer::TwoQueueFrameReplacer(size_t capacity)
+    : a1in_limit_(max<size_t>(capacity / 4, 1)), a1out_limit_(max<size_t>(capacity / 2, 1))
+{}
+
+void TwoQueueFrameReplacer::on_insert(Frame *frame)
+{
+  // 刚刚从 A1in 中淘汰又被加载的页面，放到 Am 中
+  auto ghost = a1out_index_.find(frame->frame_id());
+  if (ghost != a1out_index_.end()) {
+    a1out_.erase(ghost->second);
+    a1out_index_.erase(ghost);
+
+    am_.push_front(frame);
+    positions_[frame] = Position{true, am_.begin()};
+    return;
+  }
+
+  a1in_.push_front(frame);
+  positions_[frame] = Position{false, a1in_.begin()};
+}
+
+void TwoQueueFrameReplacer::on_access(Frame *frame)
+{
+  // A1in 中的页面再次访问时不移动，短时间内的多次访问通常只是同一个操作
+  auto iter = positions_.find(frame);
+  if (iter != positions_.end() && iter->second.in_am) {
+    am_.splice(am_.begin(), am_, iter->second.iter);
+  }
+}
+
+void TwoQueueFrameReplacer::on_remove(Frame *frame)
+{
+  auto iter = positions_.find(frame);
+  if (iter == positions_.end()) {
+    return;
+  }
+
+  if (iter->second.in_am) {
+    am_.erase(iter->second.iter);
+  } else {
+    a1in_.erase(iter->second.iter);
+
+    const FrameId frame_id = frame->frame_id();
+    if (a1out_index_.find(frame_id) == a1out_index_.end()) {
+      a1out_.push_front(frame_id);
+      a1out_index_[frame_id] = a1out_.begin();
+      if (a1out_.size() > a1out_limit_) {
+        a1out_index_.erase(a1out_.back());
+        a1out_.pop_back();
+      }
+    }
+  }
+  positions_.erase(iter);
+}
+
+void TwoQueueFrameReplacer::foreach_victim(const function<bool(Frame *)> &visitor)
+{
+  auto visit = [&visitor](list<Frame *> &frames) {
+    for (auto iter = frames.rbegin(); iter != frames.rend(); ++iter) {
+      if (!visitor(*iter)) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  // A1in 没有超过限制时，优先淘汰 Am 中最久没有访问的页面
+  if (a1in_.size() > a1in_limit_) {
+    (void)(visit(a1in_) && visit(am_));
+  } else {
+    (void)(visit(am_) && visit(a1in_));
+  }
+}
@@ -0,0 +1,166 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/lang/functional.h"
+#include "common/lang/list.h"
+#include "common/lang/memory.h"
+#include "common/lang/unordered_map.h"
+#include "common/lang/vector.h"
+#include "common/rc.h"
+#include "storage/buffer/frame.h"
+
+/**
+ * @brief 页面置换策略的类型
+ * @ingroup BufferPool
+ */
+enum class FrameReplacerType
+{
+  LRU,        ///< 最近最少使用
+  CLOCK,      ///< 时钟算法，命中时只需要设置访问标记
+  TWO_QUEUE,  ///< 2Q，只访问过一次的页面优先淘汰，可以抵抗全表扫描
+};
+
+const char *frame_replacer_type_name(FrameReplacerType type);
+
+/**
+ * @brief 根据名字（lru、clock、2q，不区分大小写）获取置换策略的类型
+ */
+RC frame_replacer_type_from_string(const char *name, FrameReplacerType &type);
+
+/**
+ * @brief 页面置换策略
+ * @ingroup BufferPool
+ * @details 记录页帧的访问情况，在需要淘汰页面时给出淘汰的顺序。
+ * 置换策略不负责并发控制，BPFrameManager 的每个分片有自己的置换策略对象，所有的调用都在分片的锁内。
+ * 置换策略只决定顺序，页面是否能够淘汰(比如是否被pin住)由调用者判断。
+ */
+class FrameReplacer
+{
+public:
+  virtual ~FrameReplacer() = default;
+
+  /**
+   * @brief 创建置换策略
+   * @param capacity 预计管理的页帧个数，有些策略用它决定各个队列的长度
+   */
+  static unique_ptr<FrameReplacer> create(FrameReplacerType type, size_t capacity);
+
+  virtual FrameReplacerType type() const = 0;
+
+  /// @brief 页面刚刚加载到页帧中
+  virtual void on_insert(Frame *frame) = 0;
+  /// @brief 页面命中
+  virtual void on_access(Frame *frame) = 0;
+  /// @brief 页帧被淘汰或者释放，调用时页帧上还是原来的页面
+  virtual void on_remove(Frame *frame) = 0;
+
+  /**
+   * @brief 按照淘汰的优先顺序遍历页帧
+   * @details 遍历过程中不能调用 on_remove 等修改状态的接口，选中的页帧在遍历结束后再删除
+   * @param visitor 返回 false 时停止遍历
+   */
+  virtual void foreach_victim(const function<bool(Frame *)> &visitor) = 0;
+
+  /**
+   * @brief 按照淘汰的优先顺序查看页帧，但是不改变置换策略的状态
+   * @details 后台刷脏线程用它找到即将被淘汰的脏页，不能影响之后真正淘汰时的顺序
+   */
+  virtual void peek_victims(const function<bool(Frame *)> &visitor) { foreach_victim(visitor); }
+};
+
+/**
+ * @brief LRU 置换策略
+ * @ingroup BufferPool
+ * @details 每次命中都要把页帧移动到链表头部
+ */
+class LruFrameReplacer : public FrameReplacer
+{
+public:
+  FrameReplacerType type() const override { return FrameReplacerType::LRU; }
+
+  void on_insert(Frame *frame) override;
+  void on_access(Frame *frame) override;
+  void on_remove(Frame *frame) override;
+  void foreach_victim(const function<bool(Frame *)> &visitor) override;
+
+private:
+  list<Frame *>                                  frames_;  ///< 头部是最近访问的
+  unordered_map<Frame *, list<Frame *>::iterator> positions_;
+};
+
+/**
+ * @brief CLOCK 置换策略
+ * @ingroup BufferPool
+ * @details 页帧放在一个环上，命中时只设置页帧的访问标记，不需要移动任何数据。
+ * 淘汰时指针沿着环转动，遇到有访问标记的页帧就清除标记给它第二次机会，没有标记的就是淘汰的候选。
+ */
+class ClockFrameReplacer : public FrameReplacer
+{
+public:
+  FrameReplacerType type() const override { return FrameReplacerType::CLOCK; }
+
+  void on_insert(Frame *frame) override;
+  void on_access(Frame *frame) override;
+  void on_remove(Frame *frame) override;
+  void foreach_victim(const function<bool(Frame *)> &visitor) override;
+  void peek_victims(const function<bool(Frame *)> &visitor) override;
+
+private:
+  vector<Frame *>                slots_;       ///< 环上的位置，删除的页帧留下空位
+  vector<size_t>                 free_slots_;  ///< 可以复用的空位
+  unordered_map<Frame *, size_t> positions_;
+  size_t                         hand_ = 0;    ///< 时钟指针
+};
+
+/**
+ * @brief 2Q 置换策略
+ * @ingroup BufferPool
+ * @details 新加载的页面先放到 FIFO 队列 A1in 中，再次命中也不会移动。A1in 中的页面被淘汰后，
+ * 页面编号记录在 A1out 中(只记录编号，不占用页帧)，如果很快又被加载，说明它是热点数据，放到 LRU 队列 Am 中。
+ * A1in 超过总容量的 1/4 时优先从 A1in 中淘汰，所以全表扫描只访问一次的页面不会把 Am 中的热点页面挤出去。
+ * 参考 Johnson and Shasha, 2Q: A Low Overhead High Performance Buffer Management Replacement Algorithm
+ */
+class TwoQueueFrameReplacer : public FrameReplacer
+{
+public:
+  explicit TwoQueueFrameReplacer(size_t capacity);
+
+  FrameReplacerType type() const override { return FrameReplacerType::TWO_QUEUE; }
+
+  void on_insert(Frame *frame) override;
+  void on_access(Frame *frame) override;
+  void on_remove(Frame *frame) override;
+  void foreach_victim(const function<bool(Frame *)> &visitor) override;
+
+private:
+  class FrameIdHasher
+  {
+  public:
+    size_t operator()(const FrameId &frame_id) const { return frame_id.hash(); }
+  };
+
+  struct Position
+  {
+    bool                     in_am = false;
+    list<Frame *>::iterator iter;
+  };
+
+  size_t a1in_limit_  = 0;
+  size_t a1out_limit_ = 0;
+
+  list<Frame *>                    a1in_;  ///< 头部是最近加载的
+  list<Frame *>                    am_;    ///< 头部是最近访问的
+  unordered_map<Frame *, Position> positions_;
+
+  list<FrameId>                                                   a1out_;  ///< 头部是最近淘汰的
+  unordered_map<FrameId, list<FrameId>::iterator, FrameIdHasher> a1out_index_;
+};
@@ -0,0 +1,207 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "storage/buffer/page_cleaner.h"
+#include "common/lang/algorithm.h"
+#include "common/lang/chrono.h"
+#include "common/log/log.h"
+#include "common/thread/thread_util.h"
+#include "storage/buffer/disk_buffer_pool.h"
+
+PageCleaner::PageCleaner(BufferPoolManager &bp_manager) : bp_manager_(bp_manager) {}
+
+PageCleaner::~PageCleaner() { stop(); }
+
+RC PageCleaner::start(int thread_num, int clean_percent, int interval_ms)
+{
+  if (thread_num < 0 || clean_percent < 0 || clean_percent > 100 || interval_ms <= 0) {
+    LOG_WARN("invalid page cleaner arguments. thread num=%d, clean percent=%d, interval=%dms",
+             thread_num, clean_percent, interval_ms);
+    return RC::INVALID_ARGUMENT;
+  }
+  if (running_.load()) {
+    LOG_WARN("page cleaner has been started");
+    return RC::INTERNAL;
+  }
+
+#ifndef CONCURRENCY
+  // 非并发编译时 DiskBufferPool 和页帧上的锁都是空操作，后台线程会和前台线程同时读写文件
+  if (thread_num > 0) {
+    LOG_WARN("page cleaner threads require CONCURRENCY, pages are flushed in foreground only. thread num=%d",
+             thread_num);
+    thread_num = 0;
+  }
+#endif
+
+  clean_percent_ = clean_percent;
+  interval_ms_   = interval_ms;
+  thread_num_    = thread_num;
+  running_.store(true);
+  for (int i = 0; i < thread_num; i++) {
+    threads_.emplace_back(&PageCleaner::thread_func, this, i);
+  }
+  LOG_INFO("page cleaner started. thread num=%d, clean percent=%d", thread_num, clean_percent);
+  return RC::SUCCESS;
+}
+
+void PageCleaner::stop()
+{
+  if (!running_.exchange(false)) {
+    return;
+  }
+
+  wakeup_cv_.notify_all();
+  for (thread &t : threads_) {
+    t.join();
+  }
+  threads_.clear();
+  thread_num_ = 0;
+  LOG_INFO("page cleaner stopped. background flush=%ld, foreground flush=%ld",
+           background_flush_count_.load(), foreground_flush_count_.load());
+}
+
+void PageCleaner::wakeup()
+{
+  foreground_flush_count_.fetch_add(1);
+  wakeup_cv_.notify_all();
+}
+
+void PageCleaner::thread_func(int index)
+{
+  common::thread_set_name("PageCleaner");
+  LOG_INFO("page cleaner thread started. index=%d", index);
+
+  while (running_.load()) {
+    // 刷了一些页面说明写入的压力比较大，马上开始下一轮
+    if (clean(index) > 0) {
+      continue;
+    }
+
+    unique_lock<mutex> lock(wakeup_lock_);
+    wakeup_cv_.wait_for(lock, chrono::milliseconds(interval_ms_));
+  }
+  LOG_INFO("page cleaner thread stopped. index=%d", index);
+}
+
+int PageCleaner::clean(int index)
+{
+  BPFrameManager &frame_manager = bp_manager_.get_frame_manager();
+  const int       shard_num     = frame_manager.shard_num();
+  const int       step          = max(thread_num(), 1);
+  const int       depth         =
+      static_cast<int>(frame_manager.total_frame_num() * clean_percent_ / 100 / static_cast<size_t>(shard_num));
+  if (depth <= 0) {
+    return 0;
+  }
+
+  vector<Frame *> frames;
+  auto            filter = [this](Frame *frame) { return hold(frame->buffer_pool_id()); };
+  for (int shard_index = index; shard_index < shard_num; shard_index += step) {
+    frame_manager.collect_dirty_victims(shard_index, depth, frames, filter);
+  }
+  if (frames.empty()) {
+    return 0;
+  }
+
+  int flushed = 0;
+  RC  rc      = flush_frames(frames, true /*background*/, flushed);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("page cleaner failed to flush pages. rc=%s", strrc(rc));
+  }
+  background_flush_count_.fetch_add(flushed);
+  LOG_TRACE("page cleaner flushed %d pages. index=%d", flushed, index);
+  return flushed;
+}
+
+RC PageCleaner::flush_all(int buffer_pool_id)
+{
+  vector<Frame *> frames;
+  bp_manager_.get_frame_manager().collect_dirty_frames(buffer_pool_id, frames);
+
+  int flushed = 0;
+  RC  rc      = flush_frames(frames, false /*background*/, flushed);
+  LOG_INFO("flush all dirty pages. buffer pool id=%d, flushed=%d, rc=%s", buffer_pool_id, flushed, strrc(rc));
+  return rc;
+}
+
+RC PageCleaner::flush_frames(vector<Frame *> &frames, bool background, int &flushed)
+{
+  sort(frames.begin(), frames.end(), [](const Frame *left, const Frame *right) {
+    if (left->buffer_pool_id() != right->buffer_pool_id()) {
+      return left->buffer_pool_id() < right->buffer_pool_id();
+    }
+    return left->page_num() < right->page_num();
+  });
+
+  RC              rc          = RC::SUCCESS;
+  DiskBufferPool *buffer_pool = nullptr;
+  flushed                     = 0;
+  for (Frame *frame : frames) {
+    const int buffer_pool_id = frame->buffer_pool_id();
+    if (OB_SUCC(rc) && (buffer_pool == nullptr || buffer_pool->id() != buffer_pool_id)) {
+      rc = bp_manager_.get_buffer_pool(buffer_pool_id, buffer_pool);
+    }
+
+    if (OB_SUCC(rc)) {
+      if (!background) {
+        if (frame->dirty()) {
+          rc = buffer_pool->flush_page(*frame);
+          flushed++;
+        }
+      } else if (frame->try_read_latch()) {
+        // 页面在刷盘时不能被修改，否则写下去的数据和校验和可能不一致
+        if (frame->dirty()) {
+          rc = buffer_pool->flush_page(*frame);
+          flushed++;
+        }
+        frame->read_unlatch();
+      }
+    }
+
+    frame->unpin();
+    if (background) {
+      release(buffer_pool_id);
+    }
+  }
+  return rc;
+}
+
+bool PageCleaner::hold(int buffer_pool_id)
+{
+  lock_guard<mutex> guard(pools_lock_);
+  if (closing_.count(buffer_pool_id) > 0) {
+    return false;
+  }
+  holding_[buffer_pool_id]++;
+  return true;
+}
+
+void PageCleaner::release(int buffer_pool_id)
+{
+  lock_guard<mutex> guard(pools_lock_);
+  auto              iter = holding_.find(buffer_pool_id);
+  if (--iter->second == 0) {
+    holding_.erase(iter);
+    pools_cv_.notify_all();
+  }
+}
+
+void PageCleaner::begin_close(int buffer_pool_id)
+{
+  unique_lock<mutex> lock(pools_lock_);
+  closing_.insert(buffer_pool_id);
+  pools_cv_.wait(lock, [this, buffer_pool_id]() { return holding_.count(buffer_pool_id) == 0; });
+}
+
+void PageCleaner::end_close(int buffer_pool_id)
+{
+  lock_guard<mutex> guard(pools_lock_);
+  closing_.erase(buffer_pool_id);
+}
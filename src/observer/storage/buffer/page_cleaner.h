@@ -0,0 +1,121 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/lang/atomic.h"
+#include "common/lang/memory.h"
+#include "common/lang/mutex.h"
+#include "common/lang/thread.h"
+#include "common/lang/unordered_map.h"
+#include "common/lang/unordered_set.h"
+#include "common/lang/vector.h"
+#include "common/rc.h"
+
+class BufferPoolManager;
+class DiskBufferPool;
+class Frame;
+
+/**
+ * @brief 后台刷脏
+ * @ingroup BufferPool
+ * @details 缓存满了以后，加载新页面需要先淘汰一个页面，如果淘汰的是脏页，前台线程就要等待脏页写盘(还要先写 double
+ * write buffer)，查询的延迟会因此变得很高。PageCleaner 启动几个后台线程，每个线程负责一部分页帧分片，
+ * 定期检查每个分片淘汰顺序最靠前的一部分页帧(比例可以配置)，把其中的脏页刷到磁盘上，这样前台淘汰页面时通常都能找到干净的页面。
+ * 前台线程淘汰了脏页时会唤醒后台线程。各个线程互不等待，关闭文件时只等待正在刷这个文件页面的线程。
+ * 刷盘时页面按照文件和页号排序，double write buffer 写回数据文件时，页号连续的页面合并成一次写。
+ * checkpoint (Db::sync) 时也通过 flush_all 按照同样的方式刷盘。
+ */
+class PageCleaner
+{
+public:
+  static constexpr int DEFAULT_THREAD_NUM    = 1;
+  static constexpr int DEFAULT_CLEAN_PERCENT = 10;
+  static constexpr int DEFAULT_INTERVAL_MS   = 100;
+
+  explicit PageCleaner(BufferPoolManager &bp_manager);
+  ~PageCleaner();
+
+  /**
+   * @brief 启动后台刷脏线程
+   * @param thread_num 线程个数。为0时不启动后台线程，只在 flush_all 时刷盘。非并发编译(没有定义 CONCURRENCY)时不启动后台线程
+   * @param clean_percent 每个分片中，淘汰顺序最靠前的百分之多少的页帧需要保持干净
+   */
+  RC   start(int thread_num, int clean_percent, int interval_ms = DEFAULT_INTERVAL_MS);
+  void stop();
+
+  /**
+   * @brief 前台线程淘汰了一个脏页，唤醒后台线程尽快刷脏
+   */
+  void wakeup();
+
+  /**
+   * @brief 后台线程执行一轮刷脏
+   * @param index 当前是第几个线程，负责编号为 index, index + thread_num, ... 的分片
+   * @return 刷盘的页面个数
+   */
+  int clean(int index = 0);
+
+  /**
+   * @brief 把指定文件的所有脏页按照页号顺序刷盘
+   */
+  RC flush_all(int buffer_pool_id);
+
+  /**
+   * @brief 关闭文件前调用，等待后台线程刷完已经拿到的这个文件的页面，之后不再刷这个文件的页面
+   */
+  void begin_close(int buffer_pool_id);
+
+  /**
+   * @brief 文件关闭以后调用，同一个文件还可能再次打开
+   */
+  void end_close(int buffer_pool_id);
+
+  int     thread_num() const { return thread_num_; }
+  int     clean_percent() const { return clean_percent_; }
+  int64_t background_flush_count() const { return background_flush_count_.load(); }
+  int64_t foreground_flush_count() const { return foreground_flush_count_.load(); }
+
+private:
+  void thread_func(int index);
+
+  /**
+   * @brief 按照文件和页号排序后刷盘，最后unpin所有的页帧
+   * @param background 后台刷脏时不等待页面的锁，正在修改的页面留到下一轮再刷
+   * @param flushed 返回刷盘的页面个数
+   */
+  RC flush_frames(vector<Frame *> &frames, bool background, int &flushed);
+
+  /**
+   * @brief 后台线程在分片的锁内拿到一个页面时调用，文件正在关闭时返回false
+   */
+  bool hold(int buffer_pool_id);
+  void release(int buffer_pool_id);
+
+private:
+  BufferPoolManager &bp_manager_;
+
+  int            clean_percent_ = DEFAULT_CLEAN_PERCENT;
+  int            interval_ms_   = DEFAULT_INTERVAL_MS;
+  int            thread_num_    = 0;  ///< 在启动线程之前设置，线程启动过程中就会用到
+  vector<thread> threads_;
+  atomic<bool>   running_{false};
+
+  mutex              wakeup_lock_;
+  condition_variable wakeup_cv_;
+
+  mutex                   pools_lock_;
+  condition_variable      pools_cv_;
+  unordered_map<int, int> holding_;  ///< 每个文件被后台线程拿到的页面个数
+  unordered_set<int>      closing_;  ///< 正在关闭的文件
+
+  atomic<int64_t> background_flush_count_{0};  ///< 后台线程刷盘的页面个数
+  atomic<int64_t> foreground_flush_count_{0};  ///< 前台线程淘汰脏页的次数
+};
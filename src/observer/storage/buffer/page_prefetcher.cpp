@@ -0,0 +1,145 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "storage/buffer/page_prefetcher.h"
+#include "common/lang/algorithm.h"
+#include "common/log/log.h"
+#include "common/thread/thread_util.h"
+#include "storage/buffer/disk_buffer_pool.h"
+
+PagePrefetcher::PagePrefetcher(BPFrameManager &frame_manager) : frame_manager_(frame_manager) {}
+
+PagePrefetcher::~PagePrefetcher() { stop(); }
+
+RC PagePrefetcher::start(int thread_num, int window_pages)
+{
+  if (thread_num < 0 || window_pages <= 0) {
+    LOG_WARN("invalid page prefetcher arguments. thread num=%d, window pages=%d", thread_num, window_pages);
+    return RC::INVALID_ARGUMENT;
+  }
+  if (running()) {
+    LOG_WARN("page prefetcher has been started");
+    return RC::INTERNAL;
+  }
+  if (thread_num == 0) {
+    LOG_INFO("page prefetcher is disabled");
+    return RC::SUCCESS;
+  }
+
+  window_pages_ = window_pages;
+#ifndef CONCURRENCY
+  sync_      = true;
+  thread_num = 0;
+#endif
+  running_.store(true);
+  for (int i = 0; i < thread_num; i++) {
+    threads_.emplace_back(&PagePrefetcher::thread_func, this, i);
+  }
+  LOG_INFO("page prefetcher started. thread num=%d, window pages=%d, sync=%d", thread_num, window_pages, sync_);
+  return RC::SUCCESS;
+}
+
+void PagePrefetcher::stop()
+{
+  {
+    lock_guard<mutex> guard(lock_);
+    if (!running_.exchange(false)) {
+      return;
+    }
+    requests_.clear();
+  }
+
+  cv_.notify_all();
+  for (thread &t : threads_) {
+    t.join();
+  }
+  threads_.clear();
+  LOG_INFO("page prefetcher stopped. read=%ld, hit=%ld, dropped=%ld",
+           read_count_.load(), hit_count_.load(), dropped_count_.load());
+}
+
+int PagePrefetcher::window_pages() const
+{
+  return static_cast<int>(std::min<size_t>(window_pages_, frame_manager_.total_frame_num() / 8));
+}
+
+void PagePrefetcher::submit(DiskBufferPool &buffer_pool, PageNum start_page, int count)
+{
+  if (count <= 0) {
+    return;
+  }
+
+  if (sync_) {
+    if (running()) {
+      execute(Request{&buffer_pool, start_page, count});
+    }
+    return;
+  }
+
+  {
+    lock_guard<mutex> guard(lock_);
+    if (!running()) {
+      return;
+    }
+    if (requests_.size() >= static_cast<size_t>(MAX_PENDING_REQUESTS)) {
+      dropped_count_.fetch_add(1, std::memory_order_relaxed);
+      LOG_TRACE("too many prefetch requests, drop it. file=%s, start page=%d, count=%d",
+                buffer_pool.filename(), start_page, count);
+      return;
+    }
+    requests_.push_back(Request{&buffer_pool, start_page, count});
+  }
+  cv_.notify_one();
+}
+
+void PagePrefetcher::discard(DiskBufferPool &buffer_pool)
+{
+  unique_lock<mutex> lock(lock_);
+  requests_.erase(remove_if(requests_.begin(), requests_.end(),
+                      [&buffer_pool](const Request &request) { return request.buffer_pool == &buffer_pool; }),
+      requests_.end());
+  executing_cv_.wait(lock, [this, &buffer_pool]() {
+    return find(executing_.begin(), executing_.end(), &buffer_pool) == executing_.end();
+  });
+}
+
+void PagePrefetcher::thread_func(int index)
+{
+  common::thread_set_name("PagePrefetcher");
+  LOG_INFO("page prefetcher thread started. index=%d", index);
+
+  unique_lock<mutex> lock(lock_);
+  while (true) {
+    cv_.wait(lock, [this]() { return !running() || !requests_.empty(); });
+    if (!running()) {
+      break;
+    }
+
+    Request request = requests_.front();
+    requests_.pop_front();
+    executing_.push_back(request.buffer_pool);
+    lock.unlock();
+
+    execute(request);
+
+    lock.lock();
+    executing_.erase(find(executing_.begin(), executing_.end(), request.buffer_pool));
+    executing_cv_.notify_all();
+  }
+  LOG_INFO("page prefetcher thread stopped. index=%d", index);
+}
+
+void PagePrefetcher::execute(const Request &request)
+{
+  int loaded = request.buffer_pool->load_pages(request.start_page, request.count);
+  read_count_.fetch_add(loaded, std::memory_order_relaxed);
+  LOG_TRACE("prefetch pages. file=%s, start page=%d, count=%d, loaded=%d",
+            request.buffer_pool->filename(), request.start_page, request.count, loaded);
+}
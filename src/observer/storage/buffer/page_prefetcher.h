@@ -0,0 +1,107 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/lang/atomic.h"
+#include "common/lang/deque.h"
+#include "common/lang/mutex.h"
+#include "common/lang/thread.h"
+#include "common/lang/vector.h"
+#include "common/rc.h"
+#include "storage/buffer/page.h"
+
+class BPFrameManager;
+class DiskBufferPool;
+
+/**
+ * @brief 页面预读
+ * @ingroup BufferPool
+ * @details 全表扫描和索引范围扫描每次只在第一次访问某个页面时才从磁盘读取这一个页面，扫描的速度受限于单个页面的读取延迟。
+ * PagePrefetcher 启动几个后台IO线程，DiskBufferPool 发现页面是按照页号顺序访问的，或者扫描器明确告知接下来要访问哪些页面时，
+ * 提交一个预读请求，后台线程把页号连续的多个页面用一次 preadv 读到缓存中，前台线程访问时页面已经在内存里了。
+ * 请求队列有长度限制，IO跟不上时直接丢弃新的请求，预读只是一种优化，不影响正确性。
+ * 非并发编译(没有定义 CONCURRENCY)时各种锁都是空操作，不启动后台线程，在提交请求的线程中同步读取，仍然可以把多次读合并成一次。
+ */
+class PagePrefetcher
+{
+public:
+  static constexpr int DEFAULT_THREAD_NUM   = 1;
+  static constexpr int DEFAULT_WINDOW_PAGES = 32;  ///< 每次预读的页面个数
+  static constexpr int MAX_PENDING_REQUESTS = 64;
+
+  explicit PagePrefetcher(BPFrameManager &frame_manager);
+  ~PagePrefetcher();
+
+  /**
+   * @brief 启动后台IO线程
+   * @param thread_num 线程个数。为0时不做预读
+   * @param window_pages 每次预读的页面个数
+   */
+  RC   start(int thread_num, int window_pages = DEFAULT_WINDOW_PAGES);
+  void stop();
+
+  bool running() const { return running_.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief 实际使用的预读页面个数
+   * @details 不超过缓存页帧数的1/8，防止缓存很小时预读的页面还没有被访问就被淘汰了
+   */
+  int window_pages() const;
+
+  /**
+   * @brief 提交一个预读请求，异步读取 [start_page, start_page + count) 中已经分配并且不在缓存中的页面
+   */
+  void submit(DiskBufferPool &buffer_pool, PageNum start_page, int count);
+
+  /**
+   * @brief 丢弃指定文件还没有执行的预读请求，并等待正在执行的请求结束
+   * @details 关闭文件前调用
+   */
+  void discard(DiskBufferPool &buffer_pool);
+
+  /**
+   * @brief 预读的页面被访问了
+   */
+  void on_hit() { hit_count_.fetch_add(1, std::memory_order_relaxed); }
+
+  int64_t read_count() const { return read_count_.load(); }
+  int64_t hit_count() const { return hit_count_.load(); }
+  int64_t dropped_count() const { return dropped_count_.load(); }
+
+private:
+  struct Request
+  {
+    DiskBufferPool *buffer_pool = nullptr;
+    PageNum         start_page  = BP_INVALID_PAGE_NUM;
+    int             count       = 0;
+  };
+
+  void thread_func(int index);
+  void execute(const Request &request);
+
+private:
+  BPFrameManager &frame_manager_;
+
+  int            window_pages_ = DEFAULT_WINDOW_PAGES;
+  bool           sync_         = false;  ///< 在提交请求的线程中同步读取
+  vector<thread> threads_;
+  atomic<bool>   running_{false};
+
+  mutex                    lock_;
+  condition_variable       cv_;            ///< 通知后台线程有新的请求
+  condition_variable       executing_cv_;  ///< 通知 discard 有请求执行完了
+  deque<Request>           requests_;
+  vector<DiskBufferPool *> executing_;  ///< 后台线程正在读取的文件
+
+  atomic<int64_t> read_count_{0};     ///< 预读的页面个数
+  atomic<int64_t> hit_count_{0};      ///< 预读的页面后来被访问的次数
+  atomic<int64_t> dropped_count_{0};  ///< 队列满了丢弃的请求个数
+};
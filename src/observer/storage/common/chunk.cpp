@@ -10,10 +10,21 @@ See the Mulan PSL v2 for more details. */
 
 #include "storage/common/chunk.h"
 
-void Chunk::add_column(unique_ptr<Column> col, int col_id)
+void Chunk::add_column(unique_ptr<Column> col, int col_id, int table_id)
 {
   columns_.push_back(std::move(col));
   column_ids_.push_back(col_id);
+  column_table_ids_.push_back(table_id);
+}
+
+int Chunk::column_index(int col_id, int table_id) const
+{
+  for (size_t i = 0; i < column_ids_.size(); ++i) {
+    if (column_ids_[i] == col_id && (table_id == -1 || column_table_ids_[i] == table_id)) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
 }
 
 RC Chunk::reference(Chunk &chunk)
@@ -26,7 +37,9 @@ RC Chunk::reference(Chunk &chunk)
     }
     columns_[i]->reference(chunk.column(i));
     column_ids_.push_back(chunk.column_ids(i));
+    column_table_ids_.push_back(chunk.column_table_ids(i));
   }
+  select_ = chunk.select_;
   return RC::SUCCESS;
 }
 
@@ -46,15 +59,31 @@ int Chunk::capacity() const
   return 0;
 }
 
+int Chunk::selected_rows() const
+{
+  if (select_.empty()) {
+    return rows();
+  }
+
+  int count = 0;
+  for (int i = 0; i < rows(); i++) {
+    count += (select_[i] != 0);
+  }
+  return count;
+}
+
 void Chunk::reset_data()
 {
   for (auto &col : columns_) {
     col->reset_data();
   }
+  select_.clear();
 }
 
 void Chunk::reset()
 {
   columns_.clear();
   column_ids_.clear();
+  column_table_ids_.clear();
+  select_.clear();
 }
\ No newline at end of file
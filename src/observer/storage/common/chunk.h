@@ -46,7 +46,24 @@ public:
     return column_ids_[i];
   }
 
-  void add_column(unique_ptr<Column> col, int col_id);
+  int column_table_ids(size_t i)
+  {
+    ASSERT(i < column_table_ids_.size(), "invalid column index");
+    return column_table_ids_[i];
+  }
+
+  /**
+   * @brief 根据列 id 查找列在 Chunk 中的下标
+   * @param table_id 列所属的表，为 -1 时不检查。连接算子输出的 Chunk 中包含多个表的列，
+   * 不同表的列 id 可能相同，需要通过表来区分
+   * @return 找不到时返回 -1
+   */
+  int column_index(int col_id, int table_id = -1) const;
+
+  /**
+   * @param table_id 列所属的表，不属于任何表时为 -1
+   */
+  void add_column(unique_ptr<Column> col, int col_id, int table_id = -1);
 
   RC reference(Chunk &chunk);
 
@@ -77,9 +94,33 @@ public:
 
   void reset();
 
+  /**
+   * @brief 设置选择向量
+   * @details select[i] 为 0 表示第 i 行已经被过滤掉。没有选择向量时所有行都有效。
+   * 过滤算子只需要设置选择向量而不需要拷贝数据，下游的向量化算子需要跳过无效的行。
+   */
+  void set_select(const vector<uint8_t> &select) { select_ = select; }
+  void clear_select() { select_.clear(); }
+
+  bool                   has_select() const { return !select_.empty(); }
+  const vector<uint8_t> &select() const { return select_; }
+
+  /**
+   * @brief 第 row_idx 行是否有效
+   */
+  bool selected(int row_idx) const { return select_.empty() || select_[row_idx] != 0; }
+
+  /**
+   * @brief 获取 Chunk 中有效的行数
+   */
+  int selected_rows() const;
+
 private:
   vector<unique_ptr<Column>> columns_;
   // TODO: remove it and support multi-tables,
   // `columnd_ids` store the ids of child operator that need to be output
   vector<int> column_ids_;
+  vector<int> column_table_ids_;
+  /// 选择向量，为空表示所有行都有效
+  vector<uint8_t> select_;
 };
\ No newline at end of file
@@ -127,4 +127,16 @@ void Column::reference(const Column &column)
   this->column_type_ = column.column_type();
   this->attr_type_   = column.attr_type();
   this->attr_len_    = column.attr_len();
-}
\ No newline at end of file
+}
+void Column::reference(char *data, int count)
+{
+  if (data_ != nullptr && own_) {
+    delete[] data_;
+  }
+
+  this->data_        = data;
+  this->capacity_    = count;
+  this->count_       = count;
+  this->own_         = false;
+  this->column_type_ = Type::NORMAL_COLUMN;
+}
@@ -73,6 +73,13 @@ public:
    */
   void reference(const Column &column);
 
+  /**
+   * @brief 引用一段外部的列数据（例如页面上的内存），不拷贝数据
+   * @param data 列数据的起始地址，使用期间需要保证其有效
+   * @param count 列值的个数
+   */
+  void reference(char *data, int count);
+
   void set_column_type(Type column_type) { column_type_ = column_type; }
   void set_count(int count) { count_ = count; }
 
@@ -81,6 +88,7 @@ public:
   AttrType attr_type() const { return attr_type_; }
   int      attr_len() const { return attr_len_; }
   Type     column_type() const { return column_type_; }
+  bool     own() const { return own_; }
 
 private:
   static constexpr size_t DEFAULT_CAPACITY = 8192;
@@ -0,0 +1,222 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "storage/common/sort_run.h"
+#include "common/lang/algorithm.h"
+#include "common/log/log.h"
+
+SortRun::~SortRun()
+{
+  close_file();
+  if (::unlink(file_name_.c_str()) != 0 && errno != ENOENT) {
+    LOG_WARN("failed to remove sort run file. file=%s, error=%s", file_name_.c_str(), strerror(errno));
+  }
+}
+
+void SortRun::close_file()
+{
+  if (file_ != nullptr) {
+    fclose(file_);
+    file_ = nullptr;
+  }
+}
+
+RC SortRun::open_write()
+{
+  close_file();
+  file_ = fopen(file_name_.c_str(), "wb");
+  if (nullptr == file_) {
+    LOG_WARN("failed to create sort run file. file=%s, error=%s", file_name_.c_str(), strerror(errno));
+    return RC::FILE_CREATE;
+  }
+  io_buffer_.resize(IO_BUFFER_SIZE);
+  setvbuf(file_, io_buffer_.data(), _IOFBF, io_buffer_.size());
+  row_num_   = 0;
+  data_size_ = 0;
+  return RC::SUCCESS;
+}
+
+RC SortRun::write(const char *data, int len)
+{
+  const int32_t record_len = len;
+  RC            rc         = write_bytes(&record_len, sizeof(record_len));
+  if (OB_SUCC(rc) && len > 0) {
+    rc = write_bytes(data, len);
+  }
+  if (OB_SUCC(rc)) {
+    row_num_++;
+    data_size_ += sizeof(record_len) + len;
+  }
+  return rc;
+}
+
+RC SortRun::finish_write()
+{
+  if (nullptr == file_) {
+    return RC::FILE_NOT_OPENED;
+  }
+  if (fflush(file_) != 0) {
+    LOG_WARN("failed to flush sort run file. file=%s, error=%s", file_name_.c_str(), strerror(errno));
+    close_file();
+    return RC::IOERR_WRITE;
+  }
+  close_file();
+  return RC::SUCCESS;
+}
+
+RC SortRun::open_read()
+{
+  close_file();
+  file_ = fopen(file_name_.c_str(), "rb");
+  if (nullptr == file_) {
+    LOG_WARN("failed to open sort run file. file=%s, error=%s", file_name_.c_str(), strerror(errno));
+    return RC::FILE_OPEN;
+  }
+  io_buffer_.resize(IO_BUFFER_SIZE);
+  setvbuf(file_, io_buffer_.data(), _IOFBF, io_buffer_.size());
+  read_rows_ = 0;
+  return RC::SUCCESS;
+}
+
+RC SortRun::next()
+{
+  if (read_rows_ >= row_num_) {
+    // 读完之后就关闭文件，释放 IO 缓冲区
+    close_file();
+    io_buffer_.clear();
+    io_buffer_.shrink_to_fit();
+    return RC::RECORD_EOF;
+  }
+
+  int32_t record_len = 0;
+  RC      rc         = read_bytes(&record_len, sizeof(record_len));
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+  record_.resize(record_len);
+  if (record_len > 0 && OB_FAIL(rc = read_bytes(record_.data(), record_len))) {
+    return rc;
+  }
+
+  read_rows_++;
+  return decode_record();
+}
+
+RC SortRun::write_bytes(const void *data, size_t len)
+{
+  if (fwrite(data, 1, len, file_) != len) {
+    LOG_WARN("failed to write sort run file. file=%s, error=%s", file_name_.c_str(), strerror(errno));
+    return RC::IOERR_WRITE;
+  }
+  return RC::SUCCESS;
+}
+
+RC SortRun::read_bytes(void *data, size_t len)
+{
+  if (fread(data, 1, len, file_) != len) {
+    LOG_WARN("failed to read sort run file. file=%s, error=%s", file_name_.c_str(), strerror(errno));
+    return RC::IOERR_READ;
+  }
+  return RC::SUCCESS;
+}
+
+RC SortRunMerger::open(const vector<unique_ptr<SortRun>> &runs)
+{
+  heap_.clear();
+  for (const unique_ptr<SortRun> &run : runs) {
+    RC rc = run->open_read();
+    if (OB_SUCC(rc)) {
+      rc = run->next();
+    }
+    if (rc == RC::RECORD_EOF) {
+      continue;
+    }
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to open sort run for merging. file=%s, rc=%s", run->file_name().c_str(), strrc(rc));
+      return rc;
+    }
+    heap_.push_back(run.get());
+  }
+
+  // std 的堆是大根堆，比较函数反过来，堆顶就是排在最前面的有序段
+  auto greater = [this](const SortRun *left, const SortRun *right) { return less_(*right, *left); };
+  std::make_heap(heap_.begin(), heap_.end(), greater);
+  return RC::SUCCESS;
+}
+
+RC SortRunMerger::advance()
+{
+  auto greater = [this](const SortRun *left, const SortRun *right) { return less_(*right, *left); };
+  std::pop_heap(heap_.begin(), heap_.end(), greater);
+
+  SortRun *run = heap_.back();
+  RC       rc  = run->next();
+  if (rc == RC::RECORD_EOF) {
+    heap_.pop_back();
+    return RC::SUCCESS;
+  }
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+  std::push_heap(heap_.begin(), heap_.end(), greater);
+  return RC::SUCCESS;
+}
+
+RC SortRunMerger::reduce(
+    vector<unique_ptr<SortRun>> &runs, size_t max_fan_in, const Less &less, const RunCreator &create_run)
+{
+  ASSERT(max_fan_in >= 2, "merge fan-in should be at least 2");
+
+  while (runs.size() > max_fan_in) {
+    // 每一趟减少 fan_in - 1 个有序段，除了第一趟，之后每一趟都归并 max_fan_in 个
+    const size_t excess = (runs.size() - max_fan_in) % (max_fan_in - 1);
+    const size_t fan_in = excess == 0 ? max_fan_in : excess + 1;
+
+    std::stable_sort(runs.begin(), runs.end(), [](const unique_ptr<SortRun> &left, const unique_ptr<SortRun> &right) {
+      return left->data_size() < right->data_size();
+    });
+    vector<unique_ptr<SortRun>> inputs;
+    for (size_t i = 0; i < fan_in; i++) {
+      inputs.push_back(std::move(runs[i]));
+    }
+    runs.erase(runs.begin(), runs.begin() + fan_in);
+
+    unique_ptr<SortRun> output = create_run();
+    RC                  rc     = output->open_write();
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+
+    SortRunMerger merger(less);
+    if (OB_FAIL(rc = merger.open(inputs))) {
+      return rc;
+    }
+    for (SortRun *run = merger.top(); run != nullptr; run = merger.top()) {
+      const string &record = run->record();
+      if (OB_FAIL(rc = output->write(record.data(), static_cast<int>(record.size()))) ||
+          OB_FAIL(rc = merger.advance())) {
+        LOG_WARN("failed to merge sort runs. rc=%s", strrc(rc));
+        return rc;
+      }
+    }
+    if (OB_FAIL(rc = output->finish_write())) {
+      return rc;
+    }
+
+    LOG_TRACE("merge %d sort runs into one. file=%s, rows=%ld, remaining runs=%d",
+        static_cast<int>(fan_in), output->file_name().c_str(), output->row_num(), static_cast<int>(runs.size() + 1));
+    runs.push_back(std::move(output));
+  }
+  return RC::SUCCESS;
+}
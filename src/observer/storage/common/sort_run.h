@@ -0,0 +1,121 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <stdio.h>
+
+#include "common/lang/functional.h"
+#include "common/lang/memory.h"
+#include "common/lang/string.h"
+#include "common/lang/vector.h"
+#include "common/rc.h"
+
+/**
+ * @brief 外部排序中写到临时文件里的一个有序段
+ * @details 先顺序写入已经排好序的记录，写完之后再从头顺序读取。记录是一段字节，由使用者决定格式，
+ * 文件中每条记录前面有 4 字节的长度。写完之后就关闭文件，读取时再打开，有序段很多时也不会占用很多文件句柄。
+ * 对象析构时会删除临时文件。
+ * 子类可以重写 decode_record，在读到记录时解码一次，归并时的比较就不需要重复解码。
+ */
+class SortRun
+{
+public:
+  explicit SortRun(string file_name) : file_name_(std::move(file_name)) {}
+  virtual ~SortRun();
+
+  SortRun(const SortRun &)            = delete;
+  SortRun &operator=(const SortRun &) = delete;
+
+  const string &file_name() const { return file_name_; }
+
+  /// @brief 创建临时文件，准备写入
+  RC open_write();
+  RC write(const char *data, int len);
+  /// @brief 写入完成，刷新并关闭文件
+  RC finish_write();
+
+  /// @brief 打开临时文件，准备从头读取
+  RC open_read();
+  /**
+   * @brief 读取下一条记录，读取的结果通过 record() 获取
+   * @return 没有数据时返回 RECORD_EOF
+   */
+  RC next();
+
+  const string &record() const { return record_; }
+
+  int64_t row_num() const { return row_num_; }
+  /// @brief 写入的数据量（字节），多趟归并时用来选择数据量小的有序段
+  int64_t data_size() const { return data_size_; }
+
+protected:
+  /// @brief 读到一条记录之后调用
+  virtual RC decode_record() { return RC::SUCCESS; }
+
+  RC write_bytes(const void *data, size_t len);
+  RC read_bytes(void *data, size_t len);
+
+private:
+  void close_file();
+
+private:
+  static constexpr size_t IO_BUFFER_SIZE = 64 * 1024;
+
+  string       file_name_;
+  FILE        *file_ = nullptr;
+  vector<char> io_buffer_;
+  string       record_;
+  int64_t      row_num_   = 0;  ///< 写入的记录数
+  int64_t      data_size_ = 0;  ///< 写入的字节数
+  int64_t      read_rows_ = 0;  ///< 已经读取的记录数
+};
+
+/**
+ * @brief 多个有序段的多路归并
+ * @details 使用一个堆，堆顶是当前记录排在最前面的有序段。
+ * 同时归并的有序段越多，打开的文件和 IO 缓冲区就越多，有序段太多时先用 reduce 做多趟归并。
+ */
+class SortRunMerger
+{
+public:
+  /// @brief 有序段 left 的当前记录是否应该排在 right 的前面
+  using Less = function<bool(const SortRun &left, const SortRun &right)>;
+  /// @brief 创建一个空的有序段，用于保存中间的归并结果
+  using RunCreator = function<unique_ptr<SortRun>()>;
+
+  explicit SortRunMerger(Less less) : less_(std::move(less)) {}
+
+  /**
+   * @brief 打开所有的有序段并读取第一条记录
+   * @details runs 要一直有效，直到归并结束
+   */
+  RC open(const vector<unique_ptr<SortRun>> &runs);
+
+  /**
+   * @brief 当前记录排在最前面的有序段，所有的数据都取完时返回 nullptr
+   * @details 它的当前记录在调用 advance 之前有效
+   */
+  SortRun *top() const { return heap_.empty() ? nullptr : heap_.front(); }
+
+  /// @brief top 的当前记录已经使用完，读取它的下一条记录
+  RC advance();
+
+  /**
+   * @brief 多趟归并，直到剩下的有序段不超过 max_fan_in 个，之后就可以一次归并
+   * @details 每一趟只归并数据量最小的几个有序段，结果作为一个新的有序段放回去，输入的有序段会被删除。
+   * 第一趟归并的个数保证之后每一趟都正好归并 max_fan_in 个，这样趟数最少，大的有序段也最少被重写。
+   */
+  static RC reduce(vector<unique_ptr<SortRun>> &runs, size_t max_fan_in, const Less &less, const RunCreator &create_run);
+
+private:
+  Less              less_;
+  vector<SortRun *> heap_;
+};
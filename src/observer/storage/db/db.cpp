@@ -20,6 +20,7 @@ See the Mulan PSL v2 for more details. */
 #include <vector>
 #include <filesystem>
 
+#include "common/conf/ini.h"
 #include "common/lang/string.h"
 #include "common/log/log.h"
 #include "common/os/path.h"
@@ -70,7 +71,16 @@ RC Db::init(const char *name, const char *dbpath, const char *trx_kit_name, cons
 
   trx_kit_.reset(trx_kit);
 
-  buffer_pool_manager_ = make_unique<BufferPoolManager>();
+  // 页面置换策略在配置文件中指定，比如 [BUFFER_POOL] 下的 REPLACER=clock，默认使用 LRU
+  const string      replacer_name = get_properties()->get("REPLACER", "lru", "BUFFER_POOL");
+  FrameReplacerType replacer_type = FrameReplacerType::LRU;
+  rc                              = frame_replacer_type_from_string(replacer_name.c_str(), replacer_type);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to init DB, unknown page replacer: %s. should be one of lru, clock and 2q", replacer_name.c_str());
+    return rc;
+  }
+
+  buffer_pool_manager_ = make_unique<BufferPoolManager>(0 /*memory_size*/, replacer_type);
   auto dblwr_buffer    = make_unique<DiskDoubleWriteBuffer>(*buffer_pool_manager_);
 
   const char      *double_write_buffer_filename  = "dblwr.db";
@@ -134,6 +144,32 @@ RC Db::init(const char *name, const char *dbpath, const char *trx_kit_name, cons
     return rc;
   }
 
+  // 恢复完成以后再启动后台刷脏和预读线程，配置在 [BUFFER_POOL] 下
+  const string thread_num_value = get_properties()->get("CLEANER_THREAD_NUM", "", "BUFFER_POOL");
+  const string percent_value    = get_properties()->get("CLEAN_FRAME_PERCENT", "", "BUFFER_POOL");
+  const int    cleaner_thread_num =
+      thread_num_value.empty() ? PageCleaner::DEFAULT_THREAD_NUM : atoi(thread_num_value.c_str());
+  const int clean_percent = percent_value.empty() ? PageCleaner::DEFAULT_CLEAN_PERCENT : atoi(percent_value.c_str());
+  rc = buffer_pool_manager_->page_cleaner().start(cleaner_thread_num, clean_percent);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to start page cleaner. thread num=%d, clean frame percent=%d, rc=%s",
+              cleaner_thread_num, clean_percent, strrc(rc));
+    return rc;
+  }
+
+  const string prefetch_thread_value = get_properties()->get("PREFETCH_THREAD_NUM", "", "BUFFER_POOL");
+  const string prefetch_pages_value  = get_properties()->get("PREFETCH_PAGES", "", "BUFFER_POOL");
+  const int    prefetch_thread_num   =
+      prefetch_thread_value.empty() ? PagePrefetcher::DEFAULT_THREAD_NUM : atoi(prefetch_thread_value.c_str());
+  const int prefetch_pages =
+      prefetch_pages_value.empty() ? PagePrefetcher::DEFAULT_WINDOW_PAGES : atoi(prefetch_pages_value.c_str());
+  rc = buffer_pool_manager_->page_prefetcher().start(prefetch_thread_num, prefetch_pages);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to start page prefetcher. thread num=%d, prefetch pages=%d, rc=%s",
+              prefetch_thread_num, prefetch_pages, strrc(rc));
+    return rc;
+  }
+
   return rc;
 }
 
@@ -83,6 +83,8 @@ public:
 
   /// @brief 当前数据库的名称
   const char *name() const;
+  /// @brief 数据库文件存放的目录
+  const char *path() const { return path_.c_str(); }
 
   /// @brief 列出所有的表
   void all_tables(vector<string> &table_names) const;
@@ -17,6 +17,7 @@ See the Mulan PSL v2 for more details. */
 
 #include "storage/index/bplus_tree.h"
 #include "common/lang/lower_bound.h"
+#include "common/math/simd_util.h"
 #include "common/log/log.h"
 #include "common/global_context.h"
 #include "sql/parser/parse_defs.h"
@@ -45,6 +46,136 @@ int calc_leaf_page_capacity(int attr_length)
   return capacity;
 }
 
+/**
+ * @brief 二分查找剩下多少个元素时改为顺序查找
+ * @details 顺序查找没有分支预测失败，开启 USE_SIMD 时 int/float 键值一次比较 8 个
+ */
+static constexpr int LINEAR_SEARCH_SIZE = 16;
+
+/**
+ * @brief 统计有序键值中有多少个字段值小于查找键值的字段值
+ */
+template <AttrType TYPE>
+static int count_less_attrs(const char *first, int item_size, int size, const char *key, int attr_length)
+{
+#ifdef USE_SIMD
+  if constexpr (TYPE == AttrType::INTS) {
+    int value;
+    memcpy(&value, key, sizeof(value));
+    return mm256_count_less_epi32(first, item_size, size, value);
+  } else if constexpr (TYPE == AttrType::FLOATS) {
+    float value;
+    memcpy(&value, key, sizeof(value));
+    return mm256_count_less_ps(first, item_size, size, value, static_cast<float>(EPSILON));
+  }
+#endif
+
+  int count = 0;
+  while (count < size && TypedAttrComparator<TYPE>::compare(first + count * item_size, key, attr_length) < 0) {
+    count++;
+  }
+  return count;
+}
+
+/**
+ * @brief 使用按照类型特化的比较函数在节点中查找，结果与 common::lower_bound 相同
+ * @param compare_rid 字段相同时是否还要比较字段后面的RID
+ */
+template <AttrType TYPE>
+static int typed_lower_bound(
+    const char *first, int item_size, int size, const char *key, int attr_length, bool compare_rid, bool *found)
+{
+  auto compare = [&](int index) {
+    const char *item   = first + index * item_size;
+    int         result = TypedAttrComparator<TYPE>::compare(item, key, attr_length);
+    if (result == 0 && compare_rid) {
+      result = RID::compare((const RID *)(item + attr_length), (const RID *)(key + attr_length));
+    }
+    return result;
+  };
+
+  if (found) {
+    *found = false;
+  }
+
+  int begin = 0;
+  int count = size;
+  while (count > LINEAR_SEARCH_SIZE) {
+    const int step   = count / 2;
+    const int index  = begin + step;
+    const int result = compare(index);
+    if (0 == result) {
+      if (found) {
+        *found = true;
+      }
+      return index;
+    }
+    if (result < 0) {
+      begin = index + 1;
+      count -= step + 1;
+    } else {
+      count = step;
+    }
+  }
+
+  // 字段值小于查找键值的元素都在前面，字段值相同的元素紧跟在后面，再逐个比较RID
+  const int end   = begin + count;
+  int       index = begin + count_less_attrs<TYPE>(first + begin * item_size, item_size, count, key, attr_length);
+  for (; index < end; index++) {
+    const int result = compare(index);
+    if (result >= 0) {
+      if (found) {
+        *found = (result == 0);
+      }
+      return index;
+    }
+  }
+  return end;
+}
+
+/**
+ * @brief 在节点中查找第一个不小于 key 的元素
+ * @details 单个字段的 INTS/FLOATS/DATES/CHARS 索引只在这里按照字段类型分发一次，查找过程中使用特化的比较函数
+ * @param compare_rid 字段相同时是否比较RID，使用 KeyComparator 时为 true
+ */
+static int node_lower_bound(const char *first, int item_size, int size, const AttrComparator &comparator,
+    bool compare_rid, const char *key, bool *found)
+{
+  if (comparator.attr_num() == 1) {
+    const int attr_length = comparator.attr_length();
+    switch (comparator.attr_type(0)) {
+      case AttrType::INTS:
+        return typed_lower_bound<AttrType::INTS>(first, item_size, size, key, attr_length, compare_rid, found);
+      case AttrType::FLOATS:
+        return typed_lower_bound<AttrType::FLOATS>(first, item_size, size, key, attr_length, compare_rid, found);
+      case AttrType::DATES:
+        return typed_lower_bound<AttrType::DATES>(first, item_size, size, key, attr_length, compare_rid, found);
+      case AttrType::CHARS:
+        return typed_lower_bound<AttrType::CHARS>(first, item_size, size, key, attr_length, compare_rid, found);
+      default: break;
+    }
+  }
+  return -1;
+}
+
+/**
+ * @brief 前缀压缩的叶子节点，元素前面存放前缀长度和前缀，剩下的空间可以容纳的元素个数
+ */
+static int calc_prefix_leaf_page_capacity(int attr_length, int prefix_length)
+{
+  int item_size = attr_length - prefix_length + sizeof(RID) + sizeof(RID);
+  int capacity =
+      ((int)BP_PAGE_DATA_SIZE - LeafIndexNode::HEADER_SIZE - LeafIndexNode::PREFIX_HEADER_SIZE - attr_length) / item_size;
+  return capacity;
+}
+
+int calc_prefix_leaf_capacity(const IndexFileHeader &header, int prefix_length)
+{
+  const int64_t page_capacity  = calc_prefix_leaf_page_capacity(header.attr_length, prefix_length);
+  const int64_t full_capacity  = calc_prefix_leaf_page_capacity(header.attr_length, 0);
+  return static_cast<int>(page_capacity * header.leaf_max_size / full_capacity);
+}
+
 /////////////////////////////////////////////////////////////////////////////////
 IndexNodeHandler::IndexNodeHandler(BplusTreeMiniTransaction &mtr, const IndexFileHeader &header, Frame *frame)
     : mtr_(mtr), header_(header), frame_(frame), node_((IndexNode *)frame->data())
@@ -196,6 +327,9 @@ RC LeafIndexNodeHandler::init_empty()
   }
   IndexNodeHandler::init_empty(true/*leaf*/);
   leaf_node_->next_brother = BP_INVALID_PAGE_NUM;
+  if (prefix_compressed()) {
+    *reinterpret_cast<int32_t *>(leaf_node_->array) = 0;
+  }
   return RC::SUCCESS;
 }
 
@@ -213,10 +347,60 @@ RC LeafIndexNodeHandler::set_next_page(PageNum page_num)
 
 PageNum LeafIndexNodeHandler::next_page() const { return leaf_node_->next_brother; }
 
+int LeafIndexNodeHandler::prefix_length() const
+{
+  if (!prefix_compressed()) {
+    return 0;
+  }
+  // 并发读到修改了一半的页面时也不能越界
+  const int32_t length = *reinterpret_cast<const int32_t *>(leaf_node_->array);
+  return std::min(std::max(length, 0), header_.attr_length);
+}
+
+char *LeafIndexNodeHandler::prefix_data() const { return leaf_node_->array + LeafIndexNode::PREFIX_HEADER_SIZE; }
+
+int LeafIndexNodeHandler::key_size() const { return header_.key_length - prefix_length(); }
+
+int LeafIndexNodeHandler::common_prefix_length(const char *key) const
+{
+  // 前缀中不包含'\0'，键值比较时'\0'之后的内容会被忽略，只有这样没有共同前缀的键值才一定排在节点的两端
+  const int   length = size() == 0 ? header_.attr_length : prefix_length();
+  const char *prefix = prefix_data();
+  int         i      = 0;
+  while (i < length && key[i] != 0 && (size() == 0 || key[i] == prefix[i])) {
+    i++;
+  }
+  return i;
+}
+
+void LeafIndexNodeHandler::copy_key(int index, char *key) const
+{
+  const int prefix_length = this->prefix_length();
+  memcpy(key, prefix_data(), prefix_length);
+  memcpy(key + prefix_length, __item_at(index), header_.key_length - prefix_length);
+}
+
+void LeafIndexNodeHandler::copy_items(int index, int num, vector<char> &items) const
+{
+  const int full_item_size = header_.key_length + value_size();
+  items.resize(static_cast<size_t>(num) * full_item_size);
+  for (int i = 0; i < num; i++) {
+    char *item = items.data() + static_cast<size_t>(i) * full_item_size;
+    copy_key(index + i, item);
+    memcpy(item + header_.key_length, __value_at(index + i), value_size());
+  }
+}
+
 char *LeafIndexNodeHandler::key_at(int index)
 {
   assert(index >= 0 && index < size());
-  return __key_at(index);
+  if (!prefix_compressed()) {
+    return __key_at(index);
+  }
+
+  key_buffer_.resize(header_.key_length);
+  copy_key(index, key_buffer_.data());
+  return key_buffer_.data();
 }
 
 char *LeafIndexNodeHandler::value_at(int index)
@@ -225,9 +409,55 @@ char *LeafIndexNodeHandler::value_at(int index)
   return __value_at(index);
 }
 
+template <typename Comparator>
+int LeafIndexNodeHandler::compressed_lookup(const Comparator &comparator, const char *key, bool *found) const
+{
+  // 与 common::lower_bound 的行为保持一致，找到相等的元素就直接返回
+  vector<char> this_key(header_.key_length);
+  const int    prefix_length = this->prefix_length();
+  memcpy(this_key.data(), prefix_data(), prefix_length);
+
+  int  first      = 0;
+  int  last_count = size();
+  bool equal      = false;
+  while (last_count > 0) {
+    const int step  = last_count / 2;
+    const int index = first + step;
+    memcpy(this_key.data() + prefix_length, __item_at(index), header_.key_length - prefix_length);
+    const int result = comparator(this_key.data(), key);
+    if (0 == result) {
+      first = index;
+      equal = true;
+      break;
+    }
+    if (result < 0) {
+      first = index + 1;
+      last_count -= step + 1;
+    } else {
+      last_count = step;
+    }
+  }
+
+  if (found) {
+    *found = equal;
+  }
+  return first;
+}
+
 int LeafIndexNodeHandler::lookup(const KeyComparator &comparator, const char *key, bool *found /* = nullptr */) const
 {
-  const int                    size = this->size();
+  if (prefix_compressed()) {
+    return compressed_lookup(comparator, key, found);
+  }
+
+  const int size = this->size();
+  if (comparator.prefix_attr_num() == comparator.attr_comparator().attr_num()) {
+    int index = node_lower_bound(__key_at(0), item_size(), size, comparator.attr_comparator(), true, key, found);
+    if (index >= 0) {
+      return index;
+    }
+  }
+
   common::BinaryIterator<char> iter_begin(item_size(), __key_at(0));
   common::BinaryIterator<char> iter_end(item_size(), __key_at(size));
   common::BinaryIterator<char> iter = lower_bound(iter_begin, iter_end, key, comparator, found);
@@ -236,20 +466,111 @@ int LeafIndexNodeHandler::lookup(const KeyComparator &comparator, const char *ke
 
 int LeafIndexNodeHandler::unique_lookup(const AttrComparator &comparator, const char *key, bool *found /* = nullptr */) const
 {
-  const int                    size = this->size();
+  if (prefix_compressed()) {
+    return compressed_lookup(comparator, key, found);
+  }
+
+  const int size  = this->size();
+  int       index = node_lower_bound(__key_at(0), item_size(), size, comparator, false, key, found);
+  if (index >= 0) {
+    return index;
+  }
+
   common::BinaryIterator<char> iter_begin(item_size(), __key_at(0));
   common::BinaryIterator<char> iter_end(item_size(), __key_at(size));
   common::BinaryIterator<char> iter = lower_bound(iter_begin, iter_end, key, comparator, found);
   return iter - iter_begin;
 }
 
+bool LeafIndexNodeHandler::can_insert(const char *key) const
+{
+  if (!prefix_compressed()) {
+    return size() < max_size();
+  }
+  return size() + 1 <= calc_prefix_leaf_capacity(header_, common_prefix_length(key));
+}
+
+bool LeafIndexNodeHandler::can_merge(const LeafIndexNodeHandler &other) const
+{
+  if (!prefix_compressed()) {
+    return IndexNodeHandler::can_merge(other);
+  }
+
+  // 合并之后的前缀不会比两个节点前缀的共同部分更短
+  int prefix_length = 0;
+  if (size() == 0 || other.size() == 0) {
+    prefix_length = size() == 0 ? other.prefix_length() : this->prefix_length();
+  } else {
+    const int max_length = std::min(this->prefix_length(), other.prefix_length());
+    while (prefix_length < max_length && prefix_data()[prefix_length] == other.prefix_data()[prefix_length]) {
+      prefix_length++;
+    }
+  }
+  return size() + other.size() <= calc_prefix_leaf_capacity(header_, prefix_length);
+}
+
+RC LeafIndexNodeHandler::set_prefix(const char *prefix, int prefix_length)
+{
+  RC rc = mtr_.logger().leaf_set_prefix(
+      *this, span<const char>(prefix, prefix_length), span<const char>(prefix_data(), this->prefix_length()));
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to log set prefix. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  return recover_set_prefix(prefix, prefix_length);
+}
+
+RC LeafIndexNodeHandler::recover_set_prefix(const char *prefix, int prefix_length)
+{
+  if (!prefix_compressed() || prefix_length < 0 || prefix_length > header_.attr_length) {
+    return RC::INVALID_ARGUMENT;
+  }
+
+  const int old_length    = this->prefix_length();
+  const int old_item_size = item_size();
+  const int new_item_size = old_item_size + old_length - prefix_length;
+  const int size          = this->size();
+  char     *items         = prefix_data() + header_.attr_length;
+  if (prefix_length < old_length) {
+    // 前缀变短，每个元素都变大，从后向前移动才不会覆盖还没有处理的元素
+    const int    extend = old_length - prefix_length;
+    vector<char> item(new_item_size);
+    memcpy(item.data(), prefix_data() + prefix_length, extend);
+    for (int i = size - 1; i >= 0; i--) {
+      memcpy(item.data() + extend, items + static_cast<size_t>(i) * old_item_size, old_item_size);
+      memcpy(items + static_cast<size_t>(i) * new_item_size, item.data(), new_item_size);
+    }
+  } else if (prefix_length > old_length) {
+    // 前缀变长，每个元素都变小，从前向后移动
+    const int shrink = prefix_length - old_length;
+    for (int i = 0; i < size; i++) {
+      memmove(items + static_cast<size_t>(i) * new_item_size, items + static_cast<size_t>(i) * old_item_size + shrink,
+          new_item_size);
+    }
+  }
+
+  memmove(prefix_data(), prefix, prefix_length);
+  *reinterpret_cast<int32_t *>(leaf_node_->array) = prefix_length;
+  return RC::SUCCESS;
+}
+
 RC LeafIndexNodeHandler::insert(int index, const char *key, const char *value)
 {
+  RC        rc            = RC::SUCCESS;
+  const int prefix_length = prefix_compressed() ? common_prefix_length(key) : 0;
+  if (prefix_compressed() && (size() == 0 || prefix_length < this->prefix_length())) {
+    rc = set_prefix(key, prefix_length);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
+
   vector<char> item(key_size() + value_size());
-  memcpy(item.data(), key, key_size());
+  memcpy(item.data(), key + prefix_length, key_size());
   memcpy(item.data() + key_size(), value, value_size());
 
-  RC rc = mtr_.logger().node_insert_items(*this, index, item, 1);
+  rc = mtr_.logger().node_insert_items(*this, index, item, 1);
   if (OB_FAIL(rc)) {
     LOG_WARN("failed to log insert item. rc=%s", strrc(rc));
     return rc;
@@ -286,11 +607,24 @@ int LeafIndexNodeHandler::remove(const char *key, const KeyComparator &comparato
 
 RC LeafIndexNodeHandler::move_half_to(LeafIndexNodeHandler &other)
 {
-  const int size       = this->size();
-  const int move_index = size / 2;
+  return move_tail_to(other, this->size() / 2);
+}
+
+RC LeafIndexNodeHandler::move_tail_to(LeafIndexNodeHandler &other, int move_index)
+{
+  const int size          = this->size();
   const int move_item_num = size - move_index;
+  if (move_item_num <= 0) {
+    return RC::SUCCESS;
+  }
 
-  other.append(__item_at(move_index), move_item_num);
+  if (prefix_compressed()) {
+    vector<char> items;
+    copy_items(move_index, move_item_num, items);
+    other.append(items.data(), move_item_num);
+  } else {
+    other.append(__item_at(move_index), move_item_num);
+  }
 
   RC rc = mtr_.logger().node_remove_items(*this, move_index, span<const char>(__item_at(move_index), move_item_num * item_size()), move_item_num);
   if (OB_FAIL(rc)) {
@@ -299,18 +633,48 @@ RC LeafIndexNodeHandler::move_half_to(LeafIndexNodeHandler &other)
   }
 
   recover_remove_items(move_index, move_item_num);
-  return RC::SUCCESS;
+
+  // 剩下的键值可能有更长的共同前缀
+  if (prefix_compressed() && move_index > 0) {
+    vector<char> first_key(header_.key_length);
+    copy_key(0, first_key.data());
+    vector<char> last_key(header_.key_length);
+    copy_key(move_index - 1, last_key.data());
+
+    int prefix_length = this->prefix_length();
+    while (prefix_length < header_.attr_length && first_key[prefix_length] != 0 &&
+           first_key[prefix_length] == last_key[prefix_length]) {
+      prefix_length++;
+    }
+    if (prefix_length > this->prefix_length()) {
+      rc = set_prefix(first_key.data(), prefix_length);
+    }
+  }
+  return rc;
 }
+
 RC LeafIndexNodeHandler::move_first_to_end(LeafIndexNodeHandler &other)
 {
-  other.append(__item_at(0));
+  if (prefix_compressed()) {
+    vector<char> item;
+    copy_items(0, 1, item);
+    other.append(item.data());
+  } else {
+    other.append(__item_at(0));
+  }
 
   return this->remove(0);
 }
 
 RC LeafIndexNodeHandler::move_last_to_front(LeafIndexNodeHandler &other)
 {
-  other.preappend(__item_at(size() - 1));
+  if (prefix_compressed()) {
+    vector<char> item;
+    copy_items(size() - 1, 1, item);
+    other.preappend(item.data());
+  } else {
+    other.preappend(__item_at(size() - 1));
+  }
 
   this->remove(size() - 1);
   return RC::SUCCESS;
@@ -320,7 +684,13 @@ RC LeafIndexNodeHandler::move_last_to_front(LeafIndexNodeHandler &other)
  */
 RC LeafIndexNodeHandler::move_to(LeafIndexNodeHandler &other)
 {
-  other.append(__item_at(0), this->size());
+  if (prefix_compressed()) {
+    vector<char> items;
+    copy_items(0, this->size(), items);
+    other.append(items.data(), this->size());
+  } else {
+    other.append(__item_at(0), this->size());
+  }
   other.set_next_page(this->next_page());
 
   RC rc = mtr_.logger().node_remove_items(*this, 0, span<const char>(__item_at(0), this->size() * item_size()), this->size());
@@ -335,6 +705,40 @@ RC LeafIndexNodeHandler::move_to(LeafIndexNodeHandler &other)
 // 复制一些数据到当前节点的最右边
 RC LeafIndexNodeHandler::append(const char *items, int num)
 {
+  if (num <= 0) {
+    return RC::SUCCESS;
+  }
+
+  vector<char> compressed_items;
+  if (prefix_compressed()) {
+    // 新的前缀是当前前缀与追加的第一个和最后一个键值的共同部分，追加的键值是有序的，中间的键值一定也包含这个前缀
+    const int   full_item_size = header_.key_length + value_size();
+    const char *last_item      = items + static_cast<size_t>(num - 1) * full_item_size;
+    int         prefix_length  = common_prefix_length(items);
+    int         last_length    = 0;
+    while (last_length < prefix_length && items[last_length] == last_item[last_length]) {
+      last_length++;
+    }
+    prefix_length = last_length;
+
+    RC rc = RC::SUCCESS;
+    if (size() == 0 || prefix_length < this->prefix_length()) {
+      rc = set_prefix(items, prefix_length);
+      if (OB_FAIL(rc)) {
+        return rc;
+      }
+    }
+
+    const int item_size = this->item_size();
+    compressed_items.resize(static_cast<size_t>(num) * item_size);
+    for (int i = 0; i < num; i++) {
+      const char *item = items + static_cast<size_t>(i) * full_item_size;
+      memcpy(compressed_items.data() + static_cast<size_t>(i) * item_size, item + prefix_length,
+          full_item_size - prefix_length);
+    }
+    items = compressed_items.data();
+  }
+
   RC rc = mtr_.logger().node_insert_items(*this, size(), span<const char>(items, num * item_size()), num);
   if (OB_FAIL(rc)) {
     LOG_WARN("failed to log append items. rc=%d:%s", rc, strrc(rc));
@@ -351,18 +755,30 @@ RC LeafIndexNodeHandler::append(const char *item)
 
 RC LeafIndexNodeHandler::preappend(const char *item)
 {
-  return insert(0, item, item + key_size());
+  return insert(0, item, item + header_.key_length);
 }
 
-char *LeafIndexNodeHandler::__item_at(int index) const { return leaf_node_->array + (index * item_size()); }
+char *LeafIndexNodeHandler::__item_at(int index) const
+{
+  if (prefix_compressed()) {
+    return prefix_data() + header_.attr_length + (index * item_size());
+  }
+  return leaf_node_->array + (index * item_size());
+}
 
 string to_string(const LeafIndexNodeHandler &handler, const KeyPrinter &printer)
 {
   stringstream ss;
   ss << to_string((const IndexNodeHandler &)handler) << ",next page:" << handler.next_page();
-  ss << ",values=[" << printer(handler.__key_at(0));
-  for (int i = 1; i < handler.size(); i++) {
-    ss << "," << printer(handler.__key_at(i));
+  if (handler.prefix_compressed()) {
+    ss << ",prefix length:" << handler.prefix_length();
+  }
+
+  vector<char> key(handler.header_.key_length);
+  ss << ",values=[";
+  for (int i = 0; i < handler.size(); i++) {
+    handler.copy_key(i, key.data());
+    ss << (i == 0 ? "" : ",") << printer(key.data());
   }
   ss << "]";
   return ss.str();
@@ -375,15 +791,25 @@ bool LeafIndexNodeHandler::validate(const KeyComparator &comparator, DiskBufferP
     return false;
   }
 
-  const int node_size = size();
+  const int    node_size = size();
+  vector<char> prev_key(header_.key_length);
+  vector<char> this_key(header_.key_length);
   for (int i = 1; i < node_size; i++) {
-    if (comparator(__key_at(i - 1), __key_at(i)) >= 0) {
+    copy_key(i - 1, prev_key.data());
+    copy_key(i, this_key.data());
+    if (comparator(prev_key.data(), this_key.data()) >= 0) {
       LOG_WARN("page number = %d, invalid key order. id1=%d,id2=%d, this=%s",
                page_num(), i - 1, i, to_string(*this).c_str());
       return false;
     }
   }
 
+  if (prefix_compressed() && node_size > calc_prefix_leaf_capacity(header_, prefix_length())) {
+    LOG_WARN("page number = %d, too many items for prefix compressed leaf. size=%d, prefix length=%d",
+             page_num(), node_size, prefix_length());
+    return false;
+  }
+
   PageNum parent_page_num = this->parent_page_num();
   if (parent_page_num == BP_INVALID_PAGE_NUM) {
     return true;
@@ -406,7 +832,8 @@ bool LeafIndexNodeHandler::validate(const KeyComparator &comparator, DiskBufferP
   }
 
   if (0 != index_in_parent) {
-    int cmp_result = comparator(__key_at(0), parent_node.key_at(index_in_parent));
+    copy_key(0, this_key.data());
+    int cmp_result = comparator(this_key.data(), parent_node.key_at(index_in_parent));
     if (cmp_result < 0) {
       LOG_WARN("invalid leaf node. first item should be greate than or equal to parent item. "
                "this page num=%d, parent page num=%d, index in parent=%d",
@@ -417,7 +844,8 @@ bool LeafIndexNodeHandler::validate(const KeyComparator &comparator, DiskBufferP
   }
 
   if (index_in_parent < parent_node.size() - 1) {
-    int cmp_result = comparator(__key_at(size() - 1), parent_node.key_at(index_in_parent + 1));
+    copy_key(size() - 1, this_key.data());
+    int cmp_result = comparator(this_key.data(), parent_node.key_at(index_in_parent + 1));
     if (cmp_result >= 0) {
       LOG_WARN("invalid leaf node. last item should be less than the item at the first after item in parent."
                "this page num=%d, parent page num=%d, parent item to compare=%d",
@@ -535,10 +963,18 @@ int InternalIndexNodeHandler::lookup(const KeyComparator &comparator, const char
     return 0;
   }
 
-  common::BinaryIterator<char> iter_begin(item_size(), __key_at(1));
-  common::BinaryIterator<char> iter_end(item_size(), __key_at(size));
-  common::BinaryIterator<char> iter = lower_bound(iter_begin, iter_end, key, comparator, found);
-  int                          ret  = static_cast<int>(iter - iter_begin) + 1;
+  int ret = -1;
+  if (comparator.prefix_attr_num() == comparator.attr_comparator().attr_num()) {
+    ret = node_lower_bound(__key_at(1), item_size(), size - 1, comparator.attr_comparator(), true, key, found);
+  }
+  if (ret >= 0) {
+    ret += 1;
+  } else {
+    common::BinaryIterator<char> iter_begin(item_size(), __key_at(1));
+    common::BinaryIterator<char> iter_end(item_size(), __key_at(size));
+    common::BinaryIterator<char> iter = lower_bound(iter_begin, iter_end, key, comparator, found);
+    ret                               = static_cast<int>(iter - iter_begin) + 1;
+  }
   if (insert_position) {
     *insert_position = ret;
   }
@@ -811,6 +1247,32 @@ RC BplusTreeHandler::create(LogHandler &log_handler,
                             bool unique,
                             int internal_max_size /* = -1*/,
                             int leaf_max_size /* = -1 */)
+{
+  return this->create(log_handler, bpm, file_name, vector<AttrType>{attr_type}, vector<int>{attr_length}, unique,
+      internal_max_size, leaf_max_size);
+}
+
+RC BplusTreeHandler::create(LogHandler &log_handler,
+            DiskBufferPool &buffer_pool,
+            AttrType attr_type,
+            int attr_length,
+            bool unique /* = false */,
+            int internal_max_size /* = -1 */,
+            int leaf_max_size /* = -1 */)
+{
+  return this->create(log_handler, buffer_pool, vector<AttrType>{attr_type}, vector<int>{attr_length}, unique,
+      internal_max_size, leaf_max_size);
+}
+
+RC BplusTreeHandler::create(LogHandler &log_handler,
+                            BufferPoolManager &bpm,
+                            const char *file_name, 
+                            const vector<AttrType> &attr_types,
+                            const vector<int> &attr_lengths,
+                            bool unique,
+                            int internal_max_size /* = -1*/,
+                            int leaf_max_size /* = -1 */,
+                            bool prefix_compressed /* = false */)
 {
   RC rc = bpm.create_file(file_name);
   if (OB_FAIL(rc)) {
@@ -828,7 +1290,7 @@ RC BplusTreeHandler::create(LogHandler &log_handler,
   }
   LOG_INFO("Successfully open index file %s.", file_name);
 
-  rc = this->create(log_handler, *bp, attr_type, attr_length, unique, internal_max_size, leaf_max_size);
+  rc = this->create(log_handler, *bp, attr_types, attr_lengths, unique, internal_max_size, leaf_max_size, prefix_compressed);
   if (OB_FAIL(rc)) {
     bpm.close_file(file_name);
     return rc;
@@ -840,17 +1302,36 @@ RC BplusTreeHandler::create(LogHandler &log_handler,
 
 RC BplusTreeHandler::create(LogHandler &log_handler,
             DiskBufferPool &buffer_pool,
-            AttrType attr_type,
-            int attr_length,
+            const vector<AttrType> &attr_types,
+            const vector<int> &attr_lengths,
             bool unique /* = false */,
             int internal_max_size /* = -1 */,
-            int leaf_max_size /* = -1 */)
+            int leaf_max_size /* = -1 */,
+            bool prefix_compressed /* = false */)
 {
+  if (attr_types.empty() || attr_types.size() != attr_lengths.size() ||
+      attr_types.size() > static_cast<size_t>(IndexFileHeader::MAX_ATTR_NUM)) {
+    LOG_WARN("invalid index attributes. attr num=%d, max attr num=%d", attr_types.size(), IndexFileHeader::MAX_ATTR_NUM);
+    return RC::INVALID_ARGUMENT;
+  }
+
+  int attr_length = 0;
+  for (int length : attr_lengths) {
+    attr_length += length;
+  }
+
   if (internal_max_size < 0) {
     internal_max_size = calc_internal_page_capacity(attr_length);
   }
+  if (prefix_compressed && (attr_types.size() != 1 || attr_types[0] != AttrType::CHARS)) {
+    LOG_WARN("prefix compression only supports single chars attribute. attr num=%d, attr type=%s",
+             attr_types.size(), attr_type_to_string(attr_types[0]));
+    return RC::INVALID_ARGUMENT;
+  }
+
   if (leaf_max_size < 0) {
-    leaf_max_size = calc_leaf_page_capacity(attr_length);
+    leaf_max_size = prefix_compressed ? calc_prefix_leaf_page_capacity(attr_length, 0)
+                                      : calc_leaf_page_capacity(attr_length);
   }
 
   log_handler_      = &log_handler;
@@ -878,10 +1359,16 @@ RC BplusTreeHandler::create(LogHandler &log_handler,
   IndexFileHeader *file_header   = (IndexFileHeader *)pdata;
   file_header->attr_length       = attr_length;
   file_header->key_length        = attr_length + sizeof(RID);
-  file_header->attr_type         = attr_type;
+  file_header->attr_type         = attr_types[0];
+  file_header->attr_num          = static_cast<int32_t>(attr_types.size());
+  for (size_t i = 0; i < attr_types.size(); i++) {
+    file_header->attr_types[i]   = attr_types[i];
+    file_header->attr_lengths[i] = attr_lengths[i];
+  }
   file_header->internal_max_size = internal_max_size;
   file_header->leaf_max_size     = leaf_max_size;
   file_header->root_page         = BP_INVALID_PAGE_NUM;
+  file_header->prefix_compressed = prefix_compressed ? 1 : 0;
   unique_                        = unique;
 
   // 取消记录日志的原因请参考下面的sync调用的地方。
@@ -899,8 +1386,7 @@ RC BplusTreeHandler::create(LogHandler &log_handler,
     return RC::NOMEM;
   }
 
-  key_comparator_.init(file_header->attr_type, file_header->attr_length);
-  key_printer_.init(file_header->attr_type, file_header->attr_length);
+  init_key_comparator();
 
   /*
   虽然我们针对B+树记录了WAL，但是我们记录的都是逻辑日志，并没有记录某个页面如何修改的物理日志。
@@ -972,12 +1458,22 @@ RC BplusTreeHandler::open(LogHandler &log_handler, DiskBufferPool &buffer_pool,
   // close old page_handle
   buffer_pool.unpin_page(frame);
 
-  key_comparator_.init(file_header_.attr_type, file_header_.attr_length);
-  key_printer_.init(file_header_.attr_type, file_header_.attr_length);
+  init_key_comparator();
   LOG_INFO("Successfully open index");
   return RC::SUCCESS;
 }
 
+void BplusTreeHandler::init_key_comparator()
+{
+  if (file_header_.attr_num <= 0) {
+    file_header_.attr_num        = 1;
+    file_header_.attr_types[0]   = file_header_.attr_type;
+    file_header_.attr_lengths[0] = file_header_.attr_length;
+  }
+  key_comparator_.init(file_header_.attr_num, file_header_.attr_types, file_header_.attr_lengths);
+  key_printer_.init(file_header_.attr_num, file_header_.attr_types, file_header_.attr_lengths);
+}
+
 RC BplusTreeHandler::close()
 {
   if (disk_buffer_pool_ != nullptr) {
@@ -1201,8 +1697,14 @@ bool BplusTreeHandler::is_empty() const { return file_header_.root_page == BP_IN
 
 RC BplusTreeHandler::find_leaf(BplusTreeMiniTransaction &mtr, BplusTreeOperationType op, const char *key, Frame *&frame)
 {
-  auto child_page_getter = [this, key](InternalIndexNodeHandler &internal_node) {
-    return internal_node.value_at(internal_node.lookup(key_comparator_, key));
+  return find_leaf(mtr, op, key_comparator_, key, frame);
+}
+
+RC BplusTreeHandler::find_leaf(BplusTreeMiniTransaction &mtr, BplusTreeOperationType op,
+    const KeyComparator &comparator, const char *key, Frame *&frame)
+{
+  auto child_page_getter = [&comparator, key](InternalIndexNodeHandler &internal_node) {
+    return internal_node.value_at(internal_node.lookup(comparator, key));
   };
   return find_leaf_internal(mtr, op, child_page_getter, frame);
 }
@@ -1213,9 +1715,88 @@ RC BplusTreeHandler::left_most_page(BplusTreeMiniTransaction &mtr, Frame *&frame
   return find_leaf_internal(mtr, BplusTreeOperationType::READ, child_page_getter, frame);
 }
 
+RC BplusTreeHandler::right_most_page(BplusTreeMiniTransaction &mtr, Frame *&frame)
+{
+  auto child_page_getter = [](InternalIndexNodeHandler &internal_node) {
+    return internal_node.value_at(internal_node.size() - 1);
+  };
+  return find_leaf_internal(mtr, BplusTreeOperationType::READ, child_page_getter, frame);
+}
+
+RC BplusTreeHandler::prev_leaf(BplusTreeMiniTransaction &mtr, const char *key, Frame *&frame)
+{
+  /**
+   * 第一次查找key所在的叶子节点，记录最深的一个不是走最左边子节点的内部节点上的键值。
+   * 前一个叶子节点就是这个内部节点上左边一个子树中最右边的叶子节点，
+   * 这个键值不一定存在于叶子节点中，但是前一个叶子节点上的数据都比它小。
+   */
+  vector<char> separator(file_header_.key_length);
+  bool         found = false;
+
+  auto key_getter = [this, key, &separator, &found](InternalIndexNodeHandler &internal_node) {
+    if (internal_node.page_num() == file_header_.root_page) {
+      found = false;  // 乐观查找失败时会从根节点重新开始
+    }
+    const int index = internal_node.lookup(key_comparator_, key);
+    if (index > 0) {
+      found = true;
+      memcpy(separator.data(), internal_node.key_at(index), file_header_.key_length);
+    }
+    return internal_node.value_at(index);
+  };
+
+  LatchMemo &latch_memo = mtr.latch_memo();
+  const int  memo_point = latch_memo.memo_point();
+
+  RC rc = find_leaf_internal(mtr, BplusTreeOperationType::READ, key_getter, frame);
+  latch_memo.release_from(memo_point);
+  frame = nullptr;
+  if (rc == RC::EMPTY) {
+    return RC::SUCCESS;
+  } else if (OB_FAIL(rc)) {
+    LOG_WARN("failed to find leaf page. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  if (!found) {  // 一直走的最左边的子节点，已经是第一个叶子节点
+    return RC::SUCCESS;
+  }
+
+  // 每一层都选择最后一个比分隔键值小的子节点
+  auto separator_getter = [this, &separator](InternalIndexNodeHandler &internal_node) {
+    int index = internal_node.lookup(key_comparator_, separator.data());
+    if (index > 0 && key_comparator_(internal_node.key_at(index), separator.data()) >= 0) {
+      index--;
+    }
+    return internal_node.value_at(index);
+  };
+
+  rc = find_leaf_internal(mtr, BplusTreeOperationType::READ, separator_getter, frame);
+  if (rc == RC::EMPTY) {
+    frame = nullptr;
+    return RC::SUCCESS;
+  }
+  return rc;
+}
+
 RC BplusTreeHandler::find_leaf_internal(BplusTreeMiniTransaction &mtr, BplusTreeOperationType op,
     const function<PageNum(InternalIndexNodeHandler &)> &child_page_getter, Frame *&frame)
 {
+  if (optimistic_descent_) {
+    for (int i = 0; i < MAX_OPTIMISTIC_RETRY; i++) {
+      RC rc = optimistic_find_leaf(mtr, op, child_page_getter, frame);
+      if (OB_SUCC(rc) && frame != nullptr) {
+        return rc;
+      }
+      if (OB_SUCC(rc)) {
+        break;  // 叶子节点可能分裂或合并
+      }
+      if (rc != RC::LOCKED_CONCURRENCY_CONFLICT) {
+        return rc;
+      }
+    }
+  }
+
   LatchMemo &latch_memo = mtr.latch_memo();
 
   // root locked
@@ -1251,10 +1832,115 @@ RC BplusTreeHandler::find_leaf_internal(BplusTreeMiniTransaction &mtr, BplusTree
   return RC::SUCCESS;
 }
 
-RC BplusTreeHandler::crabing_protocal_fetch_page(
-    BplusTreeMiniTransaction &mtr, BplusTreeOperationType op, PageNum page_num, bool is_root_node, Frame *&frame)
+RC BplusTreeHandler::optimistic_find_leaf(BplusTreeMiniTransaction &mtr, BplusTreeOperationType op,
+    const function<PageNum(InternalIndexNodeHandler &)> &child_page_getter, Frame *&frame)
 {
-  LatchMemo &latch_memo = mtr.latch_memo();
+  frame = nullptr;
+
+  auto validate_root = [this](uint64_t version) {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return (version & 1) == 0 && root_version_.load(std::memory_order_relaxed) == version;
+  };
+
+  const uint64_t root_version = root_version_.load(std::memory_order_acquire);
+  const PageNum  root_page    = file_header_.root_page;
+  if (root_page == BP_INVALID_PAGE_NUM) {
+    return validate_root(root_version) ? RC::EMPTY : RC::LOCKED_CONCURRENCY_CONFLICT;
+  }
+
+  // 内部节点不加锁也不记录到 latch memo 中，同时最多pin住父子两个页面
+  Frame   *parent         = nullptr;
+  uint64_t parent_version = 0;
+  Frame   *current        = nullptr;
+  uint64_t current_version = 0;
+  auto     unpin_all       = [this, &parent, &current]() {
+    if (parent != nullptr) {
+      disk_buffer_pool_->unpin_page(parent);
+    }
+    if (current != nullptr) {
+      disk_buffer_pool_->unpin_page(current);
+    }
+  };
+
+  // 页面可能已经被释放，加载失败时当做冲突处理，重试多次后由加锁的方式报告错误
+  if (OB_FAIL(disk_buffer_pool_->get_this_page(root_page, &current))) {
+    return RC::LOCKED_CONCURRENCY_CONFLICT;
+  }
+  current_version = current->read_version();
+  if (!validate_root(root_version)) {
+    unpin_all();
+    return RC::LOCKED_CONCURRENCY_CONFLICT;
+  }
+
+  while (!reinterpret_cast<IndexNode *>(current->data())->is_leaf) {
+    InternalIndexNodeHandler internal_node(mtr, file_header_, current);
+    // 读到的可能是修改了一半的数据，先检查节点大小，避免越界访问
+    const int size = internal_node.size();
+    PageNum   child_page = BP_INVALID_PAGE_NUM;
+    if (size > 0 && size <= internal_node.max_size()) {
+      child_page = child_page_getter(internal_node);
+    }
+    if (!current->validate_version(current_version) || child_page == BP_INVALID_PAGE_NUM) {
+      unpin_all();
+      return RC::LOCKED_CONCURRENCY_CONFLICT;
+    }
+
+    if (parent != nullptr) {
+      disk_buffer_pool_->unpin_page(parent);
+    }
+    parent         = current;
+    parent_version = current_version;
+    current        = nullptr;
+
+    if (OB_FAIL(disk_buffer_pool_->get_this_page(child_page, &current))) {
+      current = nullptr;
+      unpin_all();
+      return RC::LOCKED_CONCURRENCY_CONFLICT;
+    }
+    current_version = current->read_version();
+    // 读取子节点版本号之后再校验父节点，确保子节点在这之前没有被合并或释放
+    if (!parent->validate_version(parent_version)) {
+      unpin_all();
+      return RC::LOCKED_CONCURRENCY_CONFLICT;
+    }
+  }
+
+  // 叶子节点通过 latch memo 加锁，加锁后父节点没有变化，说明这个叶子节点依然是正确的。
+  // 校验之前父节点要一直pin住，否则页帧可能被其它页面复用
+  LatchMemo &latch_memo = mtr.latch_memo();
+  const int  memo_point = latch_memo.memo_point();
+  Frame     *leaf_frame = nullptr;
+  RC         rc         = latch_memo.get_page(current->page_num(), leaf_frame);
+  disk_buffer_pool_->unpin_page(current);
+  current = nullptr;
+  if (OB_FAIL(rc)) {
+    unpin_all();
+    return RC::LOCKED_CONCURRENCY_CONFLICT;
+  }
+
+  const bool readonly = (op == BplusTreeOperationType::READ);
+  latch_memo.latch(leaf_frame, readonly ? LatchMemoType::SHARED : LatchMemoType::EXCLUSIVE);
+  const bool valid = (parent == nullptr) ? validate_root(root_version) : parent->validate_version(parent_version);
+  unpin_all();
+  if (!valid) {
+    latch_memo.release_from(memo_point);
+    return RC::LOCKED_CONCURRENCY_CONFLICT;
+  }
+
+  IndexNodeHandler leaf_node(mtr, file_header_, leaf_frame);
+  if (!leaf_node.is_safe(op, parent == nullptr /*is_root_node*/)) {
+    latch_memo.release_from(memo_point);
+    return RC::SUCCESS;
+  }
+
+  frame = leaf_frame;
+  return RC::SUCCESS;
+}
+
+RC BplusTreeHandler::crabing_protocal_fetch_page(
+    BplusTreeMiniTransaction &mtr, BplusTreeOperationType op, PageNum page_num, bool is_root_node, Frame *&frame)
+{
+  LatchMemo &latch_memo = mtr.latch_memo();
   bool      readonly   = (op == BplusTreeOperationType::READ);
   const int memo_point = latch_memo.memo_point();
 
@@ -1289,15 +1975,21 @@ RC BplusTreeHandler::insert_entry_into_leaf_node(BplusTreeMiniTransaction &mtr,
     return RC::RECORD_DUPLICATE_KEY;
   }
 
-  if (leaf_node.size() < leaf_node.max_size()) {
+  if (leaf_node.can_insert(key)) {
     leaf_node.insert(insert_position, key, (const char *)rid);
     frame->mark_dirty();
     // disk_buffer_pool_->unpin_page(frame); // unpin pages 由latch memo 来操作
     return RC::SUCCESS;
   }
 
+  // 前缀压缩的节点中，与前缀不同的键值一定在节点的两端，从插入位置分裂可以让两个节点都保留较长的前缀
+  int move_index = leaf_node.size() / 2;
+  if (leaf_node.prefix_compressed() && leaf_node.common_prefix_length(key) < leaf_node.prefix_length()) {
+    move_index = insert_position;
+  }
+
   Frame *new_frame = nullptr;
-  RC     rc        = split<LeafIndexNodeHandler>(mtr, frame, new_frame);
+  RC     rc        = split<LeafIndexNodeHandler>(mtr, frame, new_frame, move_index);
   if (OB_FAIL(rc)) {
     LOG_WARN("failed to split leaf node. rc=%d:%s", rc, strrc(rc));
     return rc;
@@ -1308,7 +2000,7 @@ RC BplusTreeHandler::insert_entry_into_leaf_node(BplusTreeMiniTransaction &mtr,
   new_index_node.set_parent_page_num(leaf_node.parent_page_num());
   leaf_node.set_next_page(new_frame->page_num());
 
-  if (insert_position < leaf_node.size()) {
+  if (insert_position < leaf_node.size() || leaf_node.size() == 0) {
     leaf_node.insert(insert_position, key, (const char *)rid);
   } else {
     new_index_node.insert(insert_position - leaf_node.size(), key, (const char *)rid);
@@ -1419,7 +2111,7 @@ RC BplusTreeHandler::insert_entry_into_parent(BplusTreeMiniTransaction &mtr, Fra
  * split one full node into two
  */
 template <typename IndexNodeHandlerType>
-RC BplusTreeHandler::split(BplusTreeMiniTransaction &mtr, Frame *frame, Frame *&new_frame)
+RC BplusTreeHandler::split(BplusTreeMiniTransaction &mtr, Frame *frame, Frame *&new_frame, int move_index /* = -1 */)
 {
   IndexNodeHandlerType old_node(mtr, file_header_, frame);
 
@@ -1436,7 +2128,15 @@ RC BplusTreeHandler::split(BplusTreeMiniTransaction &mtr, Frame *frame, Frame *&
   new_node.init_empty();
   new_node.set_parent_page_num(old_node.parent_page_num());
 
-  old_node.move_half_to(new_node);
+  if constexpr (std::is_same_v<IndexNodeHandlerType, LeafIndexNodeHandler>) {
+    if (move_index >= 0) {
+      old_node.move_tail_to(new_node, move_index);
+    } else {
+      old_node.move_half_to(new_node);
+    }
+  } else {
+    old_node.move_half_to(new_node);
+  }
 
   frame->mark_dirty();
   new_frame->mark_dirty();
@@ -1457,8 +2157,7 @@ RC BplusTreeHandler::recover_init_header_page(BplusTreeMiniTransaction &mtr, Fra
   header_dirty_ = false;
   frame->mark_dirty();
 
-  key_comparator_.init(file_header_.attr_type, file_header_.attr_length);
-  key_printer_.init(file_header_.attr_type, file_header_.attr_length);
+  init_key_comparator();
 
   return RC::SUCCESS;
 }
@@ -1471,7 +2170,13 @@ void BplusTreeHandler::update_root_page_num_locked(BplusTreeMiniTransaction &mtr
   IndexFileHeader *file_header = reinterpret_cast<IndexFileHeader *>(frame->data());
   mtr.logger().update_root_page(frame, root_page_num, file_header->root_page);
   file_header->root_page = root_page_num;
+
+  // 乐观查找的线程会在读取根节点页号前后校验 root_version_
+  root_version_.store(root_version_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
   file_header_.root_page = root_page_num;
+  root_version_.store(root_version_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+
   header_dirty_          = true;
   frame->mark_dirty();
   LOG_DEBUG("set root page to %d", root_page_num);
@@ -1586,6 +2291,225 @@ RC BplusTreeHandler::get_entry(const char *user_key, int key_len, list<RID> &rid
   return rc;
 }
 
+/**
+ * @brief 计算批量构建时一层需要的节点个数
+ * @details 每个节点按照填充比例放置元素，但是不能超过节点的最大值，有多个节点时每个节点也不能少于最小值
+ */
+static int64_t calc_bulk_load_node_num(int64_t item_num, int max_size, int fill_factor)
+{
+  const int     min_size = max_size - max_size / 2;
+  const int     target   = std::max(min_size, max_size * fill_factor / 100);
+  const int64_t node_num = std::max(item_num / target, (item_num + max_size - 1) / max_size);
+  return std::max(node_num, int64_t(1));
+}
+
+RC BplusTreeHandler::bulk_load(int64_t key_num, const function<RC(char *key)> &next_key, int fill_factor)
+{
+  if (!is_empty()) {
+    LOG_WARN("cannot bulk load a non-empty b+tree");
+    return RC::INTERNAL;
+  }
+  if (key_num <= 0) {
+    return RC::SUCCESS;
+  }
+  fill_factor = std::min(std::max(fill_factor, 1), 100);
+
+  const int key_length         = file_header_.key_length;
+  const int leaf_item_size     = key_length + sizeof(RID);
+  const int internal_item_size = key_length + sizeof(PageNum);
+
+  RC rc = RC::SUCCESS;
+
+  // 当前层每个节点的第一个键值和页号，也就是上一层内部节点的元素
+  vector<char> level_items;
+  vector<char> items;
+  int64_t      node_num  = 0;
+  PageNum      page_num  = BP_INVALID_PAGE_NUM;
+  BufferRing   ring;
+  if (file_header_.prefix_compressed) {
+    rc = bulk_load_prefix_compressed_leaves(key_num, next_key, fill_factor, level_items, page_num, ring);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+    node_num = level_items.size() / internal_item_size;
+  } else {
+    node_num          = calc_bulk_load_node_num(key_num, file_header_.leaf_max_size, fill_factor);
+    PageNum prev_page = BP_INVALID_PAGE_NUM;
+    level_items.resize(node_num * internal_item_size);
+    for (int64_t i = 0; i < node_num; i++) {
+      const int item_num = static_cast<int>(key_num / node_num + (i < key_num % node_num ? 1 : 0));
+      items.resize(item_num * leaf_item_size);
+      for (int j = 0; j < item_num; j++) {
+        char *item = items.data() + j * leaf_item_size;
+        rc         = next_key(item);
+        if (OB_FAIL(rc)) {
+          LOG_WARN("failed to get next key while bulk loading. rc=%s", strrc(rc));
+          return rc;
+        }
+        // 叶子节点的值就是键值中的RID
+        memcpy(item + key_length, item + file_header_.attr_length, sizeof(RID));
+      }
+
+      rc = bulk_load_leaf(prev_page, items.data(), item_num, page_num, ring);
+      if (OB_FAIL(rc)) {
+        return rc;
+      }
+      memcpy(level_items.data() + i * internal_item_size, items.data(), key_length);
+      memcpy(level_items.data() + i * internal_item_size + key_length, &page_num, sizeof(page_num));
+      prev_page = page_num;
+    }
+  }
+
+  while (node_num > 1) {
+    const int64_t child_num = node_num;
+    items.swap(level_items);
+    node_num = calc_bulk_load_node_num(child_num, file_header_.internal_max_size, fill_factor);
+    level_items.resize(node_num * internal_item_size);
+
+    const char *child_items = items.data();
+    for (int64_t i = 0; i < node_num; i++) {
+      const int item_num = static_cast<int>(child_num / node_num + (i < child_num % node_num ? 1 : 0));
+      rc                 = bulk_load_internal(child_items, item_num, page_num);
+      if (OB_FAIL(rc)) {
+        return rc;
+      }
+      memcpy(level_items.data() + i * internal_item_size, child_items, key_length);
+      memcpy(level_items.data() + i * internal_item_size + key_length, &page_num, sizeof(page_num));
+      child_items += item_num * internal_item_size;
+    }
+  }
+
+  BplusTreeMiniTransaction mtr(*this, &rc);
+  update_root_page_num_locked(mtr, page_num);
+  LOG_INFO("bulk load b+tree done. key num=%ld, root page=%d, fill factor=%d", key_num, page_num, fill_factor);
+  return rc;
+}
+
+RC BplusTreeHandler::bulk_load_prefix_compressed_leaves(int64_t key_num, const function<RC(char *key)> &next_key,
+    int fill_factor, vector<char> &level_items, PageNum &page_num, BufferRing &ring)
+{
+  // 前缀压缩的叶子节点能放多少元素与节点中键值的共同前缀有关，因此逐个读取键值，放不下时再开始一个新的节点
+  const int key_length         = file_header_.key_length;
+  const int attr_length        = file_header_.attr_length;
+  const int leaf_item_size     = key_length + sizeof(RID);
+  const int internal_item_size = key_length + sizeof(PageNum);
+  const int min_size           = file_header_.leaf_max_size - file_header_.leaf_max_size / 2;
+
+  RC           rc = RC::SUCCESS;
+  vector<char> items;
+  vector<char> item(leaf_item_size);
+  bool         has_item  = false;  // item 中是否有一个读取了但是还没有放到节点中的元素
+  int64_t      loaded    = 0;
+  PageNum      prev_page = BP_INVALID_PAGE_NUM;
+  while (loaded < key_num || has_item) {
+    int item_num      = 0;
+    int prefix_length = 0;
+    items.clear();
+    while (true) {
+      if (!has_item) {
+        if (loaded >= key_num) {
+          break;
+        }
+        rc = next_key(item.data());
+        if (OB_FAIL(rc)) {
+          LOG_WARN("failed to get next key while bulk loading. rc=%s", strrc(rc));
+          return rc;
+        }
+        // 叶子节点的值就是键值中的RID
+        memcpy(item.data() + key_length, item.data() + attr_length, sizeof(RID));
+        loaded++;
+        has_item = true;
+      }
+
+      int length = 0;
+      const int max_length = item_num == 0 ? attr_length : prefix_length;
+      while (length < max_length && item[length] != 0 && (item_num == 0 || item[length] == items[length])) {
+        length++;
+      }
+
+      const int target = std::max(min_size, calc_prefix_leaf_capacity(file_header_, length) * fill_factor / 100);
+      if (item_num + 1 > target) {
+        break;
+      }
+
+      items.insert(items.end(), item.begin(), item.end());
+      prefix_length = length;
+      item_num++;
+      has_item = false;
+    }
+
+    rc = bulk_load_leaf(prev_page, items.data(), item_num, page_num, ring);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+    const size_t offset = level_items.size();
+    level_items.resize(offset + internal_item_size);
+    memcpy(level_items.data() + offset, items.data(), key_length);
+    memcpy(level_items.data() + offset + key_length, &page_num, sizeof(page_num));
+    prev_page = page_num;
+  }
+  return rc;
+}
+
+RC BplusTreeHandler::bulk_load_leaf(
+    PageNum prev_page_num, const char *items, int item_num, PageNum &page_num, BufferRing &ring)
+{
+  RC rc = RC::SUCCESS;
+
+  BplusTreeMiniTransaction mtr(*this, &rc);
+
+  Frame *frame = nullptr;
+  rc           = mtr.latch_memo().allocate_page(frame, &ring);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to allocate leaf page. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  LeafIndexNodeHandler leaf_node(mtr, file_header_, frame);
+  if (OB_FAIL(rc = leaf_node.init_empty()) || OB_FAIL(rc = leaf_node.append(items, item_num))) {
+    LOG_WARN("failed to fill leaf page. rc=%s", strrc(rc));
+    return rc;
+  }
+  frame->mark_dirty();
+  page_num = frame->page_num();
+
+  if (prev_page_num != BP_INVALID_PAGE_NUM) {
+    Frame *prev_frame = nullptr;
+    rc                = mtr.latch_memo().get_page(prev_page_num, prev_frame);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to get previous leaf page. page num=%d, rc=%s", prev_page_num, strrc(rc));
+      return rc;
+    }
+    LeafIndexNodeHandler prev_node(mtr, file_header_, prev_frame);
+    rc = prev_node.set_next_page(page_num);
+    prev_frame->mark_dirty();
+  }
+  return rc;
+}
+
+RC BplusTreeHandler::bulk_load_internal(const char *items, int item_num, PageNum &page_num)
+{
+  RC rc = RC::SUCCESS;
+
+  BplusTreeMiniTransaction mtr(*this, &rc);
+
+  Frame *frame = nullptr;
+  rc           = mtr.latch_memo().allocate_page(frame);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to allocate internal page. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  InternalIndexNodeHandler internal_node(mtr, file_header_, frame);
+  if (OB_FAIL(rc = internal_node.init_empty()) || OB_FAIL(rc = internal_node.append(items, item_num))) {
+    LOG_WARN("failed to fill internal page. rc=%s", strrc(rc));
+    return rc;
+  }
+  frame->mark_dirty();
+  page_num = frame->page_num();
+  return rc;
+}
+
 RC BplusTreeHandler::adjust_root(BplusTreeMiniTransaction &mtr, Frame *root_frame)
 {
   LatchMemo &latch_memo = mtr.latch_memo();
@@ -1683,7 +2607,7 @@ RC BplusTreeHandler::coalesce_or_redistribute(BplusTreeMiniTransaction &mtr, Fra
   latch_memo.xlatch(neighbor_frame);
 
   IndexNodeHandlerType neighbor_node(mtr, file_header_, neighbor_frame);
-  if (index_node.size() + neighbor_node.size() > index_node.max_size()) {
+  if (!index_node.can_merge(neighbor_node)) {
     rc = redistribute<IndexNodeHandlerType>(mtr, neighbor_frame, frame, parent_frame, index);
   } else {
     rc = coalesce<IndexNodeHandlerType>(mtr, neighbor_frame, frame, parent_frame, index);
@@ -1847,7 +2771,7 @@ BplusTreeScanner::BplusTreeScanner(BplusTreeHandler &tree_handler)
 BplusTreeScanner::~BplusTreeScanner() { close(); }
 
 RC BplusTreeScanner::open(const char *left_user_key, int left_len, bool left_inclusive, const char *right_user_key,
-    int right_len, bool right_inclusive)
+    int right_len, bool right_inclusive, bool reverse /*= false*/)
 {
   RC rc = RC::SUCCESS;
   if (inited_) {
@@ -1857,21 +2781,60 @@ RC BplusTreeScanner::open(const char *left_user_key, int left_len, bool left_inc
 
   inited_        = true;
   first_emitted_ = false;
+  reverse_       = reverse;
 
   LatchMemo &latch_memo = mtr_.latch_memo();
 
+  // 组合索引的边界可以只包含最左边的几个字段，参与比较的字段个数由边界的长度决定
+  const auto &attr_comparator = tree_handler_.key_comparator_.attr_comparator();
+  const bool  composite       = attr_comparator.attr_num() > 1;
+  int         left_attr_num   = attr_comparator.attr_num();
+  int         right_attr_num  = attr_comparator.attr_num();
+  if (composite) {
+    if (left_user_key != nullptr && (left_attr_num = attr_comparator.prefix_attr_num(left_len)) < 0) {
+      LOG_WARN("invalid left key length of composite index. len=%d", left_len);
+      return RC::INVALID_ARGUMENT;
+    }
+    if (right_user_key != nullptr && (right_attr_num = attr_comparator.prefix_attr_num(right_len)) < 0) {
+      LOG_WARN("invalid right key length of composite index. len=%d", right_len);
+      return RC::INVALID_ARGUMENT;
+    }
+  }
+
   // 校验输入的键值是否是合法范围
   if (left_user_key && right_user_key) {
-    const auto &attr_comparator = tree_handler_.key_comparator_.attr_comparator();
-    const int   result          = attr_comparator(left_user_key, right_user_key);
+    const int result = attr_comparator.compare(left_user_key, right_user_key, std::min(left_attr_num, right_attr_num));
     if (result > 0 ||  // left < right
                        // left == right but is (left,right)/[left,right) or (left,right]
-        (result == 0 && (left_inclusive == false || right_inclusive == false))) {
+        (result == 0 && left_attr_num == right_attr_num && (left_inclusive == false || right_inclusive == false))) {
       return RC::INVALID_ARGUMENT;
     }
   }
 
-  if (nullptr == left_user_key) {
+  // 没有指定边界范围时，对应的边界就是最小值或最大值
+  left_key_ = nullptr;
+  if (left_user_key != nullptr) {
+    rc = make_bound_key(left_user_key, left_len, left_inclusive, true /*is_left*/, left_attr_num, left_key_);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
+  left_comparator_ = tree_handler_.key_comparator_.prefix(left_attr_num);
+
+  right_key_ = nullptr;
+  if (right_user_key != nullptr) {
+    rc = make_bound_key(right_user_key, right_len, right_inclusive, false /*is_left*/, right_attr_num, right_key_);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
+  right_comparator_ = tree_handler_.key_comparator_.prefix(right_attr_num);
+
+  if (reverse_) {
+    return seek_last();
+  }
+
+  if (nullptr == left_key_) {
     rc = tree_handler_.left_most_page(mtr_, current_frame_);
     if (OB_FAIL(rc)) {
       if (rc == RC::EMPTY) {
@@ -1886,35 +2849,9 @@ RC BplusTreeScanner::open(const char *left_user_key, int left_len, bool left_inc
     iter_index_ = 0;
   } else {
 
-    char *fixed_left_key = const_cast<char *>(left_user_key);
-    if (tree_handler_.file_header_.attr_type == AttrType::CHARS) {
-      bool should_inclusive_after_fix = false;
-      rc = fix_user_key(left_user_key, left_len, true /*greater*/, &fixed_left_key, &should_inclusive_after_fix);
-      if (OB_FAIL(rc)) {
-        LOG_WARN("failed to fix left user key. rc=%s", strrc(rc));
-        return rc;
-      }
-
-      if (should_inclusive_after_fix) {
-        left_inclusive = true;
-      }
-    }
-
-    MemPoolItem::item_unique_ptr left_pkey;
-    if (left_inclusive) {
-      left_pkey = tree_handler_.make_key(fixed_left_key, *RID::min());
-    } else {
-      left_pkey = tree_handler_.make_key(fixed_left_key, *RID::max());
-    }
+    const char *left_key = (const char *)left_key_.get();
 
-    const char *left_key = (const char *)left_pkey.get();
-
-    if (fixed_left_key != left_user_key) {
-      delete[] fixed_left_key;
-      fixed_left_key = nullptr;
-    }
-
-    rc = tree_handler_.find_leaf(mtr_, BplusTreeOperationType::READ, left_key, current_frame_);
+    rc = tree_handler_.find_leaf(mtr_, BplusTreeOperationType::READ, left_comparator_, left_key, current_frame_);
     if (rc == RC::EMPTY) {
       rc             = RC::SUCCESS;
       current_frame_ = nullptr;
@@ -1925,7 +2862,7 @@ RC BplusTreeScanner::open(const char *left_user_key, int left_len, bool left_inc
     }
 
     LeafIndexNodeHandler left_node(mtr_, tree_handler_.file_header_, current_frame_);
-    int                  left_index = left_node.lookup(tree_handler_.key_comparator_, left_key);
+    int                  left_index = left_node.lookup(left_comparator_, left_key);
     // lookup 返回的是适合插入的位置，还需要判断一下是否在合适的边界范围内
     if (left_index >= left_node.size()) {  // 超出了当前页，就需要向后移动一个位置
       const PageNum next_page_num = left_node.next_page();
@@ -1947,47 +2884,141 @@ RC BplusTreeScanner::open(const char *left_user_key, int left_len, bool left_inc
     iter_index_ = left_index;
   }
 
-  // 没有指定右边界范围，那么就返回右边界最大值
-  if (nullptr == right_user_key) {
-    right_key_ = nullptr;
-  } else {
+  if (touch_end()) {
+    current_frame_ = nullptr;
+  }
 
-    char *fixed_right_key          = const_cast<char *>(right_user_key);
-    bool  should_include_after_fix = false;
-    if (tree_handler_.file_header_.attr_type == AttrType::CHARS) {
-      rc = fix_user_key(right_user_key, right_len, false /*want_greater*/, &fixed_right_key, &should_include_after_fix);
-      if (OB_FAIL(rc)) {
-        LOG_WARN("failed to fix right user key. rc=%s", strrc(rc));
-        return rc;
-      }
+  return RC::SUCCESS;
+}
 
-      if (should_include_after_fix) {
-        right_inclusive = true;
-      }
-    }
-    if (right_inclusive) {
-      right_key_ = tree_handler_.make_key(fixed_right_key, *RID::max());
-    } else {
-      right_key_ = tree_handler_.make_key(fixed_right_key, *RID::min());
+RC BplusTreeScanner::make_bound_key(const char *user_key, int key_len, bool inclusive, bool is_left, int &attr_num,
+    MemPoolItem::item_unique_ptr &key)
+{
+  RC    rc        = RC::SUCCESS;
+  char *fixed_key = const_cast<char *>(user_key);
+  if (tree_handler_.key_comparator_.attr_comparator().attr_num() > 1) {
+    rc = fix_prefix_key(user_key, key_len, &fixed_key, &attr_num);
+  } else if (tree_handler_.file_header_.attr_type == AttrType::CHARS) {
+    bool should_inclusive_after_fix = false;
+    rc = fix_user_key(user_key, key_len, is_left /*want_greater*/, &fixed_key, &should_inclusive_after_fix);
+    if (OB_SUCC(rc) && should_inclusive_after_fix) {
+      inclusive = true;
     }
+  }
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to fix %s user key. rc=%s", is_left ? "left" : "right", strrc(rc));
+    return rc;
+  }
 
-    if (fixed_right_key != right_user_key) {
-      delete[] fixed_right_key;
-      fixed_right_key = nullptr;
-    }
+  // 包含边界时，左边界排在所有相同键值之前，右边界排在所有相同键值之后。不包含边界时正好相反
+  if (inclusive == is_left) {
+    key = tree_handler_.make_key(fixed_key, *RID::min());
+  } else {
+    key = tree_handler_.make_key(fixed_key, *RID::max());
   }
 
-  if (touch_end()) {
+  if (fixed_key != user_key) {
+    delete[] fixed_key;
+  }
+  return RC::SUCCESS;
+}
+
+RC BplusTreeScanner::seek_last()
+{
+  RC rc = RC::SUCCESS;
+  if (nullptr == right_key_) {
+    rc = tree_handler_.right_most_page(mtr_, current_frame_);
+  } else {
+    rc = tree_handler_.find_leaf(mtr_,
+        BplusTreeOperationType::READ,
+        right_comparator_,
+        static_cast<const char *>(right_key_.get()),
+        current_frame_);
+  }
+
+  if (rc == RC::EMPTY) {
     current_frame_ = nullptr;
+    return RC::SUCCESS;
+  } else if (OB_FAIL(rc)) {
+    LOG_WARN("failed to find right page. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  // lookup 返回第一个不小于右边界的位置，它前面的一个就是最后一条在范围内的数据
+  LeafIndexNodeHandler right_node(mtr_, tree_handler_.file_header_, current_frame_);
+  if (nullptr == right_key_) {
+    iter_index_ = right_node.size() - 1;
+  } else {
+    iter_index_ = right_node.lookup(right_comparator_, static_cast<const char *>(right_key_.get())) - 1;
+  }
+
+  if (iter_index_ < 0) {  // 当前页面的数据都比右边界大，数据在前一个页面中
+    rc = move_to_prev_leaf();
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
   }
 
+  if (current_frame_ != nullptr && touch_begin()) {
+    current_frame_ = nullptr;
+  }
   return RC::SUCCESS;
 }
 
-void BplusTreeScanner::fetch_item(RID &rid)
+RC BplusTreeScanner::move_to_prev_leaf()
+{
+  LatchMemo &latch_memo = mtr_.latch_memo();
+
+  LeafIndexNodeHandler node(mtr_, tree_handler_.file_header_, current_frame_);
+  if (node.size() == 0) {  // 只有空的根节点
+    latch_memo.release();
+    current_frame_ = nullptr;
+    return RC::SUCCESS;
+  }
+
+  /**
+   * 叶子节点只记录了后一个节点，这里使用当前节点的第一个键值从根节点重新查找前一个节点。
+   * 查找之前先释放当前节点的锁，否则与插入、删除的加锁顺序不一致，可能会死锁
+   */
+  const int    key_length = tree_handler_.file_header_.key_length;
+  vector<char> bound(node.key_at(0), node.key_at(0) + key_length);
+  vector<char> search_key(bound);
+  while (true) {
+    latch_memo.release();
+    current_frame_ = nullptr;
+
+    RC rc = tree_handler_.prev_leaf(mtr_, search_key.data(), current_frame_);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to find previous leaf page. rc=%s", strrc(rc));
+      return rc;
+    }
+    if (nullptr == current_frame_) {  // 已经是最左边的页面
+      return RC::SUCCESS;
+    }
+
+    LeafIndexNodeHandler prev_node(mtr_, tree_handler_.file_header_, current_frame_);
+    iter_index_ = prev_node.lookup(tree_handler_.key_comparator_, bound.data()) - 1;
+    if (iter_index_ >= 0) {
+      return RC::SUCCESS;
+    }
+
+    // 查找的过程中有并发的修改，找到的页面中没有更小的数据，继续向前查找
+    if (prev_node.size() == 0) {
+      latch_memo.release();
+      current_frame_ = nullptr;
+      return RC::SUCCESS;
+    }
+    memcpy(search_key.data(), prev_node.key_at(0), key_length);
+  }
+}
+
+void BplusTreeScanner::fetch_item(RID &rid, char *user_key)
 {
   LeafIndexNodeHandler node(mtr_, tree_handler_.file_header_, current_frame_);
   memcpy(&rid, node.value_at(iter_index_), sizeof(rid));
+  if (user_key != nullptr) {
+    memcpy(user_key, node.key_at(iter_index_), tree_handler_.file_header_.attr_length);
+  }
 }
 
 bool BplusTreeScanner::touch_end()
@@ -1999,22 +3030,38 @@ bool BplusTreeScanner::touch_end()
   LeafIndexNodeHandler node(mtr_, tree_handler_.file_header_, current_frame_);
 
   const char *this_key       = node.key_at(iter_index_);
-  int         compare_result = tree_handler_.key_comparator_(this_key, static_cast<char *>(right_key_.get()));
+  int         compare_result = right_comparator_(this_key, static_cast<char *>(right_key_.get()));
   return compare_result > 0;
 }
 
-RC BplusTreeScanner::next_entry(RID &rid)
+bool BplusTreeScanner::touch_begin()
+{
+  if (left_key_ == nullptr) {
+    return false;
+  }
+
+  LeafIndexNodeHandler node(mtr_, tree_handler_.file_header_, current_frame_);
+
+  const char *this_key = node.key_at(iter_index_);
+  return left_comparator_(this_key, static_cast<char *>(left_key_.get())) < 0;
+}
+
+RC BplusTreeScanner::next_entry(RID &rid, char *user_key)
 {
   if (nullptr == current_frame_) {
     return RC::RECORD_EOF;
   }
 
   if (!first_emitted_) {
-    fetch_item(rid);
+    fetch_item(rid, user_key);
     first_emitted_ = true;
     return RC::SUCCESS;
   }
 
+  if (reverse_) {
+    return prev_entry(rid, user_key);
+  }
+
   iter_index_++;
 
   LeafIndexNodeHandler node(mtr_, tree_handler_.file_header_, current_frame_);
@@ -2023,7 +3070,7 @@ RC BplusTreeScanner::next_entry(RID &rid)
       return RC::RECORD_EOF;
     }
 
-    fetch_item(rid);
+    fetch_item(rid, user_key);
     return RC::SUCCESS;
   }
 
@@ -2054,7 +3101,34 @@ RC BplusTreeScanner::next_entry(RID &rid)
 
   latch_memo.release_to(memo_point);
   iter_index_ = -1;  // `next` will add 1
-  return next_entry(rid);
+
+  // 叶子节点的页号不连续时，缓存层识别不出顺序访问，在处理当前节点的同时预读下一个节点
+  PageNum prefetch_page_num = LeafIndexNodeHandler(mtr_, tree_handler_.file_header_, current_frame_).next_page();
+  if (BP_INVALID_PAGE_NUM != prefetch_page_num && prefetch_page_num != current_frame_->page_num() + 1) {
+    tree_handler_.disk_buffer_pool_->prefetch_pages(prefetch_page_num, 1);
+  }
+  return next_entry(rid, user_key);
+}
+
+RC BplusTreeScanner::prev_entry(RID &rid, char *user_key)
+{
+  iter_index_--;
+  if (iter_index_ < 0) {
+    RC rc = move_to_prev_leaf();
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+    if (nullptr == current_frame_) {
+      return RC::RECORD_EOF;
+    }
+  }
+
+  if (touch_begin()) {
+    return RC::RECORD_EOF;
+  }
+
+  fetch_item(rid, user_key);
+  return RC::SUCCESS;
 }
 
 RC BplusTreeScanner::close()
@@ -2114,3 +3188,27 @@ RC BplusTreeScanner::fix_user_key(
   *fixed_key = key_buf;
   return RC::SUCCESS;
 }
+
+RC BplusTreeScanner::fix_prefix_key(const char *user_key, int key_len, char **fixed_key, int *attr_num)
+{
+  if (nullptr == fixed_key || nullptr == attr_num) {
+    return RC::INVALID_ARGUMENT;
+  }
+
+  const AttrComparator &attr_comparator = tree_handler_.key_comparator_.attr_comparator();
+
+  *attr_num = attr_comparator.prefix_attr_num(key_len);
+  if (*attr_num < 0) {
+    LOG_WARN("key length is not a prefix of the index key. key len=%d", key_len);
+    return RC::INVALID_ARGUMENT;
+  }
+
+  // 前缀之后的字段不参与比较，填充成0即可
+  int32_t attr_length = attr_comparator.attr_length();
+  char   *key_buf     = new char[attr_length];
+  memcpy(key_buf, user_key, key_len);
+  memset(key_buf + key_len, 0, attr_length - key_len);
+
+  *fixed_key = key_buf;
+  return RC::SUCCESS;
+}
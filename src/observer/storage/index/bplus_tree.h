@@ -19,10 +19,14 @@ See the Mulan PSL v2 for more details. */
 
 #include <string.h>
 
+#include "common/date.h"
+#include "common/defs.h"
+#include "common/lang/atomic.h"
 #include "common/lang/comparator.h"
 #include "common/lang/memory.h"
 #include "common/lang/sstream.h"
 #include "common/lang/functional.h"
+#include "common/lang/vector.h"
 #include "common/log/log.h"
 #include "sql/parser/parse_defs.h"
 #include "storage/buffer/disk_buffer_pool.h"
@@ -49,36 +53,145 @@ enum class BplusTreeOperationType
   DELETE,
 };
 
+/**
+ * @brief 按照字段类型特化的比较函数
+ * @details 比较结果与对应类型的 DataType::compare 一致，但是直接比较键值中的数据，不需要构造 Value 对象。
+ * 字符串按照定长字段比较，遇到'\0'结束。
+ * @ingroup BPlusTree
+ */
+template <AttrType TYPE>
+struct TypedAttrComparator;
+
+template <>
+struct TypedAttrComparator<AttrType::INTS>
+{
+  static int compare(const char *v1, const char *v2, int /*length*/)
+  {
+    int left, right;
+    memcpy(&left, v1, sizeof(left));
+    memcpy(&right, v2, sizeof(right));
+    return (left > right) - (left < right);
+  }
+};
+
+template <>
+struct TypedAttrComparator<AttrType::FLOATS>
+{
+  static int compare(const char *v1, const char *v2, int /*length*/)
+  {
+    float left, right;
+    memcpy(&left, v1, sizeof(left));
+    memcpy(&right, v2, sizeof(right));
+    float cmp = left - right;
+    if (cmp > EPSILON) {
+      return 1;
+    }
+    if (cmp < -EPSILON) {
+      return -1;
+    }
+    return 0;
+  }
+};
+
+template <>
+struct TypedAttrComparator<AttrType::DATES>
+{
+  static int compare(const char *v1, const char *v2, int /*length*/)
+  {
+    Date left, right;
+    memcpy(&left, v1, sizeof(left));
+    memcpy(&right, v2, sizeof(right));
+    return compare_date(left, right);
+  }
+};
+
+template <>
+struct TypedAttrComparator<AttrType::CHARS>
+{
+  static int compare(const char *v1, const char *v2, int length)
+  {
+    int result = strncmp(v1, v2, length);
+    return (result > 0) - (result < 0);
+  }
+};
+
 /**
  * @brief 属性比较(BplusTree)
+ * @details 组合索引的键值由多个字段按照定义的顺序拼接而成，比较时按照字典序逐个字段比较
  * @ingroup BPlusTree
  */
 class AttrComparator
 {
 public:
-  void init(AttrType type, int length)
+  void init(AttrType type, int length) { init(1, &type, &length); }
+  void init(int attr_num, const AttrType attr_types[], const int attr_lengths[])
   {
-    attr_type_   = type;
-    attr_length_ = length;
+    attr_types_.assign(attr_types, attr_types + attr_num);
+    attr_lengths_.assign(attr_lengths, attr_lengths + attr_num);
+    attr_length_ = 0;
+    for (int i = 0; i < attr_num; i++) {
+      attr_length_ += attr_lengths[i];
+    }
   }
 
+  /// @brief 所有字段的总长度
   int attr_length() const { return attr_length_; }
+  int attr_num() const { return static_cast<int>(attr_types_.size()); }
+  AttrType attr_type(int i) const { return attr_types_[i]; }
 
-  int operator()(const char *v1, const char *v2) const
+  /**
+   * @brief 根据前缀的长度计算包含几个字段
+   * @return 长度不是某几个前缀字段的总长度时返回 -1
+   */
+  int prefix_attr_num(int prefix_length) const
   {
-    // TODO: optimized the comparison
-    Value left;
-    left.set_type(attr_type_);
-    left.set_data(v1, attr_length_);
-    Value right;
-    right.set_type(attr_type_);
-    right.set_data(v2, attr_length_);
-    return DataType::type_instance(attr_type_)->compare(left, right);
+    int length = 0;
+    for (int i = 0; i < attr_num(); i++) {
+      length += attr_lengths_[i];
+      if (length == prefix_length) {
+        return i + 1;
+      }
+    }
+    return -1;
+  }
+
+  int operator()(const char *v1, const char *v2) const { return compare(v1, v2, attr_num()); }
+
+  /**
+   * @brief 只比较前 attr_num 个字段
+   */
+  int compare(const char *v1, const char *v2, int attr_num) const
+  {
+    for (int i = 0; i < attr_num; i++) {
+      int result = 0;
+      switch (attr_types_[i]) {
+        case AttrType::INTS: result = TypedAttrComparator<AttrType::INTS>::compare(v1, v2, attr_lengths_[i]); break;
+        case AttrType::FLOATS: result = TypedAttrComparator<AttrType::FLOATS>::compare(v1, v2, attr_lengths_[i]); break;
+        case AttrType::DATES: result = TypedAttrComparator<AttrType::DATES>::compare(v1, v2, attr_lengths_[i]); break;
+        case AttrType::CHARS: result = TypedAttrComparator<AttrType::CHARS>::compare(v1, v2, attr_lengths_[i]); break;
+        default: {
+          Value left;
+          left.set_type(attr_types_[i]);
+          left.set_data(v1, attr_lengths_[i]);
+          Value right;
+          right.set_type(attr_types_[i]);
+          right.set_data(v2, attr_lengths_[i]);
+          result = DataType::type_instance(attr_types_[i])->compare(left, right);
+        } break;
+      }
+      if (result != 0) {
+        return result;
+      }
+      v1 += attr_lengths_[i];
+      v2 += attr_lengths_[i];
+    }
+    return 0;
   }
 
 private:
-  AttrType attr_type_;
-  int      attr_length_;
+  vector<AttrType> attr_types_;
+  vector<int>      attr_lengths_;
+  int              attr_length_ = 0;
 };
 
 /**
@@ -89,13 +202,32 @@ private:
 class KeyComparator
 {
 public:
-  void init(AttrType type, int length) { attr_comparator_.init(type, length); }
+  void init(AttrType type, int length) { init(1, &type, &length); }
+  void init(int attr_num, const AttrType attr_types[], const int attr_lengths[])
+  {
+    attr_comparator_.init(attr_num, attr_types, attr_lengths);
+    prefix_attr_num_ = attr_num;
+  }
 
   const AttrComparator &attr_comparator() const { return attr_comparator_; }
+  /// @brief 参与比较的字段个数，字段都相同时再比较RID
+  int                   prefix_attr_num() const { return prefix_attr_num_; }
+
+  /**
+   * @brief 返回一个只比较前 attr_num 个字段的比较器
+   * @details 用于组合索引按照最左前缀扫描。前缀相同时直接比较RID，所以查找键带上 RID::min() 时，
+   * 会排在所有前缀相同的键值之前，带上 RID::max() 时会排在它们之后。
+   */
+  KeyComparator prefix(int attr_num) const
+  {
+    KeyComparator comparator(*this);
+    comparator.prefix_attr_num_ = attr_num;
+    return comparator;
+  }
 
   int operator()(const char *v1, const char *v2) const
   {
-    int result = attr_comparator_(v1, v2);
+    int result = attr_comparator_.compare(v1, v2, prefix_attr_num_);
     if (result != 0) {
       return result;
     }
@@ -107,6 +239,7 @@ public:
 
 private:
   AttrComparator attr_comparator_;
+  int            prefix_attr_num_ = 0;  ///< 参与比较的字段个数
 };
 
 /**
@@ -116,23 +249,37 @@ private:
 class AttrPrinter
 {
 public:
-  void init(AttrType type, int length)
+  void init(AttrType type, int length) { init(1, &type, &length); }
+  void init(int attr_num, const AttrType attr_types[], const int attr_lengths[])
   {
-    attr_type_   = type;
-    attr_length_ = length;
+    attr_types_.assign(attr_types, attr_types + attr_num);
+    attr_lengths_.assign(attr_lengths, attr_lengths + attr_num);
+    attr_length_ = 0;
+    for (int i = 0; i < attr_num; i++) {
+      attr_length_ += attr_lengths[i];
+    }
   }
 
   int attr_length() const { return attr_length_; }
 
   string operator()(const char *v) const
   {
-    Value value(attr_type_, const_cast<char *>(v), attr_length_);
-    return value.to_string();
+    string result;
+    for (size_t i = 0; i < attr_types_.size(); i++) {
+      Value value(attr_types_[i], const_cast<char *>(v), attr_lengths_[i]);
+      if (i > 0) {
+        result += ",";
+      }
+      result += value.to_string();
+      v += attr_lengths_[i];
+    }
+    return result;
   }
 
 private:
-  AttrType attr_type_;
-  int      attr_length_;
+  vector<AttrType> attr_types_;
+  vector<int>      attr_lengths_;
+  int              attr_length_ = 0;
 };
 
 /**
@@ -143,6 +290,10 @@ class KeyPrinter
 {
 public:
   void init(AttrType type, int length) { attr_printer_.init(type, length); }
+  void init(int attr_num, const AttrType attr_types[], const int attr_lengths[])
+  {
+    attr_printer_.init(attr_num, attr_types, attr_lengths);
+  }
 
   const AttrPrinter &attr_printer() const { return attr_printer_; }
 
@@ -164,10 +315,12 @@ private:
  * @brief the meta information of bplus tree
  * @ingroup BPlusTree
  * @details this is the first page of bplus tree.
- * only one field can be supported, can you extend it to multi-fields?
+ * 组合索引的键值是多个字段拼接起来的，attr_length 是所有字段的总长度，attr_type 是第一个字段的类型。
  */
 struct IndexFileHeader
 {
+  static constexpr int MAX_ATTR_NUM = 8;  ///< 组合索引最多包含的字段个数
+
   IndexFileHeader()
   {
     memset(this, 0, sizeof(IndexFileHeader));
@@ -179,6 +332,10 @@ struct IndexFileHeader
   int32_t  attr_length;        ///< 键值的长度
   int32_t  key_length;         ///< attr length + sizeof(RID)
   AttrType attr_type;          ///< 键值的类型
+  int32_t  attr_num;           ///< 键值包含的字段个数。旧版本的索引文件中是0，表示只有一个字段
+  int32_t  attr_lengths[MAX_ATTR_NUM];  ///< 每个字段的长度
+  AttrType attr_types[MAX_ATTR_NUM];    ///< 每个字段的类型
+  int32_t  prefix_compressed;           ///< 叶子节点是否使用前缀压缩，参考 LeafIndexNode
 
   const string to_string() const
   {
@@ -187,9 +344,11 @@ struct IndexFileHeader
     ss << "attr_length:" << attr_length << ","
        << "key_length:" << key_length << ","
        << "attr_type:" << attr_type_to_string(attr_type) << ","
+       << "attr_num:" << attr_num << ","
        << "root_page:" << root_page << ","
        << "internal_max_size:" << internal_max_size << ","
-       << "leaf_max_size:" << leaf_max_size << ";";
+       << "leaf_max_size:" << leaf_max_size << ","
+       << "prefix_compressed:" << prefix_compressed << ";";
 
     return ss.str();
   }
@@ -224,10 +383,19 @@ struct IndexNode
  * so the key in leaf page must be unique.
  * the value is rid.
  * can you implenment a cluster index ?
+ *
+ * 使用前缀压缩时(只支持单个 CHARS 字段)，节点上所有键值共同的前缀只存放一份，每个元素只存放前缀之后的部分：
+ * @code
+ * | common header | next page id | prefix length | prefix(attr length) |
+ * | suffix0, rid0 | suffix1, rid1 | ... | suffixn, ridn |
+ * @endcode
+ * 前缀的长度随着节点上的键值变化，元素的大小也随之变化，所以节点能容纳的元素个数不是固定的。
  */
 struct LeafIndexNode : public IndexNode
 {
   static constexpr int HEADER_SIZE = IndexNode::HEADER_SIZE + 4;
+  /// 前缀压缩时，前缀长度和前缀占用的空间，不包括前缀本身的长度
+  static constexpr int PREFIX_HEADER_SIZE = 4;
 
   PageNum next_brother;
   /**
@@ -283,6 +451,9 @@ public:
   /// @brief 存储的键值对的大小。值是指叶子节点中存放的数据
   virtual int item_size() const;
 
+  /// @brief 两个节点上的元素能否合并到一个节点中
+  bool can_merge(const IndexNodeHandler &other) const { return size() + other.size() <= max_size(); }
+
   void    increase_size(int n);
   int     size() const;
   int     max_size() const;
@@ -342,9 +513,15 @@ public:
   RC      set_next_page(PageNum page_num);
   PageNum next_page() const;
 
+  /**
+   * @brief 完整的键值
+   * @details 前缀压缩的节点需要把前缀和后缀拼接起来，返回的内存在下次调用时会被覆盖
+   */
   char *key_at(int index);
   char *value_at(int index);
 
+  int key_size() const override;
+
   /**
    * 查找指定key的插入位置(注意不是key本身)
    * 如果key已经存在，会设置found的值。
@@ -357,10 +534,24 @@ public:
    */
   int unique_lookup(const AttrComparator &comparator, const char *key, bool *found = nullptr) const;
 
+  /**
+   * @brief 插入指定的键值之后节点是否放得下
+   * @details 前缀压缩的节点插入没有共同前缀的键值时，前缀变短，每个元素都会变大
+   */
+  bool can_insert(const char *key) const;
+  /// @brief 两个节点上的元素能否合并到一个节点中
+  bool can_merge(const LeafIndexNodeHandler &other) const;
+
   RC  insert(int index, const char *key, const char *value);
   RC  remove(int index);
   int remove(const char *key, const KeyComparator &comparator);
   RC  move_half_to(LeafIndexNodeHandler &other);
+  /**
+   * @brief 把从 index 开始的元素都移动到另一个节点上
+   * @details 分裂时使用。前缀压缩的节点插入没有共同前缀的键值时，这个键值一定在节点的最前面或最后面，
+   * 从插入的位置分裂才能保证两个节点都放得下
+   */
+  RC  move_tail_to(LeafIndexNodeHandler &other, int index);
   RC  move_first_to_end(LeafIndexNodeHandler &other);
   RC  move_last_to_front(LeafIndexNodeHandler &other);
   /**
@@ -368,6 +559,23 @@ public:
    */
   RC move_to(LeafIndexNodeHandler &other);
 
+  /**
+   * @brief 在节点的最后追加多个元素
+   * @details 所有元素记录成一条日志，批量构建B+树时用来一次写满一个页面。
+   * 元素是完整的键值和RID，前缀压缩的节点会自己调整前缀
+   */
+  RC append(const char *items, int num);
+
+  /// @brief 是否使用前缀压缩
+  bool prefix_compressed() const { return header_.prefix_compressed != 0; }
+  /// @brief 前缀压缩的节点上所有键值共同前缀的长度
+  int  prefix_length() const;
+  /// @brief 键值与当前节点的共同前缀长度。空节点上可以使用键值中除了末尾的'\0'之外的所有字符作为前缀
+  int  common_prefix_length(const char *key) const;
+
+  /// @brief 把节点的前缀设置为指定的内容，重新编码所有元素。恢复和回滚时使用，不记录日志
+  RC recover_set_prefix(const char *prefix, int prefix_length);
+
   bool validate(const KeyComparator &comparator, DiskBufferPool *bp) const;
 
   friend string to_string(const LeafIndexNodeHandler &handler, const KeyPrinter &printer);
@@ -375,14 +583,32 @@ public:
 protected:
   char *__item_at(int index) const override;
 
-  RC append(const char *items, int num);
   RC append(const char *item);
   RC preappend(const char *item);
 
+private:
+  char *prefix_data() const;
+  /// @brief 把指定位置的完整键值拷贝到 key 中
+  void  copy_key(int index, char *key) const;
+  /// @brief 把 [index, index + num) 的完整元素拷贝到 items 中
+  void  copy_items(int index, int num, vector<char> &items) const;
+  /// @brief 修改前缀，记录日志
+  RC    set_prefix(const char *prefix, int prefix_length);
+  template <typename Comparator>
+  int   compressed_lookup(const Comparator &comparator, const char *key, bool *found) const;
+
 private:
   LeafIndexNode *leaf_node_ = nullptr;
+  vector<char>   key_buffer_;  ///< 前缀压缩的节点拼接完整键值使用
 };
 
+/**
+ * @brief 前缀压缩的叶子节点，前缀长度为 prefix_length 时最多可以容纳的元素个数
+ * @details 与不压缩时的容量 leaf_max_size 等比例放大，测试时指定较小的 leaf_max_size 也同样有效
+ * @ingroup BPlusTree
+ */
+int calc_prefix_leaf_capacity(const IndexFileHeader &header, int prefix_length);
+
 /**
  * @brief 内部节点的操作
  * @ingroup BPlusTree
@@ -428,13 +654,17 @@ public:
   RC move_last_to_front(InternalIndexNodeHandler &other);
   RC move_half_to(InternalIndexNodeHandler &other);
 
+  /**
+   * @brief 在节点的最后追加多个元素，并把这些子节点的父节点设置为当前节点
+   */
+  RC append(const char *items, int num);
+
   bool validate(const KeyComparator &comparator, DiskBufferPool *bp) const;
 
   friend string to_string(const InternalIndexNodeHandler &handler, const KeyPrinter &printer);
 
 private:
   RC insert_items(int index, const char *items, int num);
-  RC append(const char *items, int num);
   RC append(const char *item);
   RC preappend(const char *item);
 
@@ -470,6 +700,20 @@ public:
   RC create(LogHandler &log_handler, DiskBufferPool &buffer_pool, AttrType attr_type, int attr_length, bool unique,
       int internal_max_size = -1, int leaf_max_size = -1);
 
+  /**
+   * @brief 创建一个组合索引的B+树
+   * @details 键值由多个字段按照顺序拼接而成，按照字典序排序
+   * @param attr_types 每个字段的类型
+   * @param attr_lengths 每个字段的长度
+   * @param prefix_compressed 叶子节点是否使用前缀压缩。只支持单个 CHARS 字段的索引
+   */
+  RC create(LogHandler &log_handler, BufferPoolManager &bpm, const char *file_name, const vector<AttrType> &attr_types,
+      const vector<int> &attr_lengths, bool unique, int internal_max_size = -1, int leaf_max_size = -1,
+      bool prefix_compressed = false);
+  RC create(LogHandler &log_handler, DiskBufferPool &buffer_pool, const vector<AttrType> &attr_types,
+      const vector<int> &attr_lengths, bool unique, int internal_max_size = -1, int leaf_max_size = -1,
+      bool prefix_compressed = false);
+
   /**
    * @brief 打开一个B+树
    * @param log_handler 记录日志
@@ -508,6 +752,16 @@ public:
    */
   RC get_entry(const char *user_key, int key_len, list<RID> &rids);
 
+  /**
+   * @brief 自底向上批量构建B+树
+   * @details 只能在空树上调用。键值(包含RID)按照从小到大的顺序由 next_key 依次提供。
+   * 先按照填充比例写满每个叶子节点，再逐层向上构建内部节点，每个页面的数据只记录一条日志。
+   * @param key_num 键值的个数
+   * @param next_key 把下一个键值复制到参数指向的内存中
+   * @param fill_factor 节点的填充比例，百分比
+   */
+  RC bulk_load(int64_t key_num, const function<RC(char *key)> &next_key, int fill_factor);
+
   RC sync();
 
   /**
@@ -517,6 +771,14 @@ public:
    */
   bool validate_tree();
 
+  /**
+   * @brief 是否使用乐观的方式查找叶子节点
+   * @details 乐观的方式不对内部节点加锁，只在读取前后校验页面的版本号，到达叶子节点后才加锁。
+   * 校验失败就从根节点重新开始，多次失败或者修改操作可能导致节点分裂合并时，再使用加锁的 crabbing protocol。
+   */
+  void set_optimistic_descent(bool enable) { optimistic_descent_ = enable; }
+  bool optimistic_descent() const { return optimistic_descent_; }
+
 public:
   const IndexFileHeader &file_header() const { return file_header_; }
   DiskBufferPool        &buffer_pool() const { return *disk_buffer_pool_; }
@@ -559,12 +821,31 @@ protected:
    * @param[out] frame 返回找到的叶子节点
    */
   RC find_leaf(BplusTreeMiniTransaction &mtr, BplusTreeOperationType op, const char *key, Frame *&frame);
+  /**
+   * @brief 使用指定的比较器查找叶子节点
+   * @details 组合索引按照最左前缀扫描时，使用只比较前缀字段的比较器
+   */
+  RC find_leaf(BplusTreeMiniTransaction &mtr, BplusTreeOperationType op, const KeyComparator &comparator,
+      const char *key, Frame *&frame);
 
   /**
    * @brief 找到最左边的叶子节点
    */
   RC left_most_page(BplusTreeMiniTransaction &mtr, Frame *&frame);
 
+  /**
+   * @brief 找到最右边的叶子节点
+   */
+  RC right_most_page(BplusTreeMiniTransaction &mtr, Frame *&frame);
+
+  /**
+   * @brief 查找前一个叶子节点
+   * @details 叶子节点之间只有指向后一个节点的链接，逆序扫描时从根节点重新查找
+   * @param key 当前叶子节点的第一个键值
+   * @param[out] frame 返回数据都比 key 小的最后一个叶子节点，没有时返回空
+   */
+  RC prev_leaf(BplusTreeMiniTransaction &mtr, const char *key, Frame *&frame);
+
   /**
    * @brief 查找指定的叶子节点
    * @param op 当前想要执行的操作。操作类型不同会在查找的过程中加不同类型的锁
@@ -574,6 +855,16 @@ protected:
   RC find_leaf_internal(BplusTreeMiniTransaction &mtr, BplusTreeOperationType op,
       const function<PageNum(InternalIndexNodeHandler &)> &child_page_getter, Frame *&frame);
 
+  /**
+   * @brief 乐观地查找叶子节点
+   * @details 内部节点只pin住不加锁，每访问一个子节点都要校验父节点的版本号，保证子节点的页号是有效的。
+   * 叶子节点按照操作类型加锁，加锁后再校验一次父节点。
+   * @return 校验失败时返回 LOCKED_CONCURRENCY_CONFLICT，调用者可以重试。
+   * 修改操作找到的叶子节点可能分裂或合并时，返回 SUCCESS 但是 frame 为空，需要使用 crabbing protocol 重新查找
+   */
+  RC optimistic_find_leaf(BplusTreeMiniTransaction &mtr, BplusTreeOperationType op,
+      const function<PageNum(InternalIndexNodeHandler &)> &child_page_getter, Frame *&frame);
+
   /**
    * @brief 使用crabing protocol 获取页面
    */
@@ -588,9 +879,10 @@ protected:
   /**
    * @brief 拆分节点
    * @details 当节点中的键值对超过最大值时，需要拆分节点
+   * @param move_index 叶子节点从这个位置开始的键值对移动到新节点，小于0表示移动一半
    */
   template <typename IndexNodeHandlerType>
-  RC split(BplusTreeMiniTransaction &mtr, Frame *frame, Frame *&new_frame);
+  RC split(BplusTreeMiniTransaction &mtr, Frame *frame, Frame *&new_frame, int move_index = -1);
 
   /**
    * @brief 合并或重新分配
@@ -638,9 +930,34 @@ protected:
    */
   RC adjust_root(BplusTreeMiniTransaction &mtr, Frame *root_frame);
 
+  /**
+   * @brief 批量构建前缀压缩的叶子层
+   * @details 节点能放多少元素取决于键值的共同前缀，所以不能预先计算节点个数，每个节点的第一个键值和页号放到 level_items 中
+   */
+  RC bulk_load_prefix_compressed_leaves(int64_t key_num, const function<RC(char *key)> &next_key, int fill_factor,
+      vector<char> &level_items, PageNum &page_num, BufferRing &ring);
+
+  /**
+   * @brief 批量构建时写满一个叶子节点，并把它链接到前一个叶子节点后面
+   * @details 叶子节点写满以后就不会再访问了，所以通过私有页帧环分配，不会把其它页面挤出缓存。
+   * 内部节点很少，而且构建完成后马上就会用到，还是放在共享缓存中
+   */
+  RC bulk_load_leaf(PageNum prev_page_num, const char *items, int item_num, PageNum &page_num, BufferRing &ring);
+
+  /**
+   * @brief 批量构建时写满一个内部节点
+   */
+  RC bulk_load_internal(const char *items, int item_num, PageNum &page_num);
+
 private:
   common::MemPoolItem::item_unique_ptr make_key(const char *user_key, const RID &rid);
 
+  /**
+   * @brief 根据文件头中的字段信息初始化比较器和打印器
+   * @details 旧版本的索引文件没有记录 attr_num，这里把它当做单字段的索引
+   */
+  void init_key_comparator();
+
 protected:
   LogHandler     *log_handler_      = nullptr;  /// 日志处理器
   DiskBufferPool *disk_buffer_pool_ = nullptr;  /// 磁盘缓冲池
@@ -652,6 +969,13 @@ protected:
   // 这个锁可以使用递归读写锁，但是这里偷懒先不改
   common::SharedMutex root_lock_;
 
+  /// 根节点页号的版本号，修改根节点页号时递增，规则与 Frame 的版本号相同。乐观查找时使用
+  atomic<uint64_t> root_version_{0};
+  bool             optimistic_descent_ = true;
+
+  /// 乐观查找叶子节点失败多少次后使用加锁的方式
+  static constexpr int MAX_OPTIMISTIC_RETRY = 8;
+
   KeyComparator key_comparator_;
   KeyPrinter    key_printer_;
 
@@ -659,6 +983,7 @@ protected:
 
 private:
   friend class BplusTreeScanner;
+  friend class BplusTreeBulkLoader;
   friend class BplusTreeTester;
 };
 
@@ -680,21 +1005,22 @@ public:
    * @param right_user_key 扫描范围的右边界。如果是null，则没有右边界
    * @param right_len right_user_key 的内存大小(只有在变长字段中才会关注)
    * @param right_inclusive 右边界的值是否包含在内
+   * @param reverse 是否从右边界开始按照从大到小的顺序扫描
    * TODO 重构参数表示方法
    */
   RC open(const char *left_user_key, int left_len, bool left_inclusive, const char *right_user_key, int right_len,
-      bool right_inclusive);
+      bool right_inclusive, bool reverse = false);
 
   /**
    * @brief 获取下一条记录
    *
    * @param rid 当前默认所有值都是RID类型。对B+树来说并不是一个好的抽象
+   * @param user_key 不为空时返回索引字段的值，需要有 attr_length 大小的空间
    * @return RC RECORD_EOF 表示遍历完成
-   * TODO 需要增加返回 key 的接口
    * @warning 不要在遍历时删除数据。删除数据会导致遍历器失效。
    * 当前默认的走索引删除的逻辑就是这样做的，所以删除逻辑有BUG。
    */
-  RC next_entry(RID &rid);
+  RC next_entry(RID &rid, char *user_key = nullptr);
 
   /**
    * @brief 关闭当前扫描器
@@ -708,13 +1034,46 @@ private:
    */
   RC fix_user_key(const char *user_key, int key_len, bool want_greater, char **fixed_key, bool *should_inclusive);
 
-  void fetch_item(RID &rid);
+  /**
+   * @brief 组合索引的键值可以只包含最左边的几个字段，把它扩展成完整键值的大小
+   * @param key_len 前缀的长度，必须是前面几个字段的总长度
+   * @param[out] attr_num 前缀包含的字段个数
+   */
+  RC fix_prefix_key(const char *user_key, int key_len, char **fixed_key, int *attr_num);
+
+  /**
+   * @brief 把用户传入的边界转换成带RID的完整键值
+   * @param is_left 是否是左边界
+   * @param[in,out] attr_num 边界包含的字段个数
+   */
+  RC make_bound_key(const char *user_key, int key_len, bool inclusive, bool is_left, int &attr_num,
+      common::MemPoolItem::item_unique_ptr &key);
+
+  /**
+   * @brief 逆序扫描时定位到范围内的最后一条数据
+   */
+  RC seek_last();
+
+  /**
+   * @brief 移动到前一个叶子节点的最后一条数据
+   * @details 已经是第一个叶子节点时 current_frame_ 设置为空
+   */
+  RC move_to_prev_leaf();
+
+  RC prev_entry(RID &rid, char *user_key);
+
+  void fetch_item(RID &rid, char *user_key);
 
   /**
    * @brief 判断是否到了扫描的结束位置
    */
   bool touch_end();
 
+  /**
+   * @brief 逆序扫描时判断是否已经越过了左边界
+   */
+  bool touch_begin();
+
 private:
   bool                     inited_ = false;
   BplusTreeHandler        &tree_handler_;
@@ -724,7 +1083,11 @@ private:
   /// 起始位置和终止位置都是有效的数据
   Frame *current_frame_ = nullptr;
 
+  common::MemPoolItem::item_unique_ptr left_key_;
+  KeyComparator                        left_comparator_;  ///< 与左边界比较时使用，只比较左边界包含的字段
   common::MemPoolItem::item_unique_ptr right_key_;
+  KeyComparator                        right_comparator_;  ///< 与右边界比较时使用，只比较右边界包含的字段
   int                                  iter_index_    = -1;
   bool                                 first_emitted_ = false;
+  bool                                 reverse_       = false;  ///< 是否从大到小扫描
 };
@@ -0,0 +1,155 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <string.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+
+#include "storage/index/bplus_tree_bulk_loader.h"
+#include "common/log/log.h"
+
+BplusTreeBulkLoader::BplusTreeBulkLoader(BplusTreeHandler &handler, int64_t memory_limit, string temp_dir)
+    : handler_(handler),
+      memory_limit_(memory_limit),
+      temp_dir_(std::move(temp_dir)),
+      key_length_(handler.file_header().key_length)
+{}
+
+RC BplusTreeBulkLoader::add(const char *user_key, const RID &rid)
+{
+  const int attr_length = handler_.file_header().attr_length;
+  buffer_.insert(buffer_.end(), user_key, user_key + attr_length);
+  buffer_.insert(buffer_.end(), reinterpret_cast<const char *>(&rid), reinterpret_cast<const char *>(&rid) + sizeof(rid));
+  key_num_++;
+
+  // 每个键值除了本身的数据，排序时还需要记录一个位置
+  const int64_t buffer_key_num = static_cast<int64_t>(buffer_.size()) / key_length_;
+  if (static_cast<int64_t>(buffer_.size()) + buffer_key_num * static_cast<int64_t>(sizeof(int64_t)) >= memory_limit_) {
+    return spill();
+  }
+  return RC::SUCCESS;
+}
+
+RC BplusTreeBulkLoader::finish(int fill_factor)
+{
+  RC rc = RC::SUCCESS;
+
+  function<RC(char *)> next;
+  int64_t              pos = 0;
+  if (runs_.empty()) {
+    sort_buffer();
+    next = [this, &pos](char *key) {
+      memcpy(key, buffer_.data() + sorted_[pos++], key_length_);
+      return RC::SUCCESS;
+    };
+  } else {
+    if (!buffer_.empty() && OB_FAIL(rc = spill())) {
+      return rc;
+    }
+    if (OB_FAIL(rc = open_merge())) {
+      return rc;
+    }
+    LOG_INFO("bulk load merges %d runs. key num=%ld", static_cast<int>(runs_.size()), key_num_);
+    next = [this](char *key) {
+      SortRun *run = merger_->top();
+      if (nullptr == run) {
+        return RC::RECORD_EOF;
+      }
+      memcpy(key, run->record().data(), key_length_);
+      return merger_->advance();
+    };
+  }
+
+  // 唯一索引中不能有相同的字段值。键值是有序的，只需要与前一个比较
+  const bool            unique          = handler_.unique_;
+  const AttrComparator &attr_comparator = handler_.key_comparator_.attr_comparator();
+  string                prev_key;
+  auto                  next_key = [&](char *key) {
+    RC rc = next(key);
+    if (OB_SUCC(rc) && unique) {
+      if (!prev_key.empty() && attr_comparator(prev_key.data(), key) == 0) {
+        return RC::RECORD_DUPLICATE_KEY;
+      }
+      prev_key.assign(key, key_length_);
+    }
+    return rc;
+  };
+
+  rc = handler_.bulk_load(key_num_, next_key, fill_factor);
+
+  buffer_.clear();
+  sorted_.clear();
+  merger_.reset();
+  runs_.clear();
+  return rc;
+}
+
+void BplusTreeBulkLoader::sort_buffer()
+{
+  sorted_.resize(buffer_.size() / key_length_);
+  for (size_t i = 0; i < sorted_.size(); i++) {
+    sorted_[i] = static_cast<int64_t>(i) * key_length_;
+  }
+
+  const KeyComparator &comparator = handler_.key_comparator_;
+  const char          *data       = buffer_.data();
+  std::sort(sorted_.begin(), sorted_.end(), [&comparator, data](int64_t left, int64_t right) {
+    return comparator(data + left, data + right) < 0;
+  });
+}
+
+RC BplusTreeBulkLoader::spill()
+{
+  sort_buffer();
+
+  auto run = make_unique<SortRun>(make_run_file_name());
+  RC   rc  = run->open_write();
+  for (size_t i = 0; OB_SUCC(rc) && i < sorted_.size(); i++) {
+    rc = run->write(buffer_.data() + sorted_[i], key_length_);
+  }
+  if (OB_SUCC(rc)) {
+    rc = run->finish_write();
+  }
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  LOG_TRACE("bulk load spills a run. file=%s, key num=%ld", run->file_name().c_str(), run->row_num());
+  runs_.push_back(std::move(run));
+  buffer_.clear();
+  sorted_.clear();
+  return RC::SUCCESS;
+}
+
+RC BplusTreeBulkLoader::open_merge()
+{
+  const KeyComparator &comparator = handler_.key_comparator_;
+  SortRunMerger::Less  run_less   = [&comparator](const SortRun &left, const SortRun &right) {
+    return comparator(left.record().data(), right.record().data()) < 0;
+  };
+
+  RC rc = SortRunMerger::reduce(
+      runs_, MAX_MERGE_WAY, run_less, [this]() { return make_unique<SortRun>(make_run_file_name()); });
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to merge bulk load runs. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  merger_ = make_unique<SortRunMerger>(run_less);
+  return merger_->open(runs_);
+}
+
+string BplusTreeBulkLoader::make_run_file_name()
+{
+  static std::atomic<int64_t> sequence{0};
+  return temp_dir_ + "/bulk_" + std::to_string(getpid()) + "_" + std::to_string(sequence++) + ".run";
+}
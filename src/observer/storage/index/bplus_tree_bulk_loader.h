@@ -0,0 +1,75 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/lang/memory.h"
+#include "common/lang/string.h"
+#include "common/lang/vector.h"
+#include "common/rc.h"
+#include "storage/common/sort_run.h"
+#include "storage/index/bplus_tree.h"
+
+/**
+ * @brief 批量构建B+树
+ * @ingroup BPlusTree
+ * @details 在已有数据的表上创建索引时使用。先收集所有的键值(字段值和RID)，排好序之后交给
+ * BplusTreeHandler::bulk_load 自底向上构建，避免每条数据都从根节点查找、分裂页面并记录日志。
+ * 收集的键值超过内存限制时，把排好序的一段数据写到临时文件中，最后再做多路归并。临时文件和归并与排序算子
+ * 使用同一套实现（参考 SortRun 和 SortRunMerger），每条记录就是一个完整的键值。
+ */
+class BplusTreeBulkLoader
+{
+public:
+  /**
+   * @param handler 要构建的B+树，必须是空的
+   * @param memory_limit 排序可以使用的内存
+   * @param temp_dir 临时文件存放的目录
+   */
+  BplusTreeBulkLoader(BplusTreeHandler &handler, int64_t memory_limit, string temp_dir);
+  ~BplusTreeBulkLoader() = default;
+
+  /**
+   * @brief 添加一个键值
+   * @param user_key 索引字段的值，长度与B+树的 attr_length 一致
+   */
+  RC add(const char *user_key, const RID &rid);
+
+  /**
+   * @brief 对收集的键值排序，然后构建B+树
+   * @param fill_factor 节点的填充比例，百分比
+   * @return 唯一索引中有重复的键值时返回 RECORD_DUPLICATE_KEY
+   */
+  RC finish(int fill_factor);
+
+private:
+  /// @brief 对内存中的键值排序
+  void sort_buffer();
+  /// @brief 把内存中排好序的键值写到一个新的临时文件中
+  RC spill();
+  /// @brief 临时文件太多时先做多趟归并，然后打开最后一次归并
+  RC open_merge();
+  string make_run_file_name();
+
+private:
+  static constexpr size_t MAX_MERGE_WAY = 64;  ///< 一次最多归并的临时文件个数
+
+  BplusTreeHandler &handler_;
+  int64_t           memory_limit_ = 0;
+  string            temp_dir_;
+  int               key_length_ = 0;
+
+  vector<char>    buffer_;       ///< 内存中收集的键值
+  vector<int64_t> sorted_;       ///< 排序后每个键值在 buffer_ 中的位置
+  int64_t         key_num_ = 0;  ///< 收集的键值总数
+
+  vector<unique_ptr<SortRun>> runs_;    ///< 写满的临时文件
+  unique_ptr<SortRunMerger>   merger_;  ///< 最后一次多路归并
+};
@@ -17,6 +17,8 @@ See the Mulan PSL v2 for more details. */
 #include "storage/index/bplus_tree.h"
 #include "storage/index/index.h"
 
+class RecordFileScanner;
+
 /**
  * @brief B+树索引
  * @ingroup Index
@@ -27,18 +29,30 @@ public:
   BplusTreeIndex() = default;
   virtual ~BplusTreeIndex() noexcept;
 
-  RC create(Table *table, const char *file_name, const IndexMeta &index_meta, const FieldMeta &field_meta);
-  RC open(Table *table, const char *file_name, const IndexMeta &index_meta, const FieldMeta &field_meta);
+  RC create(Table *table, const char *file_name, const IndexMeta &index_meta,
+      const std::vector<FieldMeta> &field_metas) override;
+  RC open(Table *table, const char *file_name, const IndexMeta &index_meta,
+      const std::vector<FieldMeta> &field_metas) override;
   RC close();
 
   RC insert_entry(const char *record, const RID *rid) override;
   RC delete_entry(const char *record, const RID *rid) override;
 
+  /**
+   * @brief 把表中已有的数据批量加载到空的索引中
+   * @details 先对所有的键值排序，再自底向上构建B+树，比逐条插入快很多
+   * @param scanner 表数据的扫描器
+   * @param fill_factor 节点的填充比例，百分比
+   * @param memory_limit 排序可以使用的内存，超过时使用临时文件
+   * @param temp_dir 临时文件存放的目录
+   */
+  RC bulk_load(RecordFileScanner &scanner, int fill_factor, int64_t memory_limit, const char *temp_dir) override;
+
   /**
    * 扫描指定范围的数据
    */
   IndexScanner *create_scanner(const char *left_key, int left_len, bool left_inclusive, const char *right_key,
-      int right_len, bool right_inclusive) override;
+      int right_len, bool right_inclusive, bool reverse = false) override;
 
   RC sync() override;
 
@@ -59,10 +73,11 @@ public:
   ~BplusTreeIndexScanner() noexcept override;
 
   RC next_entry(RID *rid) override;
+  RC next_entry(RID *rid, char *user_key) override;
   RC destroy() override;
 
   RC open(const char *left_key, int left_len, bool left_inclusive, const char *right_key, int right_len,
-      bool right_inclusive);
+      bool right_inclusive, bool reverse);
 
 private:
   BplusTreeScanner tree_scanner_;
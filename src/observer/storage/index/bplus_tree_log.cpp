@@ -67,6 +67,11 @@ RC BplusTreeLogger::leaf_set_next_page(IndexNodeHandler &node_handler, PageNum p
   return append_log_entry(make_unique<LeafSetNextPageLogEntryHandler>(node_handler.frame(), page_num, old_page_num));
 }
 
+RC BplusTreeLogger::leaf_set_prefix(IndexNodeHandler &node_handler, span<const char> prefix, span<const char> old_prefix)
+{
+  return append_log_entry(make_unique<LeafSetPrefixLogEntryHandler>(node_handler.frame(), prefix, old_prefix));
+}
+
 RC BplusTreeLogger::internal_init_empty(IndexNodeHandler &node_handler)
 {
   return append_log_entry(make_unique<InternalInitEmptyLogEntryHandler>(node_handler.frame()));
@@ -107,6 +107,10 @@ public:
    * @brief 修改叶子节点的下一个兄弟节点编号
    */
   RC leaf_set_next_page(IndexNodeHandler &node_handler, PageNum page_num, PageNum old_page_num);
+  /**
+   * @brief 修改前缀压缩的叶子节点的公共前缀
+   */
+  RC leaf_set_prefix(IndexNodeHandler &node_handler, span<const char> prefix, span<const char> old_prefix);
 
   /**
    * @brief 初始化一个空的内部节点
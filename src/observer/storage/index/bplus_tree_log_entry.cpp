@@ -34,6 +34,7 @@ string LogOperation::to_string() const
     case Type::INTERNAL_UPDATE_KEY: ss << "INTERNAL_UPDATE_KEY"; break;
     case Type::NODE_INSERT: ss << "NODE_INSERT"; break;
     case Type::NODE_REMOVE: ss << "NODE_REMOVE"; break;
+    case Type::LEAF_SET_PREFIX: ss << "LEAF_SET_PREFIX"; break;
     default: ss << "INVALID"; break;
   }
   return ss.str();
@@ -155,6 +156,10 @@ RC LogEntryHandler::from_buffer(
       rc = LeafSetNextPageLogEntryHandler::deserialize(frame, buffer, handler);
     } break;
 
+    case LogOperation::Type::LEAF_SET_PREFIX: {
+      rc = LeafSetPrefixLogEntryHandler::deserialize(frame, buffer, handler);
+    } break;
+
     case LogOperation::Type::INTERNAL_INIT_EMPTY: {
       rc = InternalInitEmptyLogEntryHandler::deserialize(frame, buffer, handler);
     } break;
@@ -328,11 +333,19 @@ RC NormalOperationLogEntryHandler::rollback(BplusTreeMiniTransaction &mtr, Bplus
   if (nullptr == frame()) {
     return RC::INTERNAL;
   }
-  IndexNodeHandler node_handler(mtr, tree_handler.file_header(), frame());
+  // 元素的位置需要由具体的节点类型计算，与redo一样区分叶子节点和内部节点
+  InternalIndexNodeHandler internal_node(mtr, tree_handler.file_header(), frame());
+  LeafIndexNodeHandler     leaf_node(mtr, tree_handler.file_header(), frame());
+  IndexNodeHandler        *real_handler = nullptr;
+  if (leaf_node.is_leaf()) {
+    real_handler = &leaf_node;
+  } else {
+    real_handler = &internal_node;
+  }
   if (operation_type().type() == LogOperation::Type::NODE_INSERT) {
-    return node_handler.recover_remove_items(index_, item_num_);
+    return real_handler->recover_remove_items(index_, item_num_);
   } else {  // should be NODE_REMOVE
-    return node_handler.recover_insert_items(index_, items_.data(), item_num_);
+    return real_handler->recover_insert_items(index_, items_.data(), item_num_);
   }
 }
 
@@ -424,6 +437,63 @@ RC LeafSetNextPageLogEntryHandler::redo(BplusTreeMiniTransaction &mtr, BplusTree
   return RC::SUCCESS;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// LeafSetPrefixLogEntryHandler
+LeafSetPrefixLogEntryHandler::LeafSetPrefixLogEntryHandler(
+    Frame *frame, span<const char> prefix, span<const char> old_prefix)
+    : NodeLogEntryHandler(LogOperation::Type::LEAF_SET_PREFIX, frame),
+      prefix_(prefix.begin(), prefix.end()),
+      old_prefix_(old_prefix.begin(), old_prefix.end())
+{}
+
+RC LeafSetPrefixLogEntryHandler::serialize_body(Serializer &buffer) const
+{
+  int ret = 0;
+  if ((ret = buffer.write_int32(static_cast<int32_t>(prefix_.size()))) < 0 || (ret = buffer.write(prefix_)) < 0) {
+    return RC::INTERNAL;
+  }
+  return RC::SUCCESS;
+}
+
+string LeafSetPrefixLogEntryHandler::to_string() const
+{
+  stringstream ss;
+  ss << LogEntryHandler::to_string() << ", prefix_length=" << prefix_.size();
+  return ss.str();
+}
+
+RC LeafSetPrefixLogEntryHandler::deserialize(Frame *frame, Deserializer &buffer, unique_ptr<LogEntryHandler> &handler)
+{
+  int     ret           = 0;
+  int32_t prefix_length = -1;
+  if ((ret = buffer.read_int32(prefix_length)) < 0 || prefix_length < 0) {
+    return RC::INTERNAL;
+  }
+
+  vector<char> prefix(prefix_length);
+  if ((ret = buffer.read(prefix)) < 0) {
+    return RC::INTERNAL;
+  }
+
+  handler = make_unique<LeafSetPrefixLogEntryHandler>(frame, prefix, span<const char>() /*old_prefix*/);
+  return RC::SUCCESS;
+}
+
+RC LeafSetPrefixLogEntryHandler::rollback(BplusTreeMiniTransaction &mtr, BplusTreeHandler &tree_handler)
+{
+  if (nullptr == frame()) {
+    return RC::INTERNAL;
+  }
+  LeafIndexNodeHandler leaf_handler(mtr, tree_handler.file_header(), frame());
+  return leaf_handler.recover_set_prefix(old_prefix_.data(), static_cast<int>(old_prefix_.size()));
+}
+
+RC LeafSetPrefixLogEntryHandler::redo(BplusTreeMiniTransaction &mtr, BplusTreeHandler &tree_handler)
+{
+  LeafIndexNodeHandler leaf_handler(mtr, tree_handler.file_header(), frame());
+  return leaf_handler.recover_set_prefix(prefix_.data(), static_cast<int>(prefix_.size()));
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // InternalInitEmptyLogEntryHandler
 InternalInitEmptyLogEntryHandler::InternalInitEmptyLogEntryHandler(Frame *frame)
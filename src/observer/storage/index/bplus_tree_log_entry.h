@@ -50,6 +50,7 @@ public:
     INTERNAL_UPDATE_KEY,       /// 更新内部节点的key
     NODE_INSERT,               /// 在节点中间(也可能是末尾)插入一些元素
     NODE_REMOVE,               /// 在节点中间(也可能是末尾)删除一些元素
+    LEAF_SET_PREFIX,           /// 修改前缀压缩的叶子节点的公共前缀
 
     MAX_TYPE,
   };
@@ -300,6 +301,33 @@ private:
   PageNum old_page_num_ = -1;
 };
 
+/**
+ * @brief 修改叶子节点公共前缀的日志处理类
+ * @details 修改前缀时节点中的每个元素都会重新编码，日志中只记录前缀，恢复时重新编码即可
+ * @ingroup CLog
+ */
+class LeafSetPrefixLogEntryHandler : public NodeLogEntryHandler
+{
+public:
+  LeafSetPrefixLogEntryHandler(Frame *frame, span<const char> prefix, span<const char> old_prefix);
+  virtual ~LeafSetPrefixLogEntryHandler() = default;
+
+  RC serialize_body(common::Serializer &buffer) const override;
+  RC rollback(BplusTreeMiniTransaction &mtr, BplusTreeHandler &tree_handler) override;
+  RC redo(BplusTreeMiniTransaction &mtr, BplusTreeHandler &tree_handler) override;
+
+  string to_string() const override;
+
+  static RC deserialize(Frame *frame, common::Deserializer &buffer, unique_ptr<LogEntryHandler> &handler);
+
+  const char *prefix() const { return prefix_.data(); }
+  int32_t     prefix_length() const { return static_cast<int32_t>(prefix_.size()); }
+
+private:
+  vector<char> prefix_;
+  vector<char> old_prefix_;
+};
+
 /**
  * @brief 初始化内部节点日志处理类
  * @ingroup CLog
@@ -0,0 +1,858 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <stddef.h>
+
+#include "storage/index/extendible_hash.h"
+#include "common/lang/defer.h"
+#include "common/log/log.h"
+#include "storage/buffer/frame.h"
+
+static const int      DIR_PAGE_ENTRIES = 1 << HashIndexFileHeader::DIR_PAGE_DEPTH;
+static const uint64_t MAX_DEPTH_MASK   = (1ULL << HashIndexFileHeader::MAX_GLOBAL_DEPTH) - 1;
+
+static_assert(sizeof(HashIndexFileHeader) <= BP_PAGE_DATA_SIZE, "header of hash index should fit in one page");
+static_assert(DIR_PAGE_ENTRIES * sizeof(PageNum) <= BP_PAGE_DATA_SIZE, "directory page of hash index is too large");
+
+static HashBucketHeader *bucket_header(Frame *frame) { return reinterpret_cast<HashBucketHeader *>(frame->data()); }
+
+static HashIndexFileHeader *file_header(Frame *frame) { return reinterpret_cast<HashIndexFileHeader *>(frame->data()); }
+
+static PageNum *dir_entries(Frame *frame) { return reinterpret_cast<PageNum *>(frame->data()); }
+
+/// @brief 文件头中有效部分的长度，目录页面页号之前的字段也包含在内
+static int file_header_used_size(int global_depth)
+{
+  return static_cast<int>(offsetof(HashIndexFileHeader, dir_pages) +
+                          sizeof(PageNum) * HashIndexFileHeader::dir_page_count(global_depth));
+}
+
+static bool hashable_type(AttrType type)
+{
+  return type == AttrType::CHARS || type == AttrType::INTS || type == AttrType::DATES || type == AttrType::BOOLEANS;
+}
+
+/**
+ * @brief 固定一个页面并加写锁，析构时解锁并释放页面
+ */
+class HashPageGuard
+{
+public:
+  explicit HashPageGuard(DiskBufferPool &buffer_pool) : buffer_pool_(buffer_pool) {}
+  ~HashPageGuard()
+  {
+    if (frame_ != nullptr) {
+      frame_->write_unlatch();
+      buffer_pool_.unpin_page(frame_);
+    }
+  }
+
+  RC get(PageNum page_num)
+  {
+    RC rc = buffer_pool_.get_this_page(page_num, &frame_);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to get page of hash index. page num=%d, rc=%s", page_num, strrc(rc));
+      frame_ = nullptr;
+      return rc;
+    }
+    frame_->write_latch();
+    return rc;
+  }
+
+  RC allocate()
+  {
+    RC rc = buffer_pool_.allocate_page(&frame_);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to allocate page for hash index. rc=%s", strrc(rc));
+      frame_ = nullptr;
+      return rc;
+    }
+    frame_->write_latch();
+    return rc;
+  }
+
+  Frame *frame() const { return frame_; }
+
+private:
+  DiskBufferPool &buffer_pool_;
+  Frame          *frame_ = nullptr;
+};
+
+RC ExtendibleHashHandler::create(LogHandler &log_handler, BufferPoolManager &bpm, const char *file_name,
+    const vector<AttrType> &attr_types, const vector<int> &attr_lengths, bool unique, int bucket_capacity)
+{
+  RC rc = bpm.create_file(file_name);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("Failed to create file. file name=%s, rc=%s", file_name, strrc(rc));
+    return rc;
+  }
+
+  DiskBufferPool *bp = nullptr;
+  rc = bpm.open_file(log_handler, file_name, bp);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("Failed to open file. file name=%s, rc=%s", file_name, strrc(rc));
+    return rc;
+  }
+
+  rc = this->create(log_handler, *bp, attr_types, attr_lengths, unique, bucket_capacity);
+  if (OB_FAIL(rc)) {
+    bpm.close_file(file_name);
+    return rc;
+  }
+
+  LOG_INFO("Successfully create hash index file %s.", file_name);
+  return rc;
+}
+
+RC ExtendibleHashHandler::create(LogHandler &log_handler, DiskBufferPool &buffer_pool,
+    const vector<AttrType> &attr_types, const vector<int> &attr_lengths, bool unique, int bucket_capacity)
+{
+  if (attr_types.empty() || attr_types.size() != attr_lengths.size() ||
+      attr_types.size() > static_cast<size_t>(HashIndexFileHeader::MAX_ATTR_NUM)) {
+    LOG_WARN("invalid hash index attributes. attr num=%d, max attr num=%d",
+             attr_types.size(), HashIndexFileHeader::MAX_ATTR_NUM);
+    return RC::INVALID_ARGUMENT;
+  }
+
+  for (AttrType attr_type : attr_types) {
+    if (!hashable_type(attr_type)) {
+      LOG_WARN("hash index does not support attribute type %s", attr_type_to_string(attr_type));
+      return RC::INVALID_ARGUMENT;
+    }
+  }
+
+  int attr_length = 0;
+  for (int length : attr_lengths) {
+    attr_length += length;
+  }
+
+  const int item_size    = attr_length + static_cast<int>(sizeof(RID));
+  const int max_capacity = static_cast<int>((BP_PAGE_DATA_SIZE - sizeof(HashBucketHeader)) / item_size);
+  if (bucket_capacity <= 0 || bucket_capacity > max_capacity) {
+    bucket_capacity = max_capacity;
+  }
+  if (bucket_capacity <= 0) {
+    LOG_WARN("key of hash index is too long. attr length=%d", attr_length);
+    return RC::INVALID_ARGUMENT;
+  }
+
+  log_handler_      = &log_handler;
+  disk_buffer_pool_ = &buffer_pool;
+  unique_           = unique;
+  hash_log_handler_.init(log_handler);
+
+  HashPageGuard header_page(buffer_pool);
+  RC            rc = header_page.allocate();
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  Frame *header_frame = header_page.frame();
+  if (header_frame->page_num() != HEADER_PAGE) {
+    LOG_WARN("header page num should be %d but got %d. is it a new file", HEADER_PAGE, header_frame->page_num());
+    return RC::INTERNAL;
+  }
+
+  HashPageGuard dir_page(buffer_pool);
+  rc = dir_page.allocate();
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  HashPageGuard bucket_page(buffer_pool);
+  rc = bucket_page.allocate();
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  Frame            *bucket_frame = bucket_page.frame();
+  HashBucketHeader *bucket       = bucket_header(bucket_frame);
+  bucket->local_depth            = 0;
+  bucket->size                   = 0;
+  bucket->next_page              = BP_INVALID_PAGE_NUM;
+  rc = hash_log_handler_.update_page(bucket_frame, 0, sizeof(HashBucketHeader));
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to log the first bucket page. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  HashIndexFileHeader *header = file_header(header_frame);
+  header->attr_num            = static_cast<int32_t>(attr_types.size());
+  header->attr_length         = attr_length;
+  header->item_size           = item_size;
+  header->bucket_capacity     = bucket_capacity;
+  header->global_depth        = 0;
+  for (size_t i = 0; i < attr_types.size(); i++) {
+    header->attr_types[i]   = attr_types[i];
+    header->attr_lengths[i] = attr_lengths[i];
+  }
+  Frame *dir_frame           = dir_page.frame();
+  dir_entries(dir_frame)[0] = bucket_frame->page_num();
+  rc                        = hash_log_handler_.update_page(dir_frame, 0, sizeof(PageNum));
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to log the directory page. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  header->dir_pages[0] = dir_frame->page_num();
+  rc = hash_log_handler_.update_page(header_frame, 0, file_header_used_size(0));
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to log the header page. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  rc = init_attrs(*header);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  // 与B+树一样，元数据页面直接刷到磁盘，打开文件时就能读到正确的元数据
+  rc = buffer_pool.flush_all_pages();
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to sync hash index. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  LOG_INFO("Successfully create hash index. attr length=%d, bucket capacity=%d", attr_length, bucket_capacity);
+  return RC::SUCCESS;
+}
+
+RC ExtendibleHashHandler::open(LogHandler &log_handler, BufferPoolManager &bpm, const char *file_name, bool unique)
+{
+  if (disk_buffer_pool_ != nullptr) {
+    LOG_WARN("%s has been opened before index.open.", file_name);
+    return RC::RECORD_OPENNED;
+  }
+
+  DiskBufferPool *disk_buffer_pool = nullptr;
+  RC              rc               = bpm.open_file(log_handler, file_name, disk_buffer_pool);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("Failed to open file name=%s, rc=%s", file_name, strrc(rc));
+    return rc;
+  }
+
+  rc = this->open(log_handler, *disk_buffer_pool, unique);
+  if (OB_SUCC(rc)) {
+    LOG_INFO("open hash index success. filename=%s", file_name);
+  }
+  return rc;
+}
+
+RC ExtendibleHashHandler::open(LogHandler &log_handler, DiskBufferPool &buffer_pool, bool unique)
+{
+  if (disk_buffer_pool_ != nullptr) {
+    LOG_WARN("hash index has been opened before index.open.");
+    return RC::RECORD_OPENNED;
+  }
+
+  Frame *frame = nullptr;
+  RC     rc    = buffer_pool.get_this_page(HEADER_PAGE, &frame);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("Failed to get header page, rc=%s", strrc(rc));
+    return rc;
+  }
+
+  rc = init_attrs(*file_header(frame));
+  buffer_pool.unpin_page(frame);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  log_handler_      = &log_handler;
+  disk_buffer_pool_ = &buffer_pool;
+  unique_           = unique;
+  hash_log_handler_.init(log_handler);
+  return RC::SUCCESS;
+}
+
+RC ExtendibleHashHandler::init_attrs(const HashIndexFileHeader &header)
+{
+  if (header.attr_num <= 0 || header.attr_num > HashIndexFileHeader::MAX_ATTR_NUM || header.bucket_capacity <= 0 ||
+      header.item_size != header.attr_length + static_cast<int>(sizeof(RID))) {
+    LOG_WARN("invalid hash index header. attr num=%d, attr length=%d, item size=%d, bucket capacity=%d",
+             header.attr_num, header.attr_length, header.item_size, header.bucket_capacity);
+    return RC::INTERNAL;
+  }
+
+  attr_types_.assign(header.attr_types, header.attr_types + header.attr_num);
+  attr_lengths_.assign(header.attr_lengths, header.attr_lengths + header.attr_num);
+  attr_length_     = header.attr_length;
+  item_size_       = header.item_size;
+  bucket_capacity_ = header.bucket_capacity;
+  return RC::SUCCESS;
+}
+
+RC ExtendibleHashHandler::close()
+{
+  if (disk_buffer_pool_ != nullptr) {
+    disk_buffer_pool_->close_file();
+  }
+  disk_buffer_pool_ = nullptr;
+  return RC::SUCCESS;
+}
+
+RC ExtendibleHashHandler::sync() { return disk_buffer_pool_->flush_all_pages(); }
+
+int ExtendibleHashHandler::global_depth()
+{
+  PageNum page_num     = BP_INVALID_PAGE_NUM;
+  int     global_depth = -1;
+  RC      rc           = find_bucket(0, page_num, global_depth);
+  return OB_SUCC(rc) ? global_depth : -1;
+}
+
+uint64_t ExtendibleHashHandler::hash_key(const char *key) const
+{
+  // FNV-1a，字符串只计算结束符之前的部分，与 key_equal 的比较方法保持一致
+  uint64_t hash = 14695981039346656037ULL;
+  for (size_t i = 0; i < attr_types_.size(); i++) {
+    const int length =
+        attr_types_[i] == AttrType::CHARS ? static_cast<int>(strnlen(key, attr_lengths_[i])) : attr_lengths_[i];
+    for (int j = 0; j < length; j++) {
+      hash ^= static_cast<uint8_t>(key[j]);
+      hash *= 1099511628211ULL;
+    }
+    key += attr_lengths_[i];
+  }
+
+  // 目录使用哈希值的低位，再把高位混合进来
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+bool ExtendibleHashHandler::key_equal(const char *key1, const char *key2) const
+{
+  for (size_t i = 0; i < attr_types_.size(); i++) {
+    const int attr_length = attr_lengths_[i];
+    if (attr_types_[i] == AttrType::CHARS) {
+      const size_t len1 = strnlen(key1, attr_length);
+      if (len1 != strnlen(key2, attr_length) || 0 != memcmp(key1, key2, len1)) {
+        return false;
+      }
+    } else if (0 != memcmp(key1, key2, attr_length)) {
+      return false;
+    }
+    key1 += attr_length;
+    key2 += attr_length;
+  }
+  return true;
+}
+
+char *ExtendibleHashHandler::item_at(Frame *frame, int index) const
+{
+  return frame->data() + sizeof(HashBucketHeader) + static_cast<size_t>(index) * item_size_;
+}
+
+RC ExtendibleHashHandler::find_bucket(uint64_t hash, PageNum &page_num, int &global_depth)
+{
+  Frame *frame = nullptr;
+  RC     rc    = disk_buffer_pool_->get_this_page(HEADER_PAGE, &frame);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to get header page of hash index. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  frame->read_latch();
+  const HashIndexFileHeader *header   = file_header(frame);
+  const uint64_t             index    = hash & ((1ULL << header->global_depth) - 1);
+  const PageNum              dir_page = header->dir_pages[index >> HashIndexFileHeader::DIR_PAGE_DEPTH];
+  global_depth                        = header->global_depth;
+  frame->read_unlatch();
+  disk_buffer_pool_->unpin_page(frame);
+
+  rc = disk_buffer_pool_->get_this_page(dir_page, &frame);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to get directory page of hash index. page num=%d, rc=%s", dir_page, strrc(rc));
+    return rc;
+  }
+
+  frame->read_latch();
+  page_num = dir_entries(frame)[index & (DIR_PAGE_ENTRIES - 1)];
+  frame->read_unlatch();
+  disk_buffer_pool_->unpin_page(frame);
+  return RC::SUCCESS;
+}
+
+RC ExtendibleHashHandler::visit_bucket(PageNum page_num, bool write, const function<bool(Frame *)> &visitor)
+{
+  while (page_num != BP_INVALID_PAGE_NUM) {
+    Frame *frame = nullptr;
+    RC     rc    = disk_buffer_pool_->get_this_page(page_num, &frame);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to get bucket page of hash index. page num=%d, rc=%s", page_num, strrc(rc));
+      return rc;
+    }
+
+    write ? frame->write_latch() : frame->read_latch();
+    const bool go_on = visitor(frame);
+    page_num         = bucket_header(frame)->next_page;
+    write ? frame->write_unlatch() : frame->read_unlatch();
+    disk_buffer_pool_->unpin_page(frame);
+
+    if (!go_on) {
+      break;
+    }
+  }
+  return RC::SUCCESS;
+}
+
+RC ExtendibleHashHandler::insert_entry(const char *user_key, const RID *rid)
+{
+  lock_guard<common::SharedMutex> guard(lock_);
+
+  const uint64_t hash = hash_key(user_key);
+  while (true) {
+    PageNum bucket_page_num = BP_INVALID_PAGE_NUM;
+    int     global_depth    = 0;
+    RC      rc              = find_bucket(hash, bucket_page_num, global_depth);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+
+    // 检查是否有重复的键值，同时找一个还有空间的页面
+    bool    duplicate      = false;
+    int     local_depth    = 0;
+    PageNum free_page_num  = BP_INVALID_PAGE_NUM;
+    rc = visit_bucket(bucket_page_num, false /*write*/, [&](Frame *frame) {
+      const HashBucketHeader *bucket = bucket_header(frame);
+      if (frame->page_num() == bucket_page_num) {
+        local_depth = bucket->local_depth;
+      }
+      for (int i = 0; i < bucket->size; i++) {
+        const char *item = item_at(frame, i);
+        if (key_equal(item, user_key) && (unique_ || *rid_of(item) == *rid)) {
+          duplicate = true;
+          return false;
+        }
+      }
+      if (free_page_num == BP_INVALID_PAGE_NUM && bucket->size < bucket_capacity_) {
+        free_page_num = frame->page_num();
+      }
+      return true;
+    });
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+
+    if (duplicate) {
+      return RC::RECORD_DUPLICATE_KEY;
+    }
+
+    if (free_page_num != BP_INVALID_PAGE_NUM) {
+      return append_item(free_page_num, user_key, rid);
+    }
+
+    // 有溢出页面的桶也可以分裂，只要桶中数据的哈希值在目录还可以使用的位上有不同
+    bool split = false;
+    if (local_depth < HashIndexFileHeader::MAX_GLOBAL_DEPTH) {
+      rc = can_split(bucket_page_num, hash, split);
+      if (OB_FAIL(rc)) {
+        return rc;
+      }
+    }
+
+    if (!split) {
+      return add_overflow_page(bucket_page_num, user_key, rid);
+    }
+
+    rc = split_bucket(bucket_page_num, hash);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to split bucket of hash index. page num=%d, rc=%s", bucket_page_num, strrc(rc));
+      return rc;
+    }
+  }
+}
+
+RC ExtendibleHashHandler::append_item(PageNum page_num, const char *user_key, const RID *rid)
+{
+  HashPageGuard page(*disk_buffer_pool_);
+  RC            rc = page.get(page_num);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  Frame            *frame  = page.frame();
+  HashBucketHeader *bucket = bucket_header(frame);
+  char             *item   = item_at(frame, bucket->size);
+  memcpy(item, user_key, attr_length_);
+  memcpy(item + attr_length_, rid, sizeof(RID));
+  bucket->size++;
+
+  rc = hash_log_handler_.update_page(frame, static_cast<int>(item - frame->data()), item_size_);
+  if (OB_SUCC(rc)) {
+    rc = hash_log_handler_.update_page(frame, 0, sizeof(HashBucketHeader));
+  }
+  return rc;
+}
+
+RC ExtendibleHashHandler::add_overflow_page(PageNum bucket_page_num, const char *user_key, const RID *rid)
+{
+  HashPageGuard bucket_page(*disk_buffer_pool_);
+  RC            rc = bucket_page.get(bucket_page_num);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  HashPageGuard new_page(*disk_buffer_pool_);
+  rc = new_page.allocate();
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  // 新页面放在第一个页面的后面，先写好新页面，再修改链表
+  Frame            *bucket_frame = bucket_page.frame();
+  Frame            *new_frame    = new_page.frame();
+  HashBucketHeader *bucket       = bucket_header(bucket_frame);
+  HashBucketHeader *new_bucket   = bucket_header(new_frame);
+  new_bucket->local_depth        = bucket->local_depth;
+  new_bucket->size               = 1;
+  new_bucket->next_page          = bucket->next_page;
+  char *item                     = item_at(new_frame, 0);
+  memcpy(item, user_key, attr_length_);
+  memcpy(item + attr_length_, rid, sizeof(RID));
+  rc = hash_log_handler_.update_page(new_frame, 0, sizeof(HashBucketHeader) + item_size_);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  bucket->next_page = new_frame->page_num();
+  return hash_log_handler_.update_page(bucket_frame, 0, sizeof(HashBucketHeader));
+}
+
+RC ExtendibleHashHandler::can_split(PageNum bucket_page_num, uint64_t hash, bool &result)
+{
+  // 所有数据的哈希值在目录可以使用的位上都相同时，比如都是相同的键值，分裂没有意义
+  result = false;
+  return visit_bucket(bucket_page_num, false /*write*/, [&](Frame *frame) {
+    const HashBucketHeader *bucket = bucket_header(frame);
+    for (int i = 0; i < bucket->size && !result; i++) {
+      result = ((hash_key(item_at(frame, i)) ^ hash) & MAX_DEPTH_MASK) != 0;
+    }
+    return !result;
+  });
+}
+
+RC ExtendibleHashHandler::split_bucket(PageNum bucket_page_num, uint64_t hash)
+{
+  HashPageGuard header_page(*disk_buffer_pool_);
+  RC            rc = header_page.get(HEADER_PAGE);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  // 读出整个桶，哈希值第 local_depth 位是 1 的数据放到新的桶中
+  struct BucketPage
+  {
+    PageNum page_num;
+    int     remain_size;  ///< 分裂之后留在这个页面上的项数
+  };
+  vector<BucketPage> pages;
+  vector<char>       moved_items;
+  int                local_depth = 0;
+  rc = visit_bucket(bucket_page_num, false /*write*/, [&](Frame *frame) {
+    const HashBucketHeader *bucket = bucket_header(frame);
+    if (pages.empty()) {
+      local_depth = bucket->local_depth;
+    }
+    int remain_size = 0;
+    for (int i = 0; i < bucket->size; i++) {
+      const char *item = item_at(frame, i);
+      if ((hash_key(item) >> local_depth) & 1) {
+        moved_items.insert(moved_items.end(), item, item + item_size_);
+      } else {
+        remain_size++;
+      }
+    }
+    pages.push_back({frame->page_num(), remain_size});
+    return true;
+  });
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  // 顺序是新桶、目录、旧桶。旧桶的每个页面只在页内移动数据，中间任何一步中断，已经重放的部分都不会让数据丢失
+  const int moved_num    = static_cast<int>(moved_items.size() / item_size_);
+  PageNum   new_page_num = BP_INVALID_PAGE_NUM;
+  rc = create_bucket(moved_items.data(), moved_num, local_depth + 1, new_page_num);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  Frame               *header_frame = header_page.frame();
+  HashIndexFileHeader *header       = file_header(header_frame);
+  if (local_depth == header->global_depth) {
+    rc = double_directory(header_frame);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
+  rc = update_directory(*header, hash, local_depth, new_page_num);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  // 从后向前整理旧桶的页面，变空的溢出页面从链表中摘掉，第一个页面一直保留
+  vector<PageNum> empty_pages;
+  PageNum         next_page = BP_INVALID_PAGE_NUM;
+  for (auto iter = pages.rbegin(); iter != pages.rend(); ++iter) {
+    if (iter->remain_size == 0 && iter->page_num != bucket_page_num) {
+      empty_pages.push_back(iter->page_num);
+      continue;
+    }
+
+    HashPageGuard page(*disk_buffer_pool_);
+    rc = page.get(iter->page_num);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+
+    Frame            *frame       = page.frame();
+    HashBucketHeader *bucket      = bucket_header(frame);
+    int               remain_size = 0;
+    for (int i = 0; i < bucket->size; i++) {
+      char *item = item_at(frame, i);
+      if ((hash_key(item) >> local_depth) & 1) {
+        continue;
+      }
+      if (remain_size != i) {
+        memcpy(item_at(frame, remain_size), item, item_size_);
+      }
+      remain_size++;
+    }
+
+    bucket->local_depth = local_depth + 1;
+    bucket->size        = remain_size;
+    bucket->next_page   = next_page;
+    rc = hash_log_handler_.update_page(frame, 0, sizeof(HashBucketHeader) + remain_size * item_size_);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+    next_page = iter->page_num;
+  }
+
+  for (PageNum page_num : empty_pages) {
+    rc = disk_buffer_pool_->dispose_page(page_num);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to dispose empty page of hash bucket. page num=%d, rc=%s", page_num, strrc(rc));
+      return rc;
+    }
+  }
+
+  LOG_TRACE("split hash bucket. page num=%d, new page num=%d, moved items=%d, local depth=%d, global depth=%d",
+            bucket_page_num, new_page_num, moved_num, local_depth + 1, header->global_depth);
+  return RC::SUCCESS;
+}
+
+RC ExtendibleHashHandler::create_bucket(const char *items, int item_num, int local_depth, PageNum &page_num)
+{
+  // 从最后一个页面开始写，写每个页面时已经知道后面页面的页号
+  const int page_count = std::max(1, (item_num + bucket_capacity_ - 1) / bucket_capacity_);
+  page_num             = BP_INVALID_PAGE_NUM;
+  for (int i = page_count - 1; i >= 0; i--) {
+    HashPageGuard page(*disk_buffer_pool_);
+    RC            rc = page.allocate();
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+
+    Frame            *frame  = page.frame();
+    HashBucketHeader *bucket = bucket_header(frame);
+    const int         first  = i * bucket_capacity_;
+    bucket->local_depth      = local_depth;
+    bucket->size             = std::min(bucket_capacity_, item_num - first);
+    bucket->next_page        = page_num;
+    if (bucket->size > 0) {
+      memcpy(item_at(frame, 0), items + static_cast<size_t>(first) * item_size_,
+          static_cast<size_t>(bucket->size) * item_size_);
+    }
+    rc = hash_log_handler_.update_page(frame, 0, sizeof(HashBucketHeader) + bucket->size * item_size_);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+    page_num = frame->page_num();
+  }
+  return RC::SUCCESS;
+}
+
+RC ExtendibleHashHandler::double_directory(Frame *header_frame)
+{
+  HashIndexFileHeader *header       = file_header(header_frame);
+  const int            global_depth = header->global_depth;
+  if (global_depth >= HashIndexFileHeader::MAX_GLOBAL_DEPTH) {
+    LOG_WARN("directory of hash index reaches the max depth. global depth=%d", global_depth);
+    return RC::INTERNAL;
+  }
+
+  if (global_depth < HashIndexFileHeader::DIR_PAGE_DEPTH) {
+    // 目录在第一个目录页面中还有空间，前一半复制到后一半
+    HashPageGuard dir_page(*disk_buffer_pool_);
+    RC            rc = dir_page.get(header->dir_pages[0]);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+
+    const int dir_size = (1 << global_depth) * static_cast<int>(sizeof(PageNum));
+    memcpy(dir_page.frame()->data() + dir_size, dir_page.frame()->data(), dir_size);
+    rc = hash_log_handler_.update_page(dir_page.frame(), dir_size, dir_size);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  } else {
+    // 每个目录页面复制一份，放到新分配的页面中
+    const int dir_page_num = HashIndexFileHeader::dir_page_count(global_depth);
+    for (int i = 0; i < dir_page_num; i++) {
+      HashPageGuard old_page(*disk_buffer_pool_);
+      RC            rc = old_page.get(header->dir_pages[i]);
+      if (OB_FAIL(rc)) {
+        return rc;
+      }
+
+      HashPageGuard new_page(*disk_buffer_pool_);
+      rc = new_page.allocate();
+      if (OB_FAIL(rc)) {
+        return rc;
+      }
+
+      memcpy(new_page.frame()->data(), old_page.frame()->data(), DIR_PAGE_ENTRIES * sizeof(PageNum));
+      rc = hash_log_handler_.update_page(new_page.frame(), 0, DIR_PAGE_ENTRIES * sizeof(PageNum));
+      if (OB_FAIL(rc)) {
+        return rc;
+      }
+      header->dir_pages[dir_page_num + i] = new_page.frame()->page_num();
+    }
+  }
+
+  header->global_depth++;
+  return hash_log_handler_.update_page(header_frame, 0, file_header_used_size(header->global_depth));
+}
+
+RC ExtendibleHashHandler::update_directory(
+    const HashIndexFileHeader &header, uint64_t hash, int local_depth, PageNum new_page_num)
+{
+  const uint64_t dir_size = 1ULL << header.global_depth;
+  const uint64_t step     = 1ULL << (local_depth + 1);
+  uint64_t       index    = (hash & ((1ULL << local_depth) - 1)) | (1ULL << local_depth);
+  while (index < dir_size) {
+    // 一次修改一个目录页面上所有需要修改的项
+    const uint64_t page_index = index >> HashIndexFileHeader::DIR_PAGE_DEPTH;
+    const uint64_t page_end   = (page_index + 1) << HashIndexFileHeader::DIR_PAGE_DEPTH;
+
+    HashPageGuard dir_page(*disk_buffer_pool_);
+    RC            rc = dir_page.get(header.dir_pages[page_index]);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+
+    PageNum  *entries = dir_entries(dir_page.frame());
+    const int first   = static_cast<int>(index & (DIR_PAGE_ENTRIES - 1));
+    int       last    = first;
+    for (; index < dir_size && index < page_end; index += step) {
+      last          = static_cast<int>(index & (DIR_PAGE_ENTRIES - 1));
+      entries[last] = new_page_num;
+    }
+    rc = hash_log_handler_.update_page(dir_page.frame(),
+        first * static_cast<int>(sizeof(PageNum)),
+        (last - first + 1) * static_cast<int>(sizeof(PageNum)));
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+  }
+  return RC::SUCCESS;
+}
+
+RC ExtendibleHashHandler::delete_entry(const char *user_key, const RID *rid)
+{
+  lock_guard<common::SharedMutex> guard(lock_);
+
+  PageNum bucket_page_num = BP_INVALID_PAGE_NUM;
+  int     global_depth    = 0;
+  RC      rc              = find_bucket(hash_key(user_key), bucket_page_num, global_depth);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  bool found  = false;
+  RC   log_rc = RC::SUCCESS;
+  rc = visit_bucket(bucket_page_num, true /*write*/, [&](Frame *frame) {
+    HashBucketHeader *bucket = bucket_header(frame);
+    for (int i = 0; i < bucket->size; i++) {
+      char *item = item_at(frame, i);
+      if (!key_equal(item, user_key) || !(*rid_of(item) == *rid)) {
+        continue;
+      }
+
+      // 用页面上最后一项填补删除的位置
+      found = true;
+      bucket->size--;
+      if (i != bucket->size) {
+        memcpy(item, item_at(frame, bucket->size), item_size_);
+        log_rc = hash_log_handler_.update_page(frame, static_cast<int>(item - frame->data()), item_size_);
+      }
+      if (OB_SUCC(log_rc)) {
+        log_rc = hash_log_handler_.update_page(frame, 0, sizeof(HashBucketHeader));
+      }
+      return false;
+    }
+    return true;
+  });
+  if (OB_SUCC(rc)) {
+    rc = log_rc;
+  }
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to delete entry from hash index. rid=%s, rc=%s", rid->to_string().c_str(), strrc(rc));
+    return rc;
+  }
+  return found ? RC::SUCCESS : RC::RECORD_NOT_EXIST;
+}
+
+RC ExtendibleHashHandler::get_entry(const char *user_key, int key_len, vector<RID> &rids, vector<char> *keys)
+{
+  // 单个字符串字段的键值长度可能与字段长度不同，补齐或者截断成字段的长度
+  vector<char> fixed_key;
+  if (key_len != attr_length_) {
+    if (attr_types_.size() != 1 || attr_types_[0] != AttrType::CHARS || key_len <= 0) {
+      LOG_WARN("invalid key length of hash index. key len=%d, attr length=%d", key_len, attr_length_);
+      return RC::INVALID_ARGUMENT;
+    }
+    if (static_cast<int>(strnlen(user_key, key_len)) > attr_length_) {
+      return RC::SUCCESS;
+    }
+    fixed_key.assign(attr_length_, 0);
+    memcpy(fixed_key.data(), user_key, std::min(key_len, attr_length_));
+    user_key = fixed_key.data();
+  }
+
+  lock_.lock_shared();
+  DEFER(lock_.unlock_shared());
+
+  PageNum bucket_page_num = BP_INVALID_PAGE_NUM;
+  int     global_depth    = 0;
+  RC      rc              = find_bucket(hash_key(user_key), bucket_page_num, global_depth);
+  if (OB_FAIL(rc)) {
+    return rc;
+  }
+
+  return visit_bucket(bucket_page_num, false /*write*/, [&](Frame *frame) {
+    const HashBucketHeader *bucket = bucket_header(frame);
+    for (int i = 0; i < bucket->size; i++) {
+      const char *item = item_at(frame, i);
+      if (!key_equal(item, user_key)) {
+        continue;
+      }
+      rids.push_back(*rid_of(item));
+      if (keys != nullptr) {
+        keys->insert(keys->end(), item, item + attr_length_);
+      }
+    }
+    return true;
+  });
+}
@@ -0,0 +1,184 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "common/lang/functional.h"
+#include "common/lang/mutex.h"
+#include "common/lang/vector.h"
+#include "common/type/attr_type.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/index/hash_index_log.h"
+#include "storage/record/record.h"
+
+/**
+ * @brief 可扩展哈希的文件头
+ * @ingroup Index
+ * @details 放在索引文件的第一个页面上，包含键值的描述和所有目录页面的页号。
+ * 目录项按照哈希值的低 global_depth 位寻址，每一项指向一个桶的第一个页面。目录分散在多个目录页面中，
+ * 每个目录页面存放 1 << DIR_PAGE_DEPTH 项，第 i 项在第 i >> DIR_PAGE_DEPTH 个目录页面上。
+ * global_depth 不超过 DIR_PAGE_DEPTH 时只有一个目录页面，只使用前面 1 << global_depth 项。
+ */
+struct HashIndexFileHeader
+{
+  static constexpr int MAX_ATTR_NUM     = 8;   ///< 组合索引最多包含的字段个数
+  static constexpr int DIR_PAGE_DEPTH   = 10;  ///< 每个目录页面存放 1024 项
+  static constexpr int MAX_GLOBAL_DEPTH = 20;  ///< 最多 1024 个目录页面，100 多万个桶
+  static constexpr int MAX_DIR_PAGE_NUM = 1 << (MAX_GLOBAL_DEPTH - DIR_PAGE_DEPTH);
+
+  int32_t  attr_num;                     ///< 键值包含的字段个数
+  int32_t  attr_length;                  ///< 键值的长度，所有字段长度的和
+  int32_t  item_size;                    ///< 桶中每一项的长度，键值 + RID
+  int32_t  bucket_capacity;              ///< 每个桶页面最多存放的项数
+  int32_t  global_depth;                 ///< 目录使用哈希值的位数
+  AttrType attr_types[MAX_ATTR_NUM];     ///< 每个字段的类型
+  int32_t  attr_lengths[MAX_ATTR_NUM];   ///< 每个字段的长度
+  PageNum  dir_pages[MAX_DIR_PAGE_NUM];  ///< 目录页面，只有前面 dir_page_count(global_depth) 个有效
+
+  static int dir_page_count(int global_depth)
+  {
+    return global_depth <= DIR_PAGE_DEPTH ? 1 : 1 << (global_depth - DIR_PAGE_DEPTH);
+  }
+};
+
+/**
+ * @brief 哈希桶页面的页头
+ * @ingroup Index
+ * @details 页头后面紧跟着 size 个 键值+RID。一个桶的数据放不下并且没法再分裂时，
+ * 比如大量相同的键值，或者目录已经达到最大深度，就在后面挂上溢出页面，溢出页面使用同样的格式。
+ * 有溢出页面的桶后来插入了哈希值不同的数据时，仍然可以分裂，分裂时整个链表上的数据都会重新分配。
+ */
+struct HashBucketHeader
+{
+  int32_t local_depth;  ///< 桶中数据的哈希值低 local_depth 位都相同
+  int32_t size;         ///< 当前页面上的项数
+  PageNum next_page;    ///< 溢出页面，没有时是 BP_INVALID_PAGE_NUM
+};
+
+/**
+ * @brief 可扩展哈希
+ * @ingroup Index
+ * @details 桶满的时候分裂成两个，需要时目录加倍。与B+树一样，记录会重复的键值，
+ * 键值+RID唯一确定一项。删除数据时不会合并桶，也不会缩小目录。
+ * 所有的修改都按照页面上修改后的内容记录物理日志，参考 HashIndexLogHandler。
+ * 浮点数的相等使用了误差范围，没法计算哈希值，所以不支持浮点数字段。
+ */
+class ExtendibleHashHandler
+{
+public:
+  ExtendibleHashHandler()  = default;
+  ~ExtendibleHashHandler() { close(); }
+
+  /**
+   * @brief 创建一个新的哈希索引
+   * @param log_handler 记录日志
+   * @param bpm 缓冲池管理器
+   * @param file_name 文件名
+   * @param attr_types 每个字段的类型
+   * @param attr_lengths 每个字段的长度
+   * @param unique 是否唯一索引
+   * @param bucket_capacity 每个桶页面最多存放的项数，小于0时按照页面大小计算，测试时用于构造分裂
+   */
+  RC create(LogHandler &log_handler, BufferPoolManager &bpm, const char *file_name, const vector<AttrType> &attr_types,
+      const vector<int> &attr_lengths, bool unique = false, int bucket_capacity = -1);
+  RC create(LogHandler &log_handler, DiskBufferPool &buffer_pool, const vector<AttrType> &attr_types,
+      const vector<int> &attr_lengths, bool unique = false, int bucket_capacity = -1);
+
+  RC open(LogHandler &log_handler, BufferPoolManager &bpm, const char *file_name, bool unique = false);
+  RC open(LogHandler &log_handler, DiskBufferPool &buffer_pool, bool unique = false);
+  RC close();
+
+  /**
+   * @brief 插入一项
+   * @param user_key 键值，长度是所有字段长度的和
+   * @return 唯一索引中键值已经存在，或者键值+RID已经存在时返回 RECORD_DUPLICATE_KEY
+   */
+  RC insert_entry(const char *user_key, const RID *rid);
+
+  /**
+   * @brief 删除一项
+   * @return 不存在时返回 RECORD_NOT_EXIST
+   */
+  RC delete_entry(const char *user_key, const RID *rid);
+
+  /**
+   * @brief 查找键值相等的所有项
+   * @details 单个字符串字段时，user_key 可以比字段短，也可以更长，更长的部分不为空就一定找不到
+   * @param keys 不为空时，依次放入找到的键值
+   */
+  RC get_entry(const char *user_key, int key_len, vector<RID> &rids, vector<char> *keys = nullptr);
+
+  RC sync();
+
+  int attr_length() const { return attr_length_; }
+
+  /// @brief 目录使用的哈希值位数，出错时返回 -1
+  int global_depth();
+
+private:
+  static constexpr PageNum HEADER_PAGE = 1;
+
+  RC init_attrs(const HashIndexFileHeader &file_header);
+
+  uint64_t hash_key(const char *key) const;
+  bool     key_equal(const char *key1, const char *key2) const;
+
+  char       *item_at(Frame *frame, int index) const;
+  const RID  *rid_of(const char *item) const { return reinterpret_cast<const RID *>(item + attr_length_); }
+
+  /// @brief 根据哈希值从目录中找到桶的第一个页面
+  RC find_bucket(uint64_t hash, PageNum &page_num, int &global_depth);
+
+  /**
+   * @brief 依次访问一个桶的所有页面
+   * @param visitor 返回 false 时不再访问后面的页面
+   */
+  RC visit_bucket(PageNum page_num, bool write, const function<bool(Frame *)> &visitor);
+
+  RC append_item(PageNum page_num, const char *user_key, const RID *rid);
+  RC add_overflow_page(PageNum bucket_page_num, const char *user_key, const RID *rid);
+
+  /// @brief 分裂以后，桶中的数据是否可能分到两个桶中
+  RC can_split(PageNum bucket_page_num, uint64_t hash, bool &result);
+
+  /**
+   * @brief 分裂一个桶，包括它所有的溢出页面
+   * @param hash 桶中任意一个键值的哈希值，用来计算需要修改的目录项
+   */
+  RC split_bucket(PageNum bucket_page_num, uint64_t hash);
+
+  /// @brief 使用新分配的页面创建一个桶，放入 item_num 项，一个页面放不下时使用溢出页面
+  RC create_bucket(const char *items, int item_num, int local_depth, PageNum &page_num);
+
+  /// @brief 目录加倍，新的一半是原来的复制
+  RC double_directory(Frame *header_frame);
+
+  /**
+   * @brief 分裂之后，把原来指向桶并且哈希值第 local_depth 位是 1 的目录项指向新的桶
+   * @details 这些目录项的低 local_depth + 1 位都相同，按照步长直接找到，不需要遍历整个目录
+   */
+  RC update_directory(const HashIndexFileHeader &header, uint64_t hash, int local_depth, PageNum new_page_num);
+
+private:
+  LogHandler         *log_handler_      = nullptr;
+  DiskBufferPool     *disk_buffer_pool_ = nullptr;
+  HashIndexLogHandler hash_log_handler_;
+  bool                unique_           = false;
+
+  vector<AttrType> attr_types_;
+  vector<int>      attr_lengths_;
+  int              attr_length_     = 0;
+  int              item_size_       = 0;
+  int              bucket_capacity_ = 0;
+
+  common::SharedMutex lock_;  ///< 修改时加写锁，查找时加读锁
+};
@@ -0,0 +1,174 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "storage/index/hash_index.h"
+#include "common/log/log.h"
+#include "storage/db/db.h"
+#include "storage/record/record_manager.h"
+#include "storage/table/table.h"
+
+HashIndex::~HashIndex() noexcept { close(); }
+
+RC HashIndex::create(Table *table, const char *file_name, const IndexMeta &index_meta, const vector<FieldMeta> &field_metas)
+{
+  if (inited_) {
+    LOG_WARN("Failed to create index due to the index has been created before. file_name:%s, index:%s, field:%s",
+        file_name, index_meta.name(), index_meta.field());
+    return RC::RECORD_OPENNED;
+  }
+
+  Index::init(index_meta, field_metas);
+
+  BufferPoolManager &bpm = table->db()->buffer_pool_manager();
+  vector<AttrType> attr_types;
+  vector<int>      attr_lengths;
+  for (const FieldMeta &field_meta : field_metas) {
+    attr_types.push_back(field_meta.type());
+    attr_lengths.push_back(field_meta.len());
+  }
+  RC rc = index_handler_.create(
+      table->db()->log_handler(), bpm, file_name, attr_types, attr_lengths, Index::index_meta().is_unique());
+  if (RC::SUCCESS != rc) {
+    LOG_WARN("Failed to create hash index handler, file_name:%s, index:%s, field:%s, rc:%s",
+        file_name, index_meta.name(), index_meta.field(), strrc(rc));
+    return rc;
+  }
+
+  inited_ = true;
+  table_  = table;
+  LOG_INFO("Successfully create hash index, file_name:%s, index:%s, field:%s",
+    file_name, index_meta.name(), index_meta.field());
+  return RC::SUCCESS;
+}
+
+RC HashIndex::open(Table *table, const char *file_name, const IndexMeta &index_meta, const vector<FieldMeta> &field_metas)
+{
+  if (inited_) {
+    LOG_WARN("Failed to open index due to the index has been initedd before. file_name:%s, index:%s, field:%s",
+        file_name, index_meta.name(), index_meta.field());
+    return RC::RECORD_OPENNED;
+  }
+
+  Index::init(index_meta, field_metas);
+
+  BufferPoolManager &bpm = table->db()->buffer_pool_manager();
+  RC rc = index_handler_.open(table->db()->log_handler(), bpm, file_name, Index::index_meta().is_unique());
+  if (RC::SUCCESS != rc) {
+    LOG_WARN("Failed to open hash index handler, file_name:%s, index:%s, field:%s, rc:%s",
+        file_name, index_meta.name(), index_meta.field(), strrc(rc));
+    return rc;
+  }
+
+  inited_ = true;
+  table_  = table;
+  LOG_INFO("Successfully open hash index, file_name:%s, index:%s, field:%s",
+    file_name, index_meta.name(), index_meta.field());
+  return RC::SUCCESS;
+}
+
+RC HashIndex::close()
+{
+  if (inited_) {
+    LOG_INFO("Begin to close hash index, index:%s, field:%s", index_meta_.name(), index_meta_.field());
+    index_handler_.close();
+    inited_ = false;
+  }
+  return RC::SUCCESS;
+}
+
+RC HashIndex::insert_entry(const char *record, const RID *rid)
+{
+  vector<char> buffer;
+  return index_handler_.insert_entry(make_user_key(record, buffer), rid);
+}
+
+RC HashIndex::delete_entry(const char *record, const RID *rid)
+{
+  vector<char> buffer;
+  return index_handler_.delete_entry(make_user_key(record, buffer), rid);
+}
+
+RC HashIndex::bulk_load(RecordFileScanner &scanner, int fill_factor, int64_t memory_limit, const char *temp_dir)
+{
+  RC           rc = RC::SUCCESS;
+  Record       record;
+  vector<char> buffer;
+  while (OB_SUCC(rc = scanner.next(record))) {
+    rc = index_handler_.insert_entry(make_user_key(record.data(), buffer), &record.rid());
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to insert record into hash index. index=%s, rid=%s, rc=%s",
+               index_meta_.name(), record.rid().to_string().c_str(), strrc(rc));
+      return rc;
+    }
+  }
+  if (rc != RC::RECORD_EOF) {
+    LOG_WARN("failed to scan records while building hash index. index=%s, rc=%s", index_meta_.name(), strrc(rc));
+    return rc;
+  }
+  return RC::SUCCESS;
+}
+
+IndexScanner *HashIndex::create_scanner(const char *left_key, int left_len, bool left_inclusive,
+    const char *right_key, int right_len, bool right_inclusive, bool reverse /*= false*/)
+{
+  // 只有一个键值，正序和逆序是一样的
+  if (nullptr == left_key || nullptr == right_key || !left_inclusive || !right_inclusive || left_len != right_len ||
+      0 != memcmp(left_key, right_key, left_len)) {
+    LOG_WARN("hash index only supports equality lookup. index=%s", index_meta_.name());
+    return nullptr;
+  }
+
+  HashIndexScanner *index_scanner = new HashIndexScanner(index_handler_);
+  RC rc = index_scanner->open(left_key, left_len);
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to open hash index scanner. rc=%d:%s", rc, strrc(rc));
+    delete index_scanner;
+    return nullptr;
+  }
+  return index_scanner;
+}
+
+RC HashIndex::sync() { return index_handler_.sync(); }
+
+////////////////////////////////////////////////////////////////////////////////
+RC HashIndexScanner::open(const char *user_key, int key_len)
+{
+  rids_.clear();
+  keys_.clear();
+  pos_ = 0;
+  return hash_handler_.get_entry(user_key, key_len, rids_, &keys_);
+}
+
+RC HashIndexScanner::next_entry(RID *rid)
+{
+  if (pos_ >= rids_.size()) {
+    return RC::RECORD_EOF;
+  }
+  *rid = rids_[pos_++];
+  return RC::SUCCESS;
+}
+
+RC HashIndexScanner::next_entry(RID *rid, char *user_key)
+{
+  if (pos_ >= rids_.size()) {
+    return RC::RECORD_EOF;
+  }
+
+  const int attr_length = hash_handler_.attr_length();
+  memcpy(user_key, keys_.data() + pos_ * attr_length, attr_length);
+  *rid = rids_[pos_++];
+  return RC::SUCCESS;
+}
+
+RC HashIndexScanner::destroy()
+{
+  delete this;
+  return RC::SUCCESS;
+}
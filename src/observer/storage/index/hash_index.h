@@ -0,0 +1,81 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "storage/index/extendible_hash.h"
+#include "storage/index/index.h"
+
+class RecordFileScanner;
+
+/**
+ * @brief 哈希索引
+ * @ingroup Index
+ * @details 只能做所有字段上的等值查询，不能范围扫描，也不能按照键值的顺序输出
+ */
+class HashIndex : public Index
+{
+public:
+  HashIndex() = default;
+  virtual ~HashIndex() noexcept;
+
+  RC create(Table *table, const char *file_name, const IndexMeta &index_meta,
+      const std::vector<FieldMeta> &field_metas) override;
+  RC open(Table *table, const char *file_name, const IndexMeta &index_meta,
+      const std::vector<FieldMeta> &field_metas) override;
+  RC close();
+
+  RC insert_entry(const char *record, const RID *rid) override;
+  RC delete_entry(const char *record, const RID *rid) override;
+
+  /**
+   * @brief 把表中已有的数据逐条插入到空的索引中
+   * @details 不需要排序，忽略 fill_factor、memory_limit 和 temp_dir
+   */
+  RC bulk_load(RecordFileScanner &scanner, int fill_factor, int64_t memory_limit, const char *temp_dir) override;
+
+  /**
+   * @brief 创建等值查询的扫描器
+   * @details 左右边界必须相同，都包含边界，并且包含所有的字段。不支持的范围返回空
+   */
+  IndexScanner *create_scanner(const char *left_key, int left_len, bool left_inclusive, const char *right_key,
+      int right_len, bool right_inclusive, bool reverse = false) override;
+
+  RC sync() override;
+
+private:
+  bool                  inited_ = false;
+  Table                *table_  = nullptr;
+  ExtendibleHashHandler index_handler_;
+};
+
+/**
+ * @brief 哈希索引扫描器
+ * @ingroup Index
+ * @details 打开时就把所有键值相等的项都取出来，扫描过程中不再访问索引
+ */
+class HashIndexScanner : public IndexScanner
+{
+public:
+  HashIndexScanner(ExtendibleHashHandler &hash_handler) : hash_handler_(hash_handler) {}
+  ~HashIndexScanner() noexcept override = default;
+
+  RC open(const char *user_key, int key_len);
+
+  RC next_entry(RID *rid) override;
+  RC next_entry(RID *rid, char *user_key) override;
+  RC destroy() override;
+
+private:
+  ExtendibleHashHandler &hash_handler_;
+  std::vector<RID>       rids_;
+  std::vector<char>      keys_;
+  size_t                 pos_ = 0;
+};
@@ -0,0 +1,109 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "storage/index/hash_index_log.h"
+#include "common/log/log.h"
+#include "common/lang/defer.h"
+#include "common/lang/sstream.h"
+#include "common/lang/vector.h"
+#include "storage/buffer/disk_buffer_pool.h"
+#include "storage/buffer/frame.h"
+#include "storage/clog/log_entry.h"
+#include "storage/clog/log_handler.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// struct HashIndexLogHeader
+
+const int32_t HashIndexLogHeader::SIZE = sizeof(HashIndexLogHeader);
+
+string HashIndexLogHeader::to_string() const
+{
+  stringstream ss;
+  ss << "buffer_pool_id:" << buffer_pool_id << ", page_num:" << page_num << ", offset:" << offset
+     << ", length:" << length;
+  return ss.str();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// class HashIndexLogHandler
+
+RC HashIndexLogHandler::update_page(Frame *frame, int offset, int length)
+{
+  vector<char>        log_payload(HashIndexLogHeader::SIZE + length);
+  HashIndexLogHeader *header = reinterpret_cast<HashIndexLogHeader *>(log_payload.data());
+  header->buffer_pool_id     = frame->buffer_pool_id();
+  header->page_num           = frame->page_num();
+  header->offset             = offset;
+  header->length             = length;
+  memcpy(log_payload.data() + HashIndexLogHeader::SIZE, frame->data() + offset, length);
+
+  LSN lsn = 0;
+  RC  rc  = log_handler_->append(lsn, LogModule::Id::HASH_INDEX, std::move(log_payload));
+  if (OB_SUCC(rc) && lsn > 0) {
+    frame->set_lsn(lsn);
+  }
+  frame->mark_dirty();
+  return rc;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// class HashIndexLogReplayer
+
+HashIndexLogReplayer::HashIndexLogReplayer(BufferPoolManager &bpm) : bpm_(bpm) {}
+
+RC HashIndexLogReplayer::replay(const LogEntry &entry)
+{
+  LOG_TRACE("replaying hash index log: %s", entry.to_string().c_str());
+
+  if (entry.module().id() != LogModule::Id::HASH_INDEX) {
+    return RC::INVALID_ARGUMENT;
+  }
+
+  if (entry.payload_size() < HashIndexLogHeader::SIZE) {
+    LOG_WARN("invalid log entry. payload size: %d is less than hash index log header size %d",
+             entry.payload_size(), HashIndexLogHeader::SIZE);
+    return RC::INVALID_ARGUMENT;
+  }
+
+  auto log_header = reinterpret_cast<const HashIndexLogHeader *>(entry.data());
+  if (log_header->offset < 0 || log_header->length < 0 ||
+      log_header->offset + log_header->length > BP_PAGE_DATA_SIZE ||
+      entry.payload_size() != HashIndexLogHeader::SIZE + log_header->length) {
+    LOG_WARN("invalid hash index log entry. %s, payload size=%d", log_header->to_string().c_str(), entry.payload_size());
+    return RC::INVALID_ARGUMENT;
+  }
+
+  DiskBufferPool *buffer_pool = nullptr;
+  Frame          *frame       = nullptr;
+  RC              rc          = bpm_.get_buffer_pool(log_header->buffer_pool_id, buffer_pool);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("fail to get buffer pool. buffer pool id=%d, rc=%s", log_header->buffer_pool_id, strrc(rc));
+    return rc;
+  }
+
+  rc = buffer_pool->get_this_page(log_header->page_num, &frame);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("fail to get this page. page num=%d, rc=%s", log_header->page_num, strrc(rc));
+    return rc;
+  }
+
+  DEFER(buffer_pool->unpin_page(frame));
+
+  if (frame->lsn() >= entry.lsn()) {
+    LOG_TRACE("page %d has been updated, skip replaying hash index log. frame lsn %d, log lsn %d",
+              log_header->page_num, frame->lsn(), entry.lsn());
+    return RC::SUCCESS;
+  }
+
+  memcpy(frame->data() + log_header->offset, log_header->data, log_header->length);
+  frame->set_lsn(entry.lsn());
+  frame->mark_dirty();
+  return RC::SUCCESS;
+}
@@ -0,0 +1,84 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "common/types.h"
+#include "common/rc.h"
+#include "common/lang/string.h"
+#include "storage/clog/log_replayer.h"
+
+class LogHandler;
+class Frame;
+class BufferPoolManager;
+
+/**
+ * @brief 哈希索引的日志头
+ * @ingroup CLog
+ * @details 哈希索引记录的是物理日志，即页面上从 offset 开始的 length 个字节修改后的内容，
+ * 后面紧跟着这些字节。
+ */
+struct HashIndexLogHeader
+{
+  int32_t buffer_pool_id;
+  PageNum page_num;
+  int32_t offset;
+  int32_t length;
+
+  char data[0];
+
+  string to_string() const;
+
+  static const int32_t SIZE;
+};
+
+/**
+ * @brief 记录哈希索引的日志
+ * @ingroup CLog
+ */
+class HashIndexLogHandler final
+{
+public:
+  HashIndexLogHandler()  = default;
+  ~HashIndexLogHandler() = default;
+
+  void init(LogHandler &log_handler) { log_handler_ = &log_handler; }
+
+  /**
+   * @brief 记录页面上一段数据的修改
+   * @details 调用前页面上的数据已经修改好了，这里把修改后的内容记录下来，同时更新页面的LSN
+   * @param frame 修改的页帧
+   * @param offset 修改的数据在页面数据区的偏移量
+   * @param length 修改的数据长度
+   */
+  RC update_page(Frame *frame, int offset, int length);
+
+private:
+  LogHandler *log_handler_ = nullptr;
+};
+
+/**
+ * @brief 哈希索引的日志重放器
+ * @ingroup CLog
+ * @details 页面的LSN不小于日志的LSN时，说明修改已经在页面上了，不需要重放
+ */
+class HashIndexLogReplayer final : public LogReplayer
+{
+public:
+  HashIndexLogReplayer(BufferPoolManager &bpm);
+  virtual ~HashIndexLogReplayer() = default;
+
+  virtual RC replay(const LogEntry &entry) override;
+
+private:
+  BufferPoolManager &bpm_;
+};
@@ -13,10 +13,34 @@ See the Mulan PSL v2 for more details. */
 //
 
 #include "storage/index/index.h"
+#include "storage/index/bplus_tree_index.h"
+#include "storage/index/hash_index.h"
 
-RC Index::init(const IndexMeta &index_meta, const FieldMeta &field_meta)
+Index *Index::make(IndexType type)
 {
-  index_meta_ = index_meta;
-  field_meta_ = field_meta;
+  switch (type) {
+    case IndexType::BPLUS_TREE: return new BplusTreeIndex();
+    case IndexType::HASH: return new HashIndex();
+  }
+  return nullptr;
+}
+
+RC Index::init(const IndexMeta &index_meta, const std::vector<FieldMeta> &field_metas)
+{
+  index_meta_  = index_meta;
+  field_metas_ = field_metas;
   return RC::SUCCESS;
 }
+
+const char *Index::make_user_key(const char *record, std::vector<char> &buffer) const
+{
+  if (field_metas_.size() == 1) {
+    return record + field_metas_[0].offset();
+  }
+
+  buffer.clear();
+  for (const FieldMeta &field_meta : field_metas_) {
+    buffer.insert(buffer.end(), record + field_meta.offset(), record + field_meta.offset() + field_meta.len());
+  }
+  return buffer.data();
+}
@@ -23,6 +23,8 @@ See the Mulan PSL v2 for more details. */
 #include "storage/record/record_manager.h"
 
 class IndexScanner;
+class RecordFileScanner;
+class Table;
 
 /**
  * @brief 索引
@@ -40,8 +42,44 @@ public:
   Index()          = default;
   virtual ~Index() = default;
 
+  /**
+   * @brief 根据索引类型创建一个索引对象，之后再调用 create 或 open
+   * @details 新增索引类型时只需要修改这里，不支持的类型返回 nullptr
+   */
+  static Index *make(IndexType type);
+
+  /**
+   * @brief 创建一个新的索引文件
+   *
+   * @param table 索引所在的表
+   * @param file_name 索引文件名
+   * @param index_meta 索引的元数据
+   * @param field_metas 索引包含的字段，按照索引定义的顺序
+   */
+  virtual RC create(
+      Table *table, const char *file_name, const IndexMeta &index_meta, const std::vector<FieldMeta> &field_metas) = 0;
+
+  /**
+   * @brief 打开已经存在的索引文件，参数与 create 相同
+   */
+  virtual RC open(
+      Table *table, const char *file_name, const IndexMeta &index_meta, const std::vector<FieldMeta> &field_metas) = 0;
+
+  /**
+   * @brief 把表中已有的数据加载到刚创建的空索引中
+   * @details 不同的索引只使用需要的参数，比如哈希索引逐条插入，不需要排序
+   * @param scanner 表数据的扫描器
+   * @param fill_factor 节点的填充比例，百分比
+   * @param memory_limit 排序可以使用的内存，超过时使用临时文件
+   * @param temp_dir 临时文件存放的目录
+   */
+  virtual RC bulk_load(RecordFileScanner &scanner, int fill_factor, int64_t memory_limit, const char *temp_dir) = 0;
+
   const IndexMeta &index_meta() const { return index_meta_; }
 
+  /// @brief 索引包含的字段，组合索引的键值按照这个顺序拼接
+  const std::vector<FieldMeta> &field_metas() const { return field_metas_; }
+
   /**
    * @brief 插入一条数据
    *
@@ -61,15 +99,17 @@ public:
   /**
    * @brief 创建一个索引数据的扫描器
    *
+   * @details 组合索引的边界可以只包含最左边的几个字段，每个字段都是定义的长度，按照顺序拼接起来
    * @param left_key 要扫描的左边界
    * @param left_len 左边界的长度
    * @param left_inclusive 是否包含左边界
    * @param right_key 要扫描的右边界
    * @param right_len 右边界的长度
    * @param right_inclusive 是否包含右边界
+   * @param reverse 是否按照键值从大到小的顺序扫描
    */
   virtual IndexScanner *create_scanner(const char *left_key, int left_len, bool left_inclusive, const char *right_key,
-      int right_len, bool right_inclusive) = 0;
+      int right_len, bool right_inclusive, bool reverse = false) = 0;
 
   /**
    * @brief 同步索引数据到磁盘
@@ -78,11 +118,17 @@ public:
   virtual RC sync() = 0;
 
 protected:
-  RC init(const IndexMeta &index_meta, const FieldMeta &field_meta);
+  RC init(const IndexMeta &index_meta, const std::vector<FieldMeta> &field_metas);
+
+  /**
+   * @brief 从记录中取出索引的键值
+   * @details 单字段的索引直接返回记录中字段的位置，组合索引把各个字段拼接到 buffer 中
+   */
+  const char *make_user_key(const char *record, std::vector<char> &buffer) const;
 
 protected:
-  IndexMeta index_meta_;  ///< 索引的元数据
-  FieldMeta field_meta_;  ///< 当前实现仅考虑一个字段的索引
+  IndexMeta              index_meta_;   ///< 索引的元数据
+  std::vector<FieldMeta> field_metas_;  ///< 索引包含的字段
 };
 
 /**
@@ -101,4 +147,10 @@ public:
    */
   virtual RC next_entry(RID *rid) = 0;
   virtual RC destroy()            = 0;
+
+  /**
+   * @brief 遍历元素数据，同时返回索引字段的值
+   * @details 索引字段按照定义的顺序和长度拼接在 user_key 中，索引覆盖扫描时使用
+   */
+  virtual RC next_entry(RID *rid, char *user_key) { return RC::UNIMPLEMENTED; }
 };
@@ -23,25 +23,79 @@ See the Mulan PSL v2 for more details. */
 const static Json::StaticString FIELD_NAME("name");
 const static Json::StaticString FIELD_FIELD_NAME("field_name");
 const static Json::StaticString FIELD_UNIQUE_NAME("unique");
+const static Json::StaticString FIELD_PREFIX_COMPRESS("prefix_compress");
+const static Json::StaticString FIELD_INDEX_TYPE("type");
+
+const char *index_type_to_string(IndexType type)
+{
+  switch (type) {
+    case IndexType::BPLUS_TREE: return "BTREE";
+    case IndexType::HASH: return "HASH";
+    default: return "UNKNOWN";
+  }
+}
+
+RC index_type_from_string(const char *name, IndexType &type)
+{
+  if (0 == strcasecmp(name, "btree")) {
+    type = IndexType::BPLUS_TREE;
+  } else if (0 == strcasecmp(name, "hash")) {
+    type = IndexType::HASH;
+  } else {
+    return RC::INVALID_ARGUMENT;
+  }
+  return RC::SUCCESS;
+}
 
 RC IndexMeta::init(const char *name, const FieldMeta &field, const bool unique)
+{
+  return init(name, vector<const FieldMeta *>{&field}, unique);
+}
+
+RC IndexMeta::init(const char *name, const vector<const FieldMeta *> &fields, const bool unique,
+    const bool prefix_compressed, IndexType type)
 {
   if (common::is_blank(name)) {
     LOG_ERROR("Failed to init index, name is empty.");
     return RC::INVALID_ARGUMENT;
   }
 
-  name_   = name;
-  field_  = field.name();
-  unique_ = unique;
+  if (fields.empty()) {
+    LOG_ERROR("Failed to init index, no field. name=%s", name);
+    return RC::INVALID_ARGUMENT;
+  }
+
+  name_ = name;
+  fields_.clear();
+  for (const FieldMeta *field : fields) {
+    fields_.emplace_back(field->name());
+  }
+  unique_            = unique;
+  prefix_compressed_ = prefix_compressed;
+  type_              = type;
   return RC::SUCCESS;
 }
 
 void IndexMeta::to_json(Json::Value &json_value) const
 {
-  json_value[FIELD_NAME]        = name_;
-  json_value[FIELD_FIELD_NAME]  = field_;
+  json_value[FIELD_NAME] = name_;
+  // 单字段的索引仍然记录成字符串，与之前的格式保持一致
+  if (fields_.size() == 1) {
+    json_value[FIELD_FIELD_NAME] = fields_[0];
+  } else {
+    Json::Value fields_value;
+    for (const string &field : fields_) {
+      fields_value.append(field);
+    }
+    json_value[FIELD_FIELD_NAME] = std::move(fields_value);
+  }
   json_value[FIELD_UNIQUE_NAME] = unique_;
+  if (prefix_compressed_) {
+    json_value[FIELD_PREFIX_COMPRESS] = prefix_compressed_;
+  }
+  if (type_ != IndexType::BPLUS_TREE) {
+    json_value[FIELD_INDEX_TYPE] = index_type_to_string(type_);
+  }
 }
 
 RC IndexMeta::from_json(const TableMeta &table, const Json::Value &json_value, IndexMeta &index)
@@ -49,13 +103,17 @@ RC IndexMeta::from_json(const TableMeta &table, const Json::Value &json_value, I
   const Json::Value &name_value   = json_value[FIELD_NAME];
   const Json::Value &field_value  = json_value[FIELD_FIELD_NAME];
   const Json::Value &unique_value = json_value[FIELD_UNIQUE_NAME];
+  // 之前的元数据中没有这个字段，表示没有使用前缀压缩
+  const Json::Value &compress_value = json_value[FIELD_PREFIX_COMPRESS];
+  // 没有记录类型的都是B+树索引
+  const Json::Value &type_value = json_value[FIELD_INDEX_TYPE];
   if (!name_value.isString()) {
     LOG_ERROR("Index name is not a string. json value=%s", name_value.toStyledString().c_str());
     return RC::INTERNAL;
   }
 
-  if (!field_value.isString()) {
-    LOG_ERROR("Field name of index [%s] is not a string. json value=%s",
+  if (!field_value.isString() && !field_value.isArray()) {
+    LOG_ERROR("Field name of index [%s] is not a string or an array. json value=%s",
         name_value.asCString(), field_value.toStyledString().c_str());
     return RC::INTERNAL;
   }
@@ -66,19 +124,72 @@ RC IndexMeta::from_json(const TableMeta &table, const Json::Value &json_value, I
     return RC::INTERNAL;
   }
 
-  const FieldMeta *field = table.field(field_value.asCString());
-  if (nullptr == field) {
-    LOG_ERROR("Deserialize index [%s]: no such field: %s", name_value.asCString(), field_value.asCString());
-    return RC::SCHEMA_FIELD_MISSING;
+  if (!compress_value.isNull() && !compress_value.isBool()) {
+    LOG_ERROR("Prefix compress attribute of index [%s] is not a bool. json value=%s",
+        name_value.asCString(), compress_value.toStyledString().c_str());
+    return RC::INTERNAL;
+  }
+
+  IndexType type = IndexType::BPLUS_TREE;
+  if (!type_value.isNull() && (!type_value.isString() || OB_FAIL(index_type_from_string(type_value.asCString(), type)))) {
+    LOG_ERROR("Type of index [%s] is invalid. json value=%s",
+        name_value.asCString(), type_value.toStyledString().c_str());
+    return RC::INTERNAL;
+  }
+
+  vector<const char *> field_names;
+  if (field_value.isString()) {
+    field_names.push_back(field_value.asCString());
+  } else {
+    for (const Json::Value &value : field_value) {
+      if (!value.isString()) {
+        LOG_ERROR("Field name of index [%s] is not a string. json value=%s",
+            name_value.asCString(), value.toStyledString().c_str());
+        return RC::INTERNAL;
+      }
+      field_names.push_back(value.asCString());
+    }
+  }
+
+  vector<const FieldMeta *> fields;
+  for (const char *field_name : field_names) {
+    const FieldMeta *field = table.field(field_name);
+    if (nullptr == field) {
+      LOG_ERROR("Deserialize index [%s]: no such field: %s", name_value.asCString(), field_name);
+      return RC::SCHEMA_FIELD_MISSING;
+    }
+    fields.push_back(field);
   }
 
-  return index.init(name_value.asCString(), *field, unique_value.asBool());
+  return index.init(name_value.asCString(), fields, unique_value.asBool(),
+      compress_value.isBool() && compress_value.asBool(), type);
 }
 
 const char *IndexMeta::name() const { return name_.c_str(); }
 
-const char *IndexMeta::field() const { return field_.c_str(); }
+const char *IndexMeta::field() const { return fields_.empty() ? "" : fields_[0].c_str(); }
+
+const char *IndexMeta::field(int i) const { return fields_[i].c_str(); }
+
+int IndexMeta::field_num() const { return static_cast<int>(fields_.size()); }
 
 bool IndexMeta::is_unique() const { return unique_; }
 
-void IndexMeta::desc(ostream &os) const { os << "index name=" << name_ << ", field=" << field_ << ", unique=" << unique_; }
+bool IndexMeta::is_prefix_compressed() const { return prefix_compressed_; }
+
+IndexType IndexMeta::type() const { return type_; }
+
+void IndexMeta::desc(ostream &os) const
+{
+  os << "index name=" << name_ << ", field=";
+  for (size_t i = 0; i < fields_.size(); i++) {
+    os << (i > 0 ? "," : "") << fields_[i];
+  }
+  os << ", unique=" << unique_;
+  if (prefix_compressed_) {
+    os << ", prefix_compress=" << prefix_compressed_;
+  }
+  if (type_ != IndexType::BPLUS_TREE) {
+    os << ", type=" << index_type_to_string(type_);
+  }
+}
@@ -16,6 +16,7 @@ See the Mulan PSL v2 for more details. */
 
 #include "common/rc.h"
 #include "common/lang/string.h"
+#include "common/lang/vector.h"
 
 class TableMeta;
 class FieldMeta;
@@ -24,11 +25,27 @@ namespace Json {
 class Value;
 }  // namespace Json
 
+/**
+ * @brief 索引的类型
+ * @ingroup Index
+ */
+enum class IndexType
+{
+  BPLUS_TREE,  ///< B+树索引，支持范围扫描和按照键值顺序输出
+  HASH,        ///< 哈希索引，只支持所有字段上的等值查询
+};
+
+const char *index_type_to_string(IndexType type);
+
+/**
+ * @brief 根据名字获取索引类型，不区分大小写，btree 对应B+树索引，hash 对应哈希索引
+ */
+RC index_type_from_string(const char *name, IndexType &type);
+
 /**
  * @brief 描述一个索引
  * @ingroup Index
- * @details 一个索引包含了表的哪些字段，索引的名称等。
- * 如果以后实现了多种类型的索引，还需要记录索引的类型，对应类型的一些元数据等
+ * @details 一个索引包含了表的哪些字段，索引的名称、类型等。组合索引包含多个字段，按照创建索引时指定的顺序排列。
  */
 class IndexMeta
 {
@@ -36,11 +53,23 @@ public:
   IndexMeta() = default;
 
   RC init(const char *name, const FieldMeta &field, const bool unique);
+  /**
+   * @brief 初始化组合索引，字段的顺序就是键值中字段的顺序
+   * @param prefix_compressed B+树的叶子节点是否使用前缀压缩
+   * @param type 索引的类型
+   */
+  RC init(const char *name, const vector<const FieldMeta *> &fields, const bool unique,
+      const bool prefix_compressed = false, IndexType type = IndexType::BPLUS_TREE);
 
 public:
   const char *name() const;
+  /// @brief 第一个字段的名字
   const char *field() const;
+  const char *field(int i) const;
+  int         field_num() const;
   bool        is_unique() const;
+  bool        is_prefix_compressed() const;
+  IndexType   type() const;
 
   void desc(ostream &os) const;
 
@@ -49,7 +78,9 @@ public:
   static RC from_json(const TableMeta &table, const Json::Value &json_value, IndexMeta &index);
 
 protected:
-  string name_;   // index's name
-  string field_;  // field's name
-  bool   unique_; // if unique index
+  string         name_;    // index's name
+  vector<string> fields_;  // fields' name
+  bool           unique_;  // if unique index
+  bool           prefix_compressed_ = false;  // if leaf keys are prefix compressed
+  IndexType      type_ = IndexType::BPLUS_TREE;
 };
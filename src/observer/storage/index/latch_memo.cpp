@@ -48,11 +48,11 @@ RC LatchMemo::get_page(PageNum page_num, Frame *&frame)
   return RC::SUCCESS;
 }
 
-RC LatchMemo::allocate_page(Frame *&frame)
+RC LatchMemo::allocate_page(Frame *&frame, BufferRing *ring)
 {
   frame = nullptr;
 
-  RC rc = buffer_pool_->allocate_page(&frame);
+  RC rc = buffer_pool_->allocate_page(&frame, ring);
   if (rc == RC::SUCCESS) {
     items_.emplace_back(LatchMemoType::PIN, frame);
     ASSERT(frame->pin_count() == 1, "allocate a new frame. frame=%s", frame->to_string().c_str());
@@ -158,3 +158,15 @@ void LatchMemo::release_to(int point)
   }
   items_.erase(items_.begin(), iter);
 }
+
+void LatchMemo::release_from(int point)
+{
+  ASSERT(point >= 0 && point <= static_cast<int>(items_.size()), 
+         "invalid memo point. point=%d, items size=%d",
+         point, static_cast<int>(items_.size()));
+
+  for (int i = static_cast<int>(items_.size()) - 1; i >= point; i--) {
+    release_item(items_[i]);
+  }
+  items_.erase(items_.begin() + point, items_.end());
+}
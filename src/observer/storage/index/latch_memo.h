@@ -21,6 +21,7 @@ See the Mulan PSL v2 for more details. */
 
 class Frame;
 class DiskBufferPool;
+class BufferRing;
 
 namespace common {
 class SharedMutex;
@@ -59,8 +60,8 @@ public:
 
   RC get_page(PageNum page_num, Frame *&frame);
 
-  /// @brief 分配页面
-  RC allocate_page(Frame *&frame);
+  /// @brief 分配页面，批量构建时可以通过私有页帧环分配，参考 BufferRing
+  RC allocate_page(Frame *&frame, BufferRing *ring = nullptr);
 
   /// @brief 标记为即将释放的页面
   void dispose_page(PageNum page_num);
@@ -78,6 +79,9 @@ public:
 
   void release_to(int point);
 
+  /// @brief 释放 point 之后(包含 point)记录的所有锁和pin
+  void release_from(int point);
+
   int memo_point() const { return static_cast<int>(items_.size()); }
 
 private:
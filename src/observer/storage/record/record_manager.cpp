@@ -97,7 +97,8 @@ RC RecordPageIterator::next(Record &record)
 
 RecordPageHandler::~RecordPageHandler() { cleanup(); }
 
-RC RecordPageHandler::init(DiskBufferPool &buffer_pool, LogHandler &log_handler, PageNum page_num, ReadWriteMode mode)
+RC RecordPageHandler::init(
+    DiskBufferPool &buffer_pool, LogHandler &log_handler, PageNum page_num, ReadWriteMode mode, BufferRing *ring)
 {
   if (disk_buffer_pool_ != nullptr) {
     if (frame_->page_num() == page_num) {
@@ -109,7 +110,7 @@ RC RecordPageHandler::init(DiskBufferPool &buffer_pool, LogHandler &log_handler,
   }
 
   RC ret = RC::SUCCESS;
-  if ((ret = buffer_pool.get_this_page(page_num, &frame_)) != RC::SUCCESS) {
+  if ((ret = buffer_pool.get_this_page(page_num, &frame_, ring)) != RC::SUCCESS) {
     LOG_ERROR("Failed to get page handle from disk buffer pool. ret=%d:%s", ret, strrc(ret));
     return ret;
   }
@@ -193,9 +194,9 @@ RC RecordPageHandler::init_empty_page(
   bitmap_ = frame_->data() + PAGE_HEADER_SIZE;
   memset(bitmap_, 0, page_bitmap_size(page_header_->record_capacity));
   // column_index[i] store the end offset of column `i` or the start offset of column `i+1`
+  // NOTE: 页面中的列号是字段在 TableMeta 中的下标（包含系统字段），而不是 field_id
   int *column_index = reinterpret_cast<int *>(frame_->data() + page_header_->col_idx_offset);
   for (int i = 0; i < column_num; ++i) {
-    ASSERT(i == table_meta->field(i)->field_id(), "i should be the col_id of fields[i]");
     if (i == 0) {
       column_index[i] = table_meta->field(i)->len() * page_header_->record_capacity;
     } else {
@@ -424,8 +425,58 @@ bool RecordPageHandler::is_full() const { return page_header_->record_num >= pag
 
 RC PaxRecordPageHandler::insert_record(const char *data, RID *rid)
 {
-  // your code here
-  exit(-1);
+  ASSERT(rw_mode_ != ReadWriteMode::READ_ONLY, 
+         "cannot insert record into page while the page is readonly");
+
+  if (page_header_->record_num == page_header_->record_capacity) {
+    LOG_WARN("Page is full, page_num %d:%d.", disk_buffer_pool_->file_desc(), frame_->page_num());
+    return RC::RECORD_NOMEM;
+  }
+
+  // 找到空闲位置
+  Bitmap bitmap(bitmap_, page_header_->record_capacity);
+  int    index = bitmap.next_unsetted_bit(0);
+  bitmap.set_bit(index);
+  page_header_->record_num++;
+
+  RC rc = log_handler_.insert_record(frame_, RID(get_page_num(), index), data);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to insert record. page_num %d:%d. rc=%s", disk_buffer_pool_->file_desc(), frame_->page_num(), strrc(rc));
+    // return rc; // ignore errors
+  }
+
+  // 按列拆分记录，写入各列对应的区域
+  scatter_record(index, data);
+  frame_->mark_dirty();
+
+  if (rid) {
+    rid->page_num = get_page_num();
+    rid->slot_num = index;
+  }
+
+  return RC::SUCCESS;
+}
+
+RC PaxRecordPageHandler::recover_insert_record(const char *data, const RID &rid)
+{
+  if (rid.slot_num >= page_header_->record_capacity) {
+    LOG_WARN("slot_num illegal, slot_num(%d) > record_capacity(%d).", rid.slot_num, page_header_->record_capacity);
+    return RC::RECORD_INVALID_RID;
+  }
+
+  // 更新位图
+  Bitmap bitmap(bitmap_, page_header_->record_capacity);
+  if (!bitmap.get_bit(rid.slot_num)) {
+    bitmap.set_bit(rid.slot_num);
+    page_header_->record_num++;
+  }
+
+  // 恢复数据
+  scatter_record(rid.slot_num, data);
+
+  frame_->mark_dirty();
+
+  return RC::SUCCESS;
 }
 
 RC PaxRecordPageHandler::delete_record(const RID *rid)
@@ -452,17 +503,126 @@ RC PaxRecordPageHandler::delete_record(const RID *rid)
   }
 }
 
+RC PaxRecordPageHandler::update_record(const RID &rid, const char *data)
+{
+  ASSERT(rw_mode_ != ReadWriteMode::READ_ONLY, "Cannot update record on a read-only page");
+
+  if (rid.slot_num >= page_header_->record_capacity) {
+    LOG_ERROR("Invalid slot_num %d; exceeds page's record capacity. frame=%s, page_header=%s",
+              rid.slot_num, frame_->to_string().c_str(), page_header_->to_string().c_str());
+    return RC::INVALID_ARGUMENT;
+  }
+
+  Bitmap bitmap(bitmap_, page_header_->record_capacity);
+  if (!bitmap.get_bit(rid.slot_num)) {
+    LOG_DEBUG("Invalid slot_num %d; slot is empty. page_num %d.", rid.slot_num, frame_->page_num());
+    return RC::RECORD_NOT_EXIST;
+  }
+
+  frame_->mark_dirty();
+  scatter_record(rid.slot_num, data);
+
+  RC rc = log_handler_.update_record(frame_, rid, data);
+  if (OB_FAIL(rc)) {
+    LOG_ERROR("Failed to update record. page_num %d:%d. rc=%s",
+              disk_buffer_pool_->file_desc(), frame_->page_num(), strrc(rc));
+  }
+  return RC::SUCCESS;
+}
+
 RC PaxRecordPageHandler::get_record(const RID &rid, Record &record)
 {
-  // your code here
-  exit(-1);
+  if (rid.slot_num >= page_header_->record_capacity) {
+    LOG_ERROR("Invalid slot_num %d, exceed page's record capacity, frame=%s, page_header=%s",
+              rid.slot_num, frame_->to_string().c_str(), page_header_->to_string().c_str());
+    return RC::RECORD_INVALID_RID;
+  }
+
+  Bitmap bitmap(bitmap_, page_header_->record_capacity);
+  if (!bitmap.get_bit(rid.slot_num)) {
+    LOG_ERROR("Invalid slot_num:%d, slot is empty, page_num %d.", rid.slot_num, frame_->page_num());
+    return RC::RECORD_NOT_EXIST;
+  }
+
+  // PAX 页面中同一条记录的各列不连续，需要组装成一条完整的记录
+  RC rc = record.new_record(page_header_->record_real_size);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to allocate record. rc=%s", strrc(rc));
+    return rc;
+  }
+
+  int offset = 0;
+  for (int col_id = 0; col_id < page_header_->column_num; ++col_id) {
+    const int field_len = get_field_len(col_id);
+    memcpy(record.data() + offset, get_field_data(rid.slot_num, col_id), field_len);
+    offset += field_len;
+  }
+  record.set_rid(rid);
+  return RC::SUCCESS;
 }
 
-// TODO: specify the column_ids that chunk needed. currenly we get all columns
 RC PaxRecordPageHandler::get_chunk(Chunk &chunk)
 {
-  // your code here
-  exit(-1);
+  const int record_num      = page_header_->record_num;
+  const int record_capacity = page_header_->record_capacity;
+
+  // 如果有效记录都连续存放在页面的前部（没有删除造成的空洞），可以直接引用页面上的列数据，
+  // 不需要拷贝。页面在 ChunkFileScanner 获取下一个 chunk 之前一直是 pin 住的。
+  Bitmap    bitmap(bitmap_, record_capacity);
+  const int first_free = bitmap.next_unsetted_bit(0);
+  const bool contiguous = (first_free == -1 || first_free >= record_num);
+
+  for (int i = 0; i < chunk.column_num(); ++i) {
+    const int col_id = chunk.column_ids(i);
+    if (col_id < 0 || col_id >= page_header_->column_num) {
+      LOG_WARN("invalid column id %d, column num of page is %d", col_id, page_header_->column_num);
+      return RC::INVALID_ARGUMENT;
+    }
+
+    Column   &column    = chunk.column(i);
+    const int field_len = get_field_len(col_id);
+    if (column.attr_len() != field_len) {
+      LOG_WARN("column length mismatch. col_id=%d, column len=%d, field len=%d", col_id, column.attr_len(), field_len);
+      return RC::INVALID_ARGUMENT;
+    }
+
+    if (contiguous) {
+      column.reference(get_field_data(0, col_id), record_num);
+      continue;
+    }
+
+    // 有空洞时，按连续的有效槽位分段拷贝
+    if (!column.own() || column.capacity() < record_num) {
+      column.init(column.attr_type(), field_len, record_capacity);
+    } else {
+      column.reset_data();
+    }
+
+    int start = bitmap.next_setted_bit(0);
+    while (start != -1) {
+      int end = bitmap.next_unsetted_bit(start);
+      if (end == -1) {
+        end = record_capacity;
+      }
+      RC rc = column.append(get_field_data(start, col_id), end - start);
+      if (OB_FAIL(rc)) {
+        LOG_WARN("failed to append data to column. col_id=%d, rc=%s", col_id, strrc(rc));
+        return rc;
+      }
+      start = (end < record_capacity) ? bitmap.next_setted_bit(end) : -1;
+    }
+  }
+  return RC::SUCCESS;
+}
+
+void PaxRecordPageHandler::scatter_record(SlotNum slot_num, const char *data)
+{
+  int offset = 0;
+  for (int col_id = 0; col_id < page_header_->column_num; ++col_id) {
+    const int field_len = get_field_len(col_id);
+    memcpy(get_field_data(slot_num, col_id), data + offset, field_len);
+    offset += field_len;
+  }
 }
 
 char *PaxRecordPageHandler::get_field_data(SlotNum slot_num, int col_id)
@@ -527,12 +687,14 @@ RC RecordFileHandler::init_free_pages()
   BufferPoolIterator bp_iterator;
   bp_iterator.init(*disk_buffer_pool_, 1);
   unique_ptr<RecordPageHandler> record_page_handler(RecordPageHandler::create(storage_format_));
+  unique_ptr<BufferRing>        buffer_ring      = disk_buffer_pool_->make_buffer_ring();
   PageNum                       current_page_num = 0;
 
   while (bp_iterator.has_next()) {
     current_page_num = bp_iterator.next();
 
-    rc = record_page_handler->init(*disk_buffer_pool_, *log_handler_, current_page_num, ReadWriteMode::READ_ONLY);
+    rc = record_page_handler->init(
+        *disk_buffer_pool_, *log_handler_, current_page_num, ReadWriteMode::READ_ONLY, buffer_ring.get());
     if (rc != RC::SUCCESS) {
       LOG_WARN("failed to init record page handler. page num=%d, rc=%d:%s", current_page_num, rc, strrc(rc));
       return rc;
@@ -547,7 +709,7 @@ RC RecordFileHandler::init_free_pages()
   return rc;
 }
 
-RC RecordFileHandler::insert_record(const char *data, int record_size, RID *rid)
+RC RecordFileHandler::insert_record(const char *data, int record_size, RID *rid, BufferRing *ring)
 {
   RC ret = RC::SUCCESS;
 
@@ -562,7 +724,8 @@ RC RecordFileHandler::insert_record(const char *data, int record_size, RID *rid)
   while (!free_pages_.empty()) {
     current_page_num = *free_pages_.begin();
 
-    ret = record_page_handler->init(*disk_buffer_pool_, *log_handler_, current_page_num, ReadWriteMode::READ_WRITE);
+    ret = record_page_handler->init(
+        *disk_buffer_pool_, *log_handler_, current_page_num, ReadWriteMode::READ_WRITE, ring);
     if (OB_FAIL(ret)) {
       lock_.unlock();
       LOG_WARN("failed to init record page handler. page num=%d, rc=%d:%s", current_page_num, ret, strrc(ret));
@@ -581,7 +744,7 @@ RC RecordFileHandler::insert_record(const char *data, int record_size, RID *rid)
   // 找不到就分配一个新的页面
   if (!page_found) {
     Frame *frame = nullptr;
-    if ((ret = disk_buffer_pool_->allocate_page(&frame)) != RC::SUCCESS) {
+    if ((ret = disk_buffer_pool_->allocate_page(&frame, ring)) != RC::SUCCESS) {
       LOG_ERROR("Failed to allocate page while inserting record. ret:%d", ret);
       return ret;
     }
@@ -691,6 +854,44 @@ RC RecordFileHandler::get_record(const RID &rid, Record &record)
   return rc;
 }
 
+RC RecordFileHandler::get_records(span<const RID> rids, vector<Record> &records)
+{
+  unique_ptr<RecordPageHandler> page_handler(RecordPageHandler::create(storage_format_));
+
+  records.clear();
+  records.reserve(rids.size());
+
+  RC      rc       = RC::SUCCESS;
+  PageNum page_num = BP_INVALID_PAGE_NUM;
+  for (const RID &rid : rids) {
+    if (rid.page_num != page_num) {
+      rc = page_handler->init(*disk_buffer_pool_, *log_handler_, rid.page_num, ReadWriteMode::READ_ONLY);
+      if (OB_FAIL(rc)) {
+        LOG_ERROR("Failed to init record page handler.page number=%d", rid.page_num);
+        return rc;
+      }
+      page_num = rid.page_num;
+    }
+
+    Record inplace_record;
+    rc = page_handler->get_record(rid, inplace_record);
+    if (RC::RECORD_NOT_EXIST == rc) {
+      // 读取索引之后记录可能已经被删除了
+      LOG_TRACE("record has been deleted. rid=%s", rid.to_string().c_str());
+      continue;
+    }
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to get record from record page handle. rid=%s, rc=%s", rid.to_string().c_str(), strrc(rc));
+      return rc;
+    }
+
+    Record &record = records.emplace_back();
+    record.copy_data(inplace_record.data(), inplace_record.len());
+    record.set_rid(rid);
+  }
+  return RC::SUCCESS;
+}
+
 RC RecordFileHandler::visit_record(const RID &rid, function<bool(Record &)> updater)
 {
   unique_ptr<RecordPageHandler> page_handler(RecordPageHandler::create(storage_format_));
@@ -721,6 +922,33 @@ RC RecordFileHandler::visit_record(const RID &rid, function<bool(Record &)> upda
   return rc;
 }
 
+RC RecordFileHandler::visit_page_records(PageNum page_num, function<bool(const Record &)> visitor)
+{
+  unique_ptr<RecordPageHandler> page_handler(RecordPageHandler::create(storage_format_));
+
+  RC rc = page_handler->init(*disk_buffer_pool_, *log_handler_, page_num, ReadWriteMode::READ_ONLY);
+  if (OB_FAIL(rc)) {
+    LOG_WARN("failed to init record page handler. page num=%d, rc=%s", page_num, strrc(rc));
+    return rc;
+  }
+
+  RecordPageIterator iterator;
+  iterator.init(page_handler.get());
+
+  Record record;
+  while (iterator.has_next()) {
+    rc = iterator.next(record);
+    if (OB_FAIL(rc)) {
+      LOG_WARN("failed to get record from page. page num=%d, rc=%s", page_num, strrc(rc));
+      return rc;
+    }
+    if (!visitor(record)) {
+      break;
+    }
+  }
+  return RC::SUCCESS;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 RecordFileScanner::~RecordFileScanner() { close_scan(); }
@@ -741,6 +969,7 @@ RC RecordFileScanner::open_scan(Table *table, DiskBufferPool &buffer_pool, Trx *
     LOG_WARN("failed to init bp iterator. rc=%d:%s", rc, strrc(rc));
     return rc;
   }
+  buffer_ring_      = buffer_pool.make_buffer_ring();
   condition_filter_ = condition_filter;
   if (table == nullptr || table->table_meta().storage_format() == StorageFormat::ROW_FORMAT) {
     record_page_handler_ = new RowRecordPageHandler();
@@ -775,7 +1004,7 @@ RC RecordFileScanner::fetch_next_record()
   while (bp_iterator_.has_next()) {
     PageNum page_num = bp_iterator_.next();
     record_page_handler_->cleanup();
-    rc = record_page_handler_->init(*disk_buffer_pool_, *log_handler_, page_num, rw_mode_);
+    rc = record_page_handler_->init(*disk_buffer_pool_, *log_handler_, page_num, rw_mode_, buffer_ring_.get());
     if (OB_FAIL(rc)) {
       LOG_WARN("failed to init record page handler. page_num=%d, rc=%s", page_num, strrc(rc));
       return rc;
@@ -850,6 +1079,7 @@ RC RecordFileScanner::close_scan()
     delete record_page_handler_;
     record_page_handler_ = nullptr;
   }
+  buffer_ring_.reset();
 
   return RC::SUCCESS;
 }
@@ -887,6 +1117,7 @@ RC ChunkFileScanner::close_scan()
     delete record_page_handler_;
     record_page_handler_ = nullptr;
   }
+  buffer_ring_.reset();
 
   return RC::SUCCESS;
 }
@@ -906,6 +1137,7 @@ RC ChunkFileScanner::open_scan_chunk(
     LOG_WARN("failed to init bp iterator. rc=%d:%s", rc, strrc(rc));
     return rc;
   }
+  buffer_ring_ = buffer_pool.make_buffer_ring();
   if (table == nullptr || table->table_meta().storage_format() == StorageFormat::ROW_FORMAT) {
     record_page_handler_ = new RowRecordPageHandler();
   } else {
@@ -922,7 +1154,7 @@ RC ChunkFileScanner::next_chunk(Chunk &chunk)
   while (bp_iterator_.has_next()) {
     PageNum page_num = bp_iterator_.next();
     record_page_handler_->cleanup();
-    rc = record_page_handler_->init(*disk_buffer_pool_, *log_handler_, page_num, rw_mode_);
+    rc = record_page_handler_->init(*disk_buffer_pool_, *log_handler_, page_num, rw_mode_, buffer_ring_.get());
     if (OB_FAIL(rc)) {
       LOG_WARN("failed to init record page handler. page_num=%d, rc=%s", page_num, strrc(rc));
       return rc;
@@ -15,7 +15,9 @@ See the Mulan PSL v2 for more details. */
 #pragma once
 
 #include "common/lang/bitmap.h"
+#include "common/lang/span.h"
 #include "common/lang/sstream.h"
+#include "common/lang/unordered_set.h"
 #include "storage/buffer/disk_buffer_pool.h"
 #include "storage/common/chunk.h"
 #include "storage/record/record.h"
@@ -135,8 +137,10 @@ public:
    * @param buffer_pool 关联某个文件时，都通过buffer pool来做读写文件
    * @param page_num    当前处理哪个页面
    * @param mode        是否只读。在访问页面时，需要对页面加锁
+   * @param ring        批量访问时使用的私有页帧环，参考 BufferRing
    */
-  RC init(DiskBufferPool &buffer_pool, LogHandler &log_handler, PageNum page_num, ReadWriteMode mode);
+  RC init(DiskBufferPool &buffer_pool, LogHandler &log_handler, PageNum page_num, ReadWriteMode mode,
+      BufferRing *ring = nullptr);
 
   /**
    * @brief 数据库恢复时，与普通的运行场景有所不同，不做任何并发操作，也不需要加锁
@@ -324,8 +328,12 @@ public:
    */
   virtual RC insert_record(const char *data, RID *rid) override;
 
+  virtual RC recover_insert_record(const char *data, const RID &rid) override;
+
   virtual RC delete_record(const RID *rid) override;
 
+  virtual RC update_record(const RID &rid, const char *data) override;
+
   /**
    * @brief 获取指定位置的记录数据
    *
@@ -338,11 +346,16 @@ public:
   /**
    * @brief 以 Chunk 格式获取整个页面中指定列的所有记录。
    *
-   * @param chunk 由 chunk.column(i).col_id() 指定列。
+   * @param chunk 由 chunk.column_ids(i) 指定列。
+   * @details 如果页面中没有空洞，Column 直接引用页面内存，不会拷贝数据，此时需要保证页面在使用期间是 pin 住的；
+   * 否则按照位图将有效的列值拷贝到 Column 中。
    */
   virtual RC get_chunk(Chunk &chunk) override;
 
 private:
+  // split the row-format `data` into columns and write them to `slot_num`
+  void scatter_record(SlotNum slot_num, const char *data);
+
   // get the field data by `slot_num` and `column id`
   char *get_field_data(SlotNum slot_num, int col_id);
 
@@ -385,8 +398,9 @@ public:
    * @param data        纪录内容
    * @param record_size 记录大小
    * @param rid         返回该记录的标识符
+   * @param ring        批量插入(比如LOAD DATA)时使用的私有页帧环，写满的页面在环中回收，不会挤占共享缓存
    */
-  RC insert_record(const char *data, int record_size, RID *rid);
+  RC insert_record(const char *data, int record_size, RID *rid, BufferRing *ring = nullptr);
 
   /**
    * @brief 更新一个记录到指定文件中
@@ -407,8 +421,21 @@ public:
 
   RC get_record(const RID &rid, Record &record);
 
+  /**
+   * @brief 批量读取记录
+   * @details rids 需要按照页面排好序，每个页面只加载一次。已经不存在的记录会被跳过
+   * @param records 返回读取到的记录，数据都是复制出来的
+   */
+  RC get_records(span<const RID> rids, vector<Record> &records);
+
   RC visit_record(const RID &rid, function<bool(Record &)> updater);
 
+  /**
+   * @brief 在页面锁保护的情况下遍历页面上的所有记录
+   * @param visitor 返回false时停止遍历
+   */
+  RC visit_page_records(PageNum page_num, function<bool(const Record &)> visitor);
+
 private:
   /**
    * @brief 初始化当前没有填满记录的页面，初始化free_pages_成员
@@ -486,6 +513,7 @@ private:
   RecordPageHandler *record_page_handler_ = nullptr;  ///< 处理文件某页面的记录
   RecordPageIterator record_page_iterator_;           ///< 遍历某个页面上的所有record
   Record             next_record_;                    ///< 获取的记录放在这里缓存起来
+  unique_ptr<BufferRing> buffer_ring_;                ///< 扫描大表时使用私有页帧环，避免冲掉共享缓存
 };
 
 /**
@@ -521,4 +549,5 @@ private:
 
   BufferPoolIterator bp_iterator_;                    ///< 遍历buffer pool的所有页面
   RecordPageHandler *record_page_handler_ = nullptr;  ///< 处理文件某页面的记录
+  unique_ptr<BufferRing> buffer_ring_;                ///< 扫描大表时使用私有页帧环，避免冲掉共享缓存
 };
@@ -0,0 +1,78 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/lang/algorithm.h"
+#include "common/lang/functional.h"
+
+/**
+ * @brief 只保存在内存中、随着事务提交更新的状态的公共部分
+ * @details 状态第一次使用时(比如重启之后)扫描数据计算一次，之后只记录还没有提交的修改个数，
+ * 以及修改过数据的最大提交事务号。有未提交的修改，或者有读事务看不到的已提交修改时，状态对这个读事务不可用。
+ * VisibilityMap 和 RowCounter 的状态从这里派生，加锁由使用者负责。
+ */
+struct CommitTracker
+{
+  int     pending = 0;      ///< 还没有提交的修改个数
+  bool    loaded  = false;  ///< 是否已经扫描数据计算过
+  int32_t max_xid = 0;      ///< 修改过数据的最大提交事务号
+
+  /// @brief 将要修改数据，在修改之前调用
+  void begin_change() { pending++; }
+
+  /// @brief 修改已经提交
+  void commit_change(int32_t commit_xid)
+  {
+    if (pending > 0) {
+      pending--;
+    }
+    max_xid = max(max_xid, commit_xid);
+  }
+
+  /// @brief 修改已经回滚
+  void rollback_change()
+  {
+    if (pending > 0) {
+      pending--;
+    }
+  }
+
+  /// @brief 所有已经提交的修改对读事务是否可见
+  bool visible_to(int32_t read_xid) const { return max_xid <= read_xid; }
+
+  /**
+   * @brief 没有未提交的修改时，保证状态已经计算过
+   * @details loader 计算出的状态替换掉 state 中派生类的字段，max_xid 取两者中较大的
+   * @param loader 扫描数据计算状态，有未提交的数据、结果不能缓存时返回false
+   * @return 有未提交的修改或者没法计算时返回false
+   */
+  template <typename State>
+  static bool load_once(State &state, const function<bool(State &)> &loader)
+  {
+    if (state.pending > 0) {
+      return false;
+    }
+    if (state.loaded) {
+      return true;
+    }
+
+    State loaded_state;
+    if (!loader(loaded_state)) {
+      return false;
+    }
+
+    const int32_t max_xid = max(state.max_xid, loaded_state.max_xid);
+    state                 = loaded_state;
+    state.loaded          = true;
+    state.max_xid         = max_xid;
+    return true;
+  }
+};
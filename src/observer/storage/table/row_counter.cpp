@@ -0,0 +1,50 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "storage/table/row_counter.h"
+
+void RowCounter::begin_change()
+{
+  lock_guard<common::Mutex> guard(lock_);
+  state_.begin_change();
+}
+
+void RowCounter::commit_change(int32_t commit_xid, int64_t delta)
+{
+  lock_guard<common::Mutex> guard(lock_);
+  state_.commit_change(commit_xid);
+  // 还没有计算过时，计算的结果中已经包含了这次修改
+  if (state_.loaded) {
+    state_.rows += delta;
+  }
+}
+
+void RowCounter::rollback_change()
+{
+  lock_guard<common::Mutex> guard(lock_);
+  state_.rollback_change();
+}
+
+void RowCounter::reset()
+{
+  lock_guard<common::Mutex> guard(lock_);
+  state_ = State();
+}
+
+bool RowCounter::count(int32_t read_xid, const Loader &loader, int64_t &rows)
+{
+  // 修改记录之前会先调用 begin_change，计算时持有锁就不会漏掉或重复计算正在进行的修改
+  lock_guard<common::Mutex> guard(lock_);
+  if (!CommitTracker::load_once(state_, loader) || !state_.visible_to(read_xid)) {
+    return false;
+  }
+  rows = state_.rows;
+  return true;
+}
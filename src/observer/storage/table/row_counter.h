@@ -0,0 +1,61 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/lang/functional.h"
+#include "common/lang/mutex.h"
+#include "storage/table/commit_tracker.h"
+
+/**
+ * @brief 维护表中已经提交的记录条数
+ * @details 没有过滤条件的 COUNT(*) 直接使用这里的行数，不需要扫描全表。
+ * 与 VisibilityMap 一样使用 CommitTracker，第一次使用时扫描全表计算出来，之后随着事务提交更新。
+ */
+class RowCounter
+{
+public:
+  struct State : public CommitTracker
+  {
+    int64_t rows = 0;  ///< 已经提交的记录条数
+  };
+
+  /**
+   * @brief 扫描全表计算记录条数
+   * @return 表中没有未提交的数据，计算出的状态可以缓存下来时返回true
+   */
+  using Loader = function<bool(State &)>;
+
+public:
+  RowCounter()  = default;
+  ~RowCounter() = default;
+
+  /// @brief 将要插入或删除记录，在修改记录之前调用
+  void begin_change();
+  /// @brief 修改已经提交
+  /// @param delta 记录条数的变化，插入是正数，删除是负数
+  void commit_change(int32_t commit_xid, int64_t delta);
+  /// @brief 修改已经回滚
+  void rollback_change();
+  /// @brief 忘记记录条数，下次使用时重新计算。恢复数据时使用
+  void reset();
+
+  /**
+   * @brief 获取指定的事务可以看到的记录条数
+   * @param read_xid 读数据的事务号，所有修改的提交事务号都不能大于它
+   * @param loader 记录条数未知时用来计算
+   * @return 行数不可用时返回false，需要扫描全表
+   */
+  bool count(int32_t read_xid, const Loader &loader, int64_t &rows);
+
+private:
+  common::Mutex lock_;
+  State         state_;
+};
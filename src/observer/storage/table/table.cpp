@@ -35,7 +35,6 @@ See the Mulan PSL v2 for more details. */
 #include "storage/common/meta_util.h"
 #include "storage/field/field.h"
 #include "storage/field/field_meta.h"
-#include "storage/index/bplus_tree_index.h"
 #include "storage/index/index.h"
 #include "storage/record/record_manager.h"
 #include "storage/table/table.h"
@@ -292,20 +291,28 @@ RC Table::open(Db *db, const char *meta_file, const char *base_dir)
 
   const int index_num = table_meta_.index_num();
   for (int i = 0; i < index_num; i++) {
-    const IndexMeta *index_meta = table_meta_.index(i);
-    const FieldMeta *field_meta = table_meta_.field(index_meta->field());
-    if (field_meta == nullptr) {
-      LOG_ERROR("Found invalid index meta info which has a non-exists field. table=%s, index=%s, field=%s",
-                name(), index_meta->name(), index_meta->field());
-      // skip cleanup
-      //  do all cleanup action in destructive Table function
-      return RC::INTERNAL;
+    const IndexMeta  *index_meta = table_meta_.index(i);
+    vector<FieldMeta> index_fields;
+    for (int j = 0; j < index_meta->field_num(); j++) {
+      const FieldMeta *field_meta = table_meta_.field(index_meta->field(j));
+      if (field_meta == nullptr) {
+        LOG_ERROR("Found invalid index meta info which has a non-exists field. table=%s, index=%s, field=%s",
+                  name(), index_meta->name(), index_meta->field(j));
+        // skip cleanup
+        //  do all cleanup action in destructive Table function
+        return RC::INTERNAL;
+      }
+      index_fields.push_back(*field_meta);
     }
 
-    BplusTreeIndex *index      = new BplusTreeIndex();
-    string          index_file = table_index_file(base_dir, name(), index_meta->name());
+    Index *index = Index::make(index_meta->type());
+    if (index == nullptr) {
+      LOG_ERROR("Unsupported index type. table=%s, index=%s", name(), index_meta->name());
+      return RC::INTERNAL;
+    }
 
-    rc = index->open(this, index_file.c_str(), *index_meta, *field_meta);
+    string index_file = table_index_file(base_dir, name(), index_meta->name());
+    rc                = index->open(this, index_file.c_str(), *index_meta, index_fields);
     if (rc != RC::SUCCESS) {
       delete index;
       LOG_ERROR("Failed to open index. table=%s, index=%s, file=%s, rc=%s",
@@ -320,15 +327,18 @@ RC Table::open(Db *db, const char *meta_file, const char *base_dir)
   return rc;
 }
 
-RC Table::insert_record(Record &record)
+RC Table::insert_record(Record &record, BufferRing *ring)
 {
   RC rc = RC::SUCCESS;
-  rc    = record_handler_->insert_record(record.data(), table_meta_.record_size(), &record.rid());
+  rc    = record_handler_->insert_record(record.data(), table_meta_.record_size(), &record.rid(), ring);
   if (rc != RC::SUCCESS) {
     LOG_ERROR("Insert record failed. table name=%s, rc=%s", table_meta_.name(), strrc(rc));
     return rc;
   }
 
+  // 必须在插入索引之前标记，否则索引覆盖扫描可能会直接使用还没有提交的数据
+  visibility_map_.begin_change(record.rid().page_num);
+
   rc = insert_entry_of_indexes(record.data(), record.rid());
   if (rc != RC::SUCCESS) {  // 可能出现了键值重复
     RC rc2 = delete_entry_of_indexes(record.data(), record.rid(), false /*error_on_not_exists*/);
@@ -341,6 +351,7 @@ RC Table::insert_record(Record &record)
       LOG_PANIC("Failed to rollback record data when insert index entries failed. table name=%s, rc=%d:%s",
                 name(), rc2, strrc(rc2));
     }
+    visibility_map_.rollback_change(record.rid().page_num);
   }
   return rc;
 }
@@ -350,6 +361,11 @@ RC Table::visit_record(const RID &rid, function<bool(Record &)> visitor)
   return record_handler_->visit_record(rid, visitor);
 }
 
+RC Table::visit_page_records(PageNum page_num, function<bool(const Record &)> visitor)
+{
+  return record_handler_->visit_page_records(page_num, visitor);
+}
+
 RC Table::get_record(const RID &rid, Record &record)
 {
   RC rc = record_handler_->get_record(rid, record);
@@ -554,59 +570,64 @@ RC Table::get_chunk_scanner(ChunkFileScanner &scanner, Trx *trx, ReadWriteMode m
   return rc;
 }
 
-RC Table::create_index(Trx *trx, const FieldMeta *field_meta, const char *index_name, bool unique)
+RC Table::create_index(Trx *trx, const vector<const FieldMeta *> &field_metas, const char *index_name, bool unique,
+    int fill_factor, int64_t sort_memory, bool prefix_compressed, IndexType index_type)
 {
-  if (common::is_blank(index_name) || nullptr == field_meta) {
+  if (common::is_blank(index_name) || field_metas.empty() ||
+      find(field_metas.begin(), field_metas.end(), nullptr) != field_metas.end()) {
     LOG_INFO("Invalid input arguments, table name is %s, index_name is blank or attribute_name is blank", name());
     return RC::INVALID_ARGUMENT;
   }
 
   IndexMeta new_index_meta;
 
-  RC rc = new_index_meta.init(index_name, *field_meta, unique);
+  RC rc = new_index_meta.init(index_name, field_metas, unique, prefix_compressed, index_type);
   if (rc != RC::SUCCESS) {
     LOG_INFO("Failed to init IndexMeta in table:%s, index_name:%s, field_name:%s", 
-             name(), index_name, field_meta->name());
+             name(), index_name, field_metas.front()->name());
     return rc;
   }
 
+  vector<FieldMeta> index_fields;
+  for (const FieldMeta *field_meta : field_metas) {
+    index_fields.push_back(*field_meta);
+  }
+
   // 创建索引相关数据
-  BplusTreeIndex *index      = new BplusTreeIndex();
-  string          index_file = table_index_file(base_dir_.c_str(), name(), index_name);
+  Index *index = Index::make(index_type);
+  if (index == nullptr) {
+    LOG_WARN("Unsupported index type. table=%s, index=%s", name(), index_name);
+    return RC::UNSUPPORTED;
+  }
 
-  rc = index->create(this, index_file.c_str(), new_index_meta, *field_meta);
+  string index_file = table_index_file(base_dir_.c_str(), name(), index_name);
+  rc                = index->create(this, index_file.c_str(), new_index_meta, index_fields);
   if (rc != RC::SUCCESS) {
     delete index;
-    LOG_ERROR("Failed to create bplus tree index. file name=%s, rc=%d:%s", index_file.c_str(), rc, strrc(rc));
+    LOG_ERROR("Failed to create %s index. file name=%s, rc=%d:%s",
+              index_type_to_string(index_type), index_file.c_str(), rc, strrc(rc));
     return rc;
   }
 
-  // 遍历当前的所有数据，插入这个索引
+  // 遍历当前的所有数据，B+树排序后批量构建这个索引，哈希索引逐条插入
+  // 与插入数据时一样，所有版本的记录都要放到索引中，不能只加入对当前事务可见的记录
   RecordFileScanner scanner;
-  rc = get_record_scanner(scanner, trx, ReadWriteMode::READ_ONLY);
+  rc = get_record_scanner(scanner, nullptr /*trx*/, ReadWriteMode::READ_ONLY);
   if (rc != RC::SUCCESS) {
     LOG_WARN("failed to create scanner while creating index. table=%s, index=%s, rc=%s", 
              name(), index_name, strrc(rc));
     return rc;
   }
 
-  Record record;
-  while (OB_SUCC(rc = scanner.next(record))) {
-    rc = index->insert_entry(record.data(), &record.rid());
-    if (rc != RC::SUCCESS) {
-      LOG_WARN("failed to insert record into index while creating index. table=%s, index=%s, rc=%s",
-               name(), index_name, strrc(rc));
-      return rc;
-    }
-  }
-  if (RC::RECORD_EOF == rc) {
-    rc = RC::SUCCESS;
-  } else {
-    LOG_WARN("failed to insert record into index while creating index. table=%s, index=%s, rc=%s",
+  rc = index->bulk_load(scanner, fill_factor, sort_memory, base_dir_.c_str());
+  scanner.close_scan();
+  if (rc != RC::SUCCESS) {
+    LOG_WARN("failed to bulk load index while creating index. table=%s, index=%s, rc=%s",
              name(), index_name, strrc(rc));
+    delete index;
+    ::remove(index_file.c_str());
     return rc;
   }
-  scanner.close_scan();
   LOG_INFO("inserted all records into new index. table=%s, index=%s", name(), index_name);
 
   indexes_.push_back(index);
@@ -726,6 +747,9 @@ RC Table::update_record(Record &record, Field const &field, Value const &value)
   }
   */
 
+  // 原地修改没有维护索引，也没有多版本，索引覆盖扫描不能再直接使用这个页面上的索引数据
+  visibility_map_.mark_dead(record.rid().page_num);
+
   rc = record_handler_->update_record(record.data(), &record.rid());
   if (OB_FAIL(rc)) {
     LOG_ERROR("failed to update record: %s", strrc(rc));
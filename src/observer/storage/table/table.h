@@ -15,6 +15,8 @@ See the Mulan PSL v2 for more details. */
 #pragma once
 
 #include "storage/table/table_meta.h"
+#include "storage/table/row_counter.h"
+#include "storage/table/visibility_map.h"
 #include "common/types.h"
 #include "common/lang/span.h"
 #include "common/lang/functional.h"
@@ -23,6 +25,7 @@ See the Mulan PSL v2 for more details. */
 struct RID;
 class Record;
 class DiskBufferPool;
+class BufferRing;
 using text_t = size_t;
 class TextBufferPool;
 class RecordFileHandler;
@@ -86,8 +89,9 @@ public:
    * @brief 在当前的表中插入一条记录
    * @details 在表文件和索引中插入关联数据。这里只管在表中插入数据，不关心事务相关操作。
    * @param record[in/out] 传入的数据包含具体的数据，插入成功会通过此字段返回RID
+   * @param ring 批量导入数据时使用的私有页帧环，只作用于表数据文件，参考 BufferRing
    */
-  RC insert_record(Record &record);
+  RC insert_record(Record &record, BufferRing *ring = nullptr);
   RC delete_record(const Record &record);
   RC delete_record(const RID &rid);
   RC update_record(Record &record, Field const &field, Value const &value);
@@ -102,13 +106,24 @@ public:
   RC recover_insert_record(Record &record);
 
   // TODO refactor
-  RC create_index(Trx *trx, const FieldMeta *field_meta, const char *index_name, bool unique);
+  /**
+   * @brief 创建索引
+   * @param field_metas 索引包含的字段，多个字段时创建组合索引
+   * @param fill_factor 批量构建索引时节点的填充比例，百分比
+   * @param sort_memory 批量构建索引时排序可以使用的内存
+   * @param prefix_compressed 叶子节点是否使用前缀压缩，只支持单个字符串字段的索引
+   * @param index_type 索引的类型，B+树或者哈希
+   */
+  RC create_index(Trx *trx, const vector<const FieldMeta *> &field_metas, const char *index_name, bool unique,
+      int fill_factor = 90, int64_t sort_memory = 64 * 1024 * 1024, bool prefix_compressed = false,
+      IndexType index_type = IndexType::BPLUS_TREE);
 
   RC get_record_scanner(RecordFileScanner &scanner, Trx *trx, ReadWriteMode mode);
 
   RC get_chunk_scanner(ChunkFileScanner &scanner, Trx *trx, ReadWriteMode mode);
 
   RecordFileHandler *record_handler() const { return record_handler_; }
+  DiskBufferPool    *data_buffer_pool() const { return data_buffer_pool_; }
 
   /**
    * @brief 可以在页面锁保护的情况下访问记录
@@ -119,6 +134,22 @@ public:
    */
   RC visit_record(const RID &rid, function<bool(Record &)> visitor);
 
+  /**
+   * @brief 在页面锁保护的情况下访问某个页面上的所有记录
+   * @param visitor 返回false时停止访问
+   */
+  RC visit_page_records(PageNum page_num, function<bool(const Record &)> visitor);
+
+  /**
+   * @brief 页面上的数据是否对所有事务可见，索引覆盖扫描时使用
+   */
+  VisibilityMap &visibility_map() { return visibility_map_; }
+
+  /**
+   * @brief 表中已经提交的记录条数，没有过滤条件的 COUNT(*) 使用
+   */
+  RowCounter &row_counter() { return row_counter_; }
+
 public:
   int32_t     table_id() const { return table_meta_.table_id(); }
   const char *name() const;
@@ -141,6 +172,7 @@ private:
 public:
   Index *find_index(const char *index_name) const;
   Index *find_index_by_field(const char *field_name) const;
+  const vector<Index *> &indexes() const { return indexes_; }
 
 private:
   Db                *db_ = nullptr;
@@ -150,4 +182,6 @@ private:
   TextBufferPool    *text_buffer_pool_ = nullptr;  /// text文件关联的buffer pool
   RecordFileHandler *record_handler_   = nullptr;  /// 记录操作
   vector<Index *>    indexes_;
+  VisibilityMap      visibility_map_;
+  RowCounter         row_counter_;
 };
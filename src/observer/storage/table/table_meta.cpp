@@ -121,7 +121,8 @@ const FieldMeta *TableMeta::null_field() const { return &fields_[0]; }
 
 span<const FieldMeta> TableMeta::trx_fields() const
 {
-  return span<const FieldMeta>(fields_.data(), sys_field_num());
+  // 第一个系统字段是记录NULL的位图，事务字段在它后面
+  return span<const FieldMeta>(fields_.data() + 1, trx_fields_.size());
 }
 
 const FieldMeta *TableMeta::field(int index) const { return &fields_[index]; }
@@ -278,13 +279,13 @@ int TableMeta::deserialize(std::istream &is)
   fields_.swap(fields);
   record_size_ = fields_.back().offset() + fields_.back().len() - fields_.begin()->offset();
 
-  /*
-  for (const FieldMeta &field_meta : fields_) {
-    if (!field_meta.visible()) {
-      trx_fields_.push_back(field_meta); // 字段加上trx标识更好
+  // 第一个字段是记录NULL的位图，其它不可见的字段都是事务字段
+  trx_fields_.clear();
+  for (size_t i = 1; i < fields_.size(); i++) {
+    if (!fields_[i].visible()) {
+      trx_fields_.push_back(fields_[i]);  // 字段加上trx标识更好
     }
   }
-  */
 
   const Json::Value &indexes_value = table_value[FIELD_INDEXES];
   if (!indexes_value.empty()) {
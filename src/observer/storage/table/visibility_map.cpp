@@ -0,0 +1,61 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "storage/table/visibility_map.h"
+
+void VisibilityMap::begin_change(PageNum page_num)
+{
+  lock_guard<common::Mutex> guard(lock_);
+  pages_[page_num].begin_change();
+}
+
+void VisibilityMap::commit_change(PageNum page_num, int32_t commit_xid, bool deleted)
+{
+  lock_guard<common::Mutex> guard(lock_);
+  PageState &state = pages_[page_num];
+  state.commit_change(commit_xid);
+  state.dead = state.dead || deleted;
+}
+
+void VisibilityMap::rollback_change(PageNum page_num)
+{
+  lock_guard<common::Mutex> guard(lock_);
+  pages_[page_num].rollback_change();
+}
+
+void VisibilityMap::mark_dead(PageNum page_num)
+{
+  lock_guard<common::Mutex> guard(lock_);
+  pages_[page_num].dead = true;
+}
+
+void VisibilityMap::reset(PageNum page_num)
+{
+  lock_guard<common::Mutex> guard(lock_);
+  pages_.erase(page_num);
+}
+
+bool VisibilityMap::all_visible(PageNum page_num, int32_t read_xid, const Loader &loader)
+{
+  // 计算页面状态时也要持有锁，否则可能把计算之后才开始的修改覆盖掉
+  lock_guard<common::Mutex> guard(lock_);
+  PageState &state = pages_[page_num];
+  if (state.dead || !CommitTracker::load_once(state, loader)) {
+    return false;
+  }
+  return !state.dead && state.visible_to(read_xid);
+}
+
+bool VisibilityMap::is_dead(PageNum page_num) const
+{
+  lock_guard<common::Mutex> guard(lock_);
+  auto iter = pages_.find(page_num);
+  return iter != pages_.end() && iter->second.dead;
+}
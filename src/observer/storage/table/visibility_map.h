@@ -0,0 +1,67 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#pragma once
+
+#include "common/lang/functional.h"
+#include "common/lang/mutex.h"
+#include "common/lang/unordered_map.h"
+#include "common/types.h"
+#include "storage/table/commit_tracker.h"
+
+/**
+ * @brief 记录表中每个页面上的数据是否对所有事务可见
+ * @details 索引覆盖扫描时，如果记录所在页面上的数据都已经提交并且没有被删除或修改过，
+ * 就可以直接使用索引中的字段值，不需要再读取记录判断可见性。
+ * 这些信息只保存在内存中，每个页面一个 CommitTracker，页面第一次被访问时(比如重启之后)扫描页面上的记录计算出来。
+ */
+class VisibilityMap
+{
+public:
+  struct PageState : public CommitTracker
+  {
+    bool dead = false;  ///< 页面上有被删除或者原地修改过的记录，索引中的值不一定可信
+  };
+
+  /**
+   * @brief 扫描页面上的记录计算页面状态
+   * @return 页面上没有未提交的数据，计算出的状态可以缓存下来时返回true
+   */
+  using Loader = function<bool(PageState &)>;
+
+public:
+  VisibilityMap()  = default;
+  ~VisibilityMap() = default;
+
+  /// @brief 页面上的记录将要被修改，在修改记录或者插入索引之前调用
+  void begin_change(PageNum page_num);
+  /// @brief 修改已经提交
+  void commit_change(PageNum page_num, int32_t commit_xid, bool deleted);
+  /// @brief 修改已经回滚
+  void rollback_change(PageNum page_num);
+  /// @brief 页面上的记录被直接修改了，索引中的值不再可信
+  void mark_dead(PageNum page_num);
+  /// @brief 忘记页面的状态，下次访问时重新计算。恢复数据时使用
+  void reset(PageNum page_num);
+
+  /**
+   * @brief 页面上的所有数据是否对指定的事务可见
+   * @param read_xid 读数据的事务号，所有记录的提交事务号都不能大于它
+   * @param loader 页面状态未知时用来计算状态
+   */
+  bool all_visible(PageNum page_num, int32_t read_xid, const Loader &loader);
+
+  /// @brief 页面上是否有被删除或修改过的记录
+  bool is_dead(PageNum page_num) const;
+
+private:
+  mutable common::Mutex              lock_;
+  unordered_map<PageNum, PageState> pages_;
+};
@@ -134,8 +134,10 @@ RC MvccTrx::insert_record(Table *table, Record &record)
   begin_field.set_int(record, -trx_id_);
   end_field.set_int(record, trx_kit_.max_trx_id());
 
+  table->row_counter().begin_change();
   RC rc = table->insert_record(record);
   if (rc != RC::SUCCESS) {
+    table->row_counter().rollback_change();
     LOG_WARN("failed to insert record into table. rc=%s", strrc(rc));
     return rc;
   }
@@ -156,6 +158,10 @@ RC MvccTrx::delete_record(Table *table, Record &record)
 
   RC delete_result = RC::SUCCESS;
 
+  // 先标记页面上有未提交的修改，索引覆盖扫描就会读取记录判断可见性
+  table->visibility_map().begin_change(record.rid().page_num);
+  table->row_counter().begin_change();
+
   RC rc = table->visit_record(record.rid(), [this, table, &delete_result, &end_field](Record &inplace_record) -> bool {
     RC rc = this->visit_record(table, inplace_record, ReadWriteMode::READ_WRITE);
     if (OB_FAIL(rc)) {
@@ -167,6 +173,11 @@ RC MvccTrx::delete_record(Table *table, Record &record)
     return true;
   });
 
+  if (OB_FAIL(rc) || OB_FAIL(delete_result)) {
+    table->visibility_map().rollback_change(record.rid().page_num);
+    table->row_counter().rollback_change();
+  }
+
   if (OB_FAIL(rc)) {
     LOG_WARN("failed to visit record. rc=%s", strrc(rc));
     return rc;
@@ -260,6 +271,89 @@ void MvccTrx::trx_fields(Table *table, Field &begin_xid_field, Field &end_xid_fi
   end_xid_field.set_field(&trx_fields[1]);
 }
 
+bool MvccTrx::is_page_all_visible(Table *table, PageNum page_num)
+{
+  Field begin_xid_field;
+  Field end_xid_field;
+  trx_fields(table, begin_xid_field, end_xid_field);
+
+  const int32_t max_trx_id = trx_kit_.max_trx_id();
+  auto loader = [table, page_num, max_trx_id, &begin_xid_field, &end_xid_field](VisibilityMap::PageState &state) {
+    bool uncommitted = false;
+    RC   rc          = table->visit_page_records(page_num, [&](const Record &record) {
+      const int32_t begin_xid = begin_xid_field.get_int(record);
+      const int32_t end_xid   = end_xid_field.get_int(record);
+      if (begin_xid < 0 || end_xid < 0) {
+        uncommitted = true;
+        return false;
+      }
+      state.dead    = state.dead || end_xid != max_trx_id;
+      state.max_xid = max(state.max_xid, begin_xid);
+      return true;
+    });
+    return OB_SUCC(rc) && !uncommitted;
+  };
+  return table->visibility_map().all_visible(page_num, trx_id_, loader);
+}
+
+bool MvccTrx::count_visible_rows(Table *table, int64_t &rows)
+{
+  Field begin_xid_field;
+  Field end_xid_field;
+  trx_fields(table, begin_xid_field, end_xid_field);
+
+  // 计算的是对所有已提交的修改都可见的事务能看到的行数，已经提交删除的记录不计算在内
+  const int32_t max_trx_id = trx_kit_.max_trx_id();
+  auto loader = [table, max_trx_id, &begin_xid_field, &end_xid_field](RowCounter::State &state) {
+    RecordFileScanner scanner;
+    RC                rc = table->get_record_scanner(scanner, nullptr, ReadWriteMode::READ_ONLY);
+    if (OB_FAIL(rc)) {
+      return false;
+    }
+
+    bool   uncommitted = false;
+    Record record;
+    while (!uncommitted && OB_SUCC(rc = scanner.next(record))) {
+      const int32_t begin_xid = begin_xid_field.get_int(record);
+      const int32_t end_xid   = end_xid_field.get_int(record);
+      if (begin_xid < 0 || end_xid < 0) {
+        uncommitted = true;
+      } else if (begin_xid > 0 && end_xid > 0 && end_xid != max_trx_id) {
+        state.max_xid = max(state.max_xid, end_xid);
+      } else {
+        state.max_xid = max(state.max_xid, begin_xid);
+        state.rows++;
+      }
+    }
+    scanner.close_scan();
+    return !uncommitted && rc == RC::RECORD_EOF;
+  };
+  return table->row_counter().count(trx_id_, loader, rows);
+}
+
+void MvccTrx::commit_visibility(Table *table, PageNum page_num, int32_t commit_xid, bool deleted)
+{
+  // 恢复时没有记录修改开始的位置，让页面和行数下次访问时重新计算
+  if (recovering_) {
+    table->visibility_map().reset(page_num);
+    table->row_counter().reset();
+  } else {
+    table->visibility_map().commit_change(page_num, commit_xid, deleted);
+    table->row_counter().commit_change(commit_xid, deleted ? -1 : 1);
+  }
+}
+
+void MvccTrx::rollback_visibility(Table *table, PageNum page_num)
+{
+  if (recovering_) {
+    table->visibility_map().reset(page_num);
+    table->row_counter().reset();
+  } else {
+    table->visibility_map().rollback_change(page_num);
+    table->row_counter().rollback_change();
+  }
+}
+
 RC MvccTrx::start_if_need()
 {
   if (!started_) {
@@ -305,6 +399,7 @@ RC MvccTrx::commit_with_trx_id(int32_t commit_xid)
         rc = operation.table()->visit_record(rid, record_updater);
         ASSERT(rc == RC::SUCCESS, "failed to get record while committing. rid=%s, rc=%s",
                rid.to_string().c_str(), strrc(rc));
+        commit_visibility(table, rid.page_num, commit_xid, false /*deleted*/);
       } break;
 
       case Operation::Type::DELETE: {
@@ -327,6 +422,7 @@ RC MvccTrx::commit_with_trx_id(int32_t commit_xid)
         rc = operation.table()->visit_record(rid, record_updater);
         ASSERT(rc == RC::SUCCESS, "failed to get record while committing. rid=%s, rc=%s",
                rid.to_string().c_str(), strrc(rc));
+        commit_visibility(table, rid.page_num, commit_xid, true /*deleted*/);
       } break;
 
       default: {
@@ -379,6 +475,7 @@ RC MvccTrx::rollback()
         rc = table->delete_record(rid);
         ASSERT(rc == RC::SUCCESS, "failed to delete record while rollback. rid=%s, rc=%s",
                rid.to_string().c_str(), strrc(rc));
+        rollback_visibility(table, rid.page_num);
       } break;
 
       case Operation::Type::DELETE: {
@@ -406,6 +503,7 @@ RC MvccTrx::rollback()
         rc = table->visit_record(rid, record_updater);
         ASSERT(rc == RC::SUCCESS, "failed to get record while committing. rid=%s, rc=%s",
                rid.to_string().c_str(), strrc(rc));
+        rollback_visibility(table, rid.page_num);
       } break;
 
       default: {
@@ -91,6 +91,12 @@ public:
    */
   RC visit_record(Table *table, Record &record, ReadWriteMode mode) override;
 
+  /**
+   * @brief 页面上的数据都已经提交、没有被删除，并且提交事务号不大于当前事务号时，都是可见的
+   */
+  bool is_page_all_visible(Table *table, PageNum page_num) override;
+  bool count_visible_rows(Table *table, int64_t &rows) override;
+
   RC start_if_need() override;
   RC commit() override;
   RC rollback() override;
@@ -103,6 +109,10 @@ private:
   RC   commit_with_trx_id(int32_t commit_id);
   void trx_fields(Table *table, Field &begin_xid_field, Field &end_xid_field) const;
 
+  /// @brief 事务结束时更新页面的可见性信息
+  void commit_visibility(Table *table, PageNum page_num, int32_t commit_xid, bool deleted);
+  void rollback_visibility(Table *table, PageNum page_num);
+
 private:
   static const int32_t MAX_TRX_ID = numeric_limits<int32_t>::max();
 
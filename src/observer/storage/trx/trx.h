@@ -147,6 +147,18 @@ public:
   virtual RC delete_record(Table *table, Record &record)                    = 0;
   virtual RC visit_record(Table *table, Record &record, ReadWriteMode mode) = 0;
 
+  /**
+   * @brief 页面上的所有数据是否都对当前事务可见
+   * @details 索引覆盖扫描时使用，都可见时可以直接使用索引中的值，不需要再读取记录
+   */
+  virtual bool is_page_all_visible(Table *table, PageNum page_num) { return false; }
+
+  /**
+   * @brief 获取表中对当前事务可见的记录条数
+   * @details 没有过滤条件的 COUNT(*) 使用，不能直接得到时返回false，需要扫描全表
+   */
+  virtual bool count_visible_rows(Table *table, int64_t &rows) { return false; }
+
   virtual RC start_if_need() = 0;
   virtual RC commit()        = 0;
   virtual RC rollback()      = 0;
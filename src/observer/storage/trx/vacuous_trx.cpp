@@ -13,6 +13,7 @@ See the Mulan PSL v2 for more details. */
 //
 
 #include "storage/trx/vacuous_trx.h"
+#include "common/lang/limits.h"
 
 RC VacuousTrxKit::init() { return RC::SUCCESS; }
 
@@ -32,12 +33,58 @@ LogReplayer *VacuousTrxKit::create_log_replayer(Db &, LogHandler &) { return new
 
 ////////////////////////////////////////////////////////////////////////////////
 
-RC VacuousTrx::insert_record(Table *table, Record &record) { return table->insert_record(record); }
-
-RC VacuousTrx::delete_record(Table *table, Record &record) { return table->delete_record(record); }
+RC VacuousTrx::insert_record(Table *table, Record &record)
+{
+  // 没有事务，修改完成就相当于提交了
+  table->row_counter().begin_change();
+  RC rc = table->insert_record(record);
+  if (OB_SUCC(rc)) {
+    table->visibility_map().commit_change(record.rid().page_num, 0, false /*deleted*/);
+    table->row_counter().commit_change(0, 1);
+  } else {
+    table->row_counter().rollback_change();
+  }
+  return rc;
+}
+
+RC VacuousTrx::delete_record(Table *table, Record &record)
+{
+  table->row_counter().begin_change();
+  RC rc = table->delete_record(record);
+  if (OB_SUCC(rc)) {
+    table->row_counter().commit_change(0, -1);
+  } else {
+    table->row_counter().rollback_change();
+  }
+  return rc;
+}
 
 RC VacuousTrx::visit_record(Table *table, Record &record, ReadWriteMode) { return RC::SUCCESS; }
 
+bool VacuousTrx::is_page_all_visible(Table *table, PageNum page_num)
+{
+  return !table->visibility_map().is_dead(page_num);
+}
+
+bool VacuousTrx::count_visible_rows(Table *table, int64_t &rows)
+{
+  auto loader = [table](RowCounter::State &state) {
+    RecordFileScanner scanner;
+    RC                rc = table->get_record_scanner(scanner, nullptr, ReadWriteMode::READ_ONLY);
+    if (OB_FAIL(rc)) {
+      return false;
+    }
+
+    Record record;
+    while (OB_SUCC(rc = scanner.next(record))) {
+      state.rows++;
+    }
+    scanner.close_scan();
+    return rc == RC::RECORD_EOF;
+  };
+  return table->row_counter().count(numeric_limits<int32_t>::max(), loader, rows);
+}
+
 RC VacuousTrx::start_if_need() { return RC::SUCCESS; }
 
 RC VacuousTrx::commit() { return RC::SUCCESS; }
@@ -47,6 +47,8 @@ public:
   RC insert_record(Table *table, Record &record) override;
   RC delete_record(Table *table, Record &record) override;
   RC visit_record(Table *table, Record &record, ReadWriteMode mode) override;
+  bool is_page_all_visible(Table *table, PageNum page_num) override;
+  bool count_visible_rows(Table *table, int64_t &rows) override;
   RC start_if_need() override;
   RC commit() override;
   RC rollback() override;
@@ -16,7 +16,7 @@ See the Mulan PSL v2 for more details. */
 
 using namespace std;
 
-TEST(AggregateHashTableTest, DISABLED_standard_hash_table)
+TEST(AggregateHashTableTest, standard_hash_table)
 {
   // single group by column, single aggregate column
   {
@@ -101,6 +101,42 @@ TEST(AggregateHashTableTest, DISABLED_standard_hash_table)
                 << "sum(aggr2): " << output_chunk.get_value(3, i).get_string() << std::endl;
     }
   }
+  // rows filtered out by the selection vector are skipped
+  {
+    Chunk                   group_chunk;
+    Chunk                   aggr_chunk;
+    std::unique_ptr<Column> column1 = std::make_unique<Column>(AttrType::INTS, 4);
+    std::unique_ptr<Column> column2 = std::make_unique<Column>(AttrType::INTS, 4);
+    std::vector<uint8_t>    select;
+    for (int i = 0; i < 100; i++) {
+      int key = i % 2;
+      column1->append_one((char *)&key);
+      column2->append_one((char *)&i);
+      select.push_back(i < 10 ? 1 : 0);
+    }
+    group_chunk.add_column(std::move(column1), 0);
+    aggr_chunk.add_column(std::move(column2), 1);
+    group_chunk.set_select(select);
+
+    AggregateExpr             aggregate_expr(AggregateExpr::Type::SUM, nullptr);
+    std::vector<Expression *> aggregate_exprs;
+    aggregate_exprs.push_back(&aggregate_expr);
+    auto standard_hash_table = std::make_unique<StandardAggregateHashTable>(aggregate_exprs);
+    ASSERT_EQ(standard_hash_table->add_chunk(group_chunk, aggr_chunk), RC::SUCCESS);
+
+    Chunk output_chunk;
+    output_chunk.add_column(make_unique<Column>(AttrType::INTS, 4), 0);
+    output_chunk.add_column(make_unique<Column>(AttrType::INTS, 4), 1);
+    StandardAggregateHashTable::Scanner scanner(standard_hash_table.get());
+    scanner.open_scan();
+    ASSERT_EQ(scanner.next(output_chunk), RC::SUCCESS);
+    ASSERT_EQ(output_chunk.rows(), 2);
+    for (int i = 0; i < 2; i++) {
+      int key = output_chunk.get_value(0, i).get_int();
+      // sum of 0,2,4,6,8 and 1,3,5,7,9
+      ASSERT_EQ(output_chunk.get_value(1, i).get_int(), key == 0 ? 20 : 25);
+    }
+  }
 }
 
 #ifdef USE_SIMD
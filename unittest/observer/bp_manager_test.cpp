@@ -12,6 +12,7 @@ See the Mulan PSL v2 for more details. */
 // Created by wangyunlai.wyl on 2021
 //
 
+#include "common/lang/thread.h"
 #include "storage/buffer/disk_buffer_pool.h"
 #include "gtest/gtest.h"
 
@@ -125,6 +126,130 @@ TEST(test_frame_manager, test_frame_manager_simple_lru)
   frame_manager.cleanup();
 }
 
+TEST(test_frame_manager, test_frame_manager_single_shard)
+{
+  BPFrameManager frame_manager("Test", 1 /*shard_num*/);
+  ASSERT_EQ(1, frame_manager.shard_num());
+  frame_manager.init(2);
+
+  test_get(frame_manager);
+
+  test_alloc(frame_manager);
+
+  frame_manager.cleanup();
+}
+
+TEST(test_frame_manager, test_frame_manager_replacers)
+{
+  for (FrameReplacerType type : {FrameReplacerType::CLOCK, FrameReplacerType::TWO_QUEUE}) {
+    BPFrameManager frame_manager("Test", BPFrameManager::DEFAULT_SHARD_NUM, type);
+    ASSERT_EQ(type, frame_manager.replacer_type());
+    frame_manager.init(2);
+
+    test_get(frame_manager);
+
+    test_alloc(frame_manager);
+
+    frame_manager.cleanup();
+  }
+}
+
+class FrameManagerPurgeTest : public testing::TestWithParam<FrameReplacerType>
+{};
+
+TEST_P(FrameManagerPurgeTest, purge)
+{
+  BPFrameManager frame_manager("Test", 4 /*shard_num*/, GetParam());
+  frame_manager.init(1);
+
+  const int    buffer_pool_id = 0;
+  const size_t total          = frame_manager.total_frame_num();
+
+  // 页面不会均匀地分布在各个分片中，某个分片的空闲页帧用完以后要从其它分片中取
+  for (size_t i = 0; i < total; i++) {
+    Frame *frame = frame_manager.alloc(buffer_pool_id, i);
+    ASSERT_NE(frame, nullptr);
+    if (i % 2 == 0) {
+      frame->unpin();
+    }
+  }
+  ASSERT_EQ(nullptr, frame_manager.alloc(buffer_pool_id, total));
+
+  // 只能淘汰没有被pin住的页面
+  auto purger = [](Frame *frame) { return RC::SUCCESS; };
+  ASSERT_EQ(static_cast<int>(total / 2), frame_manager.purge_frames(static_cast<int>(total), purger));
+  ASSERT_EQ(total / 2, frame_manager.frame_num());
+  for (size_t i = 0; i < total; i++) {
+    Frame *frame = frame_manager.get(buffer_pool_id, i);
+    if (i % 2 == 0) {
+      ASSERT_EQ(nullptr, frame);
+    } else {
+      ASSERT_NE(nullptr, frame);
+      frame->unpin();
+    }
+  }
+
+  ASSERT_EQ(0, frame_manager.purge_frames(1, [](Frame *frame) { return RC::IOERR_WRITE; }));
+
+  // 分配时pin住的页面，get又pin了一次
+  for (size_t i = 1; i < total; i += 2) {
+    Frame *frame = frame_manager.get(buffer_pool_id, i);
+    frame->unpin();
+    ASSERT_EQ(RC::SUCCESS, frame_manager.free(buffer_pool_id, i, frame));
+  }
+  ASSERT_EQ(0UL, frame_manager.frame_num());
+  frame_manager.cleanup();
+}
+
+INSTANTIATE_TEST_SUITE_P(test_frame_manager, FrameManagerPurgeTest,
+    testing::Values(FrameReplacerType::LRU, FrameReplacerType::CLOCK, FrameReplacerType::TWO_QUEUE));
+
+TEST(test_frame_manager, test_frame_manager_concurrency)
+{
+  BPFrameManager frame_manager("Test");
+  frame_manager.init(2);
+
+  const int thread_num     = 8;
+  const int page_num       = 64;
+  const int round_num      = 2000;
+  auto      worker         = [&frame_manager](int buffer_pool_id) {
+    for (int round = 0; round < round_num; round++) {
+      const PageNum page = round % page_num;
+      Frame        *frame = frame_manager.get(buffer_pool_id, page);
+      if (frame == nullptr) {
+        frame = frame_manager.alloc(buffer_pool_id, page);
+        ASSERT_NE(frame, nullptr);
+      }
+      ASSERT_EQ(buffer_pool_id, frame->buffer_pool_id());
+      ASSERT_EQ(page, frame->page_num());
+      if (round % 3 == 0) {
+        frame->unpin();
+      } else {
+        // 别的线程不会访问同一个 buffer pool 的页面，只有自己pin着这个页面
+        ASSERT_EQ(RC::SUCCESS, frame_manager.free(buffer_pool_id, page, frame));
+      }
+    }
+  };
+
+  vector<thread> threads;
+  for (int i = 0; i < thread_num; i++) {
+    threads.emplace_back(worker, i);
+  }
+  for (thread &t : threads) {
+    t.join();
+  }
+
+  for (int i = 0; i < thread_num; i++) {
+    list<Frame *> frames = frame_manager.find_list(i);
+    for (Frame *frame : frames) {
+      ASSERT_EQ(i, frame->buffer_pool_id());
+      ASSERT_EQ(RC::SUCCESS, frame_manager.free(i, frame->page_num(), frame));
+    }
+  }
+  ASSERT_EQ(0UL, frame_manager.frame_num());
+  frame_manager.cleanup();
+}
+
 int main(int argc, char **argv)
 {
 
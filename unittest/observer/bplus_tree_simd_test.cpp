@@ -0,0 +1,121 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "common/lang/limits.h"
+#include "common/lang/vector.h"
+#include "common/math/simd_util.h"
+#include "storage/index/bplus_tree.h"
+#include "gtest/gtest.h"
+
+using namespace std;
+
+// B+树节点内的顺序查找开启 USE_SIMD 时使用 mm256_count_less_epi32/ps，
+// 这里用不同的间隔和个数构造节点中的键值，比较它们与标量实现(TypedAttrComparator)的结果是否一致。
+// 默认编译不开启 USE_SIMD，需要使用 -DUSE_SIMD=ON 编译才会执行。
+#ifdef USE_SIMD
+
+namespace {
+
+/// 键值后面跟着RID或者组合索引的其它字段
+const int STRIDES[] = {4, 12, 20, 36};
+
+template <typename T>
+vector<char> make_items(const vector<T> &keys, int stride)
+{
+  vector<char> items(keys.size() * stride + sizeof(T), 0x5a);
+  for (size_t i = 0; i < keys.size(); i++) {
+    memcpy(items.data() + i * stride, &keys[i], sizeof(T));
+  }
+  return items;
+}
+
+/// 与 count_less_attrs 中的标量实现相同
+template <AttrType TYPE, typename T>
+int scalar_count_less(const char *first, int stride, int size, T value)
+{
+  char key[sizeof(T)];
+  memcpy(key, &value, sizeof(T));
+  int count = 0;
+  while (count < size && TypedAttrComparator<TYPE>::compare(first + count * stride, key, sizeof(T)) < 0) {
+    count++;
+  }
+  return count;
+}
+
+}  // namespace
+
+TEST(BplusTreeSimdTest, count_less_epi32)
+{
+  for (int stride : STRIDES) {
+    for (int size = 0; size <= 40; size++) {
+      // 有序并且有重复的键值，包含最小值和最大值
+      vector<int> keys;
+      for (int i = 0; i < size; i++) {
+        keys.push_back((i - size / 2) / 2 * 3);
+      }
+      if (size > 2) {
+        keys.front() = numeric_limits<int>::min();
+        keys.back()  = numeric_limits<int>::max();
+      }
+      vector<char> items = make_items(keys, stride);
+
+      vector<int> targets = {numeric_limits<int>::min(), numeric_limits<int>::max(), 0};
+      for (int key : keys) {
+        targets.push_back(key);
+        targets.push_back(key - 1);
+        targets.push_back(key + 1);
+      }
+
+      for (int target : targets) {
+        ASSERT_EQ(scalar_count_less<AttrType::INTS>(items.data(), stride, size, target),
+            mm256_count_less_epi32(items.data(), stride, size, target))
+            << "stride=" << stride << ", size=" << size << ", target=" << target;
+      }
+    }
+  }
+}
+
+TEST(BplusTreeSimdTest, count_less_ps)
+{
+  const float epsilon = static_cast<float>(EPSILON);
+  for (int stride : STRIDES) {
+    for (int size = 0; size <= 40; size++) {
+      // 相邻的键值有相同的，也有差距小于 epsilon 的
+      vector<float> keys;
+      for (int i = 0; i < size; i++) {
+        keys.push_back((i / 3) * 1.5f - 10.0f + (i % 3 == 2 ? epsilon / 4 : 0.0f));
+      }
+      vector<char> items = make_items(keys, stride);
+
+      vector<float> targets = {-1e30f, 1e30f, 0.0f};
+      for (float key : keys) {
+        targets.push_back(key);
+        targets.push_back(key - epsilon / 2);
+        targets.push_back(key + epsilon / 2);
+        targets.push_back(key - 0.5f);
+        targets.push_back(key + 0.5f);
+      }
+
+      for (float target : targets) {
+        ASSERT_EQ(scalar_count_less<AttrType::FLOATS>(items.data(), stride, size, target),
+            mm256_count_less_ps(items.data(), stride, size, target, epsilon))
+            << "stride=" << stride << ", size=" << size << ", target=" << target;
+      }
+    }
+  }
+}
+
+#endif  // USE_SIMD
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -19,9 +19,11 @@ See the Mulan PSL v2 for more details. */
 #include "common/log/log.h"
 #include "common/lang/memory.h"
 #include "common/lang/filesystem.h"
+#include "common/lang/thread.h"
 #include "sql/parser/parse_defs.h"
 #include "storage/buffer/disk_buffer_pool.h"
 #include "storage/index/bplus_tree.h"
+#include "storage/index/bplus_tree_bulk_loader.h"
 #include "storage/clog/vacuous_log_handler.h"
 #include "storage/buffer/double_write_buffer.h"
 #include "gtest/gtest.h"
@@ -793,6 +795,724 @@ TEST(test_bplus_tree, test_scanner)
   handler.close();
 }
 
+TEST(test_bplus_tree, test_composite_key)
+{
+  LoggerFactory::init_default("test_composite_key.log");
+
+  VacuousLogHandler log_handler;
+
+  filesystem::path test_directory("bplus_tree");
+  filesystem::path buffer_pool_file = test_directory / "composite.btree";
+  filesystem::remove_all(test_directory);
+  filesystem::create_directory(test_directory);
+
+  BufferPoolManager bpm;
+  ASSERT_EQ(RC::SUCCESS, bpm.init(make_unique<VacuousDoubleWriteBuffer>()));
+  ASSERT_EQ(RC::SUCCESS, bpm.create_file(buffer_pool_file.c_str()));
+
+  DiskBufferPool *buffer_pool = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm.open_file(log_handler, buffer_pool_file.c_str(), buffer_pool));
+  ASSERT_NE(nullptr, buffer_pool);
+
+  // 键值是 (int a, int b)，a 和 b 都是 [0, 20)
+  BplusTreeHandler handler;
+  ASSERT_EQ(RC::SUCCESS,
+      handler.create(log_handler, *buffer_pool, {AttrType::INTS, AttrType::INTS}, {sizeof(int), sizeof(int)},
+          false /*unique*/, ORDER, ORDER));
+
+  const int num = 20;
+  RID       rid;
+  for (int i = 0; i < num * num; i++) {
+    int n        = (i * 7) % (num * num);
+    int key[2]   = {n / num, n % num};
+    rid.page_num = 0;
+    rid.slot_num = n;
+    ASSERT_EQ(RC::SUCCESS, handler.insert_entry(reinterpret_cast<const char *>(key), &rid));
+  }
+  ASSERT_TRUE(handler.validate_tree());
+
+  auto scan = [&handler](const int *left, int left_num, bool left_inclusive, const int *right, int right_num,
+                  bool right_inclusive, vector<int> &slots) {
+    slots.clear();
+    BplusTreeScanner scanner(handler);
+    RC rc = scanner.open(reinterpret_cast<const char *>(left), left_num * sizeof(int), left_inclusive,
+        reinterpret_cast<const char *>(right), right_num * sizeof(int), right_inclusive);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+    RID rid;
+    while (OB_SUCC(rc = scanner.next_entry(rid))) {
+      slots.push_back(rid.slot_num);
+    }
+    scanner.close();
+    return rc == RC::RECORD_EOF ? RC::SUCCESS : rc;
+  };
+
+  vector<int> slots;
+
+  // a = 5
+  int a5[] = {5};
+  ASSERT_EQ(RC::SUCCESS, scan(a5, 1, true, a5, 1, true, slots));
+  ASSERT_EQ(num, static_cast<int>(slots.size()));
+  for (int i = 0; i < num; i++) {
+    ASSERT_EQ(5 * num + i, slots[i]);
+  }
+
+  // a = 5 and b >= 10
+  int a5_b10[] = {5, 10};
+  ASSERT_EQ(RC::SUCCESS, scan(a5_b10, 2, true, a5, 1, true, slots));
+  ASSERT_EQ(10, static_cast<int>(slots.size()));
+  ASSERT_EQ(5 * num + 10, slots.front());
+
+  // a = 5 and b < 3
+  int a5_b3[] = {5, 3};
+  ASSERT_EQ(RC::SUCCESS, scan(a5, 1, true, a5_b3, 2, false, slots));
+  ASSERT_EQ(3, static_cast<int>(slots.size()));
+  ASSERT_EQ(5 * num + 2, slots.back());
+
+  // a = 5 and b = 7
+  int a5_b7[] = {5, 7};
+  ASSERT_EQ(RC::SUCCESS, scan(a5_b7, 2, true, a5_b7, 2, true, slots));
+  ASSERT_EQ(1, static_cast<int>(slots.size()));
+  ASSERT_EQ(5 * num + 7, slots.front());
+
+  // a > 3 and a < 6
+  int a3[] = {3};
+  int a6[] = {6};
+  ASSERT_EQ(RC::SUCCESS, scan(a3, 1, false, a6, 1, false, slots));
+  ASSERT_EQ(2 * num, static_cast<int>(slots.size()));
+  ASSERT_EQ(4 * num, slots.front());
+  ASSERT_EQ(6 * num - 1, slots.back());
+
+  // 边界的长度必须是前缀字段的总长度
+  BplusTreeScanner scanner(handler);
+  ASSERT_EQ(RC::INVALID_ARGUMENT, scanner.open(reinterpret_cast<const char *>(a5_b7), 6, true, nullptr, 0, false));
+  scanner.close();
+
+  // 删除 a = 5 的所有数据
+  for (int b = 0; b < num; b++) {
+    int key[2]   = {5, b};
+    rid.page_num = 0;
+    rid.slot_num = 5 * num + b;
+    ASSERT_EQ(RC::SUCCESS, handler.delete_entry(reinterpret_cast<const char *>(key), &rid));
+  }
+  ASSERT_TRUE(handler.validate_tree());
+  ASSERT_EQ(RC::SUCCESS, scan(a5, 1, true, a5, 1, true, slots));
+  ASSERT_TRUE(slots.empty());
+  ASSERT_EQ(RC::SUCCESS, scan(a3, 1, false, a6, 1, false, slots));
+  ASSERT_EQ(num, static_cast<int>(slots.size()));
+}
+
+TEST(test_bplus_tree, test_reverse_scanner)
+{
+  LoggerFactory::init_default("test_reverse_scanner.log");
+
+  VacuousLogHandler log_handler;
+
+  filesystem::path test_directory("bplus_tree");
+  filesystem::path buffer_pool_file = test_directory / "reverse_scanner.btree";
+  filesystem::remove_all(test_directory);
+  filesystem::create_directory(test_directory);
+
+  BufferPoolManager bpm;
+  ASSERT_EQ(RC::SUCCESS, bpm.init(make_unique<VacuousDoubleWriteBuffer>()));
+  ASSERT_EQ(RC::SUCCESS, bpm.create_file(buffer_pool_file.c_str()));
+
+  DiskBufferPool *buffer_pool = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm.open_file(log_handler, buffer_pool_file.c_str(), buffer_pool));
+  ASSERT_NE(nullptr, buffer_pool);
+
+  BplusTreeHandler handler;
+  ASSERT_EQ(RC::SUCCESS, handler.create(log_handler, *buffer_pool, AttrType::INTS, sizeof(int), false /*unique*/, ORDER, ORDER));
+
+  auto scan = [&handler](const int *left, bool left_inclusive, const int *right, bool right_inclusive, bool reverse,
+                  vector<int> &slots) {
+    slots.clear();
+    BplusTreeScanner scanner(handler);
+    RC rc = scanner.open(reinterpret_cast<const char *>(left), sizeof(int), left_inclusive,
+        reinterpret_cast<const char *>(right), sizeof(int), right_inclusive, reverse);
+    if (OB_FAIL(rc)) {
+      return rc;
+    }
+    RID rid;
+    while (OB_SUCC(rc = scanner.next_entry(rid))) {
+      slots.push_back(rid.slot_num);
+    }
+    scanner.close();
+    return rc == RC::RECORD_EOF ? RC::SUCCESS : rc;
+  };
+
+  // 逆序扫描的结果与正序扫描的结果相反
+  auto check = [&scan](const int *left, bool left_inclusive, const int *right, bool right_inclusive) {
+    vector<int> forward;
+    vector<int> backward;
+    ASSERT_EQ(RC::SUCCESS, scan(left, left_inclusive, right, right_inclusive, false, forward));
+    ASSERT_EQ(RC::SUCCESS, scan(left, left_inclusive, right, right_inclusive, true, backward));
+    std::reverse(backward.begin(), backward.end());
+    ASSERT_EQ(forward, backward);
+  };
+
+  vector<int> slots;
+  ASSERT_EQ(RC::SUCCESS, scan(nullptr, true, nullptr, true, true, slots));
+  ASSERT_TRUE(slots.empty());
+
+  // 插入 [1 - 199] 的所有奇数，每个值两条数据
+  RID rid;
+  for (int i = 0; i < 200; i++) {
+    int key      = (i % 100) * 2 + 1;
+    rid.page_num = i / 100;
+    rid.slot_num = key;
+    ASSERT_EQ(RC::SUCCESS, handler.insert_entry(reinterpret_cast<const char *>(&key), &rid));
+  }
+
+  ASSERT_EQ(RC::SUCCESS, scan(nullptr, true, nullptr, true, true, slots));
+  ASSERT_EQ(200, static_cast<int>(slots.size()));
+  ASSERT_EQ(199, slots.front());
+  ASSERT_EQ(1, slots.back());
+
+  int k0 = 0, k1 = 1, k50 = 50, k51 = 51, k99 = 99, k199 = 199, k300 = 300;
+  ASSERT_EQ(RC::SUCCESS, scan(&k51, true, &k99, false, true, slots));
+  ASSERT_EQ(48, static_cast<int>(slots.size()));
+  ASSERT_EQ(97, slots.front());
+  ASSERT_EQ(51, slots.back());
+  ASSERT_EQ(RC::SUCCESS, scan(&k199, false, &k300, true, true, slots));
+  ASSERT_TRUE(slots.empty());
+  ASSERT_EQ(RC::SUCCESS, scan(&k0, true, &k1, false, true, slots));
+  ASSERT_TRUE(slots.empty());
+
+  const int *bounds[] = {nullptr, &k0, &k1, &k50, &k51, &k99, &k199, &k300};
+  for (const int *left : bounds) {
+    for (const int *right : bounds) {
+      if (left != nullptr && right != nullptr && *left >= *right) {
+        continue;
+      }
+      check(left, true, right, true);
+      check(left, false, right, false);
+    }
+  }
+
+  // 删除一部分数据，内部节点上的键值可能已经不在叶子节点中了
+  for (int i = 0; i < 200; i += 3) {
+    int key      = (i % 100) * 2 + 1;
+    rid.page_num = i / 100;
+    rid.slot_num = key;
+    ASSERT_EQ(RC::SUCCESS, handler.delete_entry(reinterpret_cast<const char *>(&key), &rid));
+  }
+  ASSERT_TRUE(handler.validate_tree());
+  for (const int *left : bounds) {
+    for (const int *right : bounds) {
+      if (left != nullptr && right != nullptr && *left >= *right) {
+        continue;
+      }
+      check(left, true, right, true);
+      check(left, false, right, false);
+    }
+  }
+}
+
+TEST(test_bplus_tree, test_bulk_load)
+{
+  LoggerFactory::init_default("test_bulk_load.log");
+
+  VacuousLogHandler log_handler;
+
+  filesystem::path test_directory("bplus_tree");
+  filesystem::path buffer_pool_file = test_directory / "bulk_load.btree";
+  filesystem::remove_all(test_directory);
+  filesystem::create_directory(test_directory);
+
+  BufferPoolManager bpm;
+  ASSERT_EQ(RC::SUCCESS, bpm.init(make_unique<VacuousDoubleWriteBuffer>()));
+  ASSERT_EQ(RC::SUCCESS, bpm.create_file(buffer_pool_file.c_str()));
+
+  DiskBufferPool *buffer_pool = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm.open_file(log_handler, buffer_pool_file.c_str(), buffer_pool));
+  ASSERT_NE(nullptr, buffer_pool);
+
+  BplusTreeHandler handler;
+  ASSERT_EQ(RC::SUCCESS, handler.create(log_handler, *buffer_pool, AttrType::INTS, sizeof(int), false /*unique*/, ORDER, ORDER));
+
+  // 每个值出现两次。内存很小，排序时会产生超过 MAX_MERGE_WAY 个临时文件
+  const int num = 1000;
+  RID       rid;
+  {
+    BplusTreeBulkLoader loader(handler, 200, test_directory.string());
+    for (int i = 0; i < num * 2; i++) {
+      int key      = (i * 7) % num;
+      rid.page_num = i;
+      rid.slot_num = key;
+      ASSERT_EQ(RC::SUCCESS, loader.add(reinterpret_cast<const char *>(&key), rid));
+    }
+    ASSERT_EQ(RC::SUCCESS, loader.finish(50));
+  }
+  ASSERT_TRUE(handler.validate_tree());
+  for (const auto &entry : filesystem::directory_iterator(test_directory)) {
+    ASSERT_NE(".run", entry.path().extension().string());
+  }
+
+  auto count_range = [&handler](int left, int right) {
+    BplusTreeScanner scanner(handler);
+    EXPECT_EQ(RC::SUCCESS,
+        scanner.open(reinterpret_cast<const char *>(&left), sizeof(left), true,
+            reinterpret_cast<const char *>(&right), sizeof(right), true));
+    int count = 0;
+    int prev  = left;
+    RID rid;
+    RC  rc = RC::SUCCESS;
+    while (OB_SUCC(rc = scanner.next_entry(rid))) {
+      EXPECT_LE(prev, rid.slot_num);
+      prev = rid.slot_num;
+      count++;
+    }
+    EXPECT_EQ(RC::RECORD_EOF, rc);
+    scanner.close();
+    return count;
+  };
+  ASSERT_EQ(num * 2, count_range(0, num - 1));
+  ASSERT_EQ(2, count_range(500, 500));
+  ASSERT_EQ(20, count_range(100, 109));
+
+  // 构建完成之后可以继续插入和删除
+  for (int i = 0; i < num; i++) {
+    int key      = i;
+    rid.page_num = num * 2 + i;
+    rid.slot_num = key;
+    ASSERT_EQ(RC::SUCCESS, handler.insert_entry(reinterpret_cast<const char *>(&key), &rid));
+  }
+  ASSERT_TRUE(handler.validate_tree());
+  ASSERT_EQ(3, count_range(500, 500));
+  ASSERT_EQ(num * 3, count_range(0, num - 1));
+
+  for (int i = 0; i < num * 2; i++) {
+    int key      = (i * 7) % num;
+    rid.page_num = i;
+    rid.slot_num = key;
+    ASSERT_EQ(RC::SUCCESS, handler.delete_entry(reinterpret_cast<const char *>(&key), &rid));
+  }
+  ASSERT_TRUE(handler.validate_tree());
+  ASSERT_EQ(num, count_range(0, num - 1));
+
+  // 非空的B+树不能批量加载
+  ASSERT_NE(RC::SUCCESS, handler.bulk_load(1, [](char *) { return RC::SUCCESS; }, 100));
+}
+
+TEST(test_bplus_tree, test_bulk_load_unique)
+{
+  LoggerFactory::init_default("test_bulk_load.log");
+
+  VacuousLogHandler log_handler;
+
+  filesystem::path test_directory("bplus_tree");
+  filesystem::path buffer_pool_file = test_directory / "bulk_load_unique.btree";
+  filesystem::remove_all(test_directory);
+  filesystem::create_directory(test_directory);
+
+  BufferPoolManager bpm;
+  ASSERT_EQ(RC::SUCCESS, bpm.init(make_unique<VacuousDoubleWriteBuffer>()));
+  ASSERT_EQ(RC::SUCCESS, bpm.create_file(buffer_pool_file.c_str()));
+
+  DiskBufferPool *buffer_pool = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm.open_file(log_handler, buffer_pool_file.c_str(), buffer_pool));
+  ASSERT_NE(nullptr, buffer_pool);
+
+  BplusTreeHandler handler;
+  ASSERT_EQ(RC::SUCCESS, handler.create(log_handler, *buffer_pool, AttrType::INTS, sizeof(int), true /*unique*/, ORDER, ORDER));
+
+  BplusTreeBulkLoader loader(handler, 1024 * 1024, test_directory.string());
+  RID                 rid;
+  for (int i = 0; i < 100; i++) {
+    int key      = i % 99;
+    rid.page_num = 0;
+    rid.slot_num = i;
+    ASSERT_EQ(RC::SUCCESS, loader.add(reinterpret_cast<const char *>(&key), rid));
+  }
+  ASSERT_EQ(RC::RECORD_DUPLICATE_KEY, loader.finish(100));
+}
+
+TEST(test_bplus_tree, test_prefix_compression)
+{
+  LoggerFactory::init_default("test_prefix_compression.log");
+
+  VacuousLogHandler log_handler;
+
+  filesystem::path test_directory("bplus_tree");
+  filesystem::remove_all(test_directory);
+  filesystem::create_directory(test_directory);
+
+  BufferPoolManager bpm;
+  ASSERT_EQ(RC::SUCCESS, bpm.init(make_unique<VacuousDoubleWriteBuffer>()));
+
+  auto open_buffer_pool = [&](const char *name) {
+    filesystem::path file = test_directory / name;
+    EXPECT_EQ(RC::SUCCESS, bpm.create_file(file.c_str()));
+    DiskBufferPool *buffer_pool = nullptr;
+    EXPECT_EQ(RC::SUCCESS, bpm.open_file(log_handler, file.c_str(), buffer_pool));
+    return buffer_pool;
+  };
+
+  // 只支持单个字符串字段
+  BplusTreeHandler int_handler;
+  ASSERT_EQ(RC::INVALID_ARGUMENT,
+      int_handler.create(log_handler, *open_buffer_pool("prefix_int.btree"), {AttrType::INTS}, {sizeof(int)},
+          false /*unique*/, -1, -1, true /*prefix_compressed*/));
+
+  const int attr_length = 64;
+  const int num         = 5000;
+  auto      make_key    = [](int i, char *key) {
+    memset(key, 0, attr_length);
+    // 两组前缀不同的键值，插入时会出现与节点前缀不同的键值
+    snprintf(key, attr_length, "%s/item/%06d", i % 2 == 0 ? "https://www.example.com/catalog" : "ftp://mirror", i);
+  };
+
+  BplusTreeHandler plain_handler;
+  BplusTreeHandler handler;
+  DiskBufferPool  *plain_buffer_pool = open_buffer_pool("prefix_plain.btree");
+  DiskBufferPool  *buffer_pool       = open_buffer_pool("prefix_compressed.btree");
+  ASSERT_EQ(RC::SUCCESS,
+      plain_handler.create(log_handler, *plain_buffer_pool, {AttrType::CHARS}, {attr_length}, false /*unique*/));
+  ASSERT_EQ(RC::SUCCESS,
+      handler.create(log_handler, *buffer_pool, {AttrType::CHARS}, {attr_length}, false /*unique*/, -1, -1,
+          true /*prefix_compressed*/));
+
+  char key[attr_length];
+  RID  rid;
+  for (int i = 0; i < num; i++) {
+    int value = (i * 7919) % num;
+    make_key(value, key);
+    rid.page_num = value;
+    rid.slot_num = 0;
+    ASSERT_EQ(RC::SUCCESS, plain_handler.insert_entry(key, &rid));
+    ASSERT_EQ(RC::SUCCESS, handler.insert_entry(key, &rid));
+  }
+  ASSERT_EQ(RC::RECORD_DUPLICATE_KEY, handler.insert_entry(key, &rid));
+  ASSERT_TRUE(handler.validate_tree());
+  ASSERT_TRUE(plain_handler.validate_tree());
+  ASSERT_LT(buffer_pool->allocated_pages(), plain_buffer_pool->allocated_pages());
+
+  auto count_range = [&](BplusTreeHandler &tree, int left, int right) {
+    char left_key[attr_length];
+    char right_key[attr_length];
+    make_key(left, left_key);
+    make_key(right, right_key);
+    BplusTreeScanner scanner(tree);
+    EXPECT_EQ(RC::SUCCESS, scanner.open(left_key, strlen(left_key), true, right_key, strlen(right_key), true));
+    int  count = 0;
+    RID  rid;
+    char user_key[attr_length];
+    char expect_key[attr_length];
+    RC   rc = RC::SUCCESS;
+    while (OB_SUCC(rc = scanner.next_entry(rid, user_key))) {
+      make_key(rid.page_num, expect_key);
+      EXPECT_EQ(0, memcmp(user_key, expect_key, attr_length));
+      count++;
+    }
+    EXPECT_EQ(RC::RECORD_EOF, rc);
+    scanner.close();
+    return count;
+  };
+  ASSERT_EQ(num / 2, count_range(handler, 0, num - 2));
+  ASSERT_EQ(50, count_range(handler, 1000, 1098));
+  ASSERT_EQ(count_range(plain_handler, 1, num - 1), count_range(handler, 1, num - 1));
+
+  for (int i = 0; i < num; i += 3) {
+    make_key(i, key);
+    rid.page_num = i;
+    rid.slot_num = 0;
+    ASSERT_EQ(RC::SUCCESS, handler.delete_entry(key, &rid));
+  }
+  ASSERT_TRUE(handler.validate_tree());
+  ASSERT_EQ(num / 2 - (num / 2 + 2) / 3, count_range(handler, 0, num - 2));
+
+  // 批量构建时按照共同前缀决定每个节点放多少元素
+  BplusTreeHandler bulk_handler;
+  DiskBufferPool  *bulk_buffer_pool = open_buffer_pool("prefix_bulk_load.btree");
+  ASSERT_EQ(RC::SUCCESS,
+      bulk_handler.create(log_handler, *bulk_buffer_pool, {AttrType::CHARS}, {attr_length}, false /*unique*/, -1, -1,
+          true /*prefix_compressed*/));
+  {
+    BplusTreeBulkLoader loader(bulk_handler, 1024 * 1024, test_directory.string());
+    for (int i = 0; i < num; i++) {
+      make_key(i, key);
+      rid.page_num = i;
+      rid.slot_num = 0;
+      ASSERT_EQ(RC::SUCCESS, loader.add(key, rid));
+    }
+    ASSERT_EQ(RC::SUCCESS, loader.finish(100));
+  }
+  ASSERT_TRUE(bulk_handler.validate_tree());
+  ASSERT_LT(bulk_buffer_pool->allocated_pages(), buffer_pool->allocated_pages());
+  ASSERT_EQ(num / 2, count_range(bulk_handler, 0, num - 2));
+
+  for (int i = 0; i < num; i++) {
+    make_key(i, key);
+    rid.page_num = i;
+    rid.slot_num = 0;
+    ASSERT_EQ(RC::SUCCESS, bulk_handler.delete_entry(key, &rid));
+  }
+  ASSERT_TRUE(bulk_handler.is_empty());
+}
+
+TEST(test_bplus_tree, test_typed_comparator)
+{
+  // 特化的比较函数与 DataType::compare 的结果一致
+  auto check = [](AttrType type, int length, const char *v1, const char *v2) {
+    Value left;
+    left.set_type(type);
+    left.set_data(const_cast<char *>(v1), length);
+    Value right;
+    right.set_type(type);
+    right.set_data(const_cast<char *>(v2), length);
+    int expect = DataType::type_instance(type)->compare(left, right);
+    expect     = (expect > 0) - (expect < 0);
+
+    AttrComparator comparator;
+    comparator.init(type, length);
+    EXPECT_EQ(expect, comparator(v1, v2));
+  };
+
+  const int ints[] = {INT32_MIN, -5, 0, 3, 3, INT32_MAX};
+  for (int i : ints) {
+    for (int j : ints) {
+      check(AttrType::INTS, sizeof(int), reinterpret_cast<const char *>(&i), reinterpret_cast<const char *>(&j));
+    }
+  }
+
+  const float floats[] = {-1.5f, 0.0f, 1e-7f, 0.25f, 0.2500001f, 100.0f};
+  for (float i : floats) {
+    for (float j : floats) {
+      check(AttrType::FLOATS, sizeof(float), reinterpret_cast<const char *>(&i), reinterpret_cast<const char *>(&j));
+    }
+  }
+
+  const Date dates[] = {{1970, 1, 1}, {2024, 2, 29}, {2024, 3, 1}, {2024, 12, 31}};
+  for (const Date &i : dates) {
+    for (const Date &j : dates) {
+      check(AttrType::DATES, sizeof(Date), reinterpret_cast<const char *>(&i), reinterpret_cast<const char *>(&j));
+    }
+  }
+
+  const char chars[][8] = {"", "a", "ab", "abc", "abcdefg", "b"};
+  for (const char *i : chars) {
+    for (const char *j : chars) {
+      check(AttrType::CHARS, 8, i, j);
+    }
+  }
+}
+
+TEST(test_bplus_tree, test_float_keys)
+{
+  LoggerFactory::init_default("test_float_keys.log");
+
+  VacuousLogHandler log_handler;
+
+  filesystem::path test_directory("bplus_tree");
+  filesystem::path buffer_pool_file = test_directory / "float_keys.btree";
+  filesystem::remove_all(test_directory);
+  filesystem::create_directory(test_directory);
+
+  BufferPoolManager bpm;
+  ASSERT_EQ(RC::SUCCESS, bpm.init(make_unique<VacuousDoubleWriteBuffer>()));
+  ASSERT_EQ(RC::SUCCESS, bpm.create_file(buffer_pool_file.c_str()));
+
+  DiskBufferPool *buffer_pool = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm.open_file(log_handler, buffer_pool_file.c_str(), buffer_pool));
+  ASSERT_NE(nullptr, buffer_pool);
+
+  BplusTreeHandler handler;
+  ASSERT_EQ(RC::SUCCESS, handler.create(log_handler, *buffer_pool, AttrType::FLOATS, sizeof(float), true /*unique*/));
+
+  // 每个节点有几百个元素，查找时会先二分再顺序比较
+  const int num = 3000;
+  RID       rid;
+  for (int i = 0; i < num; i++) {
+    float key    = ((i * 7) % num - num / 2) * 0.5f;
+    rid.page_num = 0;
+    rid.slot_num = (i * 7) % num;
+    ASSERT_EQ(RC::SUCCESS, handler.insert_entry(reinterpret_cast<const char *>(&key), &rid));
+  }
+  ASSERT_TRUE(handler.validate_tree());
+
+  float key = 0.5f;
+  ASSERT_EQ(RC::RECORD_DUPLICATE_KEY, handler.insert_entry(reinterpret_cast<const char *>(&key), &rid));
+
+  list<RID> rids;
+  for (int i = 0; i < num; i++) {
+    key = (i - num / 2) * 0.5f;
+    rids.clear();
+    ASSERT_EQ(RC::SUCCESS, handler.get_entry(reinterpret_cast<const char *>(&key), sizeof(key), rids));
+    ASSERT_EQ(1, rids.size());
+    ASSERT_EQ(i, rids.front().slot_num);
+  }
+
+  key = 0.25f;
+  rids.clear();
+  ASSERT_EQ(RC::SUCCESS, handler.get_entry(reinterpret_cast<const char *>(&key), sizeof(key), rids));
+  ASSERT_EQ(0, rids.size());
+}
+
+TEST(test_bplus_tree, test_optimistic_descent)
+{
+  LoggerFactory::init_default("test_optimistic_descent.log");
+
+  VacuousLogHandler log_handler;
+
+  filesystem::path test_directory("bplus_tree");
+  filesystem::path buffer_pool_file = test_directory / "optimistic.btree";
+  filesystem::remove_all(test_directory);
+  filesystem::create_directory(test_directory);
+
+  BufferPoolManager bpm;
+  ASSERT_EQ(RC::SUCCESS, bpm.init(make_unique<VacuousDoubleWriteBuffer>()));
+  ASSERT_EQ(RC::SUCCESS, bpm.create_file(buffer_pool_file.c_str()));
+
+  DiskBufferPool *buffer_pool = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm.open_file(log_handler, buffer_pool_file.c_str(), buffer_pool));
+  ASSERT_NE(nullptr, buffer_pool);
+
+  BplusTreeHandler handler;
+  ASSERT_EQ(RC::SUCCESS, handler.create(log_handler, *buffer_pool, AttrType::INTS, sizeof(int), false /*unique*/, ORDER, ORDER));
+  ASSERT_TRUE(handler.optimistic_descent());
+
+  // step 的倍数已经删除，step 为 0 时没有删除任何数据
+  auto check_entries = [&handler](int num, int step) {
+    list<RID> rids;
+    for (int i = 0; i < num; i++) {
+      rids.clear();
+      ASSERT_EQ(RC::SUCCESS, handler.get_entry(reinterpret_cast<const char *>(&i), sizeof(i), rids));
+      ASSERT_EQ((step != 0 && i % step == 0) ? 0 : 1, static_cast<int>(rids.size())) << "key=" << i;
+    }
+  };
+
+  // 插入和删除时，安全的叶子节点走乐观的路径，需要分裂合并的回退到加锁的方式
+  const int num = 1000;
+  RID       rid;
+  for (int i = 0; i < num; i++) {
+    int key      = (i * 7) % num;
+    rid.page_num = 0;
+    rid.slot_num = key;
+    ASSERT_EQ(RC::SUCCESS, handler.insert_entry(reinterpret_cast<const char *>(&key), &rid));
+  }
+  ASSERT_TRUE(handler.validate_tree());
+  check_entries(num, 0);
+
+  for (int i = 0; i < num; i += 3) {
+    rid.page_num = 0;
+    rid.slot_num = i;
+    ASSERT_EQ(RC::SUCCESS, handler.delete_entry(reinterpret_cast<const char *>(&i), &rid));
+  }
+  ASSERT_TRUE(handler.validate_tree());
+  check_entries(num, 3);
+
+  handler.set_optimistic_descent(false);
+  check_entries(num, 3);
+
+  // 删除所有数据后树变成空树，再插入时重新创建根节点
+  handler.set_optimistic_descent(true);
+  for (int i = 0; i < num; i++) {
+    if (i % 3 == 0) {
+      continue;
+    }
+    rid.page_num = 0;
+    rid.slot_num = i;
+    ASSERT_EQ(RC::SUCCESS, handler.delete_entry(reinterpret_cast<const char *>(&i), &rid));
+  }
+  ASSERT_TRUE(handler.is_empty());
+  check_entries(num, 1);
+
+  int key = 1;
+  ASSERT_EQ(RC::SUCCESS, handler.insert_entry(reinterpret_cast<const char *>(&key), &rid));
+  list<RID> rids;
+  ASSERT_EQ(RC::SUCCESS, handler.get_entry(reinterpret_cast<const char *>(&key), sizeof(key), rids));
+  ASSERT_EQ(1, static_cast<int>(rids.size()));
+}
+
+#ifdef CONCURRENCY
+TEST(test_bplus_tree, test_optimistic_descent_concurrency)
+{
+  LoggerFactory::init_default("test_optimistic_descent.log");
+
+  VacuousLogHandler log_handler;
+
+  filesystem::path test_directory("bplus_tree");
+  filesystem::path buffer_pool_file = test_directory / "optimistic_concurrency.btree";
+  filesystem::remove_all(test_directory);
+  filesystem::create_directory(test_directory);
+
+  BufferPoolManager bpm;
+  ASSERT_EQ(RC::SUCCESS, bpm.init(make_unique<VacuousDoubleWriteBuffer>()));
+  ASSERT_EQ(RC::SUCCESS, bpm.create_file(buffer_pool_file.c_str()));
+
+  DiskBufferPool *buffer_pool = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm.open_file(log_handler, buffer_pool_file.c_str(), buffer_pool));
+  ASSERT_NE(nullptr, buffer_pool);
+
+  BplusTreeHandler handler;
+  ASSERT_EQ(RC::SUCCESS, handler.create(log_handler, *buffer_pool, AttrType::INTS, sizeof(int), false /*unique*/, ORDER, ORDER));
+
+  // 偶数一直存在，写线程反复插入删除奇数，让节点不停地分裂合并
+  const int num = 2000;
+  RID       rid;
+  for (int i = 0; i < num; i += 2) {
+    rid.page_num = 0;
+    rid.slot_num = i;
+    ASSERT_EQ(RC::SUCCESS, handler.insert_entry(reinterpret_cast<const char *>(&i), &rid));
+  }
+
+  atomic<bool> stop{false};
+  atomic<int>  errors{0};
+
+  auto writer = [&](int start, int step) {
+    RID rid;
+    for (int round = 0; round < 5; round++) {
+      for (int i = start; i < num; i += step) {
+        rid.page_num = 0;
+        rid.slot_num = i;
+        if (handler.insert_entry(reinterpret_cast<const char *>(&i), &rid) != RC::SUCCESS) {
+          errors++;
+        }
+      }
+      for (int i = start; i < num; i += step) {
+        rid.page_num = 0;
+        rid.slot_num = i;
+        if (handler.delete_entry(reinterpret_cast<const char *>(&i), &rid) != RC::SUCCESS) {
+          errors++;
+        }
+      }
+    }
+  };
+
+  auto reader = [&](int seed) {
+    list<RID> rids;
+    for (int i = seed; !stop.load(); i = (i + 34) % num) {
+      rids.clear();
+      RC rc = handler.get_entry(reinterpret_cast<const char *>(&i), sizeof(i), rids);
+      if (rc == RC::LOCKED_NEED_WAIT) {
+        continue;  // 扫描器切换叶子节点时加锁失败，由调用者重试
+      }
+      if (rc != RC::SUCCESS || rids.size() != 1 || rids.front().slot_num != i) {
+        errors++;
+      }
+    }
+  };
+
+  vector<thread> readers;
+  for (int i = 0; i < 4; i++) {
+    readers.emplace_back(reader, i * 2);
+  }
+  thread writer1(writer, 1, 4);
+  thread writer2(writer, 3, 4);
+  writer1.join();
+  writer2.join();
+  stop = true;
+  for (thread &t : readers) {
+    t.join();
+  }
+
+  ASSERT_EQ(0, errors.load());
+  ASSERT_TRUE(handler.validate_tree());
+}
+#endif  // CONCURRENCY
+
 TEST(test_bplus_tree, test_bplus_tree_insert)
 {
   LoggerFactory::init_default("test.log");
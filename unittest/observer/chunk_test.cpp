@@ -58,6 +58,34 @@ TEST(ChunkTest, chunk_test)
       ASSERT_EQ(chunk2.get_value(1, i).get_float(), value2);
     }
   }
+  // column ids are not the same as column indexes
+  {
+    Chunk chunk;
+    chunk.add_column(std::make_unique<Column>(AttrType::INTS, sizeof(int), 8), 5);
+    chunk.add_column(std::make_unique<Column>(AttrType::FLOATS, sizeof(float), 8), 3);
+    ASSERT_EQ(chunk.column_index(5), 0);
+    ASSERT_EQ(chunk.column_index(3), 1);
+    ASSERT_EQ(chunk.column_index(0), -1);
+
+    Chunk chunk2;
+    chunk2.reference(chunk);
+    ASSERT_EQ(chunk2.column_index(3), 1);
+  }
+  // columns of different tables may have the same column id
+  {
+    Chunk chunk;
+    chunk.add_column(std::make_unique<Column>(AttrType::INTS, sizeof(int), 8), 3, 1);
+    chunk.add_column(std::make_unique<Column>(AttrType::INTS, sizeof(int), 8), 3, 2);
+    ASSERT_EQ(chunk.column_index(3, 1), 0);
+    ASSERT_EQ(chunk.column_index(3, 2), 1);
+    ASSERT_EQ(chunk.column_index(3, 3), -1);
+    ASSERT_EQ(chunk.column_index(3), 0);
+
+    Chunk chunk2;
+    chunk2.reference(chunk);
+    ASSERT_EQ(chunk2.column_index(3, 2), 1);
+    ASSERT_EQ(chunk2.column_table_ids(1), 2);
+  }
 }
 
 int main(int argc, char **argv)
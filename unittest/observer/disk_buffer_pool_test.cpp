@@ -105,6 +105,37 @@ TEST(DiskBufferPool, allocate_dispose)
   ASSERT_EQ(buffer_pool_manager.close_file(buffer_pool_filename.c_str()), RC::SUCCESS);
 }
 
+TEST(DiskBufferPool, dispose_pinned_page)
+{
+  filesystem::path directory("buffer_pool");
+  filesystem::remove_all(directory);
+  filesystem::create_directories(directory);
+
+  filesystem::path buffer_pool_filename = directory / "dispose_pinned.bp";
+
+  BufferPoolManager buffer_pool_manager;
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.init(make_unique<VacuousDoubleWriteBuffer>()));
+  VacuousLogHandler log_handler;
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.create_file(buffer_pool_filename.c_str()));
+  DiskBufferPool *buffer_pool = nullptr;
+  ASSERT_EQ(RC::SUCCESS, buffer_pool_manager.open_file(log_handler, buffer_pool_filename.c_str(), buffer_pool));
+
+  Frame *frame = nullptr;
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->allocate_page(&frame));
+  const PageNum page_num = frame->page_num();
+
+  // 页面一直被 pin 着，释放失败，不会一直等待，页面也还是已分配的状态
+  ASSERT_EQ(RC::LOCKED_UNLOCK, buffer_pool->dispose_page(page_num));
+  ASSERT_EQ(1, frame->pin_count());
+  ASSERT_EQ(1, buffer_pool_page_count(buffer_pool));
+
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->unpin_page(frame));
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->dispose_page(page_num));
+  ASSERT_EQ(0, buffer_pool_page_count(buffer_pool));
+
+  ASSERT_EQ(buffer_pool_manager.close_file(buffer_pool_filename.c_str()), RC::SUCCESS);
+}
+
 TEST(BufferPool, create)
 {
   filesystem::path test_directory("buffer_pool");
@@ -132,6 +163,272 @@ TEST(BufferPool, create)
   ASSERT_EQ(buffer_pool->id(), buffer_pool2->id());
 }
 
+TEST(DiskBufferPool, buffer_ring)
+{
+  /*
+  1. 创建只有一个内存池的buffer pool manager，先分配一些热点页面
+  2. 通过环分配大量页面并写入数据，模拟LOAD DATA
+  3. 通过环扫描所有页面，检查数据
+  每一步之后，缓存中的页面都不会超过热点页面加上环的大小，热点页面也一直在缓存中
+  */
+  filesystem::path test_directory("buffer_pool");
+  filesystem::path bp_file = test_directory / "buffer_ring.bp";
+  filesystem::remove_all(test_directory);
+  filesystem::create_directory(test_directory);
+
+  BufferPoolManager bpm(BP_PAGE_SIZE * DEFAULT_ITEM_NUM_PER_POOL);
+  ASSERT_EQ(RC::SUCCESS, bpm.init(make_unique<VacuousDoubleWriteBuffer>()));
+  ASSERT_EQ(RC::SUCCESS, bpm.create_file(bp_file.c_str()));
+
+  VacuousLogHandler log_handler;
+  DiskBufferPool   *buffer_pool = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm.open_file(log_handler, bp_file.c_str(), buffer_pool));
+  ASSERT_NE(buffer_pool, nullptr);
+
+  BPFrameManager &frame_manager = bpm.get_frame_manager();
+  const int       total         = static_cast<int>(frame_manager.total_frame_num());
+  const int       hot_page_num  = 10;
+  const int       cold_page_num = total * 3;
+
+  vector<PageNum> hot_pages;
+  for (int i = 0; i < hot_page_num; i++) {
+    Frame *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->allocate_page(&frame));
+    hot_pages.push_back(frame->page_num());
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->unpin_page(frame));
+  }
+
+  auto check_hot_pages = [&](int ring_size) {
+    ASSERT_LE(frame_manager.frame_num(), static_cast<size_t>(1 + hot_page_num + ring_size));
+    for (PageNum page_num : hot_pages) {
+      Frame *frame = frame_manager.get(buffer_pool->id(), page_num);
+      ASSERT_NE(frame, nullptr);
+      ASSERT_EQ(RC::SUCCESS, buffer_pool->unpin_page(frame));
+    }
+  };
+
+  BufferRing      load_ring(16);
+  vector<PageNum> cold_pages;
+  for (int i = 0; i < cold_page_num; i++) {
+    Frame *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->allocate_page(&frame, &load_ring));
+    memcpy(frame->data(), &i, sizeof(i));
+    frame->mark_dirty();
+    cold_pages.push_back(frame->page_num());
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->unpin_page(frame));
+  }
+  check_hot_pages(load_ring.size());
+
+  unique_ptr<BufferRing> scan_ring = buffer_pool->make_buffer_ring();
+  ASSERT_NE(scan_ring, nullptr);
+  for (int i = 0; i < cold_page_num; i++) {
+    Frame *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->get_this_page(cold_pages[i], &frame, scan_ring.get()));
+    int value = -1;
+    memcpy(&value, frame->data(), sizeof(value));
+    ASSERT_EQ(i, value);
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->unpin_page(frame));
+  }
+  check_hot_pages(load_ring.size() + scan_ring->size());  // 环中最后的页面会留在缓存中
+
+  ASSERT_EQ(RC::SUCCESS, bpm.close_file(bp_file.c_str()));
+}
+
+TEST(DiskBufferPool, page_cleaner)
+{
+  /*
+  1. 分配一些脏页，执行一轮刷脏，淘汰顺序靠前的页帧都变干净了，淘汰时不需要前台刷盘
+  2. 启动后台刷脏线程，写入比缓存大得多的数据
+  3. 按照页号顺序刷新所有脏页，重新打开文件检查数据
+  4. 后台线程还在刷脏时修改数据并关闭文件，重新打开文件检查数据
+  */
+  filesystem::path test_directory("buffer_pool");
+  filesystem::path bp_file = test_directory / "page_cleaner.bp";
+  filesystem::remove_all(test_directory);
+  filesystem::create_directory(test_directory);
+
+  VacuousLogHandler log_handler;
+  vector<PageNum>   pages;
+  {
+    BufferPoolManager bpm(BP_PAGE_SIZE * DEFAULT_ITEM_NUM_PER_POOL);
+    ASSERT_EQ(RC::SUCCESS, bpm.init(make_unique<VacuousDoubleWriteBuffer>()));
+    ASSERT_EQ(RC::SUCCESS, bpm.create_file(bp_file.c_str()));
+
+    DiskBufferPool *buffer_pool = nullptr;
+    ASSERT_EQ(RC::SUCCESS, bpm.open_file(log_handler, bp_file.c_str(), buffer_pool));
+    ASSERT_NE(buffer_pool, nullptr);
+
+    BPFrameManager &frame_manager = bpm.get_frame_manager();
+    PageCleaner    &page_cleaner  = bpm.page_cleaner();
+    ASSERT_EQ(RC::SUCCESS, page_cleaner.start(0 /*thread_num*/, 100 /*clean_percent*/));
+
+    auto write_page = [&](int value) {
+      Frame *frame = nullptr;
+      ASSERT_EQ(RC::SUCCESS, buffer_pool->allocate_page(&frame));
+      memcpy(frame->data(), &value, sizeof(value));
+      frame->mark_dirty();
+      pages.push_back(frame->page_num());
+      ASSERT_EQ(RC::SUCCESS, buffer_pool->unpin_page(frame));
+    };
+
+    const int total = static_cast<int>(frame_manager.total_frame_num());
+    for (int i = 0; i < total / 2; i++) {
+      write_page(i);
+    }
+    ASSERT_GT(page_cleaner.clean(), 0);
+    for (int i = 0; i < frame_manager.shard_num(); i++) {
+      vector<Frame *> dirty_frames;
+      frame_manager.collect_dirty_victims(i, total, dirty_frames);
+      ASSERT_TRUE(dirty_frames.empty());
+    }
+
+    // 空闲页帧和刷干净的页帧加起来差不多是整个缓存，写满之前都不需要淘汰脏页
+    for (int i = total / 2; i < total - total / 8; i++) {
+      write_page(i);
+    }
+    ASSERT_EQ(0, page_cleaner.foreground_flush_count());
+    page_cleaner.stop();
+
+    ASSERT_EQ(RC::SUCCESS, page_cleaner.start(2 /*thread_num*/, 25 /*clean_percent*/, 1 /*interval_ms*/));
+    for (int i = total - total / 8; i < total * 4; i++) {
+      write_page(i);
+    }
+    page_cleaner.stop();
+
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->flush_all_pages());
+    for (int i = 0; i < frame_manager.shard_num(); i++) {
+      vector<Frame *> dirty_frames;
+      frame_manager.collect_dirty_victims(i, total, dirty_frames);
+      ASSERT_TRUE(dirty_frames.empty());
+    }
+    ASSERT_EQ(RC::SUCCESS, bpm.close_file(bp_file.c_str()));
+  }
+
+  BufferPoolManager bpm;
+  ASSERT_EQ(RC::SUCCESS, bpm.init(make_unique<VacuousDoubleWriteBuffer>()));
+  DiskBufferPool *buffer_pool = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm.open_file(log_handler, bp_file.c_str(), buffer_pool));
+  for (int i = 0; i < static_cast<int>(pages.size()); i++) {
+    Frame *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->get_this_page(pages[i], &frame));
+    int value = -1;
+    memcpy(&value, frame->data(), sizeof(value));
+    ASSERT_EQ(i, value);
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->unpin_page(frame));
+  }
+
+  ASSERT_EQ(RC::SUCCESS, bpm.page_cleaner().start(2 /*thread_num*/, 100 /*clean_percent*/, 1 /*interval_ms*/));
+  for (int i = 0; i < static_cast<int>(pages.size()); i++) {
+    Frame *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->get_this_page(pages[i], &frame));
+    int value = i + 1;
+    frame->write_latch();
+    memcpy(frame->data(), &value, sizeof(value));
+    frame->mark_dirty();
+    frame->write_unlatch();
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->unpin_page(frame));
+  }
+  ASSERT_EQ(RC::SUCCESS, bpm.close_file(bp_file.c_str()));
+
+  ASSERT_EQ(RC::SUCCESS, bpm.open_file(log_handler, bp_file.c_str(), buffer_pool));
+  for (int i = 0; i < static_cast<int>(pages.size()); i++) {
+    Frame *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->get_this_page(pages[i], &frame));
+    int value = -1;
+    frame->read_latch();
+    memcpy(&value, frame->data(), sizeof(value));
+    frame->read_unlatch();
+    ASSERT_EQ(i + 1, value);
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->unpin_page(frame));
+  }
+  ASSERT_EQ(RC::SUCCESS, bpm.close_file(bp_file.c_str()));
+  bpm.page_cleaner().stop();
+}
+
+TEST(DiskBufferPool, page_prefetcher)
+{
+  /*
+  1. 按照页号顺序访问冷数据，预读线程提前把后面的页面读到缓存中
+  2. 主动提示预读一些页面，访问这些页面时都已经在缓存中了
+  3. 还有预读请求没有执行时关闭文件
+  */
+  filesystem::path test_directory("buffer_pool");
+  filesystem::path bp_file = test_directory / "page_prefetcher.bp";
+  filesystem::remove_all(test_directory);
+  filesystem::create_directory(test_directory);
+
+  VacuousLogHandler log_handler;
+  BufferPoolManager bpm(BP_PAGE_SIZE * DEFAULT_ITEM_NUM_PER_POOL * 2);
+  ASSERT_EQ(RC::SUCCESS, bpm.init(make_unique<VacuousDoubleWriteBuffer>()));
+  ASSERT_EQ(RC::SUCCESS, bpm.create_file(bp_file.c_str()));
+
+  DiskBufferPool *buffer_pool = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm.open_file(log_handler, bp_file.c_str(), buffer_pool));
+
+  const int       page_num = static_cast<int>(bpm.get_frame_manager().total_frame_num()) / 2;
+  vector<PageNum> pages;
+  for (int i = 0; i < page_num; i++) {
+    Frame *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->allocate_page(&frame));
+    memcpy(frame->data(), &i, sizeof(i));
+    frame->mark_dirty();
+    pages.push_back(frame->page_num());
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->unpin_page(frame));
+  }
+  ASSERT_EQ(RC::SUCCESS, buffer_pool->flush_all_pages());
+  ASSERT_EQ(RC::SUCCESS, bpm.close_file(bp_file.c_str()));
+
+  PagePrefetcher &prefetcher = bpm.page_prefetcher();
+  ASSERT_EQ(RC::SUCCESS, prefetcher.start(2 /*thread_num*/, 16 /*window_pages*/));
+  ASSERT_EQ(16, prefetcher.window_pages());
+
+  auto read_page = [&](int index) {
+    Frame *frame = nullptr;
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->get_this_page(pages[index], &frame));
+    frame->read_latch();
+    int value = -1;
+    memcpy(&value, frame->data(), sizeof(value));
+    frame->read_unlatch();
+    ASSERT_EQ(index, value);
+    ASSERT_EQ(RC::SUCCESS, buffer_pool->unpin_page(frame));
+  };
+  auto wait_read_count = [&prefetcher](int64_t count) {
+    for (int i = 0; i < 5000 && prefetcher.read_count() < count; i++) {
+      this_thread::sleep_for(chrono::milliseconds(1));
+    }
+    return prefetcher.read_count() >= count;
+  };
+
+  // 访问 pages[1] 时开始预读 pages[2..17]，pages[2] 可能会先被当前线程加载，预读线程至少读取后面的15个页面
+  ASSERT_EQ(RC::SUCCESS, bpm.open_file(log_handler, bp_file.c_str(), buffer_pool));
+  for (int i = 0; i < 3; i++) {
+    read_page(i);
+  }
+  ASSERT_TRUE(wait_read_count(15));
+  for (int i = 3; i < page_num; i++) {
+    read_page(i);
+  }
+  ASSERT_GE(prefetcher.hit_count(), 15);
+  ASSERT_LE(prefetcher.hit_count(), prefetcher.read_count());
+  ASSERT_EQ(RC::SUCCESS, bpm.close_file(bp_file.c_str()));
+
+  ASSERT_EQ(RC::SUCCESS, bpm.open_file(log_handler, bp_file.c_str(), buffer_pool));
+  const int64_t read_count = prefetcher.read_count();
+  const int64_t hit_count  = prefetcher.hit_count();
+  buffer_pool->prefetch_pages(pages[10], 5);
+  ASSERT_TRUE(wait_read_count(read_count + 5));
+  for (int i = 10; i < 15; i++) {
+    read_page(i);
+  }
+  ASSERT_EQ(hit_count + 5, prefetcher.hit_count());
+
+  for (int i = 0; i < page_num; i++) {
+    buffer_pool->prefetch_pages(pages[i], 1);
+  }
+  ASSERT_EQ(RC::SUCCESS, bpm.close_file(bp_file.c_str()));
+  prefetcher.stop();
+}
+
 int main(int argc, char **argv)
 {
   testing::InitGoogleTest(&argc, argv);
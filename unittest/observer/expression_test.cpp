@@ -307,6 +307,62 @@ TEST(ComparisonExpr, comparison_expr_test)
   }
 }
 
+TEST(ConjunctionExpr, conjunction_expr_eval_test)
+{
+  const int               int_len = sizeof(int);
+  const int               count   = 100;
+  FieldMeta               field_meta("col1", AttrType::INTS, 0, int_len, true, 0);
+  Field                   field(nullptr, &field_meta);
+  std::unique_ptr<Column> column = std::make_unique<Column>(AttrType::INTS, int_len, count);
+  for (int i = 0; i < count; ++i) {
+    column->append_one((char *)&i);
+  }
+  Chunk chunk;
+  chunk.add_column(std::move(column), 0);
+
+  auto make_comparison = [&field](CompOp op, int value) -> unique_ptr<Expression> {
+    return make_unique<ComparisonExpr>(op, make_unique<FieldExpr>(field), make_unique<ValueExpr>(Value(value)));
+  };
+
+  // col1 > 10 and col1 < 20
+  {
+    vector<unique_ptr<Expression>> children;
+    children.push_back(make_comparison(CompOp::GREAT_THAN, 10));
+    children.push_back(make_comparison(CompOp::LESS_THAN, 20));
+    ConjunctionExpr      expr(ConjunctionExpr::Type::AND, children);
+    std::vector<uint8_t> select(count, 1);
+    ASSERT_EQ(expr.eval(chunk, select), RC::SUCCESS);
+    for (int i = 0; i < count; ++i) {
+      ASSERT_EQ(select[i], (i > 10 && i < 20) ? 1 : 0);
+    }
+  }
+  // col1 < 10 or col1 > 90, with rows already filtered out by the input selection
+  {
+    vector<unique_ptr<Expression>> children;
+    children.push_back(make_comparison(CompOp::LESS_THAN, 10));
+    children.push_back(make_comparison(CompOp::GREAT_THAN, 90));
+    ConjunctionExpr      expr(ConjunctionExpr::Type::OR, children);
+    std::vector<uint8_t> select(count, 1);
+    select[5]  = 0;
+    select[95] = 0;
+    ASSERT_EQ(expr.eval(chunk, select), RC::SUCCESS);
+    for (int i = 0; i < count; ++i) {
+      bool expected = (i < 10 || i > 90) && i != 5 && i != 95;
+      ASSERT_EQ(select[i], expected ? 1 : 0);
+    }
+  }
+  // short circuit: nothing is selected after the first child
+  {
+    vector<unique_ptr<Expression>> children;
+    children.push_back(make_comparison(CompOp::GREAT_THAN, 1000));
+    children.push_back(make_comparison(CompOp::LESS_THAN, 20));
+    ConjunctionExpr      expr(ConjunctionExpr::Type::AND, children);
+    std::vector<uint8_t> select(count, 1);
+    ASSERT_EQ(expr.eval(chunk, select), RC::SUCCESS);
+    ASSERT_EQ(std::count(select.begin(), select.end(), 1), 0);
+  }
+}
+
 TEST(AggregateExpr, aggregate_expr_test)
 {
   Value                  int_value(1);
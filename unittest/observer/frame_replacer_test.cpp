@@ -0,0 +1,153 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "storage/buffer/frame_replacer.h"
+#include "gtest/gtest.h"
+
+using namespace std;
+
+static const int FRAME_NUM = 8;
+
+class FrameReplacerTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    for (int i = 0; i < FRAME_NUM; i++) {
+      frames_[i].set_buffer_pool_id(1);
+      frames_[i].set_page_num(i);
+    }
+  }
+
+  /// @brief 按照淘汰顺序返回前 count 个页帧的页面编号
+  static vector<PageNum> victims(FrameReplacer &replacer, size_t count)
+  {
+    vector<PageNum> result;
+    replacer.foreach_victim([&result, count](Frame *frame) {
+      result.push_back(frame->page_num());
+      return result.size() < count;
+    });
+    return result;
+  }
+
+  Frame frames_[FRAME_NUM];
+};
+
+TEST_F(FrameReplacerTest, type_name)
+{
+  FrameReplacerType type = FrameReplacerType::LRU;
+  ASSERT_EQ(RC::SUCCESS, frame_replacer_type_from_string("CLOCK", type));
+  ASSERT_EQ(FrameReplacerType::CLOCK, type);
+  ASSERT_EQ(RC::SUCCESS, frame_replacer_type_from_string("2q", type));
+  ASSERT_EQ(FrameReplacerType::TWO_QUEUE, type);
+  ASSERT_EQ(RC::SUCCESS, frame_replacer_type_from_string("lru", type));
+  ASSERT_EQ(FrameReplacerType::LRU, type);
+  ASSERT_EQ(RC::INVALID_ARGUMENT, frame_replacer_type_from_string("fifo", type));
+
+  for (FrameReplacerType type : {FrameReplacerType::LRU, FrameReplacerType::CLOCK, FrameReplacerType::TWO_QUEUE}) {
+    ASSERT_EQ(type, FrameReplacer::create(type, FRAME_NUM)->type());
+  }
+}
+
+TEST_F(FrameReplacerTest, lru)
+{
+  LruFrameReplacer replacer;
+  for (int i = 0; i < 4; i++) {
+    replacer.on_insert(&frames_[i]);
+  }
+  replacer.on_access(&frames_[0]);
+  ASSERT_EQ((vector<PageNum>{1, 2, 3, 0}), victims(replacer, FRAME_NUM));
+
+  replacer.on_remove(&frames_[2]);
+  ASSERT_EQ((vector<PageNum>{1, 3}), victims(replacer, 2));
+}
+
+TEST_F(FrameReplacerTest, clock)
+{
+  ClockFrameReplacer replacer;
+  for (int i = 0; i < 4; i++) {
+    replacer.on_insert(&frames_[i]);
+  }
+
+  // 第一圈清除所有的访问标记
+  ASSERT_EQ((vector<PageNum>{0}), victims(replacer, 1));
+
+  // 指针停在 1 上，1 被访问过，跳过它
+  replacer.on_access(&frames_[1]);
+  ASSERT_EQ((vector<PageNum>{2, 3, 0}), victims(replacer, 3));
+
+  // 删除后留下的空位给新的页帧使用
+  replacer.on_remove(&frames_[2]);
+  replacer.on_insert(&frames_[4]);
+  frames_[4].clear_referenced();
+  ASSERT_EQ((vector<PageNum>{1, 4, 3, 0}), victims(replacer, 4));
+}
+
+TEST_F(FrameReplacerTest, clock_peek)
+{
+  ClockFrameReplacer replacer;
+  for (int i = 0; i < 4; i++) {
+    replacer.on_insert(&frames_[i]);
+  }
+  ASSERT_EQ((vector<PageNum>{0}), victims(replacer, 1));
+  replacer.on_access(&frames_[2]);
+
+  // 查看时不会移动指针，也不会清除访问标记，有访问标记的页帧排在最后
+  auto peek = [&replacer]() {
+    vector<PageNum> result;
+    replacer.peek_victims([&result](Frame *frame) {
+      result.push_back(frame->page_num());
+      return true;
+    });
+    return result;
+  };
+  ASSERT_EQ((vector<PageNum>{1, 3, 0, 2}), peek());
+  ASSERT_EQ((vector<PageNum>{1, 3, 0, 2}), peek());
+  ASSERT_TRUE(frames_[2].referenced());
+  ASSERT_EQ((vector<PageNum>{1, 3, 0}), victims(replacer, 3));
+}
+
+TEST_F(FrameReplacerTest, two_queue)
+{
+  TwoQueueFrameReplacer replacer(FRAME_NUM);  // A1in 最多 2 个，A1out 最多 4 个
+  for (int i = 0; i < 4; i++) {
+    replacer.on_insert(&frames_[i]);
+  }
+
+  // A1in 超过限制，先淘汰 A1in 中最早加载的，再次访问不会改变顺序
+  replacer.on_access(&frames_[0]);
+  ASSERT_EQ((vector<PageNum>{0, 1, 2, 3}), victims(replacer, FRAME_NUM));
+
+  // 0 被淘汰以后很快又加载，进入 Am
+  replacer.on_remove(&frames_[0]);
+  replacer.on_insert(&frames_[0]);
+  ASSERT_EQ((vector<PageNum>{1, 2, 3, 0}), victims(replacer, FRAME_NUM));
+
+  // 扫描只访问一次的页面不会把 Am 中的页面挤出去
+  replacer.on_remove(&frames_[1]);
+  replacer.on_insert(&frames_[1]);
+  replacer.on_access(&frames_[0]);
+  for (int i = 4; i < FRAME_NUM; i++) {
+    replacer.on_insert(&frames_[i]);
+  }
+  ASSERT_EQ((vector<PageNum>{2, 3, 4, 5, 6, 7, 1, 0}), victims(replacer, FRAME_NUM));
+
+  // A1in 没有超过限制时，淘汰 Am 中最久没有访问的
+  for (int i : {2, 3, 4, 5, 6}) {
+    replacer.on_remove(&frames_[i]);
+  }
+  ASSERT_EQ((vector<PageNum>{1, 0, 7}), victims(replacer, FRAME_NUM));
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
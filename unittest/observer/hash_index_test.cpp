@@ -0,0 +1,364 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <algorithm>
+#include <filesystem>
+#include <random>
+
+#include "gtest/gtest.h"
+#include "common/log/log.h"
+#include "storage/buffer/double_write_buffer.h"
+#include "storage/clog/disk_log_handler.h"
+#include "storage/clog/integrated_log_replayer.h"
+#include "storage/clog/vacuous_log_handler.h"
+#include "storage/index/extendible_hash.h"
+
+using namespace std;
+using namespace common;
+
+static RC lookup(ExtendibleHashHandler &handler, int key, vector<RID> &rids)
+{
+  rids.clear();
+  return handler.get_entry(reinterpret_cast<const char *>(&key), sizeof(key), rids);
+}
+
+TEST(HashIndex, insert_delete)
+{
+  filesystem::path test_directory = "hash_index_test_dir";
+  filesystem::remove_all(test_directory);
+  filesystem::create_directory(test_directory);
+  const filesystem::path bp_filename = test_directory / "insert_delete.hash";
+
+  VacuousLogHandler log_handler;
+  BufferPoolManager bpm;
+  ASSERT_EQ(RC::SUCCESS, bpm.init(make_unique<VacuousDoubleWriteBuffer>()));
+
+  // 桶很小，插入时会多次分裂
+  ExtendibleHashHandler handler;
+  ASSERT_EQ(RC::SUCCESS,
+      handler.create(log_handler, bpm, bp_filename.c_str(), {AttrType::INTS}, {4}, false /*unique*/, 8 /*bucket*/));
+
+  const int   insert_num = 5000;
+  vector<int> keys(insert_num);
+  for (int i = 0; i < insert_num; i++) {
+    keys[i] = i;
+  }
+  mt19937 generator(0);
+  shuffle(keys.begin(), keys.end(), generator);
+
+  for (int key : keys) {
+    RID rid(key, key);
+    ASSERT_EQ(RC::SUCCESS, handler.insert_entry(reinterpret_cast<const char *>(&key), &rid));
+  }
+  ASSERT_GT(handler.global_depth(), 0);
+
+  int key = 100;
+  RID rid(100, 100);
+  ASSERT_EQ(RC::RECORD_DUPLICATE_KEY, handler.insert_entry(reinterpret_cast<const char *>(&key), &rid));
+
+  vector<RID> rids;
+  for (int i = 0; i < insert_num; i++) {
+    ASSERT_EQ(RC::SUCCESS, lookup(handler, i, rids));
+    ASSERT_EQ(1, rids.size());
+    ASSERT_EQ(RID(i, i), rids[0]);
+  }
+  ASSERT_EQ(RC::SUCCESS, lookup(handler, insert_num, rids));
+  ASSERT_TRUE(rids.empty());
+
+  for (int i = 0; i < insert_num; i += 2) {
+    RID rid(i, i);
+    ASSERT_EQ(RC::SUCCESS, handler.delete_entry(reinterpret_cast<const char *>(&i), &rid));
+  }
+  key = 0;
+  ASSERT_EQ(RC::RECORD_NOT_EXIST, handler.delete_entry(reinterpret_cast<const char *>(&key), &rid));
+
+  for (int i = 0; i < insert_num; i++) {
+    ASSERT_EQ(RC::SUCCESS, lookup(handler, i, rids));
+    ASSERT_EQ(i % 2 == 0 ? 0 : 1, rids.size());
+  }
+}
+
+TEST(HashIndex, duplicate_keys)
+{
+  filesystem::path test_directory = "hash_index_test_dir";
+  filesystem::remove_all(test_directory);
+  filesystem::create_directory(test_directory);
+
+  VacuousLogHandler log_handler;
+  BufferPoolManager bpm;
+  ASSERT_EQ(RC::SUCCESS, bpm.init(make_unique<VacuousDoubleWriteBuffer>()));
+
+  // 相同的键值没法通过分裂分开，只能放到溢出页面中
+  ExtendibleHashHandler handler;
+  ASSERT_EQ(RC::SUCCESS,
+      handler.create(log_handler, bpm, (test_directory / "dup.hash").c_str(), {AttrType::INTS}, {4}, false, 4));
+
+  const int dup_num = 100;
+  for (int i = 0; i < dup_num; i++) {
+    int key = i % 2;
+    RID rid(1, i);
+    ASSERT_EQ(RC::SUCCESS, handler.insert_entry(reinterpret_cast<const char *>(&key), &rid));
+  }
+
+  vector<RID> rids;
+  ASSERT_EQ(RC::SUCCESS, lookup(handler, 0, rids));
+  ASSERT_EQ(dup_num / 2, rids.size());
+  ASSERT_EQ(RC::SUCCESS, lookup(handler, 1, rids));
+  ASSERT_EQ(dup_num / 2, rids.size());
+
+  // 唯一索引中相同的键值只能有一个
+  ExtendibleHashHandler unique_handler;
+  ASSERT_EQ(RC::SUCCESS,
+      unique_handler.create(log_handler, bpm, (test_directory / "unique.hash").c_str(), {AttrType::INTS}, {4}, true));
+  int key = 1;
+  RID rid(1, 1);
+  ASSERT_EQ(RC::SUCCESS, unique_handler.insert_entry(reinterpret_cast<const char *>(&key), &rid));
+  rid.slot_num = 2;
+  ASSERT_EQ(RC::RECORD_DUPLICATE_KEY, unique_handler.insert_entry(reinterpret_cast<const char *>(&key), &rid));
+
+  // 浮点数不支持
+  ExtendibleHashHandler float_handler;
+  ASSERT_EQ(RC::INVALID_ARGUMENT,
+      float_handler.create(log_handler, bpm, (test_directory / "float.hash").c_str(), {AttrType::FLOATS}, {4}));
+}
+
+TEST(HashIndex, chars)
+{
+  filesystem::path test_directory = "hash_index_test_dir";
+  filesystem::remove_all(test_directory);
+  filesystem::create_directory(test_directory);
+
+  VacuousLogHandler log_handler;
+  BufferPoolManager bpm;
+  ASSERT_EQ(RC::SUCCESS, bpm.init(make_unique<VacuousDoubleWriteBuffer>()));
+
+  ExtendibleHashHandler handler;
+  ASSERT_EQ(RC::SUCCESS,
+      handler.create(log_handler, bpm, (test_directory / "chars.hash").c_str(), {AttrType::CHARS}, {8}, false, 4));
+
+  char keys[][9] = {"abc", "abcdefg", "12345678", "abc", "x"};
+  // 结束符之后的内容不影响比较
+  keys[4][3] = 'z';
+  for (size_t i = 0; i < sizeof(keys) / sizeof(keys[0]); i++) {
+    RID rid(0, i);
+    ASSERT_EQ(RC::SUCCESS, handler.insert_entry(keys[i], &rid));
+  }
+
+  vector<RID> rids;
+  ASSERT_EQ(RC::SUCCESS, handler.get_entry("abc", 3, rids));
+  ASSERT_EQ(2, rids.size());
+
+  rids.clear();
+  ASSERT_EQ(RC::SUCCESS, handler.get_entry("x", 1, rids));
+  ASSERT_EQ(1, rids.size());
+
+  // 比字段更长的字符串不会等于任何一个键值
+  rids.clear();
+  ASSERT_EQ(RC::SUCCESS, handler.get_entry("abcdefghijk", 11, rids));
+  ASSERT_TRUE(rids.empty());
+
+  // 组合键值
+  ExtendibleHashHandler composite_handler;
+  ASSERT_EQ(RC::SUCCESS,
+      composite_handler.create(log_handler,
+          bpm,
+          (test_directory / "composite.hash").c_str(),
+          {AttrType::INTS, AttrType::CHARS},
+          {4, 4},
+          true /*unique*/));
+  char key[8] = {0};
+  for (int i = 0; i < 100; i++) {
+    memcpy(key, &i, sizeof(i));
+    snprintf(key + 4, 4, "%d", i % 7);
+    RID rid(1, i);
+    ASSERT_EQ(RC::SUCCESS, composite_handler.insert_entry(key, &rid));
+  }
+  int value = 42;
+  memset(key, 0, sizeof(key));
+  memcpy(key, &value, sizeof(value));
+  snprintf(key + 4, 4, "%d", value % 7);
+  rids.clear();
+  ASSERT_EQ(RC::SUCCESS, composite_handler.get_entry(key, sizeof(key), rids));
+  ASSERT_EQ(1, rids.size());
+  ASSERT_EQ(42, rids[0].slot_num);
+}
+
+TEST(HashIndex, deep_directory)
+{
+  filesystem::path test_directory = "hash_index_test_dir";
+  filesystem::remove_all(test_directory);
+  filesystem::create_directory(test_directory);
+
+  VacuousLogHandler log_handler;
+  BufferPoolManager bpm;
+  ASSERT_EQ(RC::SUCCESS, bpm.init(make_unique<VacuousDoubleWriteBuffer>()));
+
+  // 每个桶只放 2 项，目录需要多个目录页面
+  ExtendibleHashHandler handler;
+  ASSERT_EQ(RC::SUCCESS,
+      handler.create(log_handler, bpm, (test_directory / "deep.hash").c_str(), {AttrType::INTS}, {4}, false, 2));
+
+  const int insert_num = 20000;
+  for (int i = 0; i < insert_num; i++) {
+    RID rid(i, i);
+    ASSERT_EQ(RC::SUCCESS, handler.insert_entry(reinterpret_cast<const char *>(&i), &rid));
+  }
+  ASSERT_GT(handler.global_depth(), HashIndexFileHeader::DIR_PAGE_DEPTH + 1);
+  ASSERT_LE(handler.global_depth(), HashIndexFileHeader::MAX_GLOBAL_DEPTH);
+
+  vector<RID> rids;
+  for (int i = 0; i < insert_num; i++) {
+    ASSERT_EQ(RC::SUCCESS, lookup(handler, i, rids));
+    ASSERT_EQ(1, rids.size());
+    ASSERT_EQ(RID(i, i), rids[0]);
+  }
+}
+
+TEST(HashIndex, split_overflow_bucket)
+{
+  filesystem::path test_directory = "hash_index_test_dir";
+  filesystem::remove_all(test_directory);
+  filesystem::create_directory(test_directory);
+
+  VacuousLogHandler log_handler;
+  BufferPoolManager bpm;
+  ASSERT_EQ(RC::SUCCESS, bpm.init(make_unique<VacuousDoubleWriteBuffer>()));
+
+  ExtendibleHashHandler handler;
+  ASSERT_EQ(RC::SUCCESS,
+      handler.create(log_handler, bpm, (test_directory / "overflow.hash").c_str(), {AttrType::INTS}, {4}, false, 4));
+
+  // 相同的键值没法分裂，唯一的桶挂上了溢出页面
+  const int dup_num = 20;
+  int       key     = 0;
+  for (int i = 0; i < dup_num; i++) {
+    RID rid(0, i);
+    ASSERT_EQ(RC::SUCCESS, handler.insert_entry(reinterpret_cast<const char *>(&key), &rid));
+  }
+  ASSERT_EQ(0, handler.global_depth());
+
+  // 之后插入不同的键值，有溢出页面的桶也要分裂，不能一直挂溢出页面
+  const int insert_num = 200;
+  for (int i = 1; i <= insert_num; i++) {
+    RID rid(1, i);
+    ASSERT_EQ(RC::SUCCESS, handler.insert_entry(reinterpret_cast<const char *>(&i), &rid));
+  }
+  ASSERT_GT(handler.global_depth(), 0);
+
+  vector<RID> rids;
+  ASSERT_EQ(RC::SUCCESS, lookup(handler, 0, rids));
+  ASSERT_EQ(dup_num, rids.size());
+  for (int i = 1; i <= insert_num; i++) {
+    ASSERT_EQ(RC::SUCCESS, lookup(handler, i, rids));
+    ASSERT_EQ(1, rids.size());
+    ASSERT_EQ(RID(1, i), rids[0]);
+  }
+
+  // 分裂之后删除和再次插入都正常
+  for (int i = 0; i < dup_num; i++) {
+    RID rid(0, i);
+    ASSERT_EQ(RC::SUCCESS, handler.delete_entry(reinterpret_cast<const char *>(&key), &rid));
+  }
+  ASSERT_EQ(RC::SUCCESS, lookup(handler, 0, rids));
+  ASSERT_TRUE(rids.empty());
+  for (int i = 0; i < dup_num; i++) {
+    RID rid(2, i);
+    ASSERT_EQ(RC::SUCCESS, handler.insert_entry(reinterpret_cast<const char *>(&key), &rid));
+  }
+  ASSERT_EQ(RC::SUCCESS, lookup(handler, 0, rids));
+  ASSERT_EQ(dup_num, rids.size());
+}
+
+TEST(HashIndex, recover)
+{
+  filesystem::path test_directory = "hash_index_log_test_dir";
+  filesystem::remove_all(test_directory);
+  filesystem::create_directory(test_directory);
+
+  const filesystem::path bp_filename   = test_directory / "hash.bp";
+  const filesystem::path log_directory = test_directory / "clog";
+
+  // 1. 创建哈希索引并写入数据，日志写到磁盘上
+  auto bpm = make_unique<BufferPoolManager>();
+  ASSERT_EQ(RC::SUCCESS, bpm->init(make_unique<VacuousDoubleWriteBuffer>()));
+  auto log_handler = make_unique<DiskLogHandler>();
+  ASSERT_EQ(RC::SUCCESS, log_handler->init(log_directory.c_str()));
+  IntegratedLogReplayer log_replayer(*bpm);
+  ASSERT_EQ(RC::SUCCESS, log_handler->replay(log_replayer, 0));
+  ASSERT_EQ(RC::SUCCESS, log_handler->start());
+
+  ASSERT_EQ(RC::SUCCESS, bpm->create_file(bp_filename.c_str()));
+  DiskBufferPool *buffer_pool = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm->open_file(*log_handler, bp_filename.c_str(), buffer_pool));
+
+  // 桶很小，目录会超过一个目录页面，恢复时也要覆盖到目录页面的分配和加倍
+  auto handler = make_unique<ExtendibleHashHandler>();
+  ASSERT_EQ(RC::SUCCESS, handler->create(*log_handler, *buffer_pool, {AttrType::INTS}, {4}, false, 2));
+
+  const int insert_num = 3000;
+  for (int i = 0; i < insert_num; i++) {
+    RID rid(i, i);
+    ASSERT_EQ(RC::SUCCESS, handler->insert_entry(reinterpret_cast<const char *>(&i), &rid));
+  }
+  for (int i = 0; i < insert_num; i += 3) {
+    RID rid(i, i);
+    ASSERT_EQ(RC::SUCCESS, handler->delete_entry(reinterpret_cast<const char *>(&i), &rid));
+  }
+
+  ASSERT_EQ(RC::SUCCESS, log_handler->stop());
+  ASSERT_EQ(RC::SUCCESS, log_handler->await_termination());
+
+  // 2. 复制数据文件，只有创建时刷到磁盘的页面，其它的修改都需要从日志中恢复
+  const filesystem::path bp_filename2 = test_directory / "hash2.bp";
+  ASSERT_TRUE(filesystem::copy_file(bp_filename, bp_filename2));
+
+  handler.reset();
+  bpm.reset();
+  log_handler.reset();
+
+  // 3. 在复制出来的文件上重放日志
+  auto bpm2 = make_unique<BufferPoolManager>();
+  ASSERT_EQ(RC::SUCCESS, bpm2->init(make_unique<VacuousDoubleWriteBuffer>()));
+  auto            log_handler2 = make_unique<DiskLogHandler>();
+  DiskBufferPool *buffer_pool2 = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm2->open_file(*log_handler2, bp_filename2.c_str(), buffer_pool2));
+  ASSERT_EQ(RC::SUCCESS, log_handler2->init(log_directory.c_str()));
+
+  // 重放时使用的 buffer pool id 与原来的相同
+  IntegratedLogReplayer log_replayer2(*bpm2);
+  ASSERT_EQ(RC::SUCCESS, log_handler2->replay(log_replayer2, 0));
+
+  auto handler2 = make_unique<ExtendibleHashHandler>();
+  ASSERT_EQ(RC::SUCCESS, handler2->open(*log_handler2, *buffer_pool2));
+  ASSERT_GT(handler2->global_depth(), HashIndexFileHeader::DIR_PAGE_DEPTH);
+
+  vector<RID> rids;
+  for (int i = 0; i < insert_num; i++) {
+    ASSERT_EQ(RC::SUCCESS, lookup(*handler2, i, rids));
+    if (i % 3 == 0) {
+      ASSERT_TRUE(rids.empty());
+    } else {
+      ASSERT_EQ(1, rids.size());
+      ASSERT_EQ(RID(i, i), rids[0]);
+    }
+  }
+
+  handler2.reset();
+  bpm2.reset();
+  log_handler2.reset();
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  filesystem::path log_filename = filesystem::path(argv[0]).filename();
+  LoggerFactory::init_default(log_filename.string() + ".log", LOG_LEVEL_INFO);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,608 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "common/lang/algorithm.h"
+#include "common/lang/functional.h"
+#include "common/lang/memory.h"
+#include "common/lang/string.h"
+#include "common/lang/vector.h"
+#include "sql/expr/expression.h"
+#include "sql/operator/hash_join_physical_operator.h"
+#include "sql/operator/hash_join_vec_physical_operator.h"
+#include "sql/operator/join_logical_operator.h"
+#include "sql/operator/predicate_logical_operator.h"
+#include "sql/operator/table_get_logical_operator.h"
+#include "sql/optimizer/predicate_pushdown_rewriter.h"
+#include "storage/common/chunk.h"
+#include "storage/table/table.h"
+#include "gtest/gtest.h"
+
+using namespace std;
+
+namespace {
+
+/**
+ * @brief 逐行输出给定数据的算子，作为 hash join 的孩子
+ */
+class ValueListPhysicalOperator : public PhysicalOperator
+{
+public:
+  ValueListPhysicalOperator(const vector<TupleCellSpec> &specs, const vector<vector<Value>> &rows) : rows_(rows)
+  {
+    tuple_.set_names(specs);
+  }
+
+  PhysicalOperatorType type() const override { return PhysicalOperatorType::STRING_LIST; }
+
+  RC open(Trx *) override
+  {
+    pos_ = -1;
+    return RC::SUCCESS;
+  }
+
+  RC next() override
+  {
+    if (++pos_ >= static_cast<int>(rows_.size())) {
+      return RC::RECORD_EOF;
+    }
+    tuple_.set_cells(rows_[pos_]);
+    return RC::SUCCESS;
+  }
+
+  RC close() override { return RC::SUCCESS; }
+
+  Tuple *current_tuple() override { return &tuple_; }
+
+private:
+  vector<vector<Value>> rows_;
+  int                   pos_ = -1;
+  ValueListTuple        tuple_;
+};
+
+/**
+ * @brief 两个字段的表：left(l_id, l_key)，right(r_id, r_key)
+ */
+class HashJoinTest : public testing::Test
+{
+protected:
+  HashJoinTest()
+      : l_id_("l_id", AttrType::INTS, 0, 4, true, 0),
+        l_key_("l_key", AttrType::INTS, 4, 4, true, 1, true),
+        r_id_("r_id", AttrType::INTS, 0, 4, true, 0),
+        r_key_("r_key", AttrType::INTS, 4, 4, true, 1, true)
+  {}
+
+  /// 使用 hash join 连接两组数据，按照 "左表id,右表id" 的形式返回排好序的结果
+  vector<string> hash_join(
+      const vector<vector<Value>> &left_rows, const vector<vector<Value>> &right_rows, bool build_left)
+  {
+    vector<unique_ptr<Expression>> left_keys;
+    vector<unique_ptr<Expression>> right_keys;
+    left_keys.emplace_back(make_unique<FieldExpr>(&left_table_, &l_key_));
+    right_keys.emplace_back(make_unique<FieldExpr>(&right_table_, &r_key_));
+
+    HashJoinPhysicalOperator join(std::move(left_keys), std::move(right_keys), build_left);
+    join.add_child(make_unique<ValueListPhysicalOperator>(specs(left_table_, l_id_, l_key_), left_rows));
+    join.add_child(make_unique<ValueListPhysicalOperator>(specs(right_table_, r_id_, r_key_), right_rows));
+
+    vector<string> results;
+    EXPECT_EQ(RC::SUCCESS, join.open(nullptr));
+    RC rc = RC::SUCCESS;
+    while (OB_SUCC(rc = join.next())) {
+      Tuple *tuple = join.current_tuple();
+      EXPECT_EQ(4, tuple->cell_num());
+
+      // 左表的列总是在前面
+      Value left_id;
+      Value right_id;
+      EXPECT_EQ(RC::SUCCESS, tuple->cell_at(0, left_id));
+      EXPECT_EQ(RC::SUCCESS, tuple->cell_at(2, right_id));
+      results.push_back(left_id.to_string() + "," + right_id.to_string());
+    }
+    EXPECT_EQ(RC::RECORD_EOF, rc);
+    EXPECT_EQ(RC::SUCCESS, join.close());
+
+    sort(results.begin(), results.end());
+    return results;
+  }
+
+  /// 嵌套循环计算的期望结果，NULL 不与任何值相等
+  static vector<string> nested_loop_join(
+      const vector<vector<Value>> &left_rows, const vector<vector<Value>> &right_rows)
+  {
+    vector<string> results;
+    for (const vector<Value> &left : left_rows) {
+      for (const vector<Value> &right : right_rows) {
+        if (left[1].attr_type() != AttrType::NULLS && right[1].attr_type() != AttrType::NULLS &&
+            left[1].compare(right[1]) == 0) {
+          results.push_back(left[0].to_string() + "," + right[0].to_string());
+        }
+      }
+    }
+    sort(results.begin(), results.end());
+    return results;
+  }
+
+  static vector<TupleCellSpec> specs(const Table &table, const FieldMeta &id, const FieldMeta &key)
+  {
+    return {TupleCellSpec(table.name(), id.name()), TupleCellSpec(table.name(), key.name())};
+  }
+
+protected:
+  Table     left_table_;
+  Table     right_table_;
+  FieldMeta l_id_;
+  FieldMeta l_key_;
+  FieldMeta r_id_;
+  FieldMeta r_key_;
+};
+
+vector<Value> row(int id, int key) { return {Value(id), Value(key)}; }
+vector<Value> null_row(int id) { return {Value(id), Value::Null()}; }
+
+}  // namespace
+
+TEST_F(HashJoinTest, duplicate_keys)
+{
+  vector<vector<Value>> left_rows  = {row(1, 1), row(2, 1), row(3, 2), row(4, 3), row(5, 1)};
+  vector<vector<Value>> right_rows = {row(10, 1), row(11, 2), row(12, 1), row(13, 4), row(14, 2)};
+
+  vector<string> expected = nested_loop_join(left_rows, right_rows);
+  ASSERT_EQ(8, static_cast<int>(expected.size()));
+  ASSERT_EQ(expected, hash_join(left_rows, right_rows, true));
+  ASSERT_EQ(expected, hash_join(left_rows, right_rows, false));
+}
+
+TEST_F(HashJoinTest, null_keys)
+{
+  vector<vector<Value>> left_rows  = {row(1, 1), null_row(2), null_row(3), row(4, 2)};
+  vector<vector<Value>> right_rows = {null_row(10), row(11, 1), null_row(12), row(13, 2)};
+
+  vector<string> expected = {"1,11", "4,13"};
+  ASSERT_EQ(expected, nested_loop_join(left_rows, right_rows));
+  ASSERT_EQ(expected, hash_join(left_rows, right_rows, true));
+  ASSERT_EQ(expected, hash_join(left_rows, right_rows, false));
+}
+
+TEST_F(HashJoinTest, empty_side)
+{
+  vector<vector<Value>> rows = {row(1, 1), row(2, 2)};
+  vector<vector<Value>> empty_rows;
+
+  // 构建侧为空，或者探测侧为空
+  ASSERT_TRUE(hash_join(empty_rows, rows, true).empty());
+  ASSERT_TRUE(hash_join(rows, empty_rows, false).empty());
+  ASSERT_TRUE(hash_join(rows, empty_rows, true).empty());
+  ASSERT_TRUE(hash_join(empty_rows, rows, false).empty());
+
+  // 构建侧只有 NULL，哈希表也是空的
+  ASSERT_TRUE(hash_join({null_row(1)}, rows, true).empty());
+}
+
+TEST_F(HashJoinTest, no_match)
+{
+  vector<vector<Value>> left_rows  = {row(1, 1), row(2, 3)};
+  vector<vector<Value>> right_rows = {row(10, 2), row(11, 4)};
+  ASSERT_TRUE(hash_join(left_rows, right_rows, true).empty());
+  ASSERT_TRUE(hash_join(left_rows, right_rows, false).empty());
+}
+
+namespace {
+
+/**
+ * @brief 三个表 t1、t2、t3，都有 int 类型的 a 字段和 float 类型的 b 字段
+ */
+class PushdownJoinConditionTest : public testing::Test
+{
+protected:
+  PushdownJoinConditionTest() : a_("a", AttrType::INTS, 0, 4, true, 0), b_("b", AttrType::FLOATS, 4, 4, true, 1) {}
+
+  unique_ptr<Expression> field(const Table &table, const FieldMeta &meta)
+  {
+    return make_unique<FieldExpr>(&table, &meta);
+  }
+
+  unique_ptr<Expression> compare(CompOp comp, unique_ptr<Expression> left, unique_ptr<Expression> right)
+  {
+    return make_unique<ComparisonExpr>(comp, std::move(left), std::move(right));
+  }
+
+  unique_ptr<Expression> conjunction(vector<unique_ptr<Expression>> children)
+  {
+    return make_unique<ConjunctionExpr>(ConjunctionExpr::Type::AND, children);
+  }
+
+  unique_ptr<LogicalOperator> table_get(Table &table)
+  {
+    return make_unique<TableGetLogicalOperator>(&table, ReadWriteMode::READ_ONLY);
+  }
+
+  unique_ptr<LogicalOperator> join(unique_ptr<LogicalOperator> left, unique_ptr<LogicalOperator> right)
+  {
+    auto join_oper = make_unique<JoinLogicalOperator>();
+    join_oper->add_child(std::move(left));
+    join_oper->add_child(std::move(right));
+    return join_oper;
+  }
+
+  /// 在 join 上面放一个谓词算子，执行一次下推
+  unique_ptr<LogicalOperator> rewrite(
+      unique_ptr<Expression> predicate, unique_ptr<LogicalOperator> join_oper, bool &change_made)
+  {
+    unique_ptr<LogicalOperator> oper = make_unique<PredicateLogicalOperator>(std::move(predicate));
+    oper->add_child(std::move(join_oper));
+
+    PredicatePushdownRewriter rewriter;
+    change_made = false;
+    EXPECT_EQ(RC::SUCCESS, rewriter.rewrite(oper, change_made));
+    return oper;
+  }
+
+  /// 检查连接条件的左边引用 left 表，右边引用 right 表
+  static void check_condition(Expression &expr, const Table &left, const Table &right)
+  {
+    ASSERT_EQ(ExprType::COMPARISON, expr.type());
+    auto &comparison_expr = static_cast<ComparisonExpr &>(expr);
+    ASSERT_EQ(CompOp::EQUAL_TO, comparison_expr.comp());
+    ASSERT_EQ(ExprType::FIELD, comparison_expr.left()->type());
+    ASSERT_EQ(ExprType::FIELD, comparison_expr.right()->type());
+    ASSERT_EQ(&left, static_cast<FieldExpr *>(comparison_expr.left().get())->field().table());
+    ASSERT_EQ(&right, static_cast<FieldExpr *>(comparison_expr.right().get())->field().table());
+  }
+
+  /// 所有条件都下推之后，谓词算子只剩下一个恒为真的表达式
+  static bool is_true_predicate(LogicalOperator &predicate_oper)
+  {
+    unique_ptr<Expression> &expr = predicate_oper.expressions().front();
+    return expr->type() == ExprType::VALUE && static_cast<ValueExpr *>(expr.get())->get_value().get_boolean();
+  }
+
+protected:
+  Table     t1_;
+  Table     t2_;
+  Table     t3_;
+  FieldMeta a_;
+  FieldMeta b_;
+};
+
+}  // namespace
+
+TEST_F(PushdownJoinConditionTest, keep_sides)
+{
+  bool change_made = false;
+  auto oper =
+      rewrite(compare(EQUAL_TO, field(t1_, a_), field(t2_, a_)), join(table_get(t1_), table_get(t2_)), change_made);
+  ASSERT_TRUE(change_made);
+
+  LogicalOperator &join_oper = *oper->children().front();
+  ASSERT_EQ(1, static_cast<int>(join_oper.expressions().size()));
+  check_condition(*join_oper.expressions().front(), t1_, t2_);
+  ASSERT_TRUE(is_true_predicate(*oper));
+}
+
+TEST_F(PushdownJoinConditionTest, swap_sides)
+{
+  // 条件的左边引用的是右孩子，下推时交换两边
+  bool change_made = false;
+  auto oper =
+      rewrite(compare(EQUAL_TO, field(t2_, a_), field(t1_, a_)), join(table_get(t1_), table_get(t2_)), change_made);
+  ASSERT_TRUE(change_made);
+
+  LogicalOperator &join_oper = *oper->children().front();
+  ASSERT_EQ(1, static_cast<int>(join_oper.expressions().size()));
+  check_condition(*join_oper.expressions().front(), t1_, t2_);
+  ASSERT_TRUE(is_true_predicate(*oper));
+}
+
+TEST_F(PushdownJoinConditionTest, reject)
+{
+  vector<unique_ptr<Expression>> conditions;
+  // 类型不同的连接键哈希值不一致
+  conditions.push_back(compare(EQUAL_TO, field(t1_, a_), field(t2_, b_)));
+  // 不是等值条件
+  conditions.push_back(compare(LESS_THAN, field(t1_, a_), field(t2_, a_)));
+  // 只引用了一个表
+  conditions.push_back(compare(EQUAL_TO, field(t1_, a_), make_unique<ValueExpr>(Value(1))));
+  conditions.push_back(compare(EQUAL_TO, field(t1_, a_), field(t1_, a_)));
+
+  bool change_made = false;
+  auto oper        = rewrite(conjunction(std::move(conditions)), join(table_get(t1_), table_get(t2_)), change_made);
+  ASSERT_FALSE(change_made);
+  ASSERT_TRUE(oper->children().front()->expressions().empty());
+
+  unique_ptr<Expression> &predicate = oper->expressions().front();
+  ASSERT_EQ(ExprType::CONJUNCTION, predicate->type());
+  ASSERT_EQ(4, static_cast<int>(static_cast<ConjunctionExpr *>(predicate.get())->children().size()));
+}
+
+TEST_F(PushdownJoinConditionTest, float_keys)
+{
+  // 误差范围内的浮点数比较结果是相等，但是哈希值不同，不能作为 hash join 的连接键
+  Value left(1.0f);
+  Value right(1.0000001f);
+  ASSERT_EQ(0, left.compare(right));
+  ASSERT_NE(hash<float>()(left.get_float()), hash<float>()(right.get_float()));
+
+  bool change_made = false;
+  auto oper =
+      rewrite(compare(EQUAL_TO, field(t1_, b_), field(t2_, b_)), join(table_get(t1_), table_get(t2_)), change_made);
+  ASSERT_FALSE(change_made);
+  ASSERT_TRUE(oper->children().front()->expressions().empty());
+
+  unique_ptr<Expression> &predicate = oper->expressions().front();
+  ASSERT_EQ(ExprType::COMPARISON, predicate->type());
+  ASSERT_EQ(EQUAL_TO, static_cast<ComparisonExpr *>(predicate.get())->comp());
+}
+
+TEST_F(PushdownJoinConditionTest, nested_join)
+{
+  // (t1 join t2) join t3
+  vector<unique_ptr<Expression>> conditions;
+  conditions.push_back(compare(EQUAL_TO, field(t3_, a_), field(t2_, a_)));
+  conditions.push_back(compare(EQUAL_TO, field(t2_, a_), field(t1_, a_)));
+  conditions.push_back(compare(EQUAL_TO, field(t1_, a_), field(t3_, a_)));
+  conditions.push_back(compare(GREAT_THAN, field(t1_, a_), field(t3_, a_)));
+
+  bool change_made = false;
+  auto oper        = rewrite(conjunction(std::move(conditions)),
+      join(join(table_get(t1_), table_get(t2_)), table_get(t3_)), change_made);
+  ASSERT_TRUE(change_made);
+
+  // t2 与 t3、t1 与 t3 之间的条件留在上层的连接，左边都来自下层的连接
+  LogicalOperator &upper_join = *oper->children().front();
+  ASSERT_EQ(2, static_cast<int>(upper_join.expressions().size()));
+  check_condition(*upper_join.expressions()[0], t2_, t3_);
+  check_condition(*upper_join.expressions()[1], t1_, t3_);
+
+  // t1 与 t2 之间的条件下推到下层的连接
+  LogicalOperator &lower_join = *upper_join.children().front();
+  ASSERT_EQ(1, static_cast<int>(lower_join.expressions().size()));
+  check_condition(*lower_join.expressions().front(), t1_, t2_);
+
+  // 不是等值条件的留在谓词中
+  unique_ptr<Expression> &predicate = oper->expressions().front();
+  ASSERT_EQ(ExprType::CONJUNCTION, predicate->type());
+  auto &children = static_cast<ConjunctionExpr *>(predicate.get())->children();
+  ASSERT_EQ(1, static_cast<int>(children.size()));
+  ASSERT_EQ(GREAT_THAN, static_cast<ComparisonExpr *>(children.front().get())->comp());
+}
+
+namespace {
+
+/**
+ * @brief 按 chunk 输出给定数据的算子，作为向量化 hash join 的孩子
+ */
+class ChunkListPhysicalOperator : public PhysicalOperator
+{
+public:
+  PhysicalOperatorType type() const override { return PhysicalOperatorType::STRING_LIST; }
+
+  void add_chunk(unique_ptr<Chunk> chunk) { chunks_.emplace_back(std::move(chunk)); }
+
+  RC open(Trx *) override
+  {
+    pos_ = 0;
+    return RC::SUCCESS;
+  }
+
+  RC next(Chunk &chunk) override
+  {
+    if (pos_ >= chunks_.size()) {
+      return RC::RECORD_EOF;
+    }
+    return chunk.reference(*chunks_[pos_++]);
+  }
+
+  RC close() override { return RC::SUCCESS; }
+
+private:
+  vector<unique_ptr<Chunk>> chunks_;
+  size_t                    pos_ = 0;
+};
+
+/**
+ * @brief 向量化 hash join 与逐行的 hash join 比较结果
+ * @details 两边的数据都是 (id int, k1 int, k2 char(8))，按照 k1 或者 (k1, k2) 连接。
+ * 数据分成多个 chunk，每个 chunk 带有选择向量，没有被选中的行不参与连接
+ */
+class HashJoinVecTest : public testing::Test
+{
+protected:
+  static constexpr int CHARS_LEN = 8;
+
+  struct Row
+  {
+    int    id;
+    int    k1;
+    string k2;
+  };
+
+  HashJoinVecTest()
+  {
+    for (const char *prefix : {"l_", "r_"}) {
+      fields_.emplace_back(make_unique<FieldMeta>((string(prefix) + "id").c_str(), AttrType::INTS, 0, 4, true, 0));
+      fields_.emplace_back(make_unique<FieldMeta>((string(prefix) + "k1").c_str(), AttrType::INTS, 4, 4, true, 1));
+      fields_.emplace_back(
+          make_unique<FieldMeta>((string(prefix) + "k2").c_str(), AttrType::CHARS, 8, CHARS_LEN, true, 2));
+    }
+  }
+
+  /**
+   * @brief 每 chunk_rows 行组成一个 chunk，selected 返回 false 的行不选中
+   * @param selected_rows 返回被选中的行，用于逐行的 hash join
+   */
+  static unique_ptr<PhysicalOperator> make_chunks(const vector<Row> &rows, int chunk_rows,
+      const function<bool(const Row &)> &selected, vector<vector<Value>> &selected_rows)
+  {
+    auto oper = make_unique<ChunkListPhysicalOperator>();
+    for (size_t start = 0; start < rows.size(); start += chunk_rows) {
+      const int size  = static_cast<int>(min(rows.size() - start, static_cast<size_t>(chunk_rows)));
+      auto      id    = make_unique<Column>(AttrType::INTS, 4, size);
+      auto      k1    = make_unique<Column>(AttrType::INTS, 4, size);
+      auto      k2    = make_unique<Column>(AttrType::CHARS, CHARS_LEN, size);
+      vector<uint8_t> select(size, 1);
+      for (int i = 0; i < size; i++) {
+        const Row &row = rows[start + i];
+        char       chars[CHARS_LEN] = {0};
+        memcpy(chars, row.k2.data(), min(row.k2.size(), static_cast<size_t>(CHARS_LEN)));
+        id->append_one(const_cast<char *>(reinterpret_cast<const char *>(&row.id)));
+        k1->append_one(const_cast<char *>(reinterpret_cast<const char *>(&row.k1)));
+        k2->append_one(chars);
+        if (selected(row)) {
+          selected_rows.push_back({Value(row.id), Value(row.k1), Value(row.k2.c_str())});
+        } else {
+          select[i] = 0;
+        }
+      }
+
+      auto chunk = make_unique<Chunk>();
+      chunk->add_column(std::move(id), 0);
+      chunk->add_column(std::move(k1), 1);
+      chunk->add_column(std::move(k2), 2);
+      chunk->set_select(select);
+      oper->add_chunk(std::move(chunk));
+    }
+    return oper;
+  }
+
+  /// 连接键：左边的字段在 fields_ 的 [0, 3)，右边在 [3, 6)
+  vector<unique_ptr<Expression>> keys(bool left, int key_num, bool vectorized)
+  {
+    vector<unique_ptr<Expression>> exprs;
+    for (int i = 1; i <= key_num; i++) {
+      const FieldMeta *meta = fields_[(left ? 0 : 3) + i].get();
+      auto             expr = make_unique<FieldExpr>(left ? &left_table_ : &right_table_, meta);
+      if (vectorized) {
+        expr->set_pos(i);
+      }
+      exprs.emplace_back(std::move(expr));
+    }
+    return exprs;
+  }
+
+  vector<TupleCellSpec> specs(bool left)
+  {
+    const Table          &table = left ? left_table_ : right_table_;
+    vector<TupleCellSpec> result;
+    for (int i = 0; i < 3; i++) {
+      result.emplace_back(table.name(), fields_[(left ? 0 : 3) + i]->name());
+    }
+    return result;
+  }
+
+  /**
+   * @brief 分别使用两种 hash join 连接，比较 "左表id,右表id" 组成的结果
+   * @return 向量化 hash join 输出的 chunk 个数
+   */
+  int check(const vector<Row> &left_rows, const vector<Row> &right_rows, int key_num, bool build_left)
+  {
+    auto left_selected  = [](const Row &row) { return row.id % 3 != 0; };
+    auto right_selected = [](const Row &row) { return row.id % 5 != 0; };
+
+    vector<vector<Value>> left_values;
+    vector<vector<Value>> right_values;
+    HashJoinVecPhysicalOperator vec_join(keys(true, key_num, true), keys(false, key_num, true), build_left);
+    vec_join.add_child(make_chunks(left_rows, 100, left_selected, left_values));
+    vec_join.add_child(make_chunks(right_rows, 70, right_selected, right_values));
+
+    vector<string> vec_results;
+    int            chunk_num = 0;
+    Chunk          chunk;
+    EXPECT_EQ(RC::SUCCESS, vec_join.open(nullptr));
+    RC rc = RC::SUCCESS;
+    while (OB_SUCC(rc = vec_join.next(chunk))) {
+      chunk_num++;
+      EXPECT_EQ(6, chunk.column_num());
+      EXPECT_GT(chunk.rows(), 0);
+      for (int row = 0; row < chunk.rows(); row++) {
+        // 左表的列总是在前面
+        vec_results.push_back(
+            chunk.get_value(0, row).to_string() + "," + chunk.get_value(3, row).to_string());
+      }
+    }
+    EXPECT_EQ(RC::RECORD_EOF, rc);
+    EXPECT_EQ(RC::SUCCESS, vec_join.close());
+
+    HashJoinPhysicalOperator join(keys(true, key_num, false), keys(false, key_num, false), build_left);
+    join.add_child(make_unique<ValueListPhysicalOperator>(specs(true), left_values));
+    join.add_child(make_unique<ValueListPhysicalOperator>(specs(false), right_values));
+
+    vector<string> results;
+    EXPECT_EQ(RC::SUCCESS, join.open(nullptr));
+    while (OB_SUCC(rc = join.next())) {
+      Value left_id;
+      Value right_id;
+      join.current_tuple()->cell_at(0, left_id);
+      join.current_tuple()->cell_at(3, right_id);
+      results.push_back(left_id.to_string() + "," + right_id.to_string());
+    }
+    EXPECT_EQ(RC::RECORD_EOF, rc);
+    EXPECT_EQ(RC::SUCCESS, join.close());
+
+    sort(vec_results.begin(), vec_results.end());
+    sort(results.begin(), results.end());
+    EXPECT_EQ(results, vec_results);
+    return chunk_num;
+  }
+
+protected:
+  Table                           left_table_;
+  Table                           right_table_;
+  vector<unique_ptr<FieldMeta>>   fields_;
+};
+
+}  // namespace
+
+TEST_F(HashJoinVecTest, duplicate_keys)
+{
+  // 每个键值在左边有 30 行，在右边有 40 行，匹配的行数超过一个输出 chunk 的容量
+  vector<Row> left_rows;
+  vector<Row> right_rows;
+  for (int i = 0; i < 300; i++) {
+    left_rows.push_back({i, i % 10, "k" + to_string(i % 4)});
+  }
+  for (int i = 0; i < 400; i++) {
+    right_rows.push_back({1000 + i, i % 10 + 5, "k" + to_string(i % 3)});
+  }
+
+  for (bool build_left : {true, false}) {
+    ASSERT_GT(check(left_rows, right_rows, 1, build_left), 1);
+    ASSERT_GT(check(left_rows, right_rows, 2, build_left), 0);
+  }
+}
+
+TEST_F(HashJoinVecTest, chars_keys)
+{
+  // 定长字符串后面补0，长度不同的前缀不能相等
+  vector<Row> left_rows  = {{1, 1, "a"}, {2, 1, "ab"}, {4, 1, "abcdefgh"}, {5, 2, ""}, {7, 1, "ab"}};
+  vector<Row> right_rows = {{11, 1, "ab"}, {12, 1, "abcdefgh"}, {13, 1, "abc"}, {14, 2, ""}, {16, 1, "a"}};
+  for (bool build_left : {true, false}) {
+    ASSERT_EQ(1, check(left_rows, right_rows, 2, build_left));
+  }
+}
+
+TEST_F(HashJoinVecTest, empty_side)
+{
+  vector<Row> rows = {{1, 1, "a"}, {2, 2, "b"}};
+  vector<Row> empty_rows;
+  // 被选择向量全部过滤掉的一侧也是空的
+  vector<Row> unselected_rows = {{3, 1, "a"}, {6, 2, "b"}};
+  for (bool build_left : {true, false}) {
+    ASSERT_EQ(0, check(rows, empty_rows, 1, build_left));
+    ASSERT_EQ(0, check(empty_rows, rows, 1, build_left));
+    ASSERT_EQ(0, check(unselected_rows, rows, 1, build_left));
+  }
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -64,6 +64,79 @@ TEST(ParserTest, DISABLED_group_by_test)
   }
 }
 
+TEST(ParserTest, limit_test)
+{
+  {
+    ParsedSqlResult result;
+    const char     *sql = "select a from tab";
+    ASSERT_EQ(parse(sql, &result), RC::SUCCESS);
+    ASSERT_EQ(result.sql_nodes().front()->selection.limit.limit, -1);
+  }
+  {
+    ParsedSqlResult result;
+    const char     *sql = "select a from tab limit 10";
+    ASSERT_EQ(parse(sql, &result), RC::SUCCESS);
+    ASSERT_EQ(result.sql_nodes().front()->selection.limit.limit, 10);
+    ASSERT_EQ(result.sql_nodes().front()->selection.limit.offset, 0);
+  }
+  {
+    ParsedSqlResult result;
+    const char     *sql = "select a from tab where a > 1 group by a limit 10 offset 20";
+    ASSERT_EQ(parse(sql, &result), RC::SUCCESS);
+    ASSERT_EQ(result.sql_nodes().front()->selection.limit.limit, 10);
+    ASSERT_EQ(result.sql_nodes().front()->selection.limit.offset, 20);
+  }
+  {
+    ParsedSqlResult result;
+    const char     *sql = "select a from tab Limit 20, 10";
+    ASSERT_EQ(parse(sql, &result), RC::SUCCESS);
+    ASSERT_EQ(result.sql_nodes().front()->selection.limit.limit, 10);
+    ASSERT_EQ(result.sql_nodes().front()->selection.limit.offset, 20);
+  }
+  {
+    // 列名中包含关键字仍然是普通的 ID
+    ParsedSqlResult result;
+    const char     *sql = "select limits, offset_a from tab";
+    ASSERT_EQ(parse(sql, &result), RC::SUCCESS);
+    ASSERT_EQ(result.sql_nodes().front()->flag, SCF_SELECT);
+  }
+  {
+    ParsedSqlResult result;
+    const char     *sql = "select a from tab LIMIT 1 Offset 2";
+    ASSERT_EQ(parse(sql, &result), RC::SUCCESS);
+    ASSERT_EQ(result.sql_nodes().front()->selection.limit.limit, 1);
+    ASSERT_EQ(result.sql_nodes().front()->selection.limit.offset, 2);
+  }
+}
+
+TEST(ParserTest, create_index_keyword_test)
+{
+  {
+    ParsedSqlResult result;
+    const char     *sql = "create index i on tab(a) Using hash";
+    ASSERT_EQ(parse(sql, &result), RC::SUCCESS);
+    const CreateIndexSqlNode &create_index = result.sql_nodes().front()->create_index;
+    ASSERT_EQ(create_index.index_type, "hash");
+    ASSERT_FALSE(create_index.prefix_compressed);
+  }
+  {
+    ParsedSqlResult result;
+    const char     *sql = "CREATE INDEX i ON tab(a) COMPRESS";
+    ASSERT_EQ(parse(sql, &result), RC::SUCCESS);
+    const CreateIndexSqlNode &create_index = result.sql_nodes().front()->create_index;
+    ASSERT_TRUE(create_index.index_type.empty());
+    ASSERT_TRUE(create_index.prefix_compressed);
+  }
+  {
+    // 列名中包含关键字仍然是普通的 ID
+    ParsedSqlResult result;
+    const char     *sql = "create index i on tab(compressed, usingx, offsetx)";
+    ASSERT_EQ(parse(sql, &result), RC::SUCCESS);
+    const CreateIndexSqlNode &create_index = result.sql_nodes().front()->create_index;
+    ASSERT_EQ(create_index.attribute_names, (vector<string>{"compressed", "usingx", "offsetx"}));
+  }
+}
+
 int main(int argc, char **argv)
 {
 
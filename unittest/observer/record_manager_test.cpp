@@ -204,6 +204,55 @@ TEST(RecordFileScanner, test_record_file_iterator)
   delete bpm;
 }
 
+TEST(RecordFileHandler, test_get_records)
+{
+  VacuousLogHandler log_handler;
+
+  const char *record_manager_file = "record_manager_batch.bp";
+  filesystem::remove(record_manager_file);
+
+  BufferPoolManager *bpm = new BufferPoolManager();
+  ASSERT_EQ(RC::SUCCESS, bpm->init(make_unique<VacuousDoubleWriteBuffer>()));
+  DiskBufferPool *bp = nullptr;
+  ASSERT_EQ(RC::SUCCESS, bpm->create_file(record_manager_file));
+  ASSERT_EQ(RC::SUCCESS, bpm->open_file(log_handler, record_manager_file, bp));
+
+  RecordFileHandler file_handler(StorageFormat::ROW_FORMAT);
+  ASSERT_EQ(RC::SUCCESS, file_handler.init(*bp, log_handler, nullptr));
+
+  const int        record_insert_num = 1000;
+  char             record_data[20]   = {0};
+  std::vector<RID> rids;
+  for (int i = 0; i < record_insert_num; i++) {
+    RID rid;
+    memcpy(record_data, &i, sizeof(i));
+    ASSERT_EQ(RC::SUCCESS, file_handler.insert_record(record_data, sizeof(record_data), &rid));
+    rids.push_back(rid);
+  }
+  ASSERT_GT(rids.back().page_num, rids.front().page_num);
+
+  // 删除的记录会被跳过
+  int delete_num = 0;
+  for (int i = 0; i < record_insert_num; i += 3) {
+    ASSERT_EQ(RC::SUCCESS, file_handler.delete_record(&rids[i]));
+    delete_num++;
+  }
+
+  std::vector<Record> records;
+  ASSERT_EQ(RC::SUCCESS, file_handler.get_records(rids, records));
+  ASSERT_EQ(records.size(), static_cast<size_t>(record_insert_num - delete_num));
+  for (const Record &record : records) {
+    int value = 0;
+    memcpy(&value, record.data(), sizeof(value));
+    ASSERT_NE(0, value % 3);
+    ASSERT_EQ(record.rid(), rids[value]);
+  }
+
+  bpm->close_file(record_manager_file);
+  delete bpm;
+  filesystem::remove(record_manager_file);
+}
+
 TEST(RecordManager, durability)
 {
   /*
@@ -0,0 +1,98 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "storage/table/row_counter.h"
+#include "gtest/gtest.h"
+
+using namespace std;
+
+// 第一次计算、未提交修改和事务号可见性的处理与 VisibilityMap 相同，见 visibility_map_test
+
+TEST(RowCounterTest, insert_delete)
+{
+  RowCounter counter;
+
+  int64_t rows   = 0;
+  auto    loader = [](RowCounter::State &state) {
+    state.rows = 5;
+    return true;
+  };
+  ASSERT_TRUE(counter.count(1, loader, rows));
+  ASSERT_EQ(5, rows);
+
+  // 插入和删除提交以后按照变化的条数更新
+  counter.begin_change();
+  counter.commit_change(2, 1);
+  counter.begin_change();
+  counter.commit_change(3, 1);
+  ASSERT_TRUE(counter.count(3, loader, rows));
+  ASSERT_EQ(7, rows);
+
+  counter.begin_change();
+  counter.commit_change(4, -3);
+  ASSERT_TRUE(counter.count(4, loader, rows));
+  ASSERT_EQ(4, rows);
+}
+
+TEST(RowCounterTest, rollback)
+{
+  RowCounter counter;
+
+  int64_t rows   = 0;
+  auto    loader = [](RowCounter::State &state) {
+    state.rows = 5;
+    return true;
+  };
+  ASSERT_TRUE(counter.count(1, loader, rows));
+
+  // 回滚的插入和删除不改变行数
+  counter.begin_change();
+  counter.begin_change();
+  counter.rollback_change();
+  counter.rollback_change();
+  ASSERT_TRUE(counter.count(1, loader, rows));
+  ASSERT_EQ(5, rows);
+}
+
+TEST(RowCounterTest, change_before_load)
+{
+  RowCounter counter;
+
+  // 计算之前提交的修改已经包含在计算结果中，不能重复计算
+  counter.begin_change();
+  counter.commit_change(8, 1);
+
+  int64_t rows   = 0;
+  auto    loader = [](RowCounter::State &state) {
+    state.rows = 6;
+    return true;
+  };
+  ASSERT_TRUE(counter.count(8, loader, rows));
+  ASSERT_EQ(6, rows);
+
+  // 重置之后重新计算
+  counter.begin_change();
+  counter.commit_change(9, -1);
+  ASSERT_TRUE(counter.count(9, loader, rows));
+  ASSERT_EQ(5, rows);
+  counter.reset();
+  ASSERT_TRUE(counter.count(9, loader, rows));
+  ASSERT_EQ(6, rows);
+}
+
+int main(int argc, char **argv)
+{
+  // 分析gtest程序的命令行参数
+  testing::InitGoogleTest(&argc, argv);
+
+  // 调用RUN_ALL_TESTS()运行所有测试用例
+  // main函数返回RUN_ALL_TESTS()的运行结果
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,223 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include <unistd.h>
+
+#include "common/lang/algorithm.h"
+#include "sql/operator/row_sort_run.h"
+#include "storage/common/sort_run.h"
+#include "gtest/gtest.h"
+
+using namespace std;
+
+static Value make_date(int i)
+{
+  Date date{2024, static_cast<uint8_t>(1 + i % 12), static_cast<uint8_t>(1 + i % 28)};
+  return Value(AttrType::DATES, reinterpret_cast<char *>(&date), sizeof(date));
+}
+
+TEST(SortRunTest, write_and_read)
+{
+  const string file_name = "sort_run_test.run";
+  {
+    RowSortRun run(file_name);
+    ASSERT_EQ(run.open_write(), RC::SUCCESS);
+
+    const int row_num = 1000;
+    for (int i = 0; i < row_num; i++) {
+      Value null_value;
+      null_value.set_null();
+      Value date_value = make_date(i);
+      const string str = "row" + to_string(i);
+
+      vector<Value> keys{Value(i), Value(str.c_str())};
+      vector<Value> cells{Value(i), Value(i * 0.5f), Value(str.c_str()), null_value, Value(i % 2 == 0), date_value};
+      ASSERT_EQ(run.write(keys, cells), RC::SUCCESS);
+    }
+    ASSERT_EQ(run.finish_write(), RC::SUCCESS);
+    ASSERT_EQ(run.row_num(), row_num);
+
+    ASSERT_EQ(run.open_read(), RC::SUCCESS);
+    for (int i = 0; i < row_num; i++) {
+      ASSERT_EQ(run.next(), RC::SUCCESS);
+      const string str = "row" + to_string(i);
+
+      const vector<Value> &keys = run.keys();
+      ASSERT_EQ(keys.size(), 2);
+      ASSERT_EQ(keys[0].get_int(), i);
+      ASSERT_EQ(keys[1].get_string(), str);
+
+      const vector<Value> &cells = run.cells();
+      ASSERT_EQ(cells.size(), 6);
+      ASSERT_EQ(cells[0].get_int(), i);
+      ASSERT_EQ(cells[1].get_float(), i * 0.5f);
+      ASSERT_EQ(cells[2].get_string(), str);
+      ASSERT_EQ(cells[3].attr_type(), AttrType::NULLS);
+      ASSERT_EQ(cells[4].get_boolean(), i % 2 == 0);
+      ASSERT_EQ(cells[5].attr_type(), AttrType::DATES);
+      ASSERT_EQ(cells[5].compare(make_date(i)), 0);
+    }
+    ASSERT_EQ(run.next(), RC::RECORD_EOF);
+  }
+
+  // 析构时删除临时文件
+  ASSERT_NE(access(file_name.c_str(), F_OK), 0);
+}
+
+namespace {
+
+string run_file_name()
+{
+  static int sequence = 0;
+  return "sort_run_test_" + to_string(sequence++) + ".run";
+}
+
+/// 每条记录是一个 int
+unique_ptr<SortRun> make_int_run(const vector<int> &values)
+{
+  auto run = make_unique<SortRun>(run_file_name());
+  EXPECT_EQ(run->open_write(), RC::SUCCESS);
+  for (int value : values) {
+    EXPECT_EQ(run->write(reinterpret_cast<const char *>(&value), sizeof(value)), RC::SUCCESS);
+  }
+  EXPECT_EQ(run->finish_write(), RC::SUCCESS);
+  return run;
+}
+
+int record_int(const SortRun &run)
+{
+  int value = 0;
+  memcpy(&value, run.record().data(), sizeof(value));
+  return value;
+}
+
+const SortRunMerger::Less int_less = [](const SortRun &left, const SortRun &right) {
+  return record_int(left) < record_int(right);
+};
+
+const SortRunMerger::RunCreator create_run = []() { return make_unique<SortRun>(run_file_name()); };
+
+vector<int> merge_all(const vector<unique_ptr<SortRun>> &runs)
+{
+  vector<int>   result;
+  SortRunMerger merger(int_less);
+  EXPECT_EQ(merger.open(runs), RC::SUCCESS);
+  for (SortRun *run = merger.top(); run != nullptr; run = merger.top()) {
+    result.push_back(record_int(*run));
+    EXPECT_EQ(merger.advance(), RC::SUCCESS);
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST(SortRunTest, merge)
+{
+  // 各个有序段的长度不同，有空的有序段，也有重复的值
+  vector<unique_ptr<SortRun>> runs;
+  vector<int>                 expected;
+  for (int i = 0; i < 10; i++) {
+    vector<int> values;
+    for (int j = 0; j < i * 7; j++) {
+      values.push_back((j * 13 + i) % 50);
+    }
+    sort(values.begin(), values.end());
+    expected.insert(expected.end(), values.begin(), values.end());
+    runs.push_back(make_int_run(values));
+  }
+  sort(expected.begin(), expected.end());
+
+  ASSERT_EQ(merge_all(runs), expected);
+}
+
+TEST(SortRunTest, reduce)
+{
+  for (size_t max_fan_in : {2, 3, 5, 64}) {
+    for (int run_num = 0; run_num <= 30; run_num++) {
+      vector<unique_ptr<SortRun>> runs;
+      vector<int>                 expected;
+      for (int i = 0; i < run_num; i++) {
+        vector<int> values;
+        for (int j = 0; j < (i * 5) % 17; j++) {
+          values.push_back(j * run_num + i);
+        }
+        expected.insert(expected.end(), values.begin(), values.end());
+        runs.push_back(make_int_run(values));
+      }
+      sort(expected.begin(), expected.end());
+
+      vector<string> input_files;
+      for (const unique_ptr<SortRun> &run : runs) {
+        input_files.push_back(run->file_name());
+      }
+
+      ASSERT_EQ(SortRunMerger::reduce(runs, max_fan_in, int_less, create_run), RC::SUCCESS);
+      ASSERT_LE(runs.size(), max_fan_in);
+      ASSERT_EQ(merge_all(runs), expected) << "max_fan_in=" << max_fan_in << ", run_num=" << run_num;
+
+      // 被归并的有序段已经删除了临时文件
+      runs.clear();
+      for (const string &file_name : input_files) {
+        ASSERT_NE(access(file_name.c_str(), F_OK), 0);
+      }
+    }
+  }
+}
+
+TEST(SortRunTest, reduce_smallest_first)
+{
+  // 第一趟只归并数据量最小的有序段，大的有序段不需要重写
+  vector<unique_ptr<SortRun>> runs;
+  vector<int>                 big_values;
+  for (int i = 0; i < 1000; i++) {
+    big_values.push_back(i * 2);
+  }
+  runs.push_back(make_int_run(big_values));
+  const string big_file = runs.front()->file_name();
+  for (int i = 0; i < 4; i++) {
+    runs.push_back(make_int_run({i * 2 + 1}));
+  }
+
+  // 5 个有序段，每次最多归并 3 个：一趟归并 3 个最小的，剩下 3 个
+  ASSERT_EQ(SortRunMerger::reduce(runs, 3, int_less, create_run), RC::SUCCESS);
+  ASSERT_EQ(runs.size(), 3);
+  ASSERT_TRUE(any_of(runs.begin(), runs.end(), [&big_file](const unique_ptr<SortRun> &run) {
+    return run->file_name() == big_file;
+  }));
+
+  // 4 个有序段，每次最多归并 3 个：只需要归并 2 个最小的
+  runs.push_back(make_int_run({-1}));
+  int64_t big_size = 0;
+  for (const unique_ptr<SortRun> &run : runs) {
+    big_size = max(big_size, run->data_size());
+  }
+  ASSERT_EQ(SortRunMerger::reduce(runs, 3, int_less, create_run), RC::SUCCESS);
+  ASSERT_EQ(runs.size(), 3);
+  ASSERT_TRUE(any_of(runs.begin(), runs.end(), [&big_file](const unique_ptr<SortRun> &run) {
+    return run->file_name() == big_file;
+  }));
+  int64_t total_size = 0;
+  for (const unique_ptr<SortRun> &run : runs) {
+    total_size += run->data_size();
+  }
+  // 1 + 3 + 1 个 int，加上 1000 个 int 的大有序段
+  ASSERT_EQ(total_size, big_size + 5 * static_cast<int64_t>(sizeof(int32_t) + sizeof(int)));
+  ASSERT_EQ(merge_all(runs).size(), 1005);
+}
+
+int main(int argc, char **argv)
+{
+  // 分析gtest程序的命令行参数
+  testing::InitGoogleTest(&argc, argv);
+
+  // 调用RUN_ALL_TESTS()运行所有测试用例
+  // main函数返回RUN_ALL_TESTS()的运行结果
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,84 @@
+/* Copyright (c) 2021 OceanBase and/or its affiliates. All rights reserved.
+miniob is licensed under Mulan PSL v2.
+You can use this software according to the terms and conditions of the Mulan PSL v2.
+You may obtain a copy of Mulan PSL v2 at:
+         http://license.coscl.org.cn/MulanPSL2
+THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+See the Mulan PSL v2 for more details. */
+
+#include "storage/table/visibility_map.h"
+#include "gtest/gtest.h"
+
+using namespace std;
+
+TEST(VisibilityMapTest, load_once)
+{
+  VisibilityMap map;
+
+  int  load_count = 0;
+  auto loader     = [&load_count](VisibilityMap::PageState &state) {
+    load_count++;
+    state.max_xid = 10;
+    return true;
+  };
+
+  // 页面状态只计算一次，所有记录都在读事务之前提交时才可见
+  ASSERT_FALSE(map.all_visible(1, 9, loader));
+  ASSERT_TRUE(map.all_visible(1, 10, loader));
+  ASSERT_TRUE(map.all_visible(1, 11, loader));
+  ASSERT_EQ(1, load_count);
+
+  // 有未提交数据的页面不缓存计算结果
+  auto uncommitted_loader = [&load_count](VisibilityMap::PageState &) {
+    load_count++;
+    return false;
+  };
+  ASSERT_FALSE(map.all_visible(2, 100, uncommitted_loader));
+  ASSERT_FALSE(map.all_visible(2, 100, uncommitted_loader));
+  ASSERT_EQ(3, load_count);
+}
+
+TEST(VisibilityMapTest, change)
+{
+  VisibilityMap map;
+
+  auto loader = [](VisibilityMap::PageState &) { return true; };
+  ASSERT_TRUE(map.all_visible(1, 5, loader));
+
+  // 修改提交之前都不可见，提交之后只对更新的事务可见
+  map.begin_change(1);
+  map.begin_change(1);
+  ASSERT_FALSE(map.all_visible(1, 5, loader));
+  map.commit_change(1, 8, false /*deleted*/);
+  ASSERT_FALSE(map.all_visible(1, 10, loader));
+  map.rollback_change(1);
+  ASSERT_FALSE(map.all_visible(1, 7, loader));
+  ASSERT_TRUE(map.all_visible(1, 8, loader));
+
+  // 删除的数据一直留在页面上，页面不再是全部可见的
+  map.begin_change(1);
+  map.commit_change(1, 9, true /*deleted*/);
+  ASSERT_FALSE(map.all_visible(1, 100, loader));
+  ASSERT_TRUE(map.is_dead(1));
+
+  map.mark_dead(2);
+  ASSERT_TRUE(map.is_dead(2));
+  ASSERT_FALSE(map.all_visible(2, 100, loader));
+
+  // 重置之后重新计算
+  map.reset(2);
+  ASSERT_FALSE(map.is_dead(2));
+  ASSERT_TRUE(map.all_visible(2, 100, loader));
+}
+
+int main(int argc, char **argv)
+{
+  // 分析gtest程序的命令行参数
+  testing::InitGoogleTest(&argc, argv);
+
+  // 调用RUN_ALL_TESTS()运行所有测试用例
+  // main函数返回RUN_ALL_TESTS()的运行结果
+  return RUN_ALL_TESTS();
+}